@@ -148,7 +148,8 @@ QT += network \
     quick \
     printsupport \
     qml \
-    quickwidgets
+    quickwidgets \
+    concurrent
 
 ##  testlib is needed even in release flavor for QSignalSpy support
 QT += testlib
@@ -513,12 +514,14 @@ HEADERS += \
     src/uas/SlugsMAV.h \
     src/uas/PxQuadMAV.h \
     src/uas/ArduPilotMegaMAV.h \
+    src/uas/ArduPilotMessages.h \
     src/uas/senseSoarMAV.h \
     src/ui/watchdog/WatchdogControl.h \
     src/ui/watchdog/WatchdogProcessView.h \
     src/ui/watchdog/WatchdogView.h \
     src/uas/UASWaypointManager.h \
     src/ui/HSIDisplay.h \
+    src/ui/InstrumentRefresh.h \
     src/QGC.h \
     src/ui/RadioCalibration/RadioCalibrationData.h \
     src/comm/QGCMAVLink.h \
@@ -540,6 +543,7 @@ HEADERS += \
     src/ui/QGCUDPLinkConfiguration.h \
     src/ui/QGCUDPClientLinkConfiguration.h \
     src/ui/QGCTCPLinkConfiguration.h \
+    src/ui/MAVLinkRouterConfiguration.h \
     src/ui/QGCSettingsWidget.h \
     src/uas/QGCUASParamManager.h \
     src/ui/map/QGCMapWidget.h \
@@ -653,6 +657,7 @@ HEADERS += \
     src/output/logdata.h \
     src/ui/AP2DataPlot2D.h \
     src/ui/AP2DataPlotThread.h \
+    src/ui/AP2DataPlotBuffer.h \
     src/ui/dataselectionscreen.h \
     src/ui/qcustomplot.h \
     src/globalobject.h \
@@ -666,11 +671,18 @@ HEADERS += \
     src/ui/AutoUpdateCheck.h \
     src/ui/AutoUpdateDialog.h \
     src/uas/LogDownloadDialog.h \
+    src/uas/LogDownloadTransfer.h \
+    src/uas/UASTelemetryStore.h \
     src/comm/TLogReplayLink.h \
     src/ui/PrimaryFlightDisplayQML.h \
     src/ui/configuration/CompassMotorCalibrationDialog.h \
     src/comm/MAVLinkDecoder.h \
+    src/comm/MAVLinkFieldRegistry.h \
     src/comm/MAVLinkProtocol.h \
+    src/comm/MAVLinkRouter.h \
+    src/comm/MAVLinkMessageStatistics.h \
+    src/comm/LinkByteRingBuffer.h \
+    src/comm/TLogWriter.h \
     src/ui/MissionElevationDisplay.h \
     src/ui/GoogleElevationData.h \
     src/comm/UASObject.h \
@@ -690,11 +702,16 @@ HEADERS += \
     src/ui/Loghandling/BinLogParser.h \
     src/ui/Loghandling/ILogParser.h \
     src/ui/Loghandling/IParserCallback.h \
+    src/ui/Loghandling/IExportCallback.h \
     src/ui/Loghandling/AP2DataPlotStatus.h \
     src/ui/Loghandling/AsciiLogParser.h \
     src/ui/Loghandling/LogParserBase.h \
     src/ui/Loghandling/TlogParser.h \
     src/ui/Loghandling/LogdataStorage.h \
+    src/ui/Loghandling/LogdataColumn.h \
+    src/ui/Loghandling/LogdataMappedColumn.h \
+    src/ui/Loghandling/LogdataCache.h \
+    src/ui/Loghandling/LogGraphDecimator.h \
     src/ui/Loghandling/LogExporter.h \
     src/ui/Loghandling/LogAnalysis.h \
     src/ui/Loghandling/LogAnalysisMap.h \
@@ -740,12 +757,14 @@ SOURCES += src/main.cc \
     src/uas/SlugsMAV.cc \
     src/uas/PxQuadMAV.cc \
     src/uas/ArduPilotMegaMAV.cc \
+    src/uas/ArduPilotMessages.cc \
     src/uas/senseSoarMAV.cpp \
     src/ui/watchdog/WatchdogControl.cc \
     src/ui/watchdog/WatchdogProcessView.cc \
     src/ui/watchdog/WatchdogView.cc \
     src/uas/UASWaypointManager.cc \
     src/ui/HSIDisplay.cc \
+    src/ui/InstrumentRefresh.cc \
     src/QGC.cc \
     src/ui/RadioCalibration/RadioCalibrationData.cc \
     src/ui/SlugsDataSensorView.cc \
@@ -766,6 +785,7 @@ SOURCES += src/main.cc \
     src/ui/QGCUDPLinkConfiguration.cc \
     src/ui/QGCUDPClientLinkConfiguration.cc \
     src/ui/QGCTCPLinkConfiguration.cc \
+    src/ui/MAVLinkRouterConfiguration.cc \
     src/ui/QGCSettingsWidget.cc \
     src/uas/QGCUASParamManager.cc \
     src/ui/map/QGCMapWidget.cc \
@@ -878,6 +898,7 @@ SOURCES += src/main.cc \
     src/output/logdata.cc \
     src/ui/AP2DataPlot2D.cpp \
     src/ui/AP2DataPlotThread.cc \
+    src/ui/AP2DataPlotBuffer.cc \
     src/ui/dataselectionscreen.cpp \
     src/ui/qcustomplot.cpp \
     src/globalobject.cc \
@@ -891,11 +912,18 @@ SOURCES += src/main.cc \
     src/ui/AutoUpdateCheck.cc \
     src/ui/AutoUpdateDialog.cc \
     src/uas/LogDownloadDialog.cc \
+    src/uas/LogDownloadTransfer.cc \
+    src/uas/UASTelemetryStore.cc \
     src/comm/TLogReplayLink.cc \
     src/ui/PrimaryFlightDisplayQML.cpp \
     src/ui/configuration/CompassMotorCalibrationDialog.cpp \
     src/comm/MAVLinkDecoder.cc \
+    src/comm/MAVLinkFieldRegistry.cc \
     src/comm/MAVLinkProtocol.cc \
+    src/comm/MAVLinkRouter.cc \
+    src/comm/MAVLinkMessageStatistics.cc \
+    src/comm/LinkByteRingBuffer.cc \
+    src/comm/TLogWriter.cc \
     src/ui/MissionElevationDisplay.cpp \
     src/ui/GoogleElevationData.cpp \
     src/comm/UASObject.cc \
@@ -917,6 +945,10 @@ SOURCES += src/main.cc \
     src/ui/Loghandling/LogParserBase.cpp \
     src/ui/Loghandling/TlogParser.cpp \
     src/ui/Loghandling/LogdataStorage.cpp \
+    src/ui/Loghandling/LogdataColumn.cpp \
+    src/ui/Loghandling/LogdataMappedColumn.cpp \
+    src/ui/Loghandling/LogdataCache.cpp \
+    src/ui/Loghandling/LogGraphDecimator.cpp \
     src/ui/Loghandling/LogExporter.cpp \
     src/ui/Loghandling/LogAnalysis.cpp \
     src/ui/Loghandling/LogAnalysisMap.cpp\
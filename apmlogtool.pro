@@ -0,0 +1,102 @@
+# -------------------------------------------------
+# APM Planner log tool - headless batch analysis and export of
+# ArduPilot logs. Uses the parsers and exporters of the log analysis
+# without any widget, so it can run on servers without a display.
+#
+# This file is part of the APM Planner project
+# APM Planner is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# APM Planner is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with APM Planner. If not, see <http://www.gnu.org/licenses/>.
+# -------------------------------------------------
+
+# Qt configuration - QtGui is only needed for QColor and QQuaternion
+CONFIG += qt \
+    thread \
+    console \
+    c++14
+CONFIG -= app_bundle
+QT = core \
+    gui \
+    concurrent
+
+TEMPLATE = app
+TARGET = apmlogtool
+BASEDIR = $${IN_PWD}
+LANGUAGE = C++
+
+CONFIG(debug, debug|release) {
+    DESTDIR = $${OUT_PWD}/debug
+    BUILDDIR = $${OUT_PWD}/build-logtool-debug
+} else {
+    DESTDIR = $${OUT_PWD}/release
+    BUILDDIR = $${OUT_PWD}/build-logtool-release
+    DEFINES += QT_NO_DEBUG
+}
+OBJECTS_DIR = $${BUILDDIR}/obj
+MOC_DIR = $${BUILDDIR}/moc
+RCC_DIR = $${BUILDDIR}/rcc
+
+DEFINES += __STDC_LIMIT_MACROS
+!win32 {
+    LIBS += -lz
+}
+
+# MAVLink is used for the MAV_TYPE constants and the tlog parser
+MAVLINKPATH = $$BASEDIR/libs/mavlink/include/mavlink/v2.0
+INCLUDEPATH += $$MAVLINKPATH \
+    $$MAVLINKPATH/ardupilotmega
+DEFINES += QGC_USE_ARDUPILOTMEGA_MESSAGES
+
+# Zip Access Tool for KMZ export
+include (libs/thirdParty/quazip/quazip.pri)
+
+INCLUDEPATH += . \
+    src \
+    src/ui \
+    src/uas \
+    src/output \
+    src/apps/logtool
+
+HEADERS += \
+    src/logging.h \
+    src/uas/ArduPilotMessages.h \
+    src/output/kmlcreator.h \
+    src/output/logdata.h \
+    src/ui/Loghandling/AP2DataPlotStatus.h \
+    src/ui/Loghandling/ILogParser.h \
+    src/ui/Loghandling/IParserCallback.h \
+    src/ui/Loghandling/IExportCallback.h \
+    src/ui/Loghandling/LogParserBase.h \
+    src/ui/Loghandling/BinLogParser.h \
+    src/ui/Loghandling/AsciiLogParser.h \
+    src/ui/Loghandling/TlogParser.h \
+    src/ui/Loghandling/LogdataColumn.h \
+    src/ui/Loghandling/LogdataMappedColumn.h \
+    src/ui/Loghandling/LogdataStorage.h \
+    src/ui/Loghandling/LogdataCache.h \
+    src/ui/Loghandling/LogExporter.h \
+    src/apps/logtool/LogBatchProcessor.h
+
+SOURCES += \
+    src/uas/ArduPilotMessages.cc \
+    src/output/kmlcreator.cc \
+    src/output/logdata.cc \
+    src/ui/Loghandling/AP2DataPlotStatus.cpp \
+    src/ui/Loghandling/LogParserBase.cpp \
+    src/ui/Loghandling/BinLogParser.cpp \
+    src/ui/Loghandling/AsciiLogParser.cpp \
+    src/ui/Loghandling/TlogParser.cpp \
+    src/ui/Loghandling/LogdataColumn.cpp \
+    src/ui/Loghandling/LogdataMappedColumn.cpp \
+    src/ui/Loghandling/LogdataStorage.cpp \
+    src/ui/Loghandling/LogdataCache.cpp \
+    src/ui/Loghandling/LogExporter.cpp \
+    src/apps/logtool/LogBatchProcessor.cc \
+    src/apps/logtool/main.cc
@@ -24,6 +24,7 @@ HEADERS += opmapcontrol.h \
            src/core/rawtile.h \
            src/core/size.h \
            src/core/tilecachequeue.h \
+           src/core/tilepack.h \
            src/core/urlfactory.h \
            src/internals/copyrightstrings.h \
            src/internals/core.h \
@@ -41,6 +42,7 @@ HEADERS += opmapcontrol.h \
            src/mapwidget/gpsitem.h \
            src/mapwidget/homeitem.h \
            src/mapwidget/mapgraphicitem.h \
+           src/mapwidget/mapprefetcher.h \
            src/mapwidget/mapripform.h \
            src/mapwidget/mapripper.h \
            src/mapwidget/opmapwidget.h \
@@ -73,6 +75,7 @@ SOURCES += src/core/alllayersoftype.cpp \
            src/core/rawtile.cpp \
            src/core/size.cpp \
            src/core/tilecachequeue.cpp \
+           src/core/tilepack.cpp \
            src/core/urlfactory.cpp \
            src/internals/core.cpp \
            src/internals/loadtask.cpp \
@@ -88,6 +91,7 @@ SOURCES += src/core/alllayersoftype.cpp \
            src/mapwidget/gpsitem.cpp \
            src/mapwidget/homeitem.cpp \
            src/mapwidget/mapgraphicitem.cpp \
+           src/mapwidget/mapprefetcher.cpp \
            src/mapwidget/mapripform.cpp \
            src/mapwidget/mapripper.cpp \
            src/mapwidget/opmapwidget.cpp \
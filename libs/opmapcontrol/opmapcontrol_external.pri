@@ -30,6 +30,7 @@ HEADERS += libs/opmapcontrol/opmapcontrol.h \
            libs/opmapcontrol/src/core/rawtile.h \
            libs/opmapcontrol/src/core/size.h \
            libs/opmapcontrol/src/core/tilecachequeue.h \
+           libs/opmapcontrol/src/core/tilepack.h \
            libs/opmapcontrol/src/core/urlfactory.h \
            libs/opmapcontrol/src/internals/copyrightstrings.h \
            libs/opmapcontrol/src/internals/core.h \
@@ -46,6 +47,7 @@ HEADERS += libs/opmapcontrol/opmapcontrol.h \
            libs/opmapcontrol/src/mapwidget/gpsitem.h \
            libs/opmapcontrol/src/mapwidget/homeitem.h \
            libs/opmapcontrol/src/mapwidget/mapgraphicitem.h \
+           libs/opmapcontrol/src/mapwidget/mapprefetcher.h \
            libs/opmapcontrol/src/mapwidget/mapripform.h \
            libs/opmapcontrol/src/mapwidget/mapripper.h \
            libs/opmapcontrol/src/mapwidget/opmapwidget.h \
@@ -81,6 +83,7 @@ SOURCES += libs/opmapcontrol/src/core/alllayersoftype.cpp \
            libs/opmapcontrol/src/core/rawtile.cpp \
            libs/opmapcontrol/src/core/size.cpp \
            libs/opmapcontrol/src/core/tilecachequeue.cpp \
+           libs/opmapcontrol/src/core/tilepack.cpp \
            libs/opmapcontrol/src/core/urlfactory.cpp \
            libs/opmapcontrol/src/internals/core.cpp \
            libs/opmapcontrol/src/internals/loadtask.cpp \
@@ -96,6 +99,7 @@ SOURCES += libs/opmapcontrol/src/core/alllayersoftype.cpp \
            libs/opmapcontrol/src/mapwidget/gpsitem.cpp \
            libs/opmapcontrol/src/mapwidget/homeitem.cpp \
            libs/opmapcontrol/src/mapwidget/mapgraphicitem.cpp \
+           libs/opmapcontrol/src/mapwidget/mapprefetcher.cpp \
            libs/opmapcontrol/src/mapwidget/mapripform.cpp \
            libs/opmapcontrol/src/mapwidget/mapripper.cpp \
            libs/opmapcontrol/src/mapwidget/opmapwidget.cpp \
@@ -10,6 +10,7 @@ SOURCES += opmaps.cpp \
     providerstrings.cpp \
     cacheitemqueue.cpp \
     tilecachequeue.cpp \
+    tilepack.cpp \
     alllayersoftype.cpp \
     urlfactory.cpp \
     placemark.cpp \
@@ -30,6 +31,7 @@ HEADERS += opmaps.h \
     providerstrings.h \
     cacheitemqueue.h \
     tilecachequeue.h \
+    tilepack.h \
     alllayersoftype.h \
     urlfactory.h \
     geodecoderstatus.h \
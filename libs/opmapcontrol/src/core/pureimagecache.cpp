@@ -27,10 +27,97 @@
 #include "pureimagecache.h"
 #include <QDateTime>
 #include <QSettings>
+#include <QAtomicInt>
+#include <QThreadStorage>
+#include <QScopedPointer>
 //#define DEBUG_PUREIMAGECACHE
 namespace core {
     qlonglong PureImageCache::ConnCounter=0;
 
+    namespace {
+        /**
+        * @brief Persistent connection of one thread to the tile database
+        *
+        * A QSqlDatabase must only be used by the thread which created it. So every
+        * thread gets its own connection which lives as long as the thread and keeps
+        * its prepared statements.
+        */
+        class ThreadConnection
+        {
+        public:
+            explicit ThreadConnection(const QString &file):file(file),opened(false)
+            {
+                connectionName=QString("PureImageCache_%1").arg(counter.fetchAndAddRelaxed(1));
+                QSqlDatabase cn=QSqlDatabase::addDatabase("QSQLITE",connectionName);
+                cn.setDatabaseName(file);
+                cn.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+                if(!cn.open())
+                {
+#ifdef DEBUG_PUREIMAGECACHE
+                    qDebug()<<"ThreadConnection: Unable to open database"<<cn.lastError().driverText();
+#endif //DEBUG_PUREIMAGECACHE
+                    return;
+                }
+                {
+                    // readers do not block the writer and vice versa
+                    QSqlQuery query(cn);
+                    query.exec("PRAGMA journal_mode=WAL");
+                    query.exec("PRAGMA synchronous=NORMAL");
+                    // the tiles are always searched by position, zoom and type
+                    query.exec("CREATE INDEX IF NOT EXISTS IndexOfTiles ON Tiles (X, Y, Zoom, Type)");
+                }
+                selectTile.reset(new QSqlQuery(cn));
+                selectTile->setForwardOnly(true);
+                selectTile->prepare("SELECT Tile FROM TilesData WHERE id = (SELECT id FROM Tiles WHERE X=? AND Y=? AND Zoom=? AND Type=?)");
+                insertTile.reset(new QSqlQuery(cn));
+                insertTile->prepare("INSERT INTO Tiles(X, Y, Zoom, Type, Date) VALUES(?, ?, ?, ?, ?)");
+                insertTileData.reset(new QSqlQuery(cn));
+                insertTileData->prepare("INSERT INTO TilesData(id, Tile) VALUES(?, ?)");
+                opened=true;
+            }
+            ~ThreadConnection()
+            {
+                // the statements must be gone before the connection is removed
+                selectTile.reset();
+                insertTile.reset();
+                insertTileData.reset();
+                {
+                    QSqlDatabase cn=QSqlDatabase::database(connectionName,false);
+                    cn.close();
+                }
+                QSqlDatabase::removeDatabase(connectionName);
+            }
+            bool isOpen()const{return opened;}
+            QString name()const{return connectionName;}
+            QString fileName()const{return file;}
+
+            QScopedPointer<QSqlQuery> selectTile;
+            QScopedPointer<QSqlQuery> insertTile;
+            QScopedPointer<QSqlQuery> insertTileData;
+        private:
+            static QAtomicInt counter;
+            QString connectionName;
+            QString file;
+            bool opened;
+        };
+        QAtomicInt ThreadConnection::counter(0);
+
+        QThreadStorage<ThreadConnection*> connections;
+
+        /**
+        * @brief Delivers the connection of the calling thread. Opens a new one
+        *        on first use or if the cache file changed.
+        */
+        ThreadConnection *threadConnection(const QString &file)
+        {
+            if(!connections.hasLocalData() || connections.localData()->fileName()!=file)
+            {
+                connections.setLocalData(new ThreadConnection(file));
+            }
+            return connections.localData();
+        }
+    }
+
     PureImageCache::PureImageCache()
     {
 
@@ -171,82 +258,80 @@ namespace core {
     }
     bool PureImageCache::PutImageToCache(const QByteArray &tile, const MapType::Types &type,const Point &pos,const int &zoom)
     {
-        if(gtilecache.isEmpty()|gtilecache.isNull())
-            return false;
+        CacheItemQueue item(type,pos,tile,zoom);
+        QList<CacheItemQueue*> tiles;
+        tiles.append(&item);
+        return PutImagesToCache(tiles);
+    }
+    bool PureImageCache::PutImagesToCache(const QList<CacheItemQueue*> &tiles)
+    {
         lock.lockForRead();
+        if(gtilecache.isEmpty())
+        {
+            lock.unlock();
+            return false;
+        }
 #ifdef DEBUG_PUREIMAGECACHE
-        qDebug()<<"PutImageToCache Start:";//<<pos;
+        qDebug()<<"PutImagesToCache Start:"<<tiles.count();
 #endif //DEBUG_PUREIMAGECACHE
-        Mcounter.lock();
-        qlonglong id=++ConnCounter;
-        Mcounter.unlock();
+        bool ret=false;
+        ThreadConnection *cn=threadConnection(gtilecache+"Data.qmdb");
+        if(cn->isOpen())
         {
-            QSqlDatabase cn;
-            cn = QSqlDatabase::addDatabase("QSQLITE",QString::number(id));
-            QString db=gtilecache+"Data.qmdb";
-            cn.setDatabaseName(db);
-            cn.setConnectOptions("QSQLITE_ENABLE_SHARED_CACHE");
-            if(cn.open())
+            QSqlDatabase db=QSqlDatabase::database(cn->name(),false);
+            db.transaction();
+            QString date=QDateTime::currentDateTime().toString();
+            foreach(CacheItemQueue *tile,tiles)
             {
+                cn->insertTile->bindValue(0,tile->GetPosition().X());
+                cn->insertTile->bindValue(1,tile->GetPosition().Y());
+                cn->insertTile->bindValue(2,tile->GetZoom());
+                cn->insertTile->bindValue(3,(int)tile->GetMapType());
+                cn->insertTile->bindValue(4,date);
+                if(cn->insertTile->exec())
                 {
-                    QSqlQuery query(cn);
-                    query.prepare("INSERT INTO Tiles(X, Y, Zoom, Type,Date) VALUES(?, ?, ?, ?,?)");
-                    query.addBindValue(pos.X());
-                    query.addBindValue(pos.Y());
-                    query.addBindValue(zoom);
-
-                    query.addBindValue((int)type);
-                    query.addBindValue(QDateTime::currentDateTime().toString());
-                    query.exec();
+                    cn->insertTileData->bindValue(0,cn->insertTile->lastInsertId());
+                    cn->insertTileData->bindValue(1,tile->GetImg());
+                    cn->insertTileData->exec();
                 }
+#ifdef DEBUG_PUREIMAGECACHE
+                else
                 {
-                    QSqlQuery query(cn);
-                    query.prepare("INSERT INTO TilesData(id, Tile) VALUES((SELECT last_insert_rowid()), ?)");
-                    query.addBindValue(tile);
-                    query.exec();
+                    qDebug()<<"PutImagesToCache: "<<cn->insertTile->lastError().driverText();
                 }
-                cn.close();
+#endif //DEBUG_PUREIMAGECACHE
             }
+            ret=db.commit();
         }
-        QSqlDatabase::removeDatabase(QString::number(id));
         lock.unlock();
-        return true;
+        return ret;
     }
     QByteArray PureImageCache::GetImageFromCache(MapType::Types type, Point pos, int zoom)
     {
         lock.lockForRead();
         QByteArray ar;
-        if(gtilecache.isEmpty()|gtilecache.isNull())
+        if(gtilecache.isEmpty())
+        {
+            lock.unlock();
             return ar;
-        QString dir=gtilecache;
-        Mcounter.lock();
-        qlonglong id=++ConnCounter;
-        Mcounter.unlock();
+        }
 #ifdef DEBUG_PUREIMAGECACHE
-        qDebug()<<"Cache dir="<<dir<<" Try to GET:"<<pos.X()+","+pos.Y();
+        qDebug()<<"Cache dir="<<gtilecache<<" Try to GET:"<<pos.X()+","+pos.Y();
 #endif //DEBUG_PUREIMAGECACHE
-
-            QString db=dir+"Data.qmdb";
-			{
-				QSqlDatabase cn;
-			
-				cn = QSqlDatabase::addDatabase("QSQLITE",QString::number(id));
-
-	            cn.setDatabaseName(db);
-		        cn.setConnectOptions("QSQLITE_ENABLE_SHARED_CACHE");
-			    if(cn.open())
-				{
-					QSqlQuery query(cn);
-					query.exec(QString("SELECT Tile FROM TilesData WHERE id = (SELECT id FROM Tiles WHERE X=%1 AND Y=%2 AND Zoom=%3 AND Type=%4)").arg(pos.X()).arg(pos.Y()).arg(zoom).arg((int) type));
-					query.next();
-					if(query.isValid())
-					{
-						ar=query.value(0).toByteArray();
-					}
-					cn.close();
-				}
-			}
-			QSqlDatabase::removeDatabase(QString::number(id));
+        ThreadConnection *cn=threadConnection(gtilecache+"Data.qmdb");
+        if(cn->isOpen())
+        {
+            cn->selectTile->bindValue(0,pos.X());
+            cn->selectTile->bindValue(1,pos.Y());
+            cn->selectTile->bindValue(2,zoom);
+            cn->selectTile->bindValue(3,(int)type);
+            if(cn->selectTile->exec() && cn->selectTile->next())
+            {
+                ar=cn->selectTile->value(0).toByteArray();
+            }
+            // release the read lock of the statement, so the WAL can be checkpointed
+            cn->selectTile->finish();
+        }
         lock.unlock();
         return ar;
     }
@@ -39,10 +39,19 @@
 #include "point.h"
 #include <QVariant>
 #include "pureimage.h"
+#include "cacheitemqueue.h"
 #include <QList>
 #include <QMutex>
 #include <QReadWriteLock>
 namespace core {
+    /**
+    * @brief Tile cache in a SQLite database.
+    *
+    * Every thread uses its own persistent connection with prepared statements
+    * (SQLite connections must not be shared between threads). The database runs
+    * in WAL mode, so the readers of the tile loader threads are not blocked by
+    * the TileCacheQueue writing new tiles.
+    */
     class PureImageCache
     {
 
@@ -50,6 +59,13 @@ namespace core {
         PureImageCache();
         static bool CreateEmptyDB(const QString &file);
         bool PutImageToCache(const QByteArray &tile,const MapType::Types &type,const core::Point &pos, const int &zoom);
+        /**
+        * @brief Writes several tiles using one transaction
+        *
+        * @param tiles the tiles to store
+        * @return bool true if the transaction was committed
+        */
+        bool PutImagesToCache(const QList<CacheItemQueue*> &tiles);
         QByteArray GetImageFromCache(MapType::Types type, core::Point pos, int zoom);
         QString GtileCache();
         void setGtileCache(const QString &value);
@@ -79,21 +79,24 @@ void TileCacheQueue::run()
 #endif //DEBUG_TILECACHEQUEUE
     while(true)
     {
-        CacheItemQueue *task;
+        QList<CacheItemQueue*> batch;
 #ifdef DEBUG_TILECACHEQUEUE
         qDebug()<<"Cache";
 #endif //DEBUG_TILECACHEQUEUE
-        if(tileCacheQueue.count()>0)
+        // everything queued so far is written with one transaction
+        mutex.lock();
+        while(tileCacheQueue.count()>0 && batch.count()<MaxBatchSize)
+        {
+            batch.append(tileCacheQueue.dequeue());
+        }
+        mutex.unlock();
+        if(batch.count()>0)
         {
-            mutex.lock();
-            task=tileCacheQueue.dequeue();
-            mutex.unlock();
 #ifdef DEBUG_TILECACHEQUEUE
-            qDebug()<<"Cache engine Put:"<<task->GetPosition().X()<<","<<task->GetPosition().Y();
+            qDebug()<<"Cache engine Put:"<<batch.count()<<"tiles";
 #endif //DEBUG_TILECACHEQUEUE
-            Cache::Instance()->ImageCache.PutImageToCache(task->GetImg(),task->GetMapType(),task->GetPosition(),task->GetZoom());
-            usleep(44);
-            delete task;
+            Cache::Instance()->ImageCache.PutImagesToCache(batch);
+            qDeleteAll(batch);
         }
 
         else
@@ -117,10 +120,13 @@ void TileCacheQueue::run()
                 }
                 mutex.unlock();
             }
-            #ifdef DEBUG_TILECACHEQUEUE
-            qDebug()<<"Cache Engine DID NOT TimeOut";
-            #endif //DEBUG_TILECACHEQUEUE
-            waitmutex.unlock();
+            else
+            {
+                #ifdef DEBUG_TILECACHEQUEUE
+                qDebug()<<"Cache Engine DID NOT TimeOut";
+                #endif //DEBUG_TILECACHEQUEUE
+                waitmutex.unlock();
+            }
         }
     }
 #ifdef DEBUG_TILECACHEQUEUE
@@ -50,6 +50,10 @@ namespace core {
     protected:
         QQueue<CacheItemQueue*> tileCacheQueue;
     private:
+        /**
+        * @brief Max number of tiles written with one transaction
+        */
+        static const int MaxBatchSize=64;
         void run();
         QMutex mutex;
         QMutex waitmutex;
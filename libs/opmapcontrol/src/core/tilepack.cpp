@@ -0,0 +1,214 @@
+/**
+******************************************************************************
+*
+* @file       tilepack.cpp
+* @author     APM_PLANNER PROJECT <http://www.ardupilot.com> Copyright (C) 2026.
+* @brief      Single file tile packs for offline use
+* @see        The GNU Public License (GPL) Version 3
+* @defgroup   OPMapWidget
+* @{
+*
+*****************************************************************************/
+/*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#include "tilepack.h"
+#include "cache.h"
+#include <QAtomicInt>
+#include <QFile>
+#include <QFileInfo>
+#include <QVector>
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlQuery>
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlRecord>
+#include <QDebug>
+//#define DEBUG_TILEPACK
+namespace core {
+    namespace {
+        QAtomicInt connectionCounter(0);
+
+        QString newConnectionName()
+        {
+            return QString("TilePack_%1").arg(connectionCounter.fetchAndAddRelaxed(1));
+        }
+
+        /**
+        * @brief MBTiles counts the rows from the bottom (TMS), the map from the top
+        */
+        int flipRow(int row,int zoom)
+        {
+            return (1<<zoom)-1-row;
+        }
+
+        QString imageFormat(const QByteArray &img)
+        {
+            if(img.startsWith("\x89PNG"))
+                return "png";
+            if(img.startsWith("\xFF\xD8"))
+                return "jpg";
+            return QString();
+        }
+
+        bool writeMetadata(QSqlDatabase &db,const QString &name,const QString &value)
+        {
+            QSqlQuery query(db);
+            query.prepare("INSERT INTO metadata(name, value) VALUES(?, ?)");
+            query.bindValue(0,name);
+            query.bindValue(1,value);
+            return query.exec();
+        }
+    }
+
+    int TilePack::Export(const QString &file, const QList<RawTile> &tiles)
+    {
+        if(QFile::exists(file) && !QFile::remove(file))
+        {
+#ifdef DEBUG_TILEPACK
+            qDebug()<<"TilePack::Export: Unable to replace"<<file;
+#endif //DEBUG_TILEPACK
+            return -1;
+        }
+        int count=-1;
+        QString connectionName=newConnectionName();
+        {
+            QSqlDatabase db=QSqlDatabase::addDatabase("QSQLITE",connectionName);
+            db.setDatabaseName(file);
+            if(db.open())
+            {
+                QSqlQuery query(db);
+                if(query.exec("CREATE TABLE metadata (name TEXT, value TEXT)") &&
+                   query.exec("CREATE TABLE tiles (zoom_level INTEGER, tile_column INTEGER, tile_row INTEGER, tile_data BLOB, map_type INTEGER)") &&
+                   query.exec("CREATE UNIQUE INDEX tile_index ON tiles (map_type, zoom_level, tile_column, tile_row)"))
+                {
+                    db.transaction();
+                    QSqlQuery insert(db);
+                    insert.prepare("INSERT OR REPLACE INTO tiles(zoom_level, tile_column, tile_row, tile_data, map_type) VALUES(?, ?, ?, ?, ?)");
+                    int minZoom=-1;
+                    int maxZoom=-1;
+                    QString format;
+                    count=0;
+                    foreach(RawTile tile,tiles)
+                    {
+                        QByteArray img=Cache::Instance()->ImageCache.GetImageFromCache(tile.Type(),tile.Pos(),tile.Zoom());
+                        if(img.isEmpty())
+                            continue;
+                        insert.bindValue(0,tile.Zoom());
+                        insert.bindValue(1,tile.Pos().X());
+                        insert.bindValue(2,flipRow(tile.Pos().Y(),tile.Zoom()));
+                        insert.bindValue(3,img);
+                        insert.bindValue(4,(int)tile.Type());
+                        if(!insert.exec())
+                        {
+#ifdef DEBUG_TILEPACK
+                            qDebug()<<"TilePack::Export: "<<insert.lastError().driverText();
+#endif //DEBUG_TILEPACK
+                            continue;
+                        }
+                        ++count;
+                        if(minZoom<0 || tile.Zoom()<minZoom)
+                            minZoom=tile.Zoom();
+                        if(tile.Zoom()>maxZoom)
+                            maxZoom=tile.Zoom();
+                        if(format.isEmpty())
+                            format=imageFormat(img);
+                    }
+                    writeMetadata(db,"name",QFileInfo(file).completeBaseName());
+                    writeMetadata(db,"type","baselayer");
+                    writeMetadata(db,"version","1.0");
+                    writeMetadata(db,"description","Offline map tiles exported by APM Planner");
+                    if(!format.isEmpty())
+                        writeMetadata(db,"format",format);
+                    if(count>0)
+                    {
+                        writeMetadata(db,"minzoom",QString::number(minZoom));
+                        writeMetadata(db,"maxzoom",QString::number(maxZoom));
+                    }
+                    if(!db.commit())
+                        count=-1;
+                }
+#ifdef DEBUG_TILEPACK
+                else
+                {
+                    qDebug()<<"TilePack::Export: "<<query.lastError().driverText();
+                }
+#endif //DEBUG_TILEPACK
+                db.close();
+            }
+        }
+        QSqlDatabase::removeDatabase(connectionName);
+        return count;
+    }
+
+    int TilePack::Import(const QString &file, MapType::Types defaultType)
+    {
+        if(!QFile::exists(file))
+            return -1;
+        int count=-1;
+        QString connectionName=newConnectionName();
+        {
+            QSqlDatabase db=QSqlDatabase::addDatabase("QSQLITE",connectionName);
+            db.setDatabaseName(file);
+            db.setConnectOptions("QSQLITE_OPEN_READONLY");
+            if(db.open())
+            {
+                QSqlQuery query(db);
+                query.setForwardOnly(true);
+                // Standard MBTiles files have no map_type column, their tiles belong to defaultType
+                bool hasMapType=db.record("tiles").contains("map_type");
+                if(query.exec(hasMapType ? "SELECT zoom_level, tile_column, tile_row, tile_data, map_type FROM tiles"
+                                         : "SELECT zoom_level, tile_column, tile_row, tile_data FROM tiles"))
+                {
+                    count=0;
+                    QVector<CacheItemQueue> batch;
+                    batch.reserve(ImportBatchSize);
+                    bool more=true;
+                    while(more)
+                    {
+                        more=query.next();
+                        if(more)
+                        {
+                            int zoom=query.value(0).toInt();
+                            Point pos(query.value(1).toInt(),flipRow(query.value(2).toInt(),zoom));
+                            MapType::Types type=hasMapType ? (MapType::Types)query.value(4).toInt() : defaultType;
+                            if(Cache::Instance()->ImageCache.GetImageFromCache(type,pos,zoom).isEmpty())
+                            {
+                                batch.append(CacheItemQueue(type,pos,query.value(3).toByteArray(),zoom));
+                            }
+                        }
+                        if(batch.count()==ImportBatchSize || (!more && !batch.isEmpty()))
+                        {
+                            QList<CacheItemQueue*> tiles;
+                            for(int i=0;i<batch.count();++i)
+                                tiles.append(&batch[i]);
+                            if(Cache::Instance()->ImageCache.PutImagesToCache(tiles))
+                                count+=batch.count();
+                            batch.resize(0);
+                        }
+                    }
+                }
+#ifdef DEBUG_TILEPACK
+                else
+                {
+                    qDebug()<<"TilePack::Import: "<<query.lastError().driverText();
+                }
+#endif //DEBUG_TILEPACK
+                db.close();
+            }
+        }
+        QSqlDatabase::removeDatabase(connectionName);
+        return count;
+    }
+}
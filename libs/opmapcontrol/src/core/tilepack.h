@@ -0,0 +1,75 @@
+/**
+******************************************************************************
+*
+* @file       tilepack.h
+* @author     APM_PLANNER PROJECT <http://www.ardupilot.com> Copyright (C) 2026.
+* @brief      Single file tile packs for offline use
+* @see        The GNU Public License (GPL) Version 3
+* @defgroup   OPMapWidget
+* @{
+*
+*****************************************************************************/
+/*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef TILEPACK_H
+#define TILEPACK_H
+
+#include "rawtile.h"
+#include <QList>
+#include <QString>
+
+namespace core {
+    /**
+    * @brief Exports tiles of the cache to a single file tile pack and imports them again.
+    *
+    * A tile pack is a SQLite database laid out like an MBTiles file: a "metadata"
+    * table with name/value pairs and a "tiles" table with zoom_level, tile_column,
+    * tile_row (TMS numbering, counted from the bottom) and tile_data. An additional
+    * map_type column keeps the layers of hybrid map types apart. It is optional
+    * on import, so plain MBTiles files can be read as well.
+    */
+    class TilePack
+    {
+    public:
+        /**
+        * @brief Writes the given tiles from the cache to a new tile pack
+        *
+        * Tiles which are not in the cache are skipped. An existing file is replaced.
+        *
+        * @param file the tile pack to create
+        * @param tiles the tiles to export
+        * @return int number of tiles written, -1 on error
+        */
+        static int Export(const QString &file, const QList<RawTile> &tiles);
+        /**
+        * @brief Reads all tiles of a tile pack into the cache
+        *
+        * Tiles which are already in the cache are skipped. Files without the map_type
+        * column, like standard MBTiles files, are imported as tiles of defaultType.
+        *
+        * @param file the tile pack to read
+        * @param defaultType map type of the tiles if the file does not store it
+        * @return int number of tiles added to the cache, -1 on error
+        */
+        static int Import(const QString &file, MapType::Types defaultType);
+    private:
+        /**
+        * @brief Max number of tiles written to the cache with one transaction
+        */
+        static const int ImportBatchSize=64;
+    };
+}
+#endif // TILEPACK_H
@@ -186,6 +186,7 @@ namespace internals {
 
                         if(t->Overlays.count() > 0)
                         {
+                            t->DecodeOverlays();
                             Matrix.SetTileAt(task.Pos,t);
                             emit OnNeedInvalidation();
 
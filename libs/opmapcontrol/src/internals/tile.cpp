@@ -25,6 +25,7 @@
 * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 */
 #include "tile.h"
+#include <QPainter>
 
  
 namespace internals {
@@ -39,11 +40,31 @@ void Tile::Clear()
     qDebug()<<"Tile:Clear Overlays";
 #endif //DEBUG_TILE
     mutex.lock();
+    Overlays.clear();
+    Image=QImage();
+    mutex.unlock();
+}
+void Tile::DecodeOverlays()
+{
+    QImage composed;
     foreach(QByteArray img, Overlays)
     {
-        img.~QByteArray();
+        QImage layer=QImage::fromData(img);
+        if(layer.isNull())
+            continue;
+        if(composed.isNull())
+        {
+            // the format the raster engine draws fastest
+            composed=layer.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        }
+        else
+        {
+            QPainter painter(&composed);
+            painter.drawImage(composed.rect(),layer);
+        }
     }
-    Overlays.clear();
+    mutex.lock();
+    Image=composed;
     mutex.unlock();
 }
 Tile::Tile():zoom(0),pos(0,0)
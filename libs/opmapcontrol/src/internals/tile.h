@@ -53,7 +53,17 @@ public:
         this->pos=cSource.pos;
     }
     bool HasValue(){return !(zoom==0);}
+    /**
+    * @brief Decodes the overlays and draws them on top of each other into Image
+    *
+    * Called by the loader threads, so the GUI thread never has to decode a tile.
+    */
+    void DecodeOverlays();
     QList<QByteArray> Overlays;
+    /**
+    * @brief All overlays decoded into one image, null if not decoded yet
+    */
+    QImage Image;
 protected:
 
     QMutex mutex;
@@ -41,6 +41,10 @@ namespace mapcontrol
         zoomDigi(0),
         isSelected(false)
     {
+        // 128 MB of tile pixmaps, enough for a 4K screen at two zoom levels
+        tilePixmaps.setMaxCost(128*1024);
+        // the map is only rendered again when it changed, not when an item on top of it moved
+        setCacheMode(QGraphicsItem::DeviceCoordinateCache);
         dragons.load(QString::fromUtf8(":/markers/images/dragons1.jpg"));
         showTileGridLines=false;
         isMouseOverMarker=false;
@@ -359,17 +363,12 @@ namespace mapcontrol
                             //lock(t.Overlays)
                             if(t!=0)
                             {
-                                foreach(QByteArray img,t->Overlays)
+                                QPixmap pixmap=TilePixmap(t);
+                                if(!pixmap.isNull())
                                 {
-                                    if(img.count()!=0)
-                                    {
-                                        if(!found)
-                                            found = true;
-                                        {
-                                            painter->drawPixmap(core->tileRect.X(),core->tileRect.Y(), core->tileRect.Width(), core->tileRect.Height(),PureImageProxy::FromStream(img));
-                                           // qDebug()<<"tile:"<<core->tileRect.X()<<core->tileRect.Y();
-                                        }
-                                    }
+                                    found = true;
+                                    painter->drawPixmap(core->tileRect.X(),core->tileRect.Y(), core->tileRect.Width(), core->tileRect.Height(),pixmap);
+                                   // qDebug()<<"tile:"<<core->tileRect.X()<<core->tileRect.Y();
                                 }
                             }
 
@@ -425,6 +424,41 @@ namespace mapcontrol
 //        painter->drawRect(boundingRect().adjusted(100,100,-100,-100));
     }
 
+    QPixmap MapGraphicItem::TilePixmap(internals::Tile *tile)
+    {
+        core::RawTile key(core->GetMapType(),tile->GetPos(),tile->GetZoom());
+        QPixmap *cached=tilePixmaps.object(key);
+        if(cached)
+            return *cached;
+
+        QPixmap pixmap;
+        if(!tile->Image.isNull())
+        {
+            // decoded by the loader thread
+            pixmap=QPixmap::fromImage(tile->Image);
+        }
+        else
+        {
+            foreach(QByteArray img,tile->Overlays)
+            {
+                if(img.count()==0)
+                    continue;
+                QPixmap layer=PureImageProxy::FromStream(img);
+                if(pixmap.isNull())
+                {
+                    pixmap=layer;
+                }
+                else
+                {
+                    QPainter painter(&pixmap);
+                    painter.drawPixmap(pixmap.rect(),layer);
+                }
+            }
+        }
+        if(!pixmap.isNull())
+            tilePixmaps.insert(key,new QPixmap(pixmap),qMax(1,pixmap.width()*pixmap.height()*pixmap.depth()/8/1024));
+        return pixmap;
+    }
 
     core::Point MapGraphicItem::FromLatLngToLocal(internals::PointLatLng const& point)
     {
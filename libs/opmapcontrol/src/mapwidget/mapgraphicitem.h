@@ -31,6 +31,7 @@
 #include "../internals/core.h"
 //#include "../internals/point.h"
 #include "../core/diagnostics.h"
+#include "../core/rawtile.h"
 #include "omapconfiguration.h"
 #include <QtGui>
 #include <QTransform>
@@ -38,6 +39,7 @@
 #include <QBrush>
 #include <QFont>
 #include <QObject>
+#include <QCache>
 
 namespace mapcontrol
 {
@@ -153,6 +155,17 @@ namespace mapcontrol
         qreal MapRenderTransform;
         void DrawMap2D(QPainter *painter);
         /**
+        * @brief Returns the pixmap of a tile, from the cache if possible
+        *
+        * @param tile the tile to draw
+        * @return QPixmap all overlays of the tile, null if the tile has no image
+        */
+        QPixmap TilePixmap(internals::Tile *tile);
+        /**
+        * @brief Least recently used tile pixmaps, keyed by type, position and zoom. The cost is in KB.
+        */
+        QCache<core::RawTile,QPixmap> tilePixmaps;
+        /**
         * @brief Maximum possible zoom
         *
         * @var maxZoom
@@ -207,7 +220,7 @@ namespace mapcontrol
         void SetZoom(double const& value);
         void mapRotate ( qreal angle );
         void start();
-        void  ReloadMap(){core->ReloadMap();}
+        void  ReloadMap(){tilePixmaps.clear();core->ReloadMap();}
         GeoCoderStatusCode::Types SetCurrentPositionByKeywords(QString const& keys){return core->SetCurrentPositionByKeywords(keys);}
         MapType::Types GetMapType(){return core->GetMapType();}
         void SetMapType(MapType::Types const& value){core->SetMapType(value);}
@@ -0,0 +1,253 @@
+/**
+******************************************************************************
+*
+* @file       mapprefetcher.cpp
+* @author     APM_PLANNER PROJECT <http://www.ardupilot.com> Copyright (C) 2026.
+* @brief      Downloads all tiles of a region for offline use
+* @see        The GNU Public License (GPL) Version 3
+* @defgroup   OPMapWidget
+* @{
+*
+*****************************************************************************/
+/*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#include "mapprefetcher.h"
+#include "../core/opmaps.h"
+#include <QPainterPath>
+#include <QPolygonF>
+#include <QRunnable>
+#include <QThread>
+#include <qmath.h>
+
+//#define DEBUG_MAPPREFETCHER
+namespace mapcontrol
+{
+
+class MapPrefetcher::Worker:public QRunnable
+{
+public:
+    explicit Worker(MapPrefetcher *prefetcher):prefetcher(prefetcher){}
+    void run(){prefetcher->runWorker();}
+private:
+    MapPrefetcher *prefetcher;
+};
+
+MapPrefetcher::MapPrefetcher(internals::Core *core, QObject *parent):QObject(parent),
+    core(core),minZoom(0),maxZoom(0),maxRequestsPerSecond(10),running(false),nextRequest(0)
+{
+    pool.setMaxThreadCount(4);
+    progressTimer.setInterval(200);
+    connect(&progressTimer,SIGNAL(timeout()),this,SLOT(reportProgress()));
+}
+
+MapPrefetcher::~MapPrefetcher()
+{
+    Cancel();
+    pool.waitForDone();
+}
+
+void MapPrefetcher::SetRegion(const QVector<internals::PointLatLng> &polygon)
+{
+    region=polygon;
+}
+
+void MapPrefetcher::SetRegion(const internals::RectLatLng &rect)
+{
+    region.clear();
+    if(rect.IsEmpty())
+        return;
+    region<<internals::PointLatLng(rect.Top(),rect.Left())
+          <<internals::PointLatLng(rect.Top(),rect.Right())
+          <<internals::PointLatLng(rect.Bottom(),rect.Right())
+          <<internals::PointLatLng(rect.Bottom(),rect.Left());
+}
+
+void MapPrefetcher::SetZoomRange(int minZoom, int maxZoom)
+{
+    this->minZoom=qMax(0,minZoom);
+    this->maxZoom=qMin(core->MaxZoom(),maxZoom);
+}
+
+void MapPrefetcher::SetMaxConcurrentDownloads(int value)
+{
+    pool.setMaxThreadCount(qMax(1,value));
+}
+
+void MapPrefetcher::SetMaxRequestsPerSecond(int value)
+{
+    QMutexLocker locker(&rateMutex);
+    maxRequestsPerSecond=qMax(0,value);
+}
+
+QList<core::RawTile> MapPrefetcher::TileList()
+{
+    QList<core::RawTile> ret;
+    if(region.count()<3)
+        return ret;
+    internals::PureProjection *projection=core->Projection();
+    QVector<core::MapType::Types> types=core::OPMaps::Instance()->GetAllLayersOfType(core->GetMapType());
+    const int tileWidth=projection->TileSize().Width();
+    const int tileHeight=projection->TileSize().Height();
+    for(int zoom=minZoom;zoom<=maxZoom;++zoom)
+    {
+        QPolygonF outline;
+        foreach(internals::PointLatLng point,region)
+        {
+            core::Point pixel=projection->FromLatLngToPixel(point,zoom);
+            outline<<QPointF(pixel.X(),pixel.Y());
+        }
+        QPainterPath path;
+        path.addPolygon(outline);
+        path.closeSubpath();
+
+        // only the tiles of the bounding box can touch the region
+        QRectF bounds=outline.boundingRect();
+        core::Size minXY=projection->GetTileMatrixMinXY(zoom);
+        core::Size maxXY=projection->GetTileMatrixMaxXY(zoom);
+        int left=qMax(minXY.Width(),(int)qFloor(bounds.left()/tileWidth));
+        int right=qMin(maxXY.Width(),(int)qFloor(bounds.right()/tileWidth));
+        int top=qMax(minXY.Height(),(int)qFloor(bounds.top()/tileHeight));
+        int bottom=qMin(maxXY.Height(),(int)qFloor(bounds.bottom()/tileHeight));
+        for(int x=left;x<=right;++x)
+        {
+            for(int y=top;y<=bottom;++y)
+            {
+                if(!path.intersects(QRectF(x*tileWidth,y*tileHeight,tileWidth,tileHeight)))
+                    continue;
+                foreach(core::MapType::Types type,types)
+                {
+                    ret.append(core::RawTile(type,core::Point(x,y),zoom));
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+void MapPrefetcher::Start()
+{
+    if(running)
+        return;
+    tiles=TileList();
+    nextTile.store(0);
+    doneTiles.store(0);
+    failedTiles.store(0);
+    lastZoom.store(minZoom);
+    cancel.store(0);
+
+    int workers=qMin(pool.maxThreadCount(),tiles.count());
+#ifdef DEBUG_MAPPREFETCHER
+    qDebug()<<"MapPrefetcher: Start"<<tiles.count()<<"tiles with"<<workers<<"workers";
+#endif //DEBUG_MAPPREFETCHER
+    if(workers==0)
+    {
+        emit finished(0,0);
+        return;
+    }
+    running=true;
+    {
+        QMutexLocker locker(&rateMutex);
+        rateClock.start();
+        nextRequest=0;
+    }
+    activeWorkers.store(workers);
+    for(int i=0;i<workers;++i)
+    {
+        pool.start(new Worker(this));
+    }
+    progressTimer.start();
+    emit progressChanged(0,tiles.count(),minZoom);
+}
+
+void MapPrefetcher::Cancel()
+{
+    cancel.store(1);
+}
+
+void MapPrefetcher::reportProgress()
+{
+    emit progressChanged(doneTiles.load(),tiles.count(),lastZoom.load());
+}
+
+void MapPrefetcher::workerFinished()
+{
+    pool.waitForDone();
+    progressTimer.stop();
+    reportProgress();
+    running=false;
+    int failed=failedTiles.load();
+#ifdef DEBUG_MAPPREFETCHER
+    qDebug()<<"MapPrefetcher: Finished, done:"<<doneTiles.load()<<"failed:"<<failed;
+#endif //DEBUG_MAPPREFETCHER
+    emit finished(doneTiles.load()-failed,failed);
+}
+
+void MapPrefetcher::runWorker()
+{
+    while(!cancel.load())
+    {
+        int index=nextTile.fetchAndAddRelaxed(1);
+        if(index>=tiles.count())
+            break;
+        core::RawTile tile=tiles.at(index);
+        if(!fetchTile(tile))
+            failedTiles.ref();
+        lastZoom.store(tile.Zoom());
+        doneTiles.ref();
+    }
+    if(!activeWorkers.deref())
+    {
+        // the last worker reports back to the thread of the prefetcher
+        QMetaObject::invokeMethod(this,"workerFinished",Qt::QueuedConnection);
+    }
+}
+
+bool MapPrefetcher::fetchTile(core::RawTile &tile)
+{
+    if(!core::Cache::Instance()->ImageCache.GetImageFromCache(tile.Type(),tile.Pos(),tile.Zoom()).isEmpty())
+        return true;
+    for(int attempt=1;attempt<=MaxAttempts && !cancel.load();++attempt)
+    {
+        waitForRequestSlot();
+        if(!core::OPMaps::Instance()->GetImageFrom(tile.Type(),tile.Pos(),tile.Zoom()).isEmpty())
+            return true;
+#ifdef DEBUG_MAPPREFETCHER
+        qDebug()<<"MapPrefetcher: Failed to load"<<tile.ToString()<<"attempt"<<attempt;
+#endif //DEBUG_MAPPREFETCHER
+        // give a busy server some time before the next try
+        QThread::msleep(500*attempt);
+    }
+    return false;
+}
+
+void MapPrefetcher::waitForRequestSlot()
+{
+    qint64 wait=0;
+    {
+        QMutexLocker locker(&rateMutex);
+        if(maxRequestsPerSecond==0)
+            return;
+        qint64 now=rateClock.elapsed();
+        if(nextRequest<now)
+            nextRequest=now;
+        wait=nextRequest-now;
+        nextRequest+=1000/maxRequestsPerSecond;
+    }
+    if(wait>0)
+        QThread::msleep(wait);
+}
+
+}
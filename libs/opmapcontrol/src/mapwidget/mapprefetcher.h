@@ -0,0 +1,153 @@
+/**
+******************************************************************************
+*
+* @file       mapprefetcher.h
+* @author     APM_PLANNER PROJECT <http://www.ardupilot.com> Copyright (C) 2026.
+* @brief      Downloads all tiles of a region for offline use
+* @see        The GNU Public License (GPL) Version 3
+* @defgroup   OPMapWidget
+* @{
+*
+*****************************************************************************/
+/*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*
+* You should have received a copy of the GNU General Public License along
+* with this program; if not, write to the Free Software Foundation, Inc.,
+* 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef MAPPREFETCHER_H
+#define MAPPREFETCHER_H
+
+#include "../internals/core.h"
+#include "../core/rawtile.h"
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+
+namespace mapcontrol
+{
+    /**
+    * @brief Downloads all tiles of a region over a range of zoom levels into the cache
+    *
+    * The region is a polygon, only the tiles touching it are fetched. The tiles are
+    * loaded with OPMaps::GetImageFrom() by a bounded pool of workers. The requests
+    * to the tile server are rate limited, tiles which are already in the cache
+    * neither count against the limit nor cause a request.
+    */
+    class MapPrefetcher:public QObject
+    {
+        Q_OBJECT
+    public:
+        MapPrefetcher(internals::Core *core,QObject *parent=0);
+        ~MapPrefetcher();
+
+        /**
+        * @brief Sets the region to fetch
+        *
+        * @param polygon corners of the region
+        */
+        void SetRegion(const QVector<internals::PointLatLng> &polygon);
+        /**
+        * @brief Sets a rectangular region to fetch
+        */
+        void SetRegion(const internals::RectLatLng &rect);
+        /**
+        * @brief Sets the zoom levels to fetch, both included
+        */
+        void SetZoomRange(int minZoom,int maxZoom);
+        /**
+        * @brief Sets the number of concurrent downloads
+        */
+        void SetMaxConcurrentDownloads(int value);
+        /**
+        * @brief Sets the max number of requests to the tile server per second, 0 means unlimited
+        */
+        void SetMaxRequestsPerSecond(int value);
+        /**
+        * @brief Calculates the tiles of all layers of the current map type inside the region
+        *
+        * @return QList<core::RawTile> the tiles ordered by zoom level
+        */
+        QList<core::RawTile> TileList();
+        bool IsRunning()const{return running;}
+
+    public slots:
+        /**
+        * @brief Starts fetching the tiles, does nothing if already running
+        */
+        void Start();
+        /**
+        * @brief Stops fetching, the finished() signal follows when all workers stopped
+        */
+        void Cancel();
+
+    signals:
+        /**
+        * @brief Fires while fetching
+        *
+        * @param done number of tiles handled
+        * @param total number of tiles to fetch
+        * @param zoom zoom level of the last handled tile
+        */
+        void progressChanged(int done,int total,int zoom);
+        /**
+        * @brief Fires when all tiles were handled or fetching was cancelled
+        *
+        * @param loaded number of tiles in the cache
+        * @param failed number of tiles which could not be loaded
+        */
+        void finished(int loaded,int failed);
+
+    private slots:
+        void reportProgress();
+        void workerFinished();
+
+    private:
+        class Worker;
+        friend class Worker;
+
+        /**
+        * @brief Max number of tries for one tile
+        */
+        static const int MaxAttempts=3;
+
+        void runWorker();
+        bool fetchTile(core::RawTile &tile);
+        void waitForRequestSlot();
+
+        internals::Core *core;
+        QVector<internals::PointLatLng> region;
+        int minZoom;
+        int maxZoom;
+        int maxRequestsPerSecond;
+        bool running;
+
+        QThreadPool pool;
+        QTimer progressTimer;
+        QList<core::RawTile> tiles;
+        QAtomicInt nextTile;
+        QAtomicInt doneTiles;
+        QAtomicInt failedTiles;
+        QAtomicInt lastZoom;
+        QAtomicInt activeWorkers;
+        QAtomicInt cancel;
+
+        QMutex rateMutex;
+        QElapsedTimer rateClock;
+        qint64 nextRequest;
+    };
+}
+#endif // MAPPREFETCHER_H
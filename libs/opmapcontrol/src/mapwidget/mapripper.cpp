@@ -35,36 +35,54 @@
 namespace mapcontrol
 {
 
-MapRipper::MapRipper(internals::Core * core, const internals::RectLatLng & rect):sleep(100),cancel(false),progressForm(0),core(core)
+MapRipper::MapRipper(internals::Core * core, const internals::RectLatLng & rect):progressForm(0),core(core),shouldAutoRip(false),prefetcher(core)
 {
-    if(!rect.IsEmpty())
+    if(rect.IsEmpty())
     {
-        type=core->GetMapType();
-        progressForm=new MapRipForm;
-        area=rect;
-        zoom=core->Zoom();
-        maxzoom=core->MaxZoom();
-        points=core->Projection()->GetAreaTileList(area,zoom,0);
-        progressForm->show();
-
-        //Move the ripper form to the screen center
-        this->moveFormToCenter();
-
-        connect(this,SIGNAL(percentageChanged(int)),progressForm,SLOT(SetPercentage(int)));
-        connect(this,SIGNAL(numberOfTilesChanged(int,int)),progressForm,SLOT(SetNumberOfTiles(int,int)));
-        connect(this,SIGNAL(providerChanged(QString,int)),progressForm,SLOT(SetProvider(QString,int)));
-        connect(this,SIGNAL(finished()),this,SLOT(finish()));
-        emit numberOfTilesChanged(0,0);
-
-        //Start the ripping when the form button is pressed
-        connect(progressForm,SIGNAL(beginRip()),this,SLOT(start()));
-
-        //Stop the current ripping when the form button is pressed
-        connect(progressForm,SIGNAL(cancelRip()),this,SLOT(cancelRipping()));
-
-        //Connect to the form to see if should auto rip
-        connect(progressForm,SIGNAL(shouldAutoRip(bool)),this,SLOT(setAutoRip(bool)));
+        this->deleteLater();
+        return;
     }
+    prefetcher.SetRegion(rect);
+    init();
+}
+
+MapRipper::MapRipper(internals::Core * core, const QVector<internals::PointLatLng> & polygon):progressForm(0),core(core),shouldAutoRip(false),prefetcher(core)
+{
+    if(polygon.count()<3)
+    {
+        this->deleteLater();
+        return;
+    }
+    prefetcher.SetRegion(polygon);
+    init();
+}
+
+void MapRipper::init()
+{
+    type=core->GetMapType();
+    progressForm=new MapRipForm;
+    zoom=core->Zoom();
+    maxzoom=core->MaxZoom();
+    progressForm->show();
+
+    //Move the ripper form to the screen center
+    this->moveFormToCenter();
+
+    connect(this,SIGNAL(percentageChanged(int)),progressForm,SLOT(SetPercentage(int)));
+    connect(this,SIGNAL(numberOfTilesChanged(int,int)),progressForm,SLOT(SetNumberOfTiles(int,int)));
+    connect(this,SIGNAL(providerChanged(QString,int)),progressForm,SLOT(SetProvider(QString,int)));
+    connect(&prefetcher,SIGNAL(progressChanged(int,int,int)),this,SLOT(progress(int,int,int)));
+    connect(&prefetcher,SIGNAL(finished(int,int)),this,SLOT(finish()));
+    emit numberOfTilesChanged(0,0);
+
+    //Start the ripping when the form button is pressed
+    connect(progressForm,SIGNAL(beginRip()),this,SLOT(doRip()));
+
+    //Stop the current ripping when the form button is pressed
+    connect(progressForm,SIGNAL(cancelRip()),this,SLOT(cancelRipping()));
+
+    //Connect to the form to see if should auto rip
+    connect(progressForm,SIGNAL(shouldAutoRip(bool)),this,SLOT(setAutoRip(bool)));
 }
 
 void MapRipper::moveFormToCenter()
@@ -86,107 +104,50 @@ void MapRipper::moveFormToCenter()
 
 void MapRipper::finish()
 {
-    if(zoom<maxzoom && cancel==false)
-    {
-        ++zoom;
-
-        if (shouldAutoRip == true && (zoom <= progressForm->maxAutoRipZoom))
-        {
-            this->doRip();
-        }else{
-
-            if(openMessageBox())
-            {
-                this->doRip();
-            }else{
-                this->stopRipping();
-            }
-        }
-    }
-    else
-    {
-        this->stopRipping();
-    }
+    this->stopRipping();
 }
 
-void MapRipper::run()
+void MapRipper::progress(int done, int total, int currentZoom)
 {
-    int countOk = 0;
-    bool goodtile=false;
-    //  Stuff.Shuffle<Point>(ref list);
-    QVector<core::MapType::Types> types = OPMaps::Instance()->GetAllLayersOfType(type);
-    int all=points.count();
-    for(int i = 0; i < all; i++)
-    {
-        emit numberOfTilesChanged(all,i+1);
-        if(cancel)
-            break;
-
-        core::Point p = points[i];
-        {
-            //qDebug()<<"offline fetching:"<<p.ToString();
-            foreach(core::MapType::Types type,types)
-            {
-                emit providerChanged(core::MapType::StrByType(type),zoom);
-                QByteArray img = OPMaps::Instance()->GetImageFrom(type, p, zoom);
-                if(img.length()!=0)
-                {
-                    goodtile=true;
-                    img=NULL;
-                }
-                else
-                    goodtile=false;
-            }
-            if(goodtile)
-            {
-                countOk++;
-            }
-            else
-            {
-                i--;
-                QThread::msleep(1000);
-                continue;
-            }
-        }
-        emit percentageChanged((int) ((i+1)*100/all));//, i+1);
-        // worker.ReportProgress((int) ((i+1)*100/all), i+1);
-
-        QThread::msleep(sleep);
-    }
+    emit numberOfTilesChanged(total,done);
+    emit providerChanged(core::MapType::StrByType(type),currentZoom);
+    if(total>0)
+        emit percentageChanged((int) ((qint64)done*100/total));
 }
 
 void MapRipper::doRip()
 {
-    points.clear();
-    points=core->Projection()->GetAreaTileList(area,zoom,0);
-    this->start();
+    //All zoom levels up to the limit of the form are fetched in one go
+    int lastZoom=zoom;
+    if(shouldAutoRip)
+        lastZoom=qMin(qMax(zoom,progressForm->maxAutoRipZoom),maxzoom);
+    prefetcher.SetZoomRange(zoom,lastZoom);
+    prefetcher.Start();
 }
 
-void MapRipper::stopRipping()
+void MapRipper::cancelRipping()
 {
-    progressForm->close();
-    delete progressForm;
-    progressForm=NULL;
-    this->deleteLater();
+    if(prefetcher.IsRunning())
+    {
+        //finish() follows when the workers stopped
+        prefetcher.Cancel();
+    }
+    else
+    {
+        this->stopRipping();
+    }
 }
 
-int MapRipper::openMessageBox()
+void MapRipper::stopRipping()
 {
-    QMessageBox msgBox;
-    msgBox.setText(QString("Continue Ripping at zoom level %1?").arg(zoom));
-    msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
-    msgBox.setDefaultButton(QMessageBox::Yes);
-    int ret = msgBox.exec();
-
-    bool cont;
-    if (ret==QMessageBox::Yes)
-        cont = true;
-    else
-        cont = false;
-
-    return cont;
+    if(progressForm)
+    {
+        //the form might be in its cancel button handler
+        progressForm->close();
+        progressForm->deleteLater();
+        progressForm=NULL;
+    }
+    this->deleteLater();
 }
 
 }
-
-
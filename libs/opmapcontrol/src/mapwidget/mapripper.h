@@ -27,34 +27,36 @@
 #ifndef MAPRIPPER_H
 #define MAPRIPPER_H
 
-#include <QThread>
 #include "../internals/core.h"
 #include "mapripform.h"
+#include "mapprefetcher.h"
 #include <QObject>
 #include <QMessageBox>
 namespace mapcontrol
 {
-    class MapRipper:public QThread
+    /**
+    * @brief Shows the MapRipForm and fetches the tiles of a region with a MapPrefetcher
+    *
+    * The ripper deletes itself when the form is closed or fetching finished.
+    */
+    class MapRipper:public QObject
     {
         Q_OBJECT
     public:
         MapRipper(internals::Core *,internals::RectLatLng const&);
-        void run();
+        MapRipper(internals::Core *,QVector<internals::PointLatLng> const&);
         void moveFormToCenter();
         void doRip();
 
     private:
-        QList<core::Point> points;
         int zoom;
         core::MapType::Types type;
-        int sleep;
-        internals::RectLatLng area;
-        bool cancel;
         MapRipForm * progressForm;
         int maxzoom;
         internals::Core * core;
         bool shouldAutoRip;
-        int openMessageBox();
+        MapPrefetcher prefetcher;
+        void init();
 
     signals:
         void percentageChanged(int const& perc);
@@ -69,9 +71,10 @@ namespace mapcontrol
         void setAutoRip(bool val){
             shouldAutoRip = val;
         }
-        void cancelRipping(){
-            this->cancel=true;
-        }
+        void cancelRipping();
+
+    private slots:
+        void progress(int done,int total,int currentZoom);
     };
 }
 #endif // MAPRIPPER_H
@@ -12,6 +12,7 @@ SOURCES += mapgraphicitem.cpp \
     gpsitem.cpp \
     trailitem.cpp \
     homeitem.cpp \
+    mapprefetcher.cpp \
     mapripform.cpp \
     mapripper.cpp \
     traillineitem.cpp
@@ -35,6 +36,7 @@ HEADERS += mapgraphicitem.h \
     uavtrailtype.h \
     trailitem.h \
     homeitem.h \
+    mapprefetcher.h \
     mapripform.h \
     mapripper.h \
     traillineitem.h \
@@ -29,6 +29,7 @@
 #include <QtGui>
 #include <QMetaObject>
 #include "waypointitem.h"
+#include "../core/tilepack.h"
 
 namespace mapcontrol
 {
@@ -476,6 +477,24 @@ namespace mapcontrol
     {
         new MapRipper(core,map->SelectedArea());
     }
+    void OPMapWidget::RipMap(QVector<internals::PointLatLng> const& polygon)
+    {
+        new MapRipper(core,polygon);
+    }
+    int OPMapWidget::ExportTilePack(QString const& file,QVector<internals::PointLatLng> const& polygon,int const& minZoom,int const& maxZoom)
+    {
+        MapPrefetcher prefetcher(core);
+        prefetcher.SetRegion(polygon);
+        prefetcher.SetZoomRange(minZoom,maxZoom);
+        return core::TilePack::Export(file,prefetcher.TileList());
+    }
+    int OPMapWidget::ImportTilePack(QString const& file)
+    {
+        int ret=core::TilePack::Import(file,GetMapType());
+        if(ret>0)
+            ReloadMap();
+        return ret;
+    }
 
 
 #define deg_to_rad          ((double)M_PI / 180.0)
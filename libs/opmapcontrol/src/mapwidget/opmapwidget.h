@@ -215,7 +215,28 @@ namespace mapcontrol
         //  QString GetMouseWheelZoomTypeStr(){return map->GetMouseWheelZoomTypeStr();}
 
         internals::RectLatLng SelectedArea()const{return  map->selectedArea;}
-        void SetSelectedArea(internals::RectLatLng const& value){ map->selectedArea = value;this->update();}
+        void SetSelectedArea(internals::RectLatLng const& value){ map->SetSelectedArea(value);}
+
+        /**
+        * @brief Writes the cached tiles of a region to a single file tile pack
+        *
+        * @param file the tile pack to create
+        * @param polygon corners of the region
+        * @param minZoom first zoom level to export
+        * @param maxZoom last zoom level to export
+        * @return int number of tiles written, -1 on error
+        */
+        int ExportTilePack(QString const& file,QVector<internals::PointLatLng> const& polygon,int const& minZoom,int const& maxZoom);
+        /**
+        * @brief Reads a tile pack into the cache and reloads the map
+        *
+        * Tiles of files without map type, like standard MBTiles files, are
+        * imported for the currently selected map type.
+        *
+        * @param file the tile pack to read
+        * @return int number of tiles added, -1 on error
+        */
+        int ImportTilePack(QString const& file);
 
         bool CanDragMap()const{return map->CanDragMap();}
         void SetCanDragMap(bool const& value){map->SetCanDragMap(value);}
@@ -515,6 +536,12 @@ namespace mapcontrol
         * @brief Ripps the current selection to the DB
         */
         void RipMap();
+        /**
+        * @brief Ripps a region to the DB
+        *
+        * @param polygon corners of the region
+        */
+        void RipMap(QVector<internals::PointLatLng> const& polygon);
 
         /**
         * @brief Sets the map zoom level
@@ -0,0 +1,98 @@
+# -------------------------------------------------
+# APM Planner log benchmark - generates synthetic ArduPilot logs and
+# measures parse throughput, peak memory and datamodel access latency
+# of the log analysis. Run it before a release with --baseline to catch
+# regressions in log loading speed.
+#
+# This file is part of the APM Planner project
+# APM Planner is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# APM Planner is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with APM Planner. If not, see <http://www.gnu.org/licenses/>.
+# -------------------------------------------------
+
+# Qt configuration - QtGui is only needed for QColor and QQuaternion
+CONFIG += qt \
+    thread \
+    console \
+    c++14
+CONFIG -= app_bundle
+QT = core \
+    gui \
+    concurrent \
+    testlib
+
+TEMPLATE = app
+TARGET = logbenchmark
+BASEDIR = $${IN_PWD}
+LANGUAGE = C++
+
+CONFIG(debug, debug|release) {
+    DESTDIR = $${OUT_PWD}/debug
+    BUILDDIR = $${OUT_PWD}/build-logbenchmark-debug
+} else {
+    DESTDIR = $${OUT_PWD}/release
+    BUILDDIR = $${OUT_PWD}/build-logbenchmark-release
+    DEFINES += QT_NO_DEBUG
+}
+OBJECTS_DIR = $${BUILDDIR}/obj
+MOC_DIR = $${BUILDDIR}/moc
+RCC_DIR = $${BUILDDIR}/rcc
+
+DEFINES += __STDC_LIMIT_MACROS
+!win32 {
+    LIBS += -lz
+}
+# Peak memory of the process
+win32 {
+    LIBS += -lpsapi
+}
+
+# MAVLink is used for the tlog parser and to write synthetic tlogs
+MAVLINKPATH = $$BASEDIR/libs/mavlink/include/mavlink/v2.0
+INCLUDEPATH += $$MAVLINKPATH \
+    $$MAVLINKPATH/ardupilotmega
+DEFINES += QGC_USE_ARDUPILOTMEGA_MESSAGES
+
+INCLUDEPATH += . \
+    src \
+    src/ui \
+    src/uas \
+    src/qgcunittest
+
+HEADERS += \
+    src/logging.h \
+    src/uas/ArduPilotMessages.h \
+    src/ui/Loghandling/AP2DataPlotStatus.h \
+    src/ui/Loghandling/ILogParser.h \
+    src/ui/Loghandling/IParserCallback.h \
+    src/ui/Loghandling/LogParserBase.h \
+    src/ui/Loghandling/BinLogParser.h \
+    src/ui/Loghandling/AsciiLogParser.h \
+    src/ui/Loghandling/TlogParser.h \
+    src/ui/Loghandling/LogdataColumn.h \
+    src/ui/Loghandling/LogdataMappedColumn.h \
+    src/ui/Loghandling/LogdataStorage.h \
+    src/qgcunittest/AutoTest.h \
+    src/qgcunittest/SyntheticLogGenerator.h \
+    src/qgcunittest/LogParserBenchmark.h
+
+SOURCES += \
+    src/uas/ArduPilotMessages.cc \
+    src/ui/Loghandling/AP2DataPlotStatus.cpp \
+    src/ui/Loghandling/LogParserBase.cpp \
+    src/ui/Loghandling/BinLogParser.cpp \
+    src/ui/Loghandling/AsciiLogParser.cpp \
+    src/ui/Loghandling/TlogParser.cpp \
+    src/ui/Loghandling/LogdataColumn.cpp \
+    src/ui/Loghandling/LogdataMappedColumn.cpp \
+    src/ui/Loghandling/LogdataStorage.cpp \
+    src/qgcunittest/SyntheticLogGenerator.cc \
+    src/qgcunittest/LogParserBenchmark.cc \
+    src/qgcunittest/logBenchmarkMain.cc
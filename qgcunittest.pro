@@ -261,6 +261,7 @@ HEADERS += src/MG.h \
     src/ui/HUD.h \
     src/ui/linechart/LinechartWidget.h \
     src/ui/linechart/LinechartPlot.h \
+    src/ui/linechart/TimeSeriesBuffer.h \
     src/ui/linechart/Scrollbar.h \
     src/ui/linechart/ScrollZoomer.h \
     src/configuration.h \
@@ -286,6 +287,7 @@ HEADERS += src/MG.h \
     src/uas/SlugsMAV.h \
     src/uas/PxQuadMAV.h \
     src/uas/ArduPilotMegaMAV.h \
+    src/uas/ArduPilotMessages.h \
     src/uas/senseSoarMAV.h \
     src/ui/watchdog/WatchdogControl.h \
     src/ui/watchdog/WatchdogProcessView.h \
@@ -425,6 +427,7 @@ SOURCES += src/QGCCore.cc \
     src/ui/HUD.cc \
     src/ui/linechart/LinechartWidget.cc \
     src/ui/linechart/LinechartPlot.cc \
+    src/ui/linechart/TimeSeriesBuffer.cc \
     src/ui/linechart/Scrollbar.cc \
     src/ui/linechart/ScrollZoomer.cc \
     src/ui/uas/UASView.cc \
@@ -449,6 +452,7 @@ SOURCES += src/QGCCore.cc \
     src/uas/SlugsMAV.cc \
     src/uas/PxQuadMAV.cc \
     src/uas/ArduPilotMegaMAV.cc \
+    src/uas/ArduPilotMessages.cc \
     src/uas/senseSoarMAV.cpp \
     src/ui/watchdog/WatchdogControl.cc \
     src/ui/watchdog/WatchdogProcessView.cc \
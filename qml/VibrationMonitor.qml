@@ -24,13 +24,17 @@ Rectangle {
 
     function activeUasSet() {
         console.log("Vibration Monitor: Active UAS is now set");
-        gaugeX.value = Qt.binding(function() { return vehicleOverview.vibration_x})
-        gaugeY.value = Qt.binding(function() { return vehicleOverview.vibration_y})
-        gaugeZ.value = Qt.binding(function() { return vehicleOverview.vibration_z})
+    }
+
+    // Called at display rate with the latest values
+    function updateVibration(vibrationX, vibrationY, vibrationZ, clipping0, clipping1, clipping2) {
+        gaugeX.value = vibrationX
+        gaugeY.value = vibrationY
+        gaugeZ.value = vibrationZ
 
-        clip0.value = Qt.binding(function() { return vehicleOverview.clipping_0})
-        clip1.value = Qt.binding(function() { return vehicleOverview.clipping_1})
-        clip2.value = Qt.binding(function() { return vehicleOverview.clipping_2})
+        clip0.value = clipping0
+        clip1.value = clipping1
+        clip2.value = clipping2
     }
 
     function activeUasUnset() {
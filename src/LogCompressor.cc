@@ -29,15 +29,175 @@ This file is part of the QGROUNDCONTROL project
 
 #include <QFile>
 #include <QFileInfo>
-#include <QDir>
-#include <QTemporaryFile>
-#include <QTextStream>
+#include <QDataStream>
+#include <QHash>
+#include <QSharedPointer>
 #include <QStringList>
-#include <QFileInfo>
-#include <QList>
+#include <QTemporaryFile>
+#include <QVector>
 #include "LogCompressor.h"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+namespace {
+
+/** @brief One value of the raw log */
+struct LogSample {
+    quint64 timestamp;
+    qint32 column;      ///< Id of the column in the order of discovery
+    QByteArray value;
+};
+
+typedef QSharedPointer<QTemporaryFile> RunFile;
+typedef std::function<bool(const LogSample&)> SampleSink;
+
+const int sortBlockSize = 200000;   ///< Samples sorted in memory at once
+const int maxMergeWidth = 32;       ///< Runs merged at once, limits the number of open files
+
+/** @brief Splits a line of the raw log without converting it to a QString */
+QList<QByteArray> splitLine(const QByteArray &line, const QByteArray &delimiter)
+{
+    QList<QByteArray> fields;
+    int start = 0;
+    int pos;
+    while ((pos = line.indexOf(delimiter, start)) >= 0) {
+        fields.append(line.mid(start, pos - start));
+        start = pos + delimiter.size();
+    }
+    fields.append(line.mid(start));
+    return fields;
+}
+
+void writeSample(QDataStream &out, const LogSample &sample)
+{
+    out << sample.timestamp << sample.column << sample.value;
+}
+
+/** @brief Creates a temporary file holding a sorted run */
+RunFile createRun()
+{
+    RunFile run(new QTemporaryFile());
+    if (!run->open()) {
+        return RunFile();
+    }
+    return run;
+}
+
+/**
+ * @brief Sorts the samples by time and writes them to a new run. Samples with the
+ * same time keep their order, so the last value of a column still wins.
+ */
+bool writeRun(QVector<LogSample> &samples, QList<RunFile> &runs)
+{
+    std::stable_sort(samples.begin(), samples.end(), [](const LogSample &a, const LogSample &b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    RunFile run = createRun();
+    if (run.isNull()) {
+        return false;
+    }
+    QDataStream out(run.data());
+    foreach (const LogSample &sample, samples) {
+        writeSample(out, sample);
+    }
+    samples.clear();
+    runs.append(run);
+    return run->flush() && out.status() == QDataStream::Ok;
+}
+
+/** @brief Reads the samples of one run back in order */
+class RunReader
+{
+public:
+    explicit RunReader(QIODevice *device) : stream(device) {
+        device->seek(0);
+    }
+
+    /** @return false at the end of the run */
+    bool next() {
+        if (stream.atEnd()) {
+            return false;
+        }
+        stream >> sample.timestamp >> sample.column >> sample.value;
+        return stream.status() == QDataStream::Ok;
+    }
+
+    QDataStream stream;
+    LogSample sample;
+};
+
+/**
+ * @brief Merges the given runs and hands all samples ordered by time to the sink. Samples
+ * with the same time are delivered in the order of the runs, which is the order of the
+ * raw log.
+ */
+bool mergeRuns(const QList<RunFile> &runs, const SampleSink &sink)
+{
+    std::vector<std::unique_ptr<RunReader> > readers;
+    foreach (const RunFile &run, runs) {
+        readers.emplace_back(new RunReader(run.data()));
+    }
+
+    auto later = [&readers](int a, int b) {
+        const quint64 timeA = readers[a]->sample.timestamp;
+        const quint64 timeB = readers[b]->sample.timestamp;
+        return timeA != timeB ? timeA > timeB : a > b;
+    };
+    std::priority_queue<int, std::vector<int>, decltype(later)> heads(later);
+    for (int i = 0; i < static_cast<int>(readers.size()); ++i) {
+        if (readers[i]->next()) {
+            heads.push(i);
+        }
+    }
+
+    while (!heads.empty()) {
+        const int i = heads.top();
+        heads.pop();
+        if (!sink(readers[i]->sample)) {
+            return false;
+        }
+        if (readers[i]->next()) {
+            heads.push(i);
+        }
+    }
+    return true;
+}
+
+/** @brief Merges neighbouring runs until they can be merged at once */
+bool reduceRuns(QList<RunFile> &runs)
+{
+    while (runs.size() > maxMergeWidth) {
+        QList<RunFile> merged;
+        for (int i = 0; i < runs.size(); i += maxMergeWidth) {
+            const QList<RunFile> group = runs.mid(i, maxMergeWidth);
+            if (group.size() == 1) {
+                merged.append(group.first());
+                continue;
+            }
+            RunFile run = createRun();
+            if (run.isNull()) {
+                return false;
+            }
+            QDataStream out(run.data());
+            if (!mergeRuns(group, [&out](const LogSample &sample) {
+                    writeSample(out, sample);
+                    return out.status() == QDataStream::Ok;
+                }) || !run->flush()) {
+                return false;
+            }
+            merged.append(run);
+        }
+        runs = merged;
+    }
+    return true;
+}
 
+}
 
 /**
  * Initializes all the variables necessary for a compression run. This won't actually happen
@@ -53,17 +213,23 @@ LogCompressor::LogCompressor(QString logFileName, QString outFileName, QString d
 {
 }
 
+/**
+ * The raw log holds one value per line. It is compressed in two passes, so only a bounded
+ * number of values is held in memory no matter how long the recording is:
+ * The first pass discovers all columns and writes the values in sorted runs of
+ * sortBlockSize values to temporary files. The second pass merges the runs by time
+ * and writes each row as soon as all values of its time are known.
+ */
 void LogCompressor::run()
 {
 	// Verify that the input file is useable
 	QFile infile(logFileName);
-	if (!infile.exists() || !infile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+	if (!infile.exists() || !infile.open(QIODevice::ReadOnly)) {
 		emit logProcessingStatusChanged(tr("Log Compressor: Cannot start/compress log file, since input file %1 is not readable").arg(QFileInfo(infile.fileName()).absoluteFilePath()));
+		running = false;
 		return;
 	}
 
-//    outFileName = logFileName;
-
     QString outFileName;
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
@@ -80,35 +246,69 @@ void LogCompressor::run()
     QFile outTmpFile(outFileName);
     if (!outTmpFile.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
 		emit logProcessingStatusChanged(tr("Log Compressor: Cannot start/compress log file, since output file %1 is not writable").arg(QFileInfo(outTmpFile.fileName()).absoluteFilePath()));
+		running = false;
 		return;
 	}
 
+    // First pass: find all variables, as CSV files require the same number of fields
+    // for every line, and sort the values by time in blocks.
+    const QByteArray delimiterBytes = delimiter.toLatin1();
+    QHash<QString, int> columnIds;
+    QStringList columnNames;
+    QVector<LogSample> samples;
+    samples.reserve(sortBlockSize);
+    QList<RunFile> runs;
+
+    currentDataLine = 0;
+    while (!infile.atEnd()) {
+        QByteArray line = infile.readLine();
+        ++currentDataLine;
+        while (line.endsWith('\n') || line.endsWith('\r')) {
+            line.chop(1);
+        }
+        const QList<QByteArray> fields = splitLine(line, delimiterBytes);
+        if (fields.size() < 4) {
+            continue;   // Not a value line
+        }
 
-	// First we search the input file through keySearchLimit number of lines
-	// looking for variables. This is neccessary before CSV files require
-	// the same number of fields for every line.
-	const unsigned int keySearchLimit = 15000;
-	unsigned int keyCounter = 0;
-	QTextStream in(&infile);
-	QMap<QString, int> messageMap;
-
-	while (!in.atEnd() && keyCounter < keySearchLimit) {
-		QString messageName = in.readLine().split(delimiter).at(2);
-		messageMap.insert(messageName, 0);
-		++keyCounter;
-	}
+        const QString name = QString::fromLatin1(fields.at(2));
+        QHash<QString, int>::const_iterator id = columnIds.constFind(name);
+        if (id == columnIds.constEnd()) {
+            id = columnIds.insert(name, columnNames.size());
+            columnNames.append(name);
+        }
+        LogSample sample;
+        sample.timestamp = fields.at(0).toULongLong();
+        sample.column = id.value();
+        sample.value = fields.at(3);
+        samples.append(sample);
+
+        if (samples.size() >= sortBlockSize && !writeRun(samples, runs)) {
+            emit logProcessingStatusChanged(tr("Log Compressor: Cannot write temporary file while compressing %1").arg(logFileName));
+            running = false;
+            return;
+        }
+    }
+    if (!samples.isEmpty() && !writeRun(samples, runs)) {
+        emit logProcessingStatusChanged(tr("Log Compressor: Cannot write temporary file while compressing %1").arg(logFileName));
+        running = false;
+        return;
+    }
+    samples.squeeze();
 
-	// Now update each key with its index in the output string. These are
-	// all offset by one to account for the first field: timestamp_ms.
-    QMap<QString, int>::iterator i = messageMap.begin();
-	int j;
-	for (i = messageMap.begin(), j = 1; i != messageMap.end(); ++i, ++j) {
-		i.value() = j;
-	}
+	// We're now done with the source file
+	infile.close();
 
-	// Open the output file and write the header line to it
-	QStringList headerList(messageMap.keys());
+    // The columns are sorted by name. They are all offset by one to account for the
+    // first field: timestamp_ms.
+    QStringList headerList(columnNames);
+    std::sort(headerList.begin(), headerList.end());
+    QVector<int> outputIndex(columnNames.size());
+    for (int i = 0; i < headerList.size(); ++i) {
+        outputIndex[columnIds.value(headerList.at(i))] = i + 1;
+    }
 
+	// Write the header line to the output file
 	QString headerLine = "timestamp_ms" + delimiter + headerList.join(delimiter) + "\n";
     // Clean header names from symbols Matlab considers as Latex syntax
     headerLine = headerLine.replace("timestamp", "TIMESTAMP");
@@ -118,85 +318,71 @@ void LogCompressor::run()
 	outTmpFile.write(headerLine.toLocal8Bit());
 
     emit logProcessingStatusChanged(tr("Log compressor: Dataset contains dimensions: ") + headerLine);
+    emit logProcessingStatusChanged(tr("Log Compressor: Writing output to file %1").arg(QFileInfo(outFileName).absoluteFilePath()));
 
     // Template list stores a list for populating with data as it's parsed from messages.
-    QStringList templateList;
+    QList<QByteArray> templateList;
     for (int i = 0; i < headerList.size() + 1; ++i) {
-        templateList << (holeFillingEnabled?"NaN":"");
-    }
-
-
-//	// Reset our position in the input file before we start the main processing loop.
-//    in.seek(0);
-
-//    // Search through all lines and build a list of unique timestamps
-//    QMap<quint64, QStringList> timestampMap;
-//    while (!in.atEnd()) {
-//        quint64 timestamp = in.readLine().split(delimiter).at(0).toULongLong();
-//        timestampMap.insert(timestamp, templateList);
-//    }
-
-    // Jump back to start of file
-    in.seek(0);
-
-    // Map of final output lines, key is time
-    QMap<quint64, QStringList> timestampMap;
-
-    // Run through the whole file and fill map of timestamps
-    while (!in.atEnd()) {
-        QStringList newLine = in.readLine().split(delimiter);
-        quint64 timestamp = newLine.at(0).toULongLong();
-
-        // Check if timestamp does exist - if not, add it
-        if (!timestampMap.contains(timestamp)) {
-            timestampMap.insert(timestamp, templateList);
-        }
-
-        QStringList list = timestampMap.value(timestamp);
-
-        QString currentDataName = newLine.at(2);
-        QString currentDataValue = newLine.at(3);
-        list.replace(messageMap.value(currentDataName), currentDataValue);
-        timestampMap.insert(timestamp, list);
+        templateList << (holeFillingEnabled ? "NaN" : "");
     }
 
+    // Second pass: merge the runs by time and write each time as one line
+    QList<QByteArray> list = templateList;
+    QList<QByteArray> lastList;
+    quint64 timestamp = 0;
+    bool hasValues = false;
     int lineCounter = 0;
+    const QByteArray outDelimiter = delimiter.toLocal8Bit();
 
-    QStringList lastList = timestampMap.values().at(1);
-
-    foreach (QStringList list, timestampMap.values()) {
-        // Write this current time set out to the file
-        // only do so from the 2nd line on, since the first
-        // line could be incomplete
+    auto writeLine = [&]() {
+        // Write this current time set out to the file only do so from the
+        // 3rd time on, since the first ones could be incomplete
         if (lineCounter > 1) {
             // Set the timestamp
-            list.replace(0,QString("%1").arg(timestampMap.keys().at(lineCounter)));
+            list.replace(0, QByteArray::number(timestamp));
 
             // Fill holes if necessary
             if (holeFillingEnabled) {
-                int index = 0;
-                foreach (QString str, list) {
-                    if (str == "" || str == "NaN") {
+                for (int index = 0; index < list.size(); ++index) {
+                    if (list.at(index).isEmpty() || list.at(index) == "NaN") {
                         list.replace(index, lastList.at(index));
                     }
-                    index++;
                 }
             }
 
+            // Write data columns
+            outTmpFile.write(list.join(outDelimiter) + "\n");
+        }
+        if (lineCounter > 0) {
             // Set last list
             lastList = list;
-
-            // Write data columns
-            QString output = list.join(delimiter) + "\n";
-            outTmpFile.write(output.toLocal8Bit());
         }
         lineCounter++;
-    }
+        list = templateList;
+    };
 
-	// We're now done with the source file
-	infile.close();
+    currentDataLine = 0;
+    const bool merged = reduceRuns(runs) && mergeRuns(runs, [&](const LogSample &sample) {
+        if (hasValues && sample.timestamp != timestamp) {
+            writeLine();
+        }
+        timestamp = sample.timestamp;
+        hasValues = true;
+        list.replace(outputIndex.at(sample.column), sample.value);
+        ++currentDataLine;
+        return true;
+    });
+    if (hasValues) {
+        writeLine();
+    }
+    runs.clear();
+    outTmpFile.close();
 
-    emit logProcessingStatusChanged(tr("Log Compressor: Writing output to file %1").arg(QFileInfo(outFileName).absoluteFilePath()));
+    if (!merged) {
+        emit logProcessingStatusChanged(tr("Log Compressor: Cannot read temporary file while compressing %1").arg(logFileName));
+        running = false;
+        return;
+    }
 
 	// Clean up and update the status before we return.
 	currentDataLine = 0;
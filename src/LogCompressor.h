@@ -12,6 +12,7 @@ public:
     /** @brief Start the compression of a raw, line-based logfile into a CSV file */
     void startCompression(bool holeFilling=false);
     bool isFinished();
+    /** @brief Progress: lines read while sorting, then values merged while writing the output */
     int getCurrentLine();
 
 protected:
@@ -19,7 +20,7 @@ protected:
     QString logFileName;            ///< The input file name.
     QString outFileName;            ///< The output file name. If blank defaults to logFileName
     bool running;                   ///< True when the startCompression() function is operating.
-    int currentDataLine;            ///< The current line of data that is being processed. Only relevant when running==true
+    int currentDataLine;            ///< The current line or value that is being processed. Only relevant when running==true
     QString delimiter;              ///< Delimiter between fields in the output file. Defaults to tab ('\t')
     bool holeFillingEnabled;        ///< Enables the filling of holes in the dataset with the previous value (or NaN if none exists)
 
@@ -0,0 +1,281 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief LogBatchProcessor
+ *          Parses and exports many logs in parallel without any GUI.
+ *
+ */
+
+#include "LogBatchProcessor.h"
+#include "logging.h"
+
+#include "Loghandling/IParserCallback.h"
+#include "Loghandling/BinLogParser.h"
+#include "Loghandling/AsciiLogParser.h"
+#include "Loghandling/TlogParser.h"
+#include "Loghandling/LogdataCache.h"
+#include "Loghandling/LogExporter.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QFuture>
+#include <QSet>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace
+{
+    /**
+     * @brief The jobCallback class collects the errors of one parser run
+     */
+    class jobCallback : public IParserCallback
+    {
+    public:
+        virtual void onProgress(const qint64 /*pos*/, const qint64 /*size*/)
+        {
+            // nobody is watching
+        }
+
+        virtual void onError(const QString &errorMsg)
+        {
+            m_errors.append(errorMsg);
+        }
+
+        QStringList m_errors;   /// all reported errors
+    };
+}
+
+LogBatchProcessor::LogBatchProcessor(const options &opts) :
+    m_options(opts)
+{
+}
+
+bool LogBatchProcessor::isSupportedLog(const QString &fileName)
+{
+    const QString lowerName = fileName.toLower();
+    return lowerName.endsWith(".bin") || lowerName.endsWith(".log") || lowerName.endsWith(".tlog");
+}
+
+QVector<LogBatchProcessor::result> LogBatchProcessor::process(const QStringList &logFiles) const
+{
+    QThreadPool jobPool;
+    jobPool.setMaxThreadCount(m_options.m_jobs > 0 ? m_options.m_jobs : QThread::idealThreadCount());
+
+    // Output names are fixed before the jobs start, so parallel jobs never write the same file
+    const QStringList baseNames = outputBaseNames(logFiles);
+
+    QVector<QFuture<result> > jobs;
+    jobs.reserve(logFiles.size());
+    for (int i = 0; i < logFiles.size(); ++i)
+    {
+        jobs.append(QtConcurrent::run(&jobPool, this, &LogBatchProcessor::processFile, logFiles.at(i), baseNames.at(i)));
+    }
+
+    QVector<result> results;
+    results.reserve(jobs.size());
+    for (auto &job : jobs)
+    {
+        results.append(job.result());
+    }
+    return results;
+}
+
+LogBatchProcessor::result LogBatchProcessor::processFile(const QString &fileName, const QString &outputBaseName) const
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    result fileResult;
+    fileResult.m_fileName = fileName;
+
+    LogdataStorage::Ptr storagePtr(new LogdataStorage());
+    AP2DataPlotStatus status;
+
+    if (!parseLog(fileName, storagePtr, status, fileResult.m_message))
+    {
+        fileResult.m_state = status.getParsingState();
+        fileResult.m_msecs = timer.elapsed();
+        return fileResult;
+    }
+    fileResult.m_state = status.getParsingState();
+
+    if (m_options.m_listFields)
+    {
+        QTextStream listStream(&fileResult.m_fieldList);
+        const QMap<QString, QStringList> fields = storagePtr->getFmtValues(true);
+        for (auto iter = fields.constBegin(); iter != fields.constEnd(); ++iter)
+        {
+            listStream << "  " << iter.key() << ": " << iter.value().join(", ") << "\n";
+        }
+    }
+
+    if (m_options.m_format == exportFormat::None)
+    {
+        fileResult.m_success = true;
+        fileResult.m_message = (status.getParsingState() == AP2DataPlotStatus::OK) ? QString("Parsed without errors")
+                                                                                     : status.getErrorOverview();
+    }
+    else
+    {
+        fileResult.m_success = exportLog(fileName, outputBaseName, storagePtr, status, fileResult.m_message);
+        if (outputBaseName != defaultOutputBaseName(fileName))
+        {
+            fileResult.m_message = "Exported as " + QFileInfo(outputBaseName).fileName()
+                                 + " as another log has the same name. " + fileResult.m_message;
+        }
+    }
+
+    fileResult.m_msecs = timer.elapsed();
+    return fileResult;
+}
+
+bool LogBatchProcessor::parseLog(const QString &fileName, LogdataStorage::Ptr storagePtr, AP2DataPlotStatus &status, QString &errorMessage) const
+{
+    if (m_options.m_useCache && LogdataCache::read(fileName, *storagePtr, status))
+    {
+        QLOG_DEBUG() << "LogBatchProcessor::parseLog() using cache of" << fileName;
+        return true;
+    }
+
+    QFile logfile(fileName);
+    if (!logfile.open(QIODevice::ReadOnly))
+    {
+        errorMessage = "Unable to open log file: " + logfile.errorString();
+        return false;
+    }
+
+    jobCallback callback;
+    const QString lowerName = fileName.toLower();
+    if (lowerName.endsWith(".bin"))
+    {
+        BinLogParser parser(storagePtr, &callback);
+        status = parser.parse(logfile);
+    }
+    else if (lowerName.endsWith(".log"))
+    {
+        AsciiLogParser parser(storagePtr, &callback);
+        status = parser.parse(logfile);
+    }
+    else if (lowerName.endsWith(".tlog"))
+    {
+        TlogParser parser(storagePtr, &callback);
+        status = parser.parse(logfile);
+    }
+    else
+    {
+        errorMessage = "Unsupported file type. Only .bin, .log and .tlog files can be processed";
+        return false;
+    }
+
+    if (!callback.m_errors.isEmpty())
+    {
+        errorMessage = callback.m_errors.join("; ");
+        return false;
+    }
+
+    if (m_options.m_useCache)
+    {
+        LogdataCache::write(fileName, *storagePtr, status);
+    }
+    return true;
+}
+
+bool LogBatchProcessor::exportLog(const QString &fileName, const QString &outputBaseName, LogdataStorage::Ptr storagePtr,
+                                  const AP2DataPlotStatus &status, QString &message) const
+{
+    switch (m_options.m_format)
+    {
+    case exportFormat::Csv:
+    {
+        CsvFieldExporter exporter(nullptr);
+        message = exporter.exportToFile(outputBaseName + ".csv", storagePtr, m_options.m_fields);
+        return exporter.isSuccessful();
+    }
+    case exportFormat::Binary:
+    {
+        BinaryFieldExporter exporter(nullptr);
+        message = exporter.exportToFile(outputBaseName + ".apmf", storagePtr, m_options.m_fields);
+        return exporter.isSuccessful();
+    }
+    case exportFormat::Kml:
+    {
+        KmlLogExporter exporter(nullptr, status.getMavType(), m_options.m_iconInterval);
+        message = exporter.exportToFile(outputBaseName + ".kml", storagePtr);
+        return exporter.isSuccessful();
+    }
+    case exportFormat::Ascii:
+    {
+        const QString outputName = outputBaseName + ".log";
+        if (QFileInfo(outputName) == QFileInfo(fileName))
+        {
+            message = "Export would overwrite the log. Use another output directory";
+            return false;
+        }
+        AsciiLogExporter exporter(nullptr);
+        message = exporter.exportToFile(outputName, storagePtr);
+        return exporter.isSuccessful();
+    }
+    case exportFormat::None:
+        break;
+    }
+    return true;
+}
+
+QString LogBatchProcessor::defaultOutputBaseName(const QString &fileName) const
+{
+    const QFileInfo logInfo(fileName);
+    const QDir outputDir(m_options.m_outputDir.isEmpty() ? logInfo.absolutePath() : m_options.m_outputDir);
+    return outputDir.filePath(logInfo.completeBaseName());
+}
+
+QStringList LogBatchProcessor::outputBaseNames(const QStringList &logFiles) const
+{
+    // Compared case insensitive as some file systems are
+    QSet<QString> usedNames;
+    QStringList baseNames;
+    baseNames.reserve(logFiles.size());
+    for (const auto &fileName : logFiles)
+    {
+        QString baseName = defaultOutputBaseName(fileName);
+        if (usedNames.contains(baseName.toLower()))
+        {
+            // Same name like several 00000001.BIN from different directories. Prefix the name
+            // of the directory of the log and add a number if that is not unique either.
+            const QFileInfo logInfo(fileName);
+            const QString prefixedName = QFileInfo(baseName).absoluteDir().filePath(
+                        logInfo.absoluteDir().dirName() + '_' + logInfo.completeBaseName());
+            baseName = prefixedName;
+            for (int number = 2; usedNames.contains(baseName.toLower()); ++number)
+            {
+                baseName = prefixedName + '_' + QString::number(number);
+            }
+        }
+        usedNames.insert(baseName.toLower());
+        baseNames.append(baseName);
+    }
+    return baseNames;
+}
@@ -0,0 +1,159 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief LogBatchProcessor
+ *          Parses and exports many logs in parallel without any GUI.
+ *
+ */
+
+#ifndef LOGBATCHPROCESSOR_H
+#define LOGBATCHPROCESSOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "Loghandling/AP2DataPlotStatus.h"
+#include "Loghandling/LogdataStorage.h"
+
+/**
+ * @brief The LogBatchProcessor class runs the log parsers and exporters of the
+ *        log analysis on a list of logs. Every log is handled by one job of an own
+ *        thread pool. The parsers themselves still use the global thread pool for
+ *        indexing, so the jobs only limit how many logs are held in memory at once.
+ */
+class LogBatchProcessor
+{
+public:
+
+    /**
+     * @brief The exportFormat enum lists all supported export formats
+     */
+    enum class exportFormat
+    {
+        None,       /// parse only
+        Csv,        /// selected fields as CSV - one file per message type
+        Kml,        /// flight path as KML / KMZ
+        Ascii,      /// whole log as ASCII log (.log)
+        Binary      /// selected fields in compact binary form, @see BinaryFieldExporter
+    };
+
+    /**
+     * @brief The options struct holds the settings for a batch run
+     */
+    struct options
+    {
+        exportFormat m_format = exportFormat::None;     /// format of the export
+        QStringList m_fields;                           /// fields for Csv and Binary export. Empty means all.
+        QString m_outputDir;                            /// directory for exported files. Empty means next to the log.
+        int m_jobs = 0;                                 /// logs processed in parallel. 0 means one per core.
+        bool m_useCache = false;                        /// read and write the log cache like the GUI does
+        bool m_listFields = false;                      /// list the numeric fields of every log
+        double m_iconInterval = 2.0;                    /// minimum time between two plane icons in KML export
+    };
+
+    /**
+     * @brief The result struct holds the outcome of processing one log
+     */
+    struct result
+    {
+        QString m_fileName;                             /// name of the log
+        bool m_success = false;                         /// true if parsing and export succeeded
+        AP2DataPlotStatus::parsingState m_state = AP2DataPlotStatus::OK;  /// state of the parsing
+        QString m_message;                              /// result of the export or the error
+        QString m_fieldList;                            /// the numeric fields if options::m_listFields is set
+        qint64 m_msecs = 0;                             /// time needed for this log
+    };
+
+    /**
+     * @brief LogBatchProcessor - CTOR
+     * @param opts - settings for the batch run
+     */
+    explicit LogBatchProcessor(const options &opts);
+
+    /**
+     * @brief process handles all logs and blocks until all are done
+     * @param logFiles - names of the logs
+     * @return one result per log in the order of logFiles
+     */
+    QVector<result> process(const QStringList &logFiles) const;
+
+    /**
+     * @brief isSupportedLog checks whether a file can be processed
+     * @param fileName - name of the file
+     * @return true if the file has a supported extension
+     */
+    static bool isSupportedLog(const QString &fileName);
+
+private:
+
+    options m_options;  /// settings for the batch run
+
+    /**
+     * @brief processFile parses one log and exports it. Runs in a job thread.
+     * @param fileName - name of the log
+     * @param outputBaseName - path of the exported file without extension
+     * @return the result
+     */
+    result processFile(const QString &fileName, const QString &outputBaseName) const;
+
+    /**
+     * @brief parseLog fills the datamodel from a log
+     * @param fileName - name of the log
+     * @param storagePtr - empty datamodel
+     * @param status - filled with the status of the parsing
+     * @param errorMessage - filled on error
+     * @return true on success, false otherwise
+     */
+    bool parseLog(const QString &fileName, LogdataStorage::Ptr storagePtr, AP2DataPlotStatus &status, QString &errorMessage) const;
+
+    /**
+     * @brief exportLog exports the datamodel in the configured format
+     * @param fileName - name of the log
+     * @param outputBaseName - path of the exported file without extension
+     * @param storagePtr - filled datamodel
+     * @param status - status of the parsing. Holds the vehicle type.
+     * @param message - filled with the result of the export
+     * @return true on success, false otherwise
+     */
+    bool exportLog(const QString &fileName, const QString &outputBaseName, LogdataStorage::Ptr storagePtr,
+                   const AP2DataPlotStatus &status, QString &message) const;
+
+    /**
+     * @brief defaultOutputBaseName creates the path of the exported file without extension
+     * @param fileName - name of the log
+     * @return the log name in the output directory
+     */
+    QString defaultOutputBaseName(const QString &fileName) const;
+
+    /**
+     * @brief outputBaseNames creates a unique output path for every log, so logs with the
+     *        same name from different directories do not overwrite each other's export
+     * @param logFiles - names of the logs
+     * @return one path without extension per log in the order of logFiles
+     */
+    QStringList outputBaseNames(const QStringList &logFiles) const;
+};
+
+#endif // LOGBATCHPROCESSOR_H
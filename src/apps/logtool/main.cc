@@ -0,0 +1,204 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief Main of apmlogtool - headless batch analysis and export of
+ *          ArduPilot logs using the parsers of the log analysis.
+ *
+ */
+
+#include "LogBatchProcessor.h"
+#include "logging.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+#define ENDL endl
+#define SPLITBEHAVIOUR QString::SkipEmptyParts
+#else
+#define ENDL Qt::endl
+#define SPLITBEHAVIOUR Qt::SkipEmptyParts
+#endif
+
+// Create the base logging category as defined in logging.h
+Q_LOGGING_CATEGORY(apmGeneral, "apm.general");
+
+namespace
+{
+    /**
+     * @brief collectLogs expands directories to the supported logs they contain
+     * @param arguments - files and directories from the command line
+     * @return the log files
+     */
+    QStringList collectLogs(const QStringList &arguments)
+    {
+        QStringList logs;
+        for (const auto &argument : arguments)
+        {
+            const QFileInfo info(argument);
+            if (info.isDir())
+            {
+                const QDir dir(argument);
+                for (const auto &entry : dir.entryInfoList(QDir::Files, QDir::Name))
+                {
+                    if (LogBatchProcessor::isSupportedLog(entry.fileName()))
+                    {
+                        logs.append(entry.filePath());
+                    }
+                }
+            }
+            else
+            {
+                logs.append(argument);
+            }
+        }
+        return logs;
+    }
+}
+
+/**
+ * @brief Starts the application
+ *
+ * @param argc Number of commandline arguments
+ * @param argv Commandline arguments
+ * @return exit code, 0 if all logs could be processed, 1 otherwise
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("apmlogtool");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Parses ArduPilot logs (.bin, .log, .tlog) and exports them without a GUI.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("logs", "Log files or directories containing logs.", "<logs...>");
+
+    const QCommandLineOption formatOption(QStringList() << "f" << "format",
+            "Export format: csv, kml, log or bin (compact binary). Without a format the logs are only parsed.", "format");
+    const QCommandLineOption fieldsOption(QStringList() << "s" << "fields",
+            "Comma separated fields for csv and bin export like ATT.Roll,IMU.GyrX,GPS. Default all numeric fields.", "fields");
+    const QCommandLineOption outputOption(QStringList() << "o" << "output-dir",
+            "Directory for the exported files. Default is the directory of the log.", "dir");
+    const QCommandLineOption jobsOption(QStringList() << "j" << "jobs",
+            "Number of logs processed in parallel. Default one per CPU core.", "count", "0");
+    const QCommandLineOption listOption(QStringList() << "l" << "list",
+            "List the numeric fields of every log.");
+    const QCommandLineOption cacheOption("cache",
+            "Read and write the log cache (<log>.apmidx) like the log analysis does.");
+    const QCommandLineOption iconOption("icon-interval",
+            "Minimum time between two plane icons in the KML export in seconds.", "seconds", "2");
+    const QCommandLineOption verboseOption(QStringList() << "v" << "verbose",
+            "Print debug output.");
+
+    parser.addOption(formatOption);
+    parser.addOption(fieldsOption);
+    parser.addOption(outputOption);
+    parser.addOption(jobsOption);
+    parser.addOption(listOption);
+    parser.addOption(cacheOption);
+    parser.addOption(iconOption);
+    parser.addOption(verboseOption);
+    parser.process(app);
+
+    QLoggingCategory::setFilterRules(parser.isSet(verboseOption) ? QStringLiteral("apm.general.debug=true")
+                                                                 : QStringLiteral("apm.general.debug=false\napm.general.info=false"));
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    LogBatchProcessor::options options;
+    const QString format = parser.value(formatOption).toLower();
+    if (format == "csv")
+    {
+        options.m_format = LogBatchProcessor::exportFormat::Csv;
+    }
+    else if (format == "kml")
+    {
+        options.m_format = LogBatchProcessor::exportFormat::Kml;
+    }
+    else if (format == "log")
+    {
+        options.m_format = LogBatchProcessor::exportFormat::Ascii;
+    }
+    else if (format == "bin")
+    {
+        options.m_format = LogBatchProcessor::exportFormat::Binary;
+    }
+    else if (!format.isEmpty())
+    {
+        err << "Unknown export format: " << format << ENDL;
+        return 1;
+    }
+
+    if (parser.isSet(fieldsOption))
+    {
+        options.m_fields = parser.value(fieldsOption).split(',', SPLITBEHAVIOUR);
+    }
+    options.m_outputDir = parser.value(outputOption);
+    options.m_jobs = parser.value(jobsOption).toInt();
+    options.m_listFields = parser.isSet(listOption);
+    options.m_useCache = parser.isSet(cacheOption);
+    options.m_iconInterval = parser.value(iconOption).toDouble();
+
+    if (!options.m_outputDir.isEmpty() && !QDir().mkpath(options.m_outputDir))
+    {
+        err << "Unable to create output directory: " << options.m_outputDir << ENDL;
+        return 1;
+    }
+
+    const QStringList logs = collectLogs(parser.positionalArguments());
+    if (logs.isEmpty())
+    {
+        parser.showHelp(1);
+    }
+
+    LogBatchProcessor processor(options);
+    const QVector<LogBatchProcessor::result> results = processor.process(logs);
+
+    int failed = 0;
+    for (const auto &fileResult : results)
+    {
+        if (fileResult.m_success)
+        {
+            out << "OK     " << fileResult.m_fileName << " (" << fileResult.m_msecs / 1000.0 << "s): "
+                << fileResult.m_message << ENDL;
+        }
+        else
+        {
+            ++failed;
+            err << "FAILED " << fileResult.m_fileName << " (" << fileResult.m_msecs / 1000.0 << "s): "
+                << fileResult.m_message << ENDL;
+        }
+        if (!fileResult.m_fieldList.isEmpty())
+        {
+            out << fileResult.m_fieldList;
+        }
+    }
+
+    out << results.size() - failed << " of " << results.size() << " logs processed successfully" << ENDL;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief LinkByteRingBuffer
+ *          Lock free single producer / single consumer byte queue used to hand
+ *          the received bytes of a link over to the MAVLinkProtocol.
+ *
+ */
+
+#include "LinkByteRingBuffer.h"
+
+#include <cstring>
+
+LinkByteRingBuffer::LinkByteRingBuffer(int capacity) :
+    m_mask(0),
+    m_writePos(0),
+    m_readPos(0),
+    m_droppedBytes(0)
+{
+    quint32 size = 1;
+    while (size < static_cast<quint32>(qMax(capacity, 1)))
+    {
+        size <<= 1;
+    }
+    m_buffer.resize(static_cast<int>(size));
+    m_mask = size - 1;
+}
+
+int LinkByteRingBuffer::write(const char *data, int size)
+{
+    const quint32 writePos = m_writePos.load(std::memory_order_relaxed);
+    const quint32 readPos  = m_readPos.load(std::memory_order_acquire);
+    const quint32 freeSpace = static_cast<quint32>(m_buffer.size()) - (writePos - readPos);
+    const quint32 toWrite = qMin(static_cast<quint32>(size), freeSpace);
+
+    // the data may wrap around the end of the buffer
+    const quint32 start = writePos & m_mask;
+    const quint32 firstPart = qMin(toWrite, static_cast<quint32>(m_buffer.size()) - start);
+    std::memcpy(m_buffer.data() + start, data, firstPart);
+    std::memcpy(m_buffer.data(), data + firstPart, toWrite - firstPart);
+
+    // publish the bytes to the consumer
+    m_writePos.store(writePos + toWrite, std::memory_order_release);
+
+    if (toWrite < static_cast<quint32>(size))
+    {
+        m_droppedBytes.fetch_add(static_cast<quint32>(size) - toWrite, std::memory_order_relaxed);
+    }
+    return static_cast<int>(toWrite);
+}
+
+bool LinkByteRingBuffer::writeAll(const char *data, int size)
+{
+    const quint32 writePos = m_writePos.load(std::memory_order_relaxed);
+    const quint32 readPos  = m_readPos.load(std::memory_order_acquire);
+    const quint32 freeSpace = static_cast<quint32>(m_buffer.size()) - (writePos - readPos);
+
+    if (static_cast<quint32>(size) > freeSpace)
+    {
+        m_droppedBytes.fetch_add(static_cast<quint32>(size), std::memory_order_relaxed);
+        return false;
+    }
+    // only the producer changes the write position, so this write can not be short
+    write(data, size);
+    return true;
+}
+
+int LinkByteRingBuffer::read(char *data, int maxSize)
+{
+    const quint32 readPos  = m_readPos.load(std::memory_order_relaxed);
+    const quint32 writePos = m_writePos.load(std::memory_order_acquire);
+    const quint32 toRead = qMin(static_cast<quint32>(maxSize), writePos - readPos);
+
+    const quint32 start = readPos & m_mask;
+    const quint32 firstPart = qMin(toRead, static_cast<quint32>(m_buffer.size()) - start);
+    std::memcpy(data, m_buffer.constData() + start, firstPart);
+    std::memcpy(data + firstPart, m_buffer.constData(), toRead - firstPart);
+
+    // release the space to the producer
+    m_readPos.store(readPos + toRead, std::memory_order_release);
+    return static_cast<int>(toRead);
+}
+
+bool LinkByteRingBuffer::isEmpty() const
+{
+    return m_readPos.load(std::memory_order_acquire) == m_writePos.load(std::memory_order_acquire);
+}
+
+quint64 LinkByteRingBuffer::droppedBytes() const
+{
+    return m_droppedBytes.load(std::memory_order_relaxed);
+}
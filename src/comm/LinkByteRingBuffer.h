@@ -0,0 +1,102 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief LinkByteRingBuffer
+ *          Lock free single producer / single consumer byte queue used to hand
+ *          the received bytes of a link over to the MAVLinkProtocol.
+ *
+ */
+
+#ifndef LINKBYTERINGBUFFER_H
+#define LINKBYTERINGBUFFER_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <atomic>
+
+/**
+ * @brief The LinkByteRingBuffer class is a lock free ring buffer for exactly one
+ *        producer thread (the thread the link receives its data in) and exactly one
+ *        consumer thread (the thread of the MAVLinkProtocol).
+ *
+ *        The read and write positions run freely and are only masked when accessing
+ *        the buffer, so the capacity is always a power of 2. If the consumer is too
+ *        slow the bytes which do not fit are dropped and counted.
+ */
+class LinkByteRingBuffer
+{
+public:
+    /**
+     * @brief LinkByteRingBuffer - CTOR
+     * @param capacity - minimal capacity in bytes. Will be rounded up to the next power of 2.
+     */
+    explicit LinkByteRingBuffer(int capacity);
+
+    /**
+     * @brief write appends bytes to the buffer. Must only be called by the producer.
+     * @param data - pointer to the bytes
+     * @param size - number of bytes
+     * @return number of bytes written. Less than size if the buffer is full.
+     */
+    int write(const char *data, int size);
+
+    /**
+     * @brief writeAll appends bytes only if all of them fit into the buffer. Used for
+     *        records which must not be split. Must only be called by the producer.
+     * @param data - pointer to the bytes
+     * @param size - number of bytes
+     * @return true if the bytes were written, false if they were dropped
+     */
+    bool writeAll(const char *data, int size);
+
+    /**
+     * @brief read removes bytes from the buffer. Must only be called by the consumer.
+     * @param data - pointer to the memory to be filled
+     * @param maxSize - maximum number of bytes to read
+     * @return number of bytes read
+     */
+    int read(char *data, int maxSize);
+
+    /**
+     * @brief isEmpty
+     * @return true if there is nothing to read
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief droppedBytes delivers the number of bytes which were dropped because
+     *        the buffer was full.
+     * @return number of dropped bytes
+     */
+    quint64 droppedBytes() const;
+
+private:
+    QVector<char> m_buffer;                 /// the memory of the buffer
+    quint32 m_mask;                         /// capacity - 1 for masking the positions
+    std::atomic<quint32> m_writePos;        /// next position to write. Only changed by the producer
+    std::atomic<quint32> m_readPos;         /// next position to read. Only changed by the consumer
+    std::atomic<quint64> m_droppedBytes;    /// bytes which did not fit into the buffer
+};
+
+#endif // LINKBYTERINGBUFFER_H
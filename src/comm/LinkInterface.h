@@ -32,6 +32,7 @@ along with PIXHAWK. If not, see <http://www.gnu.org/licenses/>.
 #ifndef _LINKINTERFACE_H_
 #define _LINKINTERFACE_H_
 
+#include <QByteArray>
 #include <QThread>
 #include <QDateTime>
 #include <QMutex>
@@ -176,6 +177,30 @@ public slots:
      **/
     virtual void writeBytes(const char *bytes, qint64 length) = 0;
 
+    /**
+     * @brief Writes data by writeBytes(). Meant to be invoked queued, so the data
+     *        is written in the thread the link object lives in. Queued calls
+     *        are discarded if the link is deleted before.
+     *
+     * @param data The bytes to write
+     **/
+    void writeByteArray(const QByteArray &data)
+    {
+        if (isConnected())
+        {
+            writeBytes(data.constData(), data.size());
+        }
+    }
+
+public:
+    /**
+     * @brief Determine if writeBytes() may be called from any thread
+     *
+     * @return True if writeBytes() is thread safe, false if it must be called
+     *         in the thread the link object lives in
+     **/
+    virtual bool isWriteThreadSafe() const { return false; }
+
 signals:
 
     /**
@@ -59,9 +59,11 @@ LinkManager::LinkManager(QObject *parent) :
     m_mavlinkDecoder.reset(new MAVLinkDecoder(this));
     m_mavlinkProtocol.reset(new MAVLinkProtocol());
     m_mavlinkProtocol->setConnectionManager(this);
+    m_mavlinkRouter.reset(new MAVLinkRouter());
     connect(m_mavlinkProtocol.data(),SIGNAL(messageReceived(LinkInterface*,mavlink_message_t)),m_mavlinkDecoder.data(),SLOT(receiveMessage(LinkInterface*,mavlink_message_t)));
     connect(m_mavlinkProtocol.data(),SIGNAL(messageReceived(LinkInterface*,mavlink_message_t)),this,SLOT(receiveMessage(LinkInterface*,mavlink_message_t)));
     connect(m_mavlinkProtocol.data(),SIGNAL(protocolStatusMessage(QString,QString)),this,SLOT(protocolStatusMessageRec(QString,QString)));
+    connect(m_mavlinkProtocol.data(),SIGNAL(loggingStatisticsChanged(quint64,quint64)),this,SIGNAL(loggingStatisticsChanged(quint64,quint64)));
 
     QTimer::singleShot(500, this, SLOT(reloadSettings()));
 }
@@ -112,6 +114,7 @@ LinkManager::~LinkManager()
 void LinkManager::shutdown()
 {  
     saveSettings();
+    m_mavlinkRouter->removeAllRoutes();
     m_mavlinkDecoder.reset();
     m_mavlinkProtocol.reset();
 }
@@ -122,10 +125,12 @@ void LinkManager::loadSettings()
     settings.beginGroup("LINKMANAGER");
     m_mavlinkLoggingEnabled = settings.value("LOGGING",true).toBool();
     int linkssize = settings.beginReadArray("LINKS");
+    QList<int> loadedLinkIds;   // link id by index in LINKS, -1 if the link was not created
     for (int i=0;i<linkssize;i++)
     {
         settings.setArrayIndex(i);
         QString type = settings.value("type").toString();
+        loadedLinkIds.append(-1);
         if (type == "SERIAL_LINK")
         {
             QString port = settings.value("port").toString();
@@ -136,12 +141,13 @@ void LinkManager::loadSettings()
                 baud = 115200;
             }
 
-            LinkManagerFactory::addSerialConnection(port,baud);
+            loadedLinkIds.last() = LinkManagerFactory::addSerialConnection(port,baud);
         }
         else if (type == "UDP_LINK")
         {
             int port = settings.value("port").toInt();
             int linkid = LinkManagerFactory::addUdpConnection(QHostAddress::Any,port);
+            loadedLinkIds.last() = linkid;
             UDPLink *iface = qobject_cast<UDPLink*>(getLink(linkid));
 
             int hostcount = settings.beginReadArray("HOSTS");
@@ -160,16 +166,37 @@ void LinkManager::loadSettings()
             QString hostName = settings.value("hostname").toString();
             int port = settings.value("port").toInt();
             bool asServer = settings.value("asServer").toBool();
-            LinkManagerFactory::addTcpConnection(hostAddress, hostName, port, asServer);
+            loadedLinkIds.last() = LinkManagerFactory::addTcpConnection(hostAddress, hostName, port, asServer);
         }
         else if (type == "UDP_CLIENT_LINK")
         {
             QString host = settings.value("host").toString();
             int port = settings.value("port").toInt();
-            LinkManagerFactory::addUdpClientConnection(QHostAddress(host),port);
+            loadedLinkIds.last() = LinkManagerFactory::addUdpClientConnection(QHostAddress(host),port);
         }
     }
     settings.endArray(); // HOSTS
+    // Routes refer to the links by their index in LINKS, as the link ids change on every start
+    int routessize = settings.beginReadArray("ROUTES");
+    for (int i=0;i<routessize;i++)
+    {
+        settings.setArrayIndex(i);
+        int source = settings.value("source",-1).toInt();
+        int target = settings.value("target",-1).toInt();
+        if (source < 0 || source >= loadedLinkIds.size() || target < 0 || target >= loadedLinkIds.size())
+        {
+            QLOG_WARN() << "Ignoring route with unknown links" << source << target;
+            continue;
+        }
+        MAVLinkRouter::Route route;
+        route.sourceLinkId = loadedLinkIds.at(source);
+        route.targetLinkId = loadedLinkIds.at(target);
+        route.sysid = settings.value("sysid",0).toInt();
+        route.compid = settings.value("compid",0).toInt();
+        route.maxRate = settings.value("maxrate",0).toInt();
+        m_mavlinkRouter->addRoute(route);
+    }
+    settings.endArray(); // ROUTES
     int portsize = settings.beginReadArray("PORTBAUDPAIRS");
     for (int i=0;i<portsize;i++)
     {
@@ -188,9 +215,11 @@ void LinkManager::saveSettings()
     settings.beginGroup("LINKMANAGER");
     settings.setValue("LOGGING",m_mavlinkLoggingEnabled);
     settings.beginWriteArray("LINKS");
+    QMap<int,int> linkIndex;    // index in LINKS by link id
     int index = 0;
     for (QMap<int,LinkInterface*>::const_iterator i= m_connectionMap.constBegin();i!=m_connectionMap.constEnd();i++)
     {
+        linkIndex.insert(i.key(),index);
         settings.setArrayIndex(index++);
         settings.setValue("linkid",i.value()->getId());
         if (i.value()->getLinkType() == LinkInterface::SERIAL_LINK)
@@ -243,6 +272,23 @@ void LinkManager::saveSettings()
         }
     }
     settings.endArray(); // LINKS
+    settings.beginWriteArray("ROUTES");
+    index = 0;
+    foreach (int routeId, m_mavlinkRouter->getRoutes())
+    {
+        MAVLinkRouter::Route route = m_mavlinkRouter->getRoute(routeId);
+        if (!linkIndex.contains(route.sourceLinkId) || !linkIndex.contains(route.targetLinkId))
+        {
+            continue;
+        }
+        settings.setArrayIndex(index++);
+        settings.setValue("source",linkIndex.value(route.sourceLinkId));
+        settings.setValue("target",linkIndex.value(route.targetLinkId));
+        settings.setValue("sysid",route.sysid);
+        settings.setValue("compid",route.compid);
+        settings.setValue("maxrate",route.maxRate);
+    }
+    settings.endArray(); // ROUTES
     settings.beginWriteArray("PORTBAUDPAIRS");
     index = 0;
     for (QMap<QString,int>::const_iterator i=m_portToBaudMap.constBegin();i!=m_portToBaudMap.constEnd();i++)
@@ -312,6 +358,11 @@ MAVLinkProtocol* LinkManager::getProtocol() const
     return m_mavlinkProtocol.data();
 }
 
+MAVLinkRouter* LinkManager::getRouter() const
+{
+    return m_mavlinkRouter.data();
+}
+
 LinkInterface::LinkType LinkManager::getLinkType(int linkid)
 {
     if (!m_connectionMap.contains(linkid))
@@ -349,6 +400,7 @@ void LinkManager::removeLink(int linkId)
         {
             m_connectionMap.value(linkId)->disconnect();
         }
+        m_mavlinkRouter->removeLink(m_connectionMap.value(linkId));
         delete m_connectionMap.value(linkId);
         m_connectionMap.remove(linkId);
         saveSettings();
@@ -45,6 +45,7 @@ This file is part of the APM_PLANNER project
  */
 #include "MAVLinkDecoder.h"
 #include "MAVLinkProtocol.h"
+#include "MAVLinkRouter.h"
 #include <QMap>
 #include <QStringList>
 
@@ -67,6 +68,8 @@ public:
     void enableAllTimeouts();
 
     MAVLinkProtocol* getProtocol() const;
+    /** @brief The router forwarding frames between the links */
+    MAVLinkRouter* getRouter() const;
     bool connectLink(int index);
     void disconnectLink(int index);
 
@@ -106,6 +109,8 @@ signals:
     //void newLink(LinkInterface* link);
     void newLink(int linkid);
     void protocolStatusMessage(QString title,QString text);
+    /** @brief number of recorded and dropped messages of the current tlog */
+    void loggingStatisticsChanged(quint64 queuedFrames, quint64 droppedFrames);
     void linkChanged(int linkid);
 
     /** @brief aggregated signal for when link status changes */
@@ -137,6 +142,7 @@ private:
     QMap<QString,int> m_portToBaudMap;
     QScopedPointer<MAVLinkDecoder, QScopedPointerDeleteLater> m_mavlinkDecoder;
     QScopedPointer<MAVLinkProtocol, QScopedPointerDeleteLater> m_mavlinkProtocol;
+    QScopedPointer<MAVLinkRouter, QScopedPointerDeleteLater> m_mavlinkRouter;
     QString m_logSubDir;
     bool m_mavlinkLoggingEnabled;
 };
@@ -39,9 +39,22 @@ This file is part of the APM_PLANNER project
 #include "UASInterface.h"
 
 #include <QDataStream>
+#include <cstring>
+
+namespace
+{
+    template <typename T> double readValue(const char *p_field, int index)
+    {
+        // The payload is packed so the value may be unaligned
+        T value;
+        memcpy(&value, p_field + index * static_cast<int>(sizeof(T)), sizeof(T));
+        return static_cast<double>(value);
+    }
+}
 
 MAVLinkDecoder::MAVLinkDecoder(QObject *parent):
     QObject(parent),
+    m_fieldRegistry(MAVLinkFieldRegistry::instance()),
     m_localDecode(false),
     mp_uas(nullptr)
 {
@@ -177,9 +190,34 @@ void MAVLinkDecoder::receiveMessage(LinkInterface* link, mavlink_message_t messa
     }
     else
     {
+        // do we have an active UAS? Check only if not local decoding
+        if(!m_localDecode)
+        {
+            mp_uas = UASManager::instance()->getUASForId(message.sysid);
+        }
+        else
+        {
+            mp_uas = nullptr;
+        }
+
+        // Store component ID
+        if (!m_componentID.contains(message.msgid))
+        {
+            m_componentID[message.msgid] = message.compid;
+        }
+        else
+        {
+            // Got this message already
+            if (m_componentID[message.msgid] != message.compid)
+            {
+                m_componentMulti[message.msgid] = true;
+            }
+        }
+
         // See if first value is a time value
         quint64 time = 0;
         quint8 fieldid = 0;
+        int firstValueField = 1;
         quint8 *p_payload = reinterpret_cast<uint8_t*>(&message.payload64[0]);
         if (QString(p_messageInfo->fields[fieldid].name) == QString("time_boot_ms") && p_messageInfo->fields[fieldid].type == MAVLINK_TYPE_UINT32_T)
         {
@@ -208,43 +246,95 @@ void MAVLinkDecoder::receiveMessage(LinkInterface* link, mavlink_message_t messa
         }
         else
         {
-            // First value is not time, send out value 0
-            emitFieldValue(&message, fieldid, getUnixTimeFromMs(message.sysid, 0));
+            // First value is not time, send it out with time 0
+            firstValueField = 0;
         }
 
         // Align time to global time
         time = getUnixTimeFromMs(message.sysid, time);
 
-        // do we have an active UAS? Check only if not local decoding
-        if(!m_localDecode)
+        if ((mp_uas != nullptr) && usesBatch(message.msgid))
         {
-            mp_uas = UASManager::instance()->getUASForId(message.sysid);
+            // Send out all field values in one go
+            emitFieldValues(&message, *p_messageInfo, firstValueField, time);
         }
         else
         {
-            mp_uas = nullptr;
-        }
-
-        // Store component ID
-        if (!m_componentID.contains(message.msgid))
-        {
-            m_componentID[message.msgid] = message.compid;
-        }
-        else
-        {
-            // Got this message already
-            if (m_componentID[message.msgid] != message.compid)
+            // Send out field values one by one
+            for (int i = firstValueField; i < static_cast<int>(p_messageInfo->num_fields); ++i)
             {
-                m_componentMulti[message.msgid] = true;
+                emitFieldValue(&message, i, time);
             }
         }
+    }
+}
 
-        // Send out field values from 1..n
-        for (int i = 1; i < static_cast<int>(p_messageInfo->num_fields); ++i)
-        {
-            emitFieldValue(&message, i, time);
+bool MAVLinkDecoder::usesBatch(quint32 msgid) const
+{
+    return !messageFilter.contains(msgid) &&
+           (msgid != MAVLINK_MSG_ID_DEBUG_VECT) &&
+           (msgid != MAVLINK_MSG_ID_DEBUG) &&
+           (msgid != MAVLINK_MSG_ID_NAMED_VALUE_FLOAT) &&
+           (msgid != MAVLINK_MSG_ID_NAMED_VALUE_INT);
+}
+
+void MAVLinkDecoder::emitFieldValues(mavlink_message_t *msg, const mavlink_message_info_t &typeInfo, int firstField, quint64 time)
+{
+    const QVector<int> &fieldIds = m_fieldRegistry.messageFieldIds(msg->msgid);
+    if (fieldIds.size() != static_cast<int>(typeInfo.num_fields))
+    {
+        return;
+    }
+
+    const char *p_payload = _MAV_PAYLOAD(msg);
+    m_batch.m_uasId = msg->sysid;
+    m_batch.m_compId = msg->compid;
+    m_batch.m_multiComponent = m_componentMulti.value(msg->msgid, false);
+    m_batch.m_msec = time;
+    // resize() keeps the capacity, so refilling does not allocate
+    m_batch.m_fieldIds.resize(0);
+    m_batch.m_values.resize(0);
+
+    for (int i = firstField; i < static_cast<int>(typeInfo.num_fields); ++i)
+    {
+        const mavlink_field_info_t &field = typeInfo.fields[i];
+        const int fieldId = fieldIds.at(i);
+        if (fieldId < 0)
+        {
+            // char fields have no ID and are emitted as text
+            emitFieldValue(msg, i, time);
+            continue;
+        }
+
+        const char *p_field = p_payload + field.wire_offset;
+        const int elements = field.array_length > 0 ? static_cast<int>(field.array_length) : 1;
+        for (int j = 0; j < elements; ++j)
+        {
+            double value = 0.0;
+            switch (field.type)
+            {
+            case MAVLINK_TYPE_UINT8_T:  value = readValue<quint8>(p_field, j);  break;
+            case MAVLINK_TYPE_INT8_T:   value = readValue<qint8>(p_field, j);   break;
+            case MAVLINK_TYPE_UINT16_T: value = readValue<quint16>(p_field, j); break;
+            case MAVLINK_TYPE_INT16_T:  value = readValue<qint16>(p_field, j);  break;
+            case MAVLINK_TYPE_UINT32_T: value = readValue<quint32>(p_field, j); break;
+            case MAVLINK_TYPE_INT32_T:  value = readValue<qint32>(p_field, j);  break;
+            case MAVLINK_TYPE_UINT64_T: value = readValue<quint64>(p_field, j); break;
+            case MAVLINK_TYPE_INT64_T:  value = readValue<qint64>(p_field, j);  break;
+            case MAVLINK_TYPE_FLOAT:    value = readValue<float>(p_field, j);   break;
+            case MAVLINK_TYPE_DOUBLE:   value = readValue<double>(p_field, j);  break;
+            default:
+                QLOG_DEBUG() << "WARNING: UNKNOWN MAVLINK TYPE";
+            }
+            m_batch.m_fieldIds.append(fieldId + j);
+            m_batch.m_values.append(value);
         }
     }
+
+    if (m_batch.count() > 0)
+    {
+        mp_uas->valuesChangedRec(m_batch);
+    }
 }
 
 
@@ -38,6 +38,7 @@ This file is part of the APM_PLANNER project
 #include "mavlink.h"
 #include "logging.h"
 #include "LinkInterface.h"
+#include "MAVLinkFieldRegistry.h"
 
 #include <QObject>
 #include <QThread>
@@ -73,6 +74,28 @@ public slots:
     void emitFieldValue(mavlink_message_t* msg, int fieldid, quint64 time);
 
 private:
+    /**
+     * @brief usesBatch checks whether the values of a message can be passed as one
+     *        MAVLinkValueBatch. Messages carrying their own value names like
+     *        NAMED_VALUE_FLOAT are still emitted field by field.
+     * @param msgid - ID of the message
+     * @return true if the message can be batched
+     */
+    bool usesBatch(quint32 msgid) const;
+
+    /**
+     * @brief emitFieldValues passes all values of a message starting at firstField
+     *        to the active UAS in one MAVLinkValueBatch. Char fields are emitted as
+     *        text messages like before.
+     * @param msg - the message
+     * @param typeInfo - format of the message
+     * @param firstField - index of the first field to emit
+     * @param time - time stamp of the message
+     */
+    void emitFieldValues(mavlink_message_t *msg, const mavlink_message_info_t &typeInfo, int firstField, quint64 time);
+
+    const MAVLinkFieldRegistry &m_fieldRegistry;    ///< Field ID of every message field
+    MAVLinkValueBatch m_batch;                      ///< Reused for every batched message
 
     QHash<int,int> m_componentID;
     QHash<int,bool> m_componentMulti;
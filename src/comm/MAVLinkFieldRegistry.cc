@@ -0,0 +1,120 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkFieldRegistry
+ *          Assigns a stable integer ID to every value field of every known
+ *          MAVLink message.
+ *
+ */
+
+#include "MAVLinkFieldRegistry.h"
+
+namespace
+{
+    QString typeName(mavlink_message_type_t type)
+    {
+        switch (type)
+        {
+        case MAVLINK_TYPE_CHAR:     return QStringLiteral("char");
+        case MAVLINK_TYPE_UINT8_T:  return QStringLiteral("uint8_t");
+        case MAVLINK_TYPE_INT8_T:   return QStringLiteral("int8_t");
+        case MAVLINK_TYPE_UINT16_T: return QStringLiteral("uint16_t");
+        case MAVLINK_TYPE_INT16_T:  return QStringLiteral("int16_t");
+        case MAVLINK_TYPE_UINT32_T: return QStringLiteral("uint32_t");
+        case MAVLINK_TYPE_INT32_T:  return QStringLiteral("int32_t");
+        case MAVLINK_TYPE_UINT64_T: return QStringLiteral("uint64_t");
+        case MAVLINK_TYPE_INT64_T:  return QStringLiteral("int64_t");
+        case MAVLINK_TYPE_FLOAT:    return QStringLiteral("float");
+        case MAVLINK_TYPE_DOUBLE:   return QStringLiteral("double");
+        }
+        return QString();
+    }
+}
+
+const MAVLinkFieldRegistry &MAVLinkFieldRegistry::instance()
+{
+    // Initialization of function local statics is thread safe
+    static const MAVLinkFieldRegistry registry;
+    return registry;
+}
+
+MAVLinkFieldRegistry::MAVLinkFieldRegistry()
+{
+    qRegisterMetaType<MAVLinkValueBatch>("MAVLinkValueBatch");
+
+    const QVector<mavlink_message_info_t> mavlinkMsg = MAVLINK_MESSAGE_INFO;
+    for (const auto &typeInfo : mavlinkMsg)
+    {
+        if (m_messageFields.contains(typeInfo.msgid))
+        {
+            continue;   // MAVLinkDecoder already warns about this
+        }
+
+        QVector<int> firstIds(static_cast<int>(typeInfo.num_fields), -1);
+        for (int i = 0; i < static_cast<int>(typeInfo.num_fields); ++i)
+        {
+            const mavlink_field_info_t &field = typeInfo.fields[i];
+            if (field.type == MAVLINK_TYPE_CHAR)
+            {
+                continue;   // strings and single chars are not handled as values
+            }
+
+            fieldInfo info;
+            info.m_msgId = typeInfo.msgid;
+            info.m_fieldIndex = static_cast<quint8>(i);
+            info.m_type = field.type;
+
+            firstIds[i] = m_fields.size();
+            const QString baseName = QString(typeInfo.name) + '.' + field.name;
+            if (field.array_length > 0)
+            {
+                info.m_unit = QString("%1[%2]").arg(typeName(field.type)).arg(field.array_length);
+                for (unsigned int j = 0; j < field.array_length; ++j)
+                {
+                    info.m_arrayIndex = static_cast<quint8>(j);
+                    info.m_name = QString("%1.%2").arg(baseName).arg(j);
+                    m_fields.append(info);
+                }
+            }
+            else
+            {
+                info.m_unit = typeName(field.type);
+                info.m_name = baseName;
+                m_fields.append(info);
+            }
+        }
+        m_messageFields.insert(typeInfo.msgid, firstIds);
+    }
+    m_fields.squeeze();
+}
+
+const QVector<int> &MAVLinkFieldRegistry::messageFieldIds(quint32 msgId) const
+{
+    const auto iter = m_messageFields.constFind(msgId);
+    if (iter == m_messageFields.constEnd())
+    {
+        return m_noFields;
+    }
+    return *iter;
+}
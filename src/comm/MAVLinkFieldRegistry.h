@@ -0,0 +1,156 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkFieldRegistry
+ *          Assigns a stable integer ID to every value field of every known
+ *          MAVLink message and defines the batch used to pass all values of
+ *          one decoded message to the UI.
+ *
+ */
+
+#ifndef MAVLINKFIELDREGISTRY_H
+#define MAVLINKFIELDREGISTRY_H
+
+#include "mavlink.h"
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMetaType>
+
+/**
+ * @brief The MAVLinkValueBatch struct holds all values of one decoded MAVLink message.
+ *        The values are identified by the field IDs of the MAVLinkFieldRegistry. The
+ *        vectors are implicitly shared, so a queued delivery only copies the header
+ *        and a reused batch only allocates while a receiver still holds its last copy.
+ */
+struct MAVLinkValueBatch
+{
+    int m_uasId = 0;                    /// system ID of the sender
+    int m_compId = 0;                   /// component ID of the sender
+    bool m_multiComponent = false;      /// true if this message is received from more than one component
+    quint64 m_msec = 0;                 /// time stamp of the message in ms since epoch
+    QVector<int> m_fieldIds;            /// field ID of each value
+    QVector<double> m_values;           /// the values, same size as m_fieldIds
+
+    /**
+     * @brief count
+     * @return number of values in the batch
+     */
+    int count() const
+    {
+        return m_values.size();
+    }
+
+    /**
+     * @brief cacheKey delivers a unique key for a value of this batch. Can be used by
+     *        receivers to cache the names they build from the field ID.
+     * @param index - index of the value
+     * @return unique key for system, component and field
+     */
+    quint64 cacheKey(int index) const
+    {
+        const quint64 component = m_multiComponent ? static_cast<quint64>(m_compId) + 1 : 0;
+        return (static_cast<quint64>(m_uasId) << 48) | (component << 32) | static_cast<quint32>(m_fieldIds[index]);
+    }
+};
+
+Q_DECLARE_METATYPE(MAVLinkValueBatch)
+
+/**
+ * @brief The MAVLinkFieldRegistry class maps every numeric field of all known MAVLink
+ *        messages to a stable integer ID. Array fields get one ID per element. The
+ *        registry is built once from MAVLINK_MESSAGE_INFO and is read only afterwards
+ *        so it can be used from any thread.
+ */
+class MAVLinkFieldRegistry
+{
+public:
+    /**
+     * @brief The fieldInfo struct describes one field ID
+     */
+    struct fieldInfo
+    {
+        quint32 m_msgId = 0;            /// ID of the message
+        quint8 m_fieldIndex = 0;        /// index of the field in mavlink_message_info_t
+        quint8 m_arrayIndex = 0;        /// index of the element for array fields
+        mavlink_message_type_t m_type = MAVLINK_TYPE_CHAR;  /// type of the field
+        QString m_name;                 /// name like "ATTITUDE.roll" or "BATTERY_STATUS.voltages.0"
+        QString m_unit;                 /// the C type like "float" or "uint16_t[10]"
+    };
+
+    /**
+     * @brief instance delivers the registry
+     * @return reference to the registry
+     */
+    static const MAVLinkFieldRegistry &instance();
+
+    /**
+     * @brief messageFieldIds delivers the field ID of the first element of every
+     *        field of a message.
+     * @param msgId - ID of the message
+     * @return vector indexed like the fields in mavlink_message_info_t. Contains -1 for
+     *         fields without ID (char fields). Empty for unknown messages.
+     */
+    const QVector<int> &messageFieldIds(quint32 msgId) const;
+
+    /**
+     * @brief info delivers the description of a field ID
+     * @param fieldId - a valid field ID
+     * @return the description
+     */
+    const fieldInfo &info(int fieldId) const
+    {
+        return m_fields.at(fieldId);
+    }
+
+    /**
+     * @brief isInteger
+     * @param fieldId - a valid field ID
+     * @return true if the field holds an integer type
+     */
+    bool isInteger(int fieldId) const
+    {
+        const mavlink_message_type_t type = m_fields.at(fieldId).m_type;
+        return (type != MAVLINK_TYPE_FLOAT) && (type != MAVLINK_TYPE_DOUBLE);
+    }
+
+    /**
+     * @brief size
+     * @return number of registered field IDs
+     */
+    int size() const
+    {
+        return m_fields.size();
+    }
+
+private:
+    MAVLinkFieldRegistry();
+
+    QVector<fieldInfo> m_fields;                    /// all field IDs
+    const QVector<int> m_noFields;                  /// returned for unknown messages
+    QHash<quint32, QVector<int> > m_messageFields;  /// msgId -> first field ID of every field
+};
+
+#endif // MAVLINKFIELDREGISTRY_H
@@ -0,0 +1,224 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkMessageStatistics
+ *          Per message statistics of all received MAVLink messages.
+ *
+ */
+
+#include "MAVLinkMessageStatistics.h"
+#include "logging.h"
+
+#include <cstring>
+
+MAVLinkMessageStatistics::MAVLinkMessageStatistics() :
+    m_slots(new messageSlot[s_SlotCount]),
+    m_usedSlots(new std::atomic<int>[s_SlotCount])
+{
+    for (int i = 0; i < s_SlotCount; ++i)
+    {
+        m_usedSlots[i].store(-1, std::memory_order_relaxed);
+        memset(&m_slots[i].m_lastMessage, 0, sizeof(mavlink_message_t));
+    }
+    reset();
+    m_clock.start();
+}
+
+void MAVLinkMessageStatistics::record(const mavlink_message_t &message)
+{
+    const quint64 key = (static_cast<quint64>(message.sysid) << 32) | (static_cast<quint64>(message.compid) << 24)
+                        | (message.msgid & 0xFFFFFF);
+    messageSlot *slot = findSlot(key + 1);
+    if (slot == nullptr)
+    {
+        if (m_droppedMessages.fetch_add(1, std::memory_order_relaxed) == 0)
+        {
+            QLOG_WARN() << "MAVLinkMessageStatistics: Table full, messages of new types are not recorded";
+        }
+        return;
+    }
+
+    int frameLength = 0;
+    if (message.magic == MAVLINK_STX_MAVLINK1)
+    {
+        frameLength = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 + message.len + MAVLINK_NUM_CHECKSUM_BYTES;
+    }
+    else
+    {
+        frameLength = MAVLINK_CORE_HEADER_LEN + 1 + message.len + MAVLINK_NUM_CHECKSUM_BYTES;
+        if (message.incompat_flags & MAVLINK_IFLAG_SIGNED)
+        {
+            frameLength += MAVLINK_SIGNATURE_BLOCK_LEN;
+        }
+    }
+    slot->m_count.fetch_add(1, std::memory_order_relaxed);
+    slot->m_bytes.fetch_add(static_cast<quint64>(frameLength), std::memory_order_relaxed);
+
+    const quint64 now = static_cast<quint64>(m_clock.nsecsElapsed() / 1000);
+    const quint64 last = slot->m_lastUsec.exchange(now, std::memory_order_relaxed);
+    if (last != 0 && now >= last)
+    {
+        quint64 intervalMs = (now - last) / 1000;
+        int bin = 0;
+        if (intervalMs > 0)
+        {
+            bin = 1;
+            while (intervalMs > 1 && bin < s_HistogramBins - 1)
+            {
+                intervalMs >>= 1;
+                ++bin;
+            }
+        }
+        slot->m_intervals[bin].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Store the message unless another thread is storing one for this slot right now,
+    // the reader gets its message a moment later.
+    quint32 sequence = slot->m_sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) == 0
+            && slot->m_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&slot->m_lastMessage, &message, sizeof(mavlink_message_t));
+        slot->m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+}
+
+MAVLinkMessageStatistics::messageSlot *MAVLinkMessageStatistics::findSlot(quint64 key)
+{
+    // Open addressing with linear probing, slots are never released
+    int index = static_cast<int>((key * 0x9E3779B97F4A7C15ULL) >> 52) & (s_SlotCount - 1);
+    for (int probe = 0; probe < s_SlotCount; ++probe)
+    {
+        messageSlot &slot = m_slots[index];
+        quint64 slotKey = slot.m_key.load(std::memory_order_acquire);
+        if (slotKey == key)
+        {
+            return &slot;
+        }
+        if (slotKey == 0)
+        {
+            if (slot.m_key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel))
+            {
+                const int order = m_usedCount.fetch_add(1, std::memory_order_acq_rel);
+                m_usedSlots[order].store(index, std::memory_order_release);
+                return &slot;
+            }
+            if (slotKey == key)
+            {
+                return &slot;   // Assigned by another thread in the meantime
+            }
+        }
+        index = (index + 1) & (s_SlotCount - 1);
+    }
+    return nullptr;
+}
+
+int MAVLinkMessageStatistics::usedSlots() const
+{
+    return m_usedCount.load(std::memory_order_acquire);
+}
+
+bool MAVLinkMessageStatistics::read(int index, messageStatistics &statistics, mavlink_message_t *lastMessage) const
+{
+    if (index < 0 || index >= usedSlots())
+    {
+        return false;
+    }
+    const int slotIndex = m_usedSlots[index].load(std::memory_order_acquire);
+    if (slotIndex < 0)
+    {
+        return false;
+    }
+    const messageSlot &slot = m_slots[slotIndex];
+
+    const quint64 key = slot.m_key.load(std::memory_order_acquire) - 1;
+    statistics.sysid = static_cast<int>((key >> 32) & 0xFF);
+    statistics.compid = static_cast<int>((key >> 24) & 0xFF);
+    statistics.msgid = static_cast<quint32>(key & 0xFFFFFF);
+    statistics.count = slot.m_count.load(std::memory_order_relaxed);
+    statistics.bytes = slot.m_bytes.load(std::memory_order_relaxed);
+    for (int bin = 0; bin < s_HistogramBins; ++bin)
+    {
+        statistics.intervals[bin] = slot.m_intervals[bin].load(std::memory_order_relaxed);
+    }
+
+    if (lastMessage == nullptr)
+    {
+        return true;
+    }
+    for (int retry = 0; retry < 3; ++retry)
+    {
+        const quint32 before = slot.m_sequence.load(std::memory_order_acquire);
+        if (before == 0)
+        {
+            return false;   // No message stored yet
+        }
+        if (before & 1)
+        {
+            continue;
+        }
+        memcpy(lastMessage, &slot.m_lastMessage, sizeof(mavlink_message_t));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.m_sequence.load(std::memory_order_relaxed) == before)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MAVLinkMessageStatistics::reset()
+{
+    for (int i = 0; i < s_SlotCount; ++i)
+    {
+        messageSlot &slot = m_slots[i];
+        slot.m_count.store(0, std::memory_order_relaxed);
+        slot.m_bytes.store(0, std::memory_order_relaxed);
+        slot.m_lastUsec.store(0, std::memory_order_relaxed);
+        for (int bin = 0; bin < s_HistogramBins; ++bin)
+        {
+            slot.m_intervals[bin].store(0, std::memory_order_relaxed);
+        }
+    }
+    m_droppedMessages.store(0, std::memory_order_relaxed);
+}
+
+quint64 MAVLinkMessageStatistics::droppedMessages() const
+{
+    return m_droppedMessages.load(std::memory_order_relaxed);
+}
+
+QString MAVLinkMessageStatistics::intervalName(int bin)
+{
+    if (bin <= 0)
+    {
+        return QString("<1 ms");
+    }
+    if (bin >= s_HistogramBins - 1)
+    {
+        return QString(">=%1 ms").arg(1 << (s_HistogramBins - 2));
+    }
+    return QString("%1-%2 ms").arg(1 << (bin - 1)).arg(1 << bin);
+}
@@ -0,0 +1,133 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkMessageStatistics
+ *          Per message statistics of all received MAVLink messages.
+ *
+ */
+
+#ifndef MAVLINKMESSAGESTATISTICS_H
+#define MAVLINKMESSAGESTATISTICS_H
+
+#include <mavlink.h>
+
+#include <QElapsedTimer>
+#include <QScopedArrayPointer>
+#include <QString>
+#include <atomic>
+
+/**
+ * @brief The MAVLinkMessageStatistics class keeps the last message, the number of messages,
+ *        the number of bytes and a histogram of the inter-arrival times for every combination
+ *        of sysid, compid and msgid received.
+ *
+ *        The statistics live in a table of fixed size which is never reallocated. record()
+ *        is lock-free and may be called from any thread, the readers only copy what they
+ *        need. The last message is guarded by a sequence counter per slot, so a reader
+ *        never sees a half written message and a writer never waits.
+ */
+class MAVLinkMessageStatistics
+{
+public:
+    static const int s_SlotCount = 4096;        /// max number of sysid/compid/msgid combinations
+    static const int s_HistogramBins = 12;      /// <1ms, 1-2ms, 2-4ms ... 512-1024ms, >=1024ms
+
+    /**
+     * @brief The messageStatistics struct holds a copy of the statistics of one slot
+     */
+    struct messageStatistics
+    {
+        int sysid = 0;
+        int compid = 0;
+        quint32 msgid = 0;
+        quint64 count = 0;                          /// number of messages received
+        quint64 bytes = 0;                          /// number of bytes received including header and checksum
+        quint64 intervals[s_HistogramBins] = {};    /// inter-arrival time histogram
+    };
+
+    MAVLinkMessageStatistics();
+
+    /**
+     * @brief record adds a received message. Lock-free, may be called from any thread.
+     * @param message - the received message
+     */
+    void record(const mavlink_message_t &message);
+
+    /**
+     * @brief usedSlots delivers the number of slots in use. Slots are used in the
+     *        order of the first reception of their message and are never released.
+     */
+    int usedSlots() const;
+
+    /**
+     * @brief read copies the statistics of a slot
+     * @param index - slot index, 0 <= index < usedSlots()
+     * @param statistics - receives the statistics
+     * @param lastMessage - receives the last message if not nullptr
+     * @return true on success, false if the slot is being set up or the message
+     *         could not be read without tearing
+     */
+    bool read(int index, messageStatistics &statistics, mavlink_message_t *lastMessage) const;
+
+    /**
+     * @brief reset sets all counters to zero. The slots stay assigned.
+     */
+    void reset();
+
+    /**
+     * @brief droppedMessages delivers the number of messages not recorded because the table was full
+     */
+    quint64 droppedMessages() const;
+
+    /**
+     * @brief intervalName delivers the range of a histogram bin like "4-8 ms"
+     */
+    static QString intervalName(int bin);
+
+private:
+    struct messageSlot
+    {
+        std::atomic<quint64> m_key{0};              /// sysid/compid/msgid + 1, 0 if the slot is empty
+        std::atomic<quint64> m_count{0};
+        std::atomic<quint64> m_bytes{0};
+        std::atomic<quint64> m_lastUsec{0};         /// time of the last reception
+        std::atomic<quint64> m_intervals[s_HistogramBins];
+        std::atomic<quint32> m_sequence{0};         /// odd while m_lastMessage is written
+        mavlink_message_t m_lastMessage;
+    };
+
+    /**
+     * @brief findSlot looks up the slot of a message and assigns one if the message is new
+     * @return the slot, nullptr if the table is full
+     */
+    messageSlot *findSlot(quint64 key);
+
+    QScopedArrayPointer<messageSlot> m_slots;
+    QScopedArrayPointer<std::atomic<int> > m_usedSlots;   /// slot index by order of assignment, -1 until set
+    std::atomic<int> m_usedCount{0};
+    std::atomic<quint64> m_droppedMessages{0};
+    QElapsedTimer m_clock;
+};
+
+#endif // MAVLINKMESSAGESTATISTICS_H
@@ -38,7 +38,7 @@ This file is part of the APM_PLANNER project
 #include "mavlink_helpers.h"
 
 #include <cstring>
-#include <QDataStream>
+#include <QtEndian>
 
 MAVLinkProtocol::MAVLinkProtocol()
 {
@@ -55,39 +55,137 @@ void MAVLinkProtocol::sendMessage(mavlink_message_t msg)
     Q_UNUSED(msg)
 }
 
+void MAVLinkProtocol::addLink(LinkInterface *link)
+{
+    QSharedPointer<linkState> state = getLinkState(link);
+
+    // The lambda is called in the thread of the link and must only touch the ring buffer
+    // and the drain flag. Parsing is done in the thread of the protocol. Only one drain is
+    // queued no matter how many chunks arrive in the meantime.
+    connect(link, &LinkInterface::bytesReceived, this, [this, state](LinkInterface *, const QByteArray &data)
+    {
+        state->m_buffer.write(data.constData(), data.size());
+        if (!m_drainScheduled.exchange(true))
+        {
+            QMetaObject::invokeMethod(this, "drainLinkBuffers", Qt::QueuedConnection);
+        }
+    }, Qt::DirectConnection);
+}
+
 void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBytes)
 {
-    static int nonmavlinkCount = 0;
-    static int radioVersionMismatchCount = 0;
-    static bool decodedFirstPacket = false;
-    static bool checkedUserNonMavlink = false;
-    static bool warnedUserNonMavlink = false;
+    QSharedPointer<linkState> state = getLinkState(link);
+    parseBytes(*state, dataBytes.constData(), dataBytes.size());
+}
+
+void MAVLinkProtocol::drainLinkBuffers()
+{
+    // Clear the flag first so bytes arriving while draining schedule a new drain
+    m_drainScheduled.store(false);
+
+    char buffer[4096];
+    // Copy the states as handling a message may remove a link
+    const QList<QSharedPointer<linkState> > states = m_linkStates.values();
+    for (const auto &state : states)
+    {
+        int size = 0;
+        while ((size = state->m_buffer.read(buffer, sizeof(buffer))) > 0)
+        {
+            parseBytes(*state, buffer, size);
+            if (!m_linkStates.contains(state->m_link))
+            {
+                break;  // link was removed while handling a message
+            }
+        }
+
+        const quint64 dropped = state->m_buffer.droppedBytes();
+        if (dropped != state->m_reportedDroppedBytes)
+        {
+            QLOG_WARN() << "MAVLinkProtocol: receive buffer overflow on channel" << state->m_channel
+                        << "dropped" << dropped - state->m_reportedDroppedBytes << "bytes";
+            state->m_reportedDroppedBytes = dropped;
+        }
+    }
+}
+
+void MAVLinkProtocol::linkDestroyed(QObject *link)
+{
+    // The link is already destroyed - only use the pointer as key
+    LinkInterface *key = static_cast<LinkInterface*>(link);
+    QSharedPointer<linkState> state = m_linkStates.take(key);
+    if (!state.isNull())
+    {
+        // The last channel may be shared by several links, so it is never released
+        if (state->m_channel < MAVLINK_COMM_NUM_BUFFERS - 1)
+        {
+            m_usedChannels &= ~(1u << state->m_channel);
+        }
+        QLOG_DEBUG() << "MAVLinkProtocol: Released MAVLink channel" << state->m_channel;
+    }
+}
+
+int MAVLinkProtocol::getLinkChannel(LinkInterface *link) const
+{
+    const QSharedPointer<linkState> state = m_linkStates.value(link);
+    return state.isNull() ? -1 : state->m_channel;
+}
+
+QSharedPointer<MAVLinkProtocol::linkState> MAVLinkProtocol::getLinkState(LinkInterface *link)
+{
+    QSharedPointer<linkState> state = m_linkStates.value(link);
+    if (state.isNull())
+    {
+        // Search the first free channel. MAVLINK_COMM_0 is left to the non _chan pack
+        // functions used for outgoing messages, see getLinkChannel().
+        quint8 channel = MAVLINK_COMM_1;
+        while ((channel < MAVLINK_COMM_NUM_BUFFERS - 1) && (m_usedChannels & (1u << channel)))
+        {
+            ++channel;
+        }
+
+        if (channel == MAVLINK_COMM_NUM_BUFFERS - 1)
+        {
+            QLOG_WARN() << "MAVLinkProtocol: No free MAVLink channel left. Links will share channel" << channel;
+        }
+        m_usedChannels |= (1u << channel);
+
+        mavlink_reset_channel_status(channel);
+        state = QSharedPointer<linkState>(new linkState(link, channel));
+        m_linkStates.insert(link, state);
+        connect(link, &QObject::destroyed, this, &MAVLinkProtocol::linkDestroyed);
+        QLOG_DEBUG() << "MAVLinkProtocol: Using MAVLink channel" << channel << "for link" << link->getId();
+    }
+    return state;
+}
 
+void MAVLinkProtocol::parseBytes(linkState &state, const char *data, int size)
+{
+    LinkInterface *link = state.m_link;
     mavlink_message_t message;
     memset(&message, 0, sizeof(mavlink_message_t));
     mavlink_status_t status;
 
-    //QLOG_DEBUG() << "MAVLinkProtocol received size:" << dataBytes.size() << " " << dataBytes.at(0);
+    //QLOG_DEBUG() << "MAVLinkProtocol received size:" << size << " on channel " << state.m_channel;
 
-    for(const auto &data : dataBytes)
+    for(int i = 0; i < size; ++i)
     {
-        unsigned int decodeState = mavlink_parse_char(MAVLINK_COMM_0, static_cast<quint8>(data), &message, &status);
+        unsigned int decodeState = mavlink_parse_char(state.m_channel, static_cast<quint8>(data[i]), &message, &status);
 
-        if (decodeState == 0 && !decodedFirstPacket)
+        if (decodeState == 0 && !state.m_decodedFirstPacket)
         {
-            nonmavlinkCount++;
-            if (nonmavlinkCount > 2000 && !warnedUserNonMavlink)
+            state.m_nonmavlinkCount++;
+            if (state.m_nonmavlinkCount > 2000 && !state.m_warnedUserNonMavlink)
             {
                 //2000 bytes with no mavlink message. Are we connected to a mavlink capable device?
-                if (!checkedUserNonMavlink)
+                if (!state.m_checkedUserNonMavlink)
                 {
                     link->requestReset();
-                    nonmavlinkCount=0;
-                    checkedUserNonMavlink = true;
+                    state.m_nonmavlinkCount=0;
+                    state.m_checkedUserNonMavlink = true;
                 }
                 else
                 {
-                    warnedUserNonMavlink = true;
+                    state.m_warnedUserNonMavlink = true;
                     emit protocolStatusMessage("MAVLink Baud Rate or Version Mismatch", "Please check if the baud rates of APM Planner and your autopilot are the same.");
                 }
             }
@@ -95,15 +193,15 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
 
         if (decodeState == 1)
         {
-            mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(MAVLINK_COMM_0);
-            if (!decodedFirstPacket)
+            mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(state.m_channel);
+            if (!state.m_decodedFirstPacket)
             {
-                decodedFirstPacket = true;
+                state.m_decodedFirstPacket = true;
 
                 if (mavlinkStatus->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)
                 {
                     QLOG_INFO() << "First Mavlink message is version 1.0. Using mavlink 1.0 and ask for mavlink 2.0 capability";
-                    mavlink_set_proto_version(MAVLINK_COMM_0, 1);
+                    mavlink_set_proto_version(state.m_channel, 1);
 
                     // Request AUTOPILOT_VERSION message to check if vehicle is mavlink 2.0 capable
                     mavlink_command_long_t command;
@@ -112,7 +210,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
                     command.command = MAV_CMD_REQUEST_AUTOPILOT_CAPABILITIES;
                     command.param1 = 1.0f;
 
-                    mavlink_msg_command_long_encode(message.sysid, message.compid, &commandMessage, &command);
+                    mavlink_msg_command_long_encode_chan(message.sysid, message.compid, state.m_channel, &commandMessage, &command);
                     // Write message into buffer, prepending start sign
                     int len = mavlink_msg_to_send_buffer(sendbuffer, &commandMessage);
                     link->writeBytes(reinterpret_cast<const char*>(sendbuffer), len);
@@ -121,7 +219,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
                     command.command = MAV_CMD_REQUEST_MESSAGE;
                     command.param1 = MAVLINK_MSG_ID_AUTOPILOT_VERSION;
 
-                    mavlink_msg_command_long_encode(message.sysid, message.compid, &commandMessage, &command);
+                    mavlink_msg_command_long_encode_chan(message.sysid, message.compid, state.m_channel, &commandMessage, &command);
                     // Write message into buffer, prepending start sign
                     len = mavlink_msg_to_send_buffer(sendbuffer, &commandMessage);
                     link->writeBytes(reinterpret_cast<const char*>(sendbuffer), len);
@@ -129,7 +227,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
                 else
                 {
                     QLOG_INFO() << "First Mavlink message is version 2.0. Using Mavlink 2.0 for communication";
-                    mavlink_set_proto_version(MAVLINK_COMM_0, 2);
+                    mavlink_set_proto_version(state.m_channel, 2);
                 }
             }
 
@@ -137,7 +235,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
             if (!(mavlinkStatus->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1) && (mavlinkStatus->flags & MAVLINK_STATUS_FLAG_OUT_MAVLINK1))
             {
                 QLOG_DEBUG() << "Switching outbound to mavlink 2.0 due to incoming mavlink 2.0 packet:" << mavlinkStatus << link->getId() << mavlinkStatus->flags;
-                mavlink_set_proto_version(MAVLINK_COMM_0, 2);
+                mavlink_set_proto_version(state.m_channel, 2);
             }
 
             if(message.msgid == MAVLINK_MSG_ID_AUTOPILOT_VERSION)
@@ -147,12 +245,12 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
                 if(version.capabilities & MAV_PROTOCOL_CAPABILITY_MAVLINK2)
                 {
                     QLOG_INFO() << "Vehicle reports mavlink 2.0 capability. Using Mavlink 2.0 for communication";
-                    mavlink_set_proto_version(MAVLINK_COMM_0, 2);
+                    mavlink_set_proto_version(state.m_channel, 2);
                 }
                 else
                 {
                     QLOG_INFO() << "Vehicle reports mavlink 1.0 capability. Using Mavlink 1.0 for communication";
-                    mavlink_set_proto_version(MAVLINK_COMM_0, 1);
+                    mavlink_set_proto_version(state.m_channel, 1);
                 }
             }
 
@@ -164,7 +262,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
                 if(!ping.target_system && !ping.target_component && m_isOnline)
                 {
                     mavlink_message_t msg;
-                    mavlink_msg_ping_pack(m_systemID, m_componentID, &msg, ping.time_usec, ping.seq, message.sysid, message.compid);
+                    mavlink_msg_ping_pack_chan(m_systemID, m_componentID, state.m_channel, &msg, ping.time_usec, ping.seq, message.sysid, message.compid);
                     sendMessage(msg);
                 }
             }
@@ -206,43 +304,29 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray &dataBy
                         && !(mavlinkStatus->flags & MAVLINK_STATUS_FLAG_OUT_MAVLINK1))
                 {
 
-                    radioVersionMismatchCount++;
+                    state.m_radioVersionMismatchCount++;
                 }
             }
 
-            if (radioVersionMismatchCount == 5)
+            if (state.m_radioVersionMismatchCount == 5)
             {
                 // Warn the user if the radio continues to send v1 while the link uses v2
                 emit protocolStatusMessage(tr("MAVLink Protocol"), tr("Detected radio still using MAVLink v1.0 on a link with MAVLink v2.0 enabled. Please upgrade the radio firmware."));
                 // Ensure the warning can't get stuck
-                radioVersionMismatchCount++;
+                state.m_radioVersionMismatchCount++;
                 // Flick link back to v1
                 QLOG_DEBUG() << "Switching outbound to mavlink 1.0 due to incoming mavlink 1.0 packet:" << mavlinkStatus << link->getId() << mavlinkStatus->flags;
-                mavlink_set_proto_version(MAVLINK_COMM_0, 1);
+                mavlink_set_proto_version(state.m_channel, 1);
             }
 
-            // Log data
-            if (m_loggingEnabled && !m_ScopedLogfilePtr.isNull())
+            // Log data - the frame is only queued, the writer thread does the disk access
+            if (m_loggingEnabled && !m_tlogWriterPtr.isNull())
             {
-                quint64 time = QGC::groundTimeUsecs();
-                uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-
-                QDataStream outStream(m_ScopedLogfilePtr.data());
-                outStream.setByteOrder(QDataStream::BigEndian);
-                outStream << time; // write time stamp
+                uint8_t frame[sizeof(quint64) + MAVLINK_MAX_PACKET_LEN];
+                qToBigEndian<quint64>(QGC::groundTimeUsecs(), &frame[0]);   // time stamp
 
-                // write decoded message into buffer and buffer to disk
-                int len = mavlink_msg_to_send_buffer(&buffer[0], &message);
-                int bytesWritten = outStream.writeRawData(reinterpret_cast<const char*>(&buffer[0]), len);
-
-                if(bytesWritten != len)
-                {
-                    emit protocolStatusMessage(tr("MAVLink Logging failed"),
-                                               tr("Could not write to file %1, disabling logging.")
-                                               .arg(m_ScopedLogfilePtr->fileName()));
-                    // Stop logging
-                    stopLogging();
-                }
+                int len = mavlink_msg_to_send_buffer(&frame[sizeof(quint64)], &message);
+                m_tlogWriterPtr->writeFrame(reinterpret_cast<const char*>(&frame[0]), static_cast<int>(sizeof(quint64)) + len);
             }
 
             if (m_isOnline)
@@ -395,40 +479,64 @@ void MAVLinkProtocol::handleMessage(LinkInterface *link, const mavlink_message_t
 
 void MAVLinkProtocol::stopLogging()
 {
-    if (!m_ScopedLogfilePtr.isNull() && m_ScopedLogfilePtr->isOpen())
+    if (!m_tlogWriterPtr.isNull())
     {
-        QLOG_DEBUG() << "Stop MAVLink logging" << m_ScopedLogfilePtr->fileName();
-        // Close the current open file
-        m_ScopedLogfilePtr->close();
-        m_ScopedLogfilePtr.reset();
+        QLOG_DEBUG() << "Stop MAVLink logging" << m_tlogWriterPtr->fileName();
+        // Writes all queued frames and closes the current open file
+        m_tlogWriterPtr->close();
+        m_tlogWriterPtr.reset();
     }
     m_loggingEnabled = false;
 }
 
 bool MAVLinkProtocol::startLogging(const QString& filename)
 {
-    if (!m_ScopedLogfilePtr.isNull() && m_ScopedLogfilePtr->isOpen())
+    if (!m_tlogWriterPtr.isNull())
     {
         return true;
     }
     stopLogging();
     QLOG_DEBUG() << "Start MAVLink logging" << filename;
 
-    m_ScopedLogfilePtr.reset(new QFile(filename));
-    if (m_ScopedLogfilePtr->open(QIODevice::WriteOnly | QIODevice::Append))
+    m_tlogWriterPtr.reset(new TLogWriter(filename));
+    connect(m_tlogWriterPtr.data(), SIGNAL(writeFailed(QString)), this, SLOT(loggingFailed(QString)), Qt::QueuedConnection);
+    connect(m_tlogWriterPtr.data(), SIGNAL(statisticsChanged(quint64,quint64)), this, SLOT(loggingStatistics(quint64,quint64)), Qt::QueuedConnection);
+    if (m_tlogWriterPtr->open())
     {
          m_loggingEnabled = true;
+         m_warnedDroppedFrames = false;
     }
     else
     {
         emit protocolStatusMessage(tr("Started MAVLink logging"),
-                                   tr("FAILED: MAVLink cannot start logging to.").arg(m_ScopedLogfilePtr->fileName()));
+                                   tr("FAILED: MAVLink cannot start logging to %1.").arg(m_tlogWriterPtr->fileName()));
         m_loggingEnabled = false;
-        m_ScopedLogfilePtr.reset();
+        m_tlogWriterPtr.reset();
     }
     return m_loggingEnabled; // reflects if logging started or not.
 }
 
+void MAVLinkProtocol::loggingFailed(const QString &fileName)
+{
+    emit protocolStatusMessage(tr("MAVLink Logging failed"),
+                               tr("Could not write to file %1, disabling logging.").arg(fileName));
+    // Stop logging
+    stopLogging();
+}
+
+void MAVLinkProtocol::loggingStatistics(quint64 queuedFrames, quint64 droppedFrames)
+{
+    if (droppedFrames > 0 && !m_warnedDroppedFrames && !m_tlogWriterPtr.isNull())
+    {
+        m_warnedDroppedFrames = true;
+        QLOG_WARN() << "MAVLinkProtocol: tlog writer dropped" << droppedFrames << "frames";
+        emit protocolStatusMessage(tr("MAVLink Logging"),
+                                   tr("The disk is too slow to record all MAVLink messages. %1 messages are missing in %2.")
+                                   .arg(droppedFrames).arg(m_tlogWriterPtr->fileName()));
+    }
+    emit loggingStatisticsChanged(queuedFrames, droppedFrames);
+}
+
 quint64 MAVLinkProtocol::getTotalMessagesReceived(int mavLinkID) const
 {
     quint64 result = 0;
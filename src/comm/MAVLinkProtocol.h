@@ -40,12 +40,17 @@ This file is part of the APM_PLANNER project
 #include <mavlink.h>
 
 #include "LinkInterface.h"
+#include "LinkByteRingBuffer.h"
+#include "TLogWriter.h"
 #include "QGC.h"
 #include "configuration.h"
 
 #include <QFile>
 #include <QByteArray>
 #include <QMap>
+#include <QHash>
+#include <QSharedPointer>
+#include <atomic>
 
 class LinkManager;
 class MAVLinkProtocol : public QObject
@@ -75,19 +80,102 @@ public:
      * \return - Number of lost messages
      */
     quint64 getTotalMessagesLost(int mavLinkID) const;
+    /*!
+     * \brief addLink - Registers a link at the protocol. The link gets its own MAVLink
+     *        channel and its received bytes are handed over to the protocol using a
+     *        lock free ring buffer instead of a queued signal per received chunk.
+     * \param link - the link to add
+     */
+    void addLink(LinkInterface *link);
+    /*!
+     * \brief getLinkChannel - delivers the MAVLink channel of a link. Outgoing messages
+     *        must be framed on this channel to use the MAVLink version detected for the link.
+     * \param link - the link
+     * \return - the channel, -1 if the link is unknown
+     */
+    int getLinkChannel(LinkInterface *link) const;
 
 public slots:
     void receiveBytes(LinkInterface* link, const QByteArray &dataBytes);
 
+private slots:
+    /*!
+     * \brief drainLinkBuffers - Parses all bytes waiting in the ring buffers of the links.
+     */
+    void drainLinkBuffers();
+
+    /*!
+     * \brief linkDestroyed - Releases the channel of a deleted link.
+     * \param link - the deleted link
+     */
+    void linkDestroyed(QObject *link);
+
+    /*!
+     * \brief loggingFailed - Stops logging after the tlog writer failed to write.
+     * \param fileName - name of the tlog
+     */
+    void loggingFailed(const QString &fileName);
+
+    /*!
+     * \brief loggingStatistics - Forwards the counters of the tlog writer and warns
+     *        once per tlog if frames had to be dropped.
+     * \param queuedFrames - frames accepted for writing
+     * \param droppedFrames - frames dropped because the disk was too slow
+     */
+    void loggingStatistics(quint64 queuedFrames, quint64 droppedFrames);
+
 private:
+    static constexpr int s_LinkBufferSize = 256 * 1024;    /// Size of the ring buffer of every link
+
+    /*!
+     * \brief The linkState struct holds everything needed to parse the byte stream of one link.
+     *        The parsing state of the MAVLink library is held per channel, so every link
+     *        needs its own channel to not corrupt the messages of other links.
+     */
+    struct linkState
+    {
+        explicit linkState(LinkInterface *link, quint8 channel) : m_link(link), m_channel(channel) {}
+
+        LinkInterface *m_link;                  /// the link the bytes are received from
+        quint8 m_channel;                       /// MAVLink channel used for parsing
+        int m_nonmavlinkCount = 0;              /// bytes received without a valid message
+        int m_radioVersionMismatchCount = 0;    /// radio status messages with the wrong version
+        bool m_decodedFirstPacket = false;      /// true if a valid message was received
+        bool m_checkedUserNonMavlink = false;   /// true if the link was reset due to invalid data
+        bool m_warnedUserNonMavlink = false;    /// true if user was warned about invalid data
+        LinkByteRingBuffer m_buffer{s_LinkBufferSize};  /// bytes received by the link but not parsed yet
+        quint64 m_reportedDroppedBytes = 0;     /// dropped bytes already reported in log
+    };
+
+    /*!
+     * \brief getLinkState - delivers the state of a link. Creates a new state
+     *        and allocates a channel if the link is unknown.
+     * \param link - the link
+     * \return - pointer to the state of the link
+     */
+    QSharedPointer<linkState> getLinkState(LinkInterface *link);
+
+    /*!
+     * \brief parseBytes - Parses received bytes using the channel of the link
+     * \param state - state of the link the bytes belong to
+     * \param data - pointer to the received bytes
+     * \param size - number of bytes
+     */
+    void parseBytes(linkState &state, const char *data, int size);
+
     void handleMessage(LinkInterface *link, const mavlink_message_t &message);
 
+    QHash<LinkInterface*, QSharedPointer<linkState> > m_linkStates;    /// State of all known links
+    quint32 m_usedChannels = 0;                     /// Bitmask of the MAVLink channels in use
+    std::atomic<bool> m_drainScheduled{false};      /// true if drainLinkBuffers() is already queued
+
     quint8 m_systemID    = QGC::defaultMavlinkSystemId;
     quint8 m_componentID = QGC::defaultComponentId;
 
     bool m_isOnline = true;
     bool m_loggingEnabled = true;
-    QScopedPointer<QFile>m_ScopedLogfilePtr;
+    QScopedPointer<TLogWriter> m_tlogWriterPtr;     /// writes the tlog in its own thread
+    bool m_warnedDroppedFrames = false;             /// true if the user was warned about dropped tlog frames
 
     bool m_throwAwayGCSPackets = false;
     LinkManager *m_connectionManager = nullptr;
@@ -105,6 +193,12 @@ signals:
     void protocolStatusMessage(const QString& title, const QString& message);
     void receiveLossChanged(int id,float value);
     void messageReceived(LinkInterface *link,mavlink_message_t message);
+    /*!
+     * \brief loggingStatisticsChanged - emitted regulary while logging
+     * \param queuedFrames - frames recorded in the current tlog
+     * \param droppedFrames - frames which could not be recorded because the disk was too slow
+     */
+    void loggingStatisticsChanged(quint64 queuedFrames, quint64 droppedFrames);
 };
 
 #endif // NEW_MAVLINKPARSER_H
@@ -0,0 +1,319 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkRouter
+ *          Forwards MAVLink frames between links.
+ *
+ */
+
+#include "MAVLinkRouter.h"
+#include "logging.h"
+
+#include <QThread>
+#include <cstring>
+
+namespace
+{
+/*!
+ * \brief frameBytes - Writes a received frame as it was on the wire. Unlike
+ *        mavlink_msg_to_send_buffer() the payload is not trimmed, so the
+ *        received checksum and signature stay valid.
+ * \param message - the received frame
+ * \param buffer - at least MAVLINK_MAX_PACKET_LEN bytes
+ * \return - length of the frame
+ */
+int frameBytes(const mavlink_message_t &message, uint8_t *buffer)
+{
+    int length = 0;
+    buffer[length++] = message.magic;
+    buffer[length++] = message.len;
+    if (message.magic != MAVLINK_STX_MAVLINK1)
+    {
+        buffer[length++] = message.incompat_flags;
+        buffer[length++] = message.compat_flags;
+    }
+    buffer[length++] = message.seq;
+    buffer[length++] = message.sysid;
+    buffer[length++] = message.compid;
+    buffer[length++] = message.msgid & 0xFF;
+    if (message.magic != MAVLINK_STX_MAVLINK1)
+    {
+        buffer[length++] = (message.msgid >> 8) & 0xFF;
+        buffer[length++] = (message.msgid >> 16) & 0xFF;
+    }
+    memcpy(&buffer[length], _MAV_PAYLOAD(&message), message.len);
+    length += message.len;
+    buffer[length++] = message.ck[0];
+    buffer[length++] = message.ck[1];
+    if ((message.magic != MAVLINK_STX_MAVLINK1) && (message.incompat_flags & MAVLINK_IFLAG_SIGNED))
+    {
+        memcpy(&buffer[length], message.signature, MAVLINK_SIGNATURE_BLOCK_LEN);
+        length += MAVLINK_SIGNATURE_BLOCK_LEN;
+    }
+    return length;
+}
+}
+
+bool MAVLinkRouter::routeState::takeToken()
+{
+    if (m_route.maxRate <= 0)
+    {
+        return true;
+    }
+
+    // Refill with maxRate tokens per second, at most one second worth of frames
+    if (!m_refillTimer.isValid())
+    {
+        m_refillTimer.start();
+        m_tokens = m_route.maxRate;
+    }
+    else
+    {
+        m_tokens += static_cast<double>(m_refillTimer.restart()) * m_route.maxRate / 1000.0;
+        if (m_tokens > m_route.maxRate)
+        {
+            m_tokens = m_route.maxRate;
+        }
+    }
+
+    if (m_tokens < 1.0)
+    {
+        return false;
+    }
+    m_tokens -= 1.0;
+    return true;
+}
+
+MAVLinkRouter::MAVLinkRouter(QObject *parent) :
+    QObject(parent)
+{
+}
+
+MAVLinkRouter::~MAVLinkRouter()
+{
+    QWriteLocker locker(&m_lock);
+    m_routes.clear();
+    m_linkStates.clear();
+    m_linksById.clear();
+}
+
+void MAVLinkRouter::addLink(LinkInterface *link)
+{
+    QSharedPointer<linkState> state(new linkState(link));
+    {
+        QWriteLocker locker(&m_lock);
+        if (m_linkStates.contains(link))
+        {
+            return;
+        }
+        m_linkStates.insert(link, state);
+        m_linksById.insert(state->m_linkId, link);
+        updateLinkRoutes();
+    }
+
+    // Called in the thread of the link, which may not be the thread of the router
+    connect(link, &LinkInterface::bytesReceived, this, [this, state](LinkInterface *, const QByteArray &data)
+    {
+        routeBytes(*state, data);
+    }, Qt::DirectConnection);
+}
+
+void MAVLinkRouter::removeLink(LinkInterface *link)
+{
+    disconnect(link, &LinkInterface::bytesReceived, this, nullptr);
+
+    // Waits until the link and all other links finished forwarding
+    QWriteLocker locker(&m_lock);
+    QSharedPointer<linkState> state = m_linkStates.take(link);
+    if (state.isNull())
+    {
+        return;
+    }
+    m_linksById.remove(state->m_linkId);
+    state->m_routes.clear();
+    updateLinkRoutes();
+}
+
+int MAVLinkRouter::addRoute(const Route &route)
+{
+    if ((route.sourceLinkId < 0) || (route.targetLinkId < 0) || (route.sourceLinkId == route.targetLinkId))
+    {
+        QLOG_WARN() << "MAVLinkRouter: Invalid route from link" << route.sourceLinkId << "to link" << route.targetLinkId;
+        return -1;
+    }
+
+    int routeId = -1;
+    {
+        QWriteLocker locker(&m_lock);
+        routeId = m_nextRouteId++;
+        m_routes.insert(routeId, QSharedPointer<routeState>(new routeState(route)));
+        updateLinkRoutes();
+    }
+    QLOG_INFO() << "MAVLinkRouter: Forwarding link" << route.sourceLinkId << "to link" << route.targetLinkId
+                << "sysid:" << route.sysid << "compid:" << route.compid << "max rate:" << route.maxRate;
+    emit routesChanged();
+    return routeId;
+}
+
+bool MAVLinkRouter::removeRoute(int routeId)
+{
+    {
+        QWriteLocker locker(&m_lock);
+        if (m_routes.remove(routeId) == 0)
+        {
+            return false;
+        }
+        updateLinkRoutes();
+    }
+    emit routesChanged();
+    return true;
+}
+
+void MAVLinkRouter::removeAllRoutes()
+{
+    {
+        QWriteLocker locker(&m_lock);
+        if (m_routes.isEmpty())
+        {
+            return;
+        }
+        m_routes.clear();
+        updateLinkRoutes();
+    }
+    emit routesChanged();
+}
+
+QList<int> MAVLinkRouter::getRoutes() const
+{
+    QReadLocker locker(&m_lock);
+    return m_routes.keys();
+}
+
+MAVLinkRouter::Route MAVLinkRouter::getRoute(int routeId) const
+{
+    QReadLocker locker(&m_lock);
+    QSharedPointer<routeState> state = m_routes.value(routeId);
+    return state.isNull() ? Route() : state->m_route;
+}
+
+MAVLinkRouter::RouteStatistics MAVLinkRouter::getStatistics(int routeId) const
+{
+    RouteStatistics statistics;
+    QReadLocker locker(&m_lock);
+    QSharedPointer<routeState> state = m_routes.value(routeId);
+    if (!state.isNull())
+    {
+        statistics.forwardedFrames = state->m_forwardedFrames.load();
+        statistics.forwardedBytes = state->m_forwardedBytes.load();
+        statistics.droppedFrames = state->m_droppedFrames.load();
+    }
+    return statistics;
+}
+
+void MAVLinkRouter::updateLinkRoutes()
+{
+    for (const auto &state : m_linkStates)
+    {
+        state->m_routes.clear();
+    }
+    for (const auto &route : m_routes)
+    {
+        route->m_target = m_linksById.value(route->m_route.targetLinkId, nullptr);
+        LinkInterface *source = m_linksById.value(route->m_route.sourceLinkId, nullptr);
+        if (source != nullptr)
+        {
+            m_linkStates.value(source)->m_routes.append(route);
+        }
+    }
+}
+
+void MAVLinkRouter::routeBytes(linkState &state, const QByteArray &data)
+{
+    QReadLocker locker(&m_lock);
+    if (state.m_routes.isEmpty())
+    {
+        return;     // Nothing to forward - do not even split the frames
+    }
+
+    // Frames for links which must be written in their own thread
+    QHash<LinkInterface*, QByteArray> queuedFrames;
+    QThread *currentThread = QThread::currentThread();
+
+    mavlink_message_t message;
+    mavlink_status_t status;
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+
+    for (int i = 0; i < data.size(); ++i)
+    {
+        if (mavlink_frame_char_buffer(&state.m_rxMessage, &state.m_rxStatus, static_cast<uint8_t>(data[i]),
+                                      &message, &status) != MAVLINK_FRAMING_OK)
+        {
+            continue;
+        }
+
+        int frameLength = 0;
+        for (const auto &route : state.m_routes)
+        {
+            LinkInterface *target = route->m_target;
+            if ((target == nullptr) || !target->isConnected())
+            {
+                continue;
+            }
+            if ((route->m_route.sysid != 0) && (route->m_route.sysid != message.sysid))
+            {
+                continue;
+            }
+            if ((route->m_route.compid != 0) && (route->m_route.compid != message.compid))
+            {
+                continue;
+            }
+            if (!route->takeToken())
+            {
+                ++route->m_droppedFrames;
+                continue;
+            }
+
+            if (frameLength == 0)
+            {
+                frameLength = frameBytes(message, frame);
+            }
+            if (target->isWriteThreadSafe() || (target->thread() == currentThread))
+            {
+                target->writeBytes(reinterpret_cast<const char*>(frame), frameLength);
+            }
+            else
+            {
+                queuedFrames[target].append(reinterpret_cast<const char*>(frame), frameLength);
+            }
+            ++route->m_forwardedFrames;
+            route->m_forwardedBytes += static_cast<quint64>(frameLength);
+        }
+    }
+
+    // Invoked on the link itself, so nothing is written if it is deleted in the meantime
+    for (auto iter = queuedFrames.constBegin(); iter != queuedFrames.constEnd(); ++iter)
+    {
+        QMetaObject::invokeMethod(iter.key(), "writeByteArray", Qt::QueuedConnection, Q_ARG(QByteArray, iter.value()));
+    }
+}
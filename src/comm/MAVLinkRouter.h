@@ -0,0 +1,208 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkRouter
+ *          Forwards MAVLink frames between links, so APM Planner can be the hub
+ *          for secondary consumers like antenna trackers or companion loggers.
+ *
+ */
+
+#ifndef MAVLINKROUTER_H
+#define MAVLINKROUTER_H
+
+#include <mavlink.h>
+
+#include "LinkInterface.h"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <atomic>
+
+/**
+ * @brief The MAVLinkRouter class forwards the frames received on one link to other links.
+ *
+ *        The frames are split off the byte stream in the thread the link receives its
+ *        data in, using a framing state of its own per link, so no MAVLink channel is
+ *        needed and the GUI thread is not involved for links with a thread of their own.
+ *        A frame is forwarded with its original bytes - sequence number, checksum and
+ *        signature are left as received.
+ *
+ *        Links with a thread safe writeBytes() are written directly. Frames for other
+ *        links are collected per received chunk and handed over to the thread the
+ *        target link object lives in by a queued LinkInterface::writeByteArray() call,
+ *        so forwarding needs no event loop and no lock of the router.
+ */
+class MAVLinkRouter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /*!
+     * \brief The Route struct describes which frames are forwarded from one link to another.
+     *        A route is one way, forwarding both directions needs two routes.
+     */
+    struct Route
+    {
+        int sourceLinkId = -1;      /// id of the link the frames are received on
+        int targetLinkId = -1;      /// id of the link the frames are forwarded to
+        int sysid = 0;              /// system id of the sender to forward, 0 for all
+        int compid = 0;             /// component id of the sender to forward, 0 for all
+        int maxRate = 0;            /// max frames per second, 0 for unlimited
+    };
+
+    /*!
+     * \brief The RouteStatistics struct holds the counters of one route
+     */
+    struct RouteStatistics
+    {
+        quint64 forwardedFrames = 0;    /// frames written to the target link
+        quint64 forwardedBytes = 0;     /// bytes written to the target link
+        quint64 droppedFrames = 0;      /// frames dropped by the rate limit
+    };
+
+    explicit MAVLinkRouter(QObject *parent = nullptr);
+    ~MAVLinkRouter() override;
+
+    /*!
+     * \brief addLink - Registers a link. Its received frames are forwarded as soon as
+     *        a route with this link as source exists.
+     * \param link - the link to add
+     */
+    void addLink(LinkInterface *link);
+
+    /*!
+     * \brief removeLink - Unregisters a link. Must be called before the link is deleted.
+     *        The routes of the link are kept and used again if a link with the
+     *        same id is added.
+     * \param link - the link to remove
+     */
+    void removeLink(LinkInterface *link);
+
+    /*!
+     * \brief addRoute - Adds a route
+     * \param route - the route to add
+     * \return - id of the new route, -1 if the route is invalid
+     */
+    int addRoute(const Route &route);
+
+    /*!
+     * \brief removeRoute - Removes a route
+     * \param routeId - id of the route
+     * \return - true if the route was removed, false if it is unknown
+     */
+    bool removeRoute(int routeId);
+
+    /*!
+     * \brief removeAllRoutes - Removes all routes
+     */
+    void removeAllRoutes();
+
+    /*!
+     * \brief getRoutes - delivers the ids of all routes
+     */
+    QList<int> getRoutes() const;
+
+    /*!
+     * \brief getRoute - delivers a route
+     * \param routeId - id of the route
+     * \return - the route, a default route if routeId is unknown
+     */
+    Route getRoute(int routeId) const;
+
+    /*!
+     * \brief getStatistics - delivers the counters of a route
+     * \param routeId - id of the route
+     * \return - the counters, all zero if routeId is unknown
+     */
+    RouteStatistics getStatistics(int routeId) const;
+
+signals:
+    void routesChanged();
+
+private:
+    /*!
+     * \brief The routeState struct holds a route and its rate limit and counters.
+     *        The rate limit is only touched in the thread of the source link.
+     */
+    struct routeState
+    {
+        explicit routeState(const Route &route) : m_route(route) {}
+
+        /*!
+         * \brief takeToken - Token bucket rate limit
+         * \return - true if the frame may be forwarded
+         */
+        bool takeToken();
+
+        Route m_route;
+        LinkInterface *m_target = nullptr;          /// target link, nullptr if not registered
+        double m_tokens = 0.0;                      /// frames which may be forwarded right now
+        QElapsedTimer m_refillTimer;                /// time since the last refill of m_tokens
+        std::atomic<quint64> m_forwardedFrames{0};
+        std::atomic<quint64> m_forwardedBytes{0};
+        std::atomic<quint64> m_droppedFrames{0};
+    };
+
+    /*!
+     * \brief The linkState struct holds the framing state of one link and the routes
+     *        starting at it. The framing state is only touched in the thread of the link.
+     */
+    struct linkState
+    {
+        explicit linkState(LinkInterface *link) : m_link(link), m_linkId(link->getId()) {}
+
+        LinkInterface *m_link;                          /// the link the frames are received on
+        int m_linkId;                                   /// id of m_link, valid after its deletion
+        mavlink_message_t m_rxMessage{};                /// frame being received
+        mavlink_status_t m_rxStatus{};                  /// framing state
+        QList<QSharedPointer<routeState> > m_routes;    /// routes with this link as source
+    };
+
+    /*!
+     * \brief routeBytes - Splits the received bytes into frames and forwards them.
+     *        Called in the thread of the link.
+     * \param state - state of the link the bytes were received on
+     * \param data - the received bytes
+     */
+    void routeBytes(linkState &state, const QByteArray &data);
+
+    /*!
+     * \brief updateLinkRoutes - Assigns the routes to the links. m_lock must be locked for writing.
+     */
+    void updateLinkRoutes();
+
+    mutable QReadWriteLock m_lock;                              /// protects everything below
+    QHash<LinkInterface*, QSharedPointer<linkState> > m_linkStates;
+    QHash<int, LinkInterface*> m_linksById;
+    QMap<int, QSharedPointer<routeState> > m_routes;            /// all routes by id
+    int m_nextRouteId = 0;
+};
+
+#endif // MAVLINKROUTER_H
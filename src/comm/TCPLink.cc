@@ -168,23 +168,22 @@ void TCPLink::writeBytes(const char* data, qint64 size)
  **/
 void TCPLink::readBytes()
 {
-    qint64 byteCount = _socket->bytesAvailable();
-
-    if (byteCount)
-    {
-        QByteArray buffer;
-        buffer.resize(byteCount);
+    if (!_socket)
+        return;
 
-        _socket->read(buffer.data(), buffer.size());
+    // Take over the whole read buffer of the socket at once
+    const QByteArray buffer = _socket->readAll();
 
+    if (!buffer.isEmpty())
+    {
         emit bytesReceived(this, buffer);
 
         // Log the amount and time received for future data rate calculations.
         QMutexLocker dataRateLocker(&dataRateMutex);
-        logDataRateToBuffer(inDataWriteAmounts, inDataWriteTimes, &inDataIndex, byteCount, QDateTime::currentMSecsSinceEpoch());
+        logDataRateToBuffer(inDataWriteAmounts, inDataWriteTimes, &inDataIndex, buffer.size(), QDateTime::currentMSecsSinceEpoch());
 
 #ifdef TCPLINK_READWRITE_DEBUG
-        writeDebugBytes(buffer.data(), buffer.size());
+        _writeDebugBytes(buffer.data(), buffer.size());
 #endif
     }
 }
@@ -262,6 +261,8 @@ void TCPLink::newConnection()
         return;
 
     qDebug() << _hostAddress.toString() << ": new connection";
+    // MAVLink packets are small, do not let Nagle hold them back
+    _socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
 
     QObject::connect(_socket, SIGNAL(readyRead()), this, SLOT(readBytes()));
     QObject::connect(_socket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(_socketError(QAbstractSocket::SocketError)));
@@ -316,6 +317,8 @@ bool TCPLink::_hardwareConnect(void)
             _socket = NULL;
             return false;
         }
+        // MAVLink packets are small, do not let Nagle hold them back
+        _socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
 
         emit connected(true);
         emit connected();
@@ -8,13 +8,18 @@
 #include <QDebug>
 #include <QDateTime>
 #include <QFile>
+#include <QtEndian>
+
+#include <algorithm>
 
 TLogReplayLink::TLogReplayLink(QObject *parent) :
     LinkInterface(),
     m_toBeDeleted(false),
     m_threadRun(false),
-    m_speedVar(50),
-    m_posVar(0),
+    m_speedVar(100),
+    m_seekIndex(s_NoSeek),
+    m_stepRequests(0),
+    m_pause(false),
     m_mavlinkDecoder(new MAVLinkDecoder()),
     m_mavlinkInspector(NULL)
 {
@@ -79,24 +84,47 @@ void TLogReplayLink::setSpeed(int speed)
     m_speedVar = speed;
     m_variableAccessMutex.unlock();
 }
-void TLogReplayLink::setPosition(qint64 pos)
+void TLogReplayLink::setPosition(qint64 msec)
 {
-    m_variableAccessMutex.lock();
-    m_posVar = pos;
-    m_variableAccessMutex.unlock();
+    QMutexLocker lock(&m_variableAccessMutex);
+    if (!m_index.isEmpty())
+    {
+        m_seekIndex = findPacket(m_index.first().m_timeUsec + static_cast<quint64>(qMax<qint64>(msec, 0)) * 1000);
+    }
+}
+
+void TLogReplayLink::seekToTime(quint64 timeUsec)
+{
+    QMutexLocker lock(&m_variableAccessMutex);
+    m_seekIndex = findPacket(timeUsec);
+}
+
+void TLogReplayLink::stepForward()
+{
+    QMutexLocker lock(&m_variableAccessMutex);
+    ++m_stepRequests;
+}
+
+void TLogReplayLink::stepBackward()
+{
+    QMutexLocker lock(&m_variableAccessMutex);
+    --m_stepRequests;
 }
 
 void TLogReplayLink::play()
 {
+    QMutexLocker lock(&m_variableAccessMutex);
     m_pause = false;
 }
 
 void TLogReplayLink::pause()
 {
+    QMutexLocker lock(&m_variableAccessMutex);
     m_pause = true;
 }
 bool TLogReplayLink::isPaused()
 {
+    QMutexLocker lock(&m_variableAccessMutex);
     return m_pause;
 }
 void TLogReplayLink::setMavlinkDecoder(MAVLinkDecoder *decoder)
@@ -108,203 +136,258 @@ void TLogReplayLink::setMavlinkInspector(QGCMAVLinkInspector *inspector)
     m_mavlinkInspector = inspector;
 }
 
+int TLogReplayLink::packetSize(const uchar *data, qint64 available)
+{
+    if ((available >= MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1) && (data[0] == MAVLINK_STX_MAVLINK1))
+    {
+        return MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 + data[1] + MAVLINK_NUM_CHECKSUM_BYTES;
+    }
+    if ((available >= MAVLINK_CORE_HEADER_LEN + 1) && (data[0] == MAVLINK_STX))
+    {
+        const int signature = (data[2] & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+        return MAVLINK_CORE_HEADER_LEN + 1 + data[1] + MAVLINK_NUM_CHECKSUM_BYTES + signature;
+    }
+    return 0;
+}
+
+QVector<TLogReplayLink::packetIndex> TLogReplayLink::buildIndex(const uchar *data, qint64 size)
+{
+    static const int timeStampSize = static_cast<int>(sizeof(quint64));
+
+    // The packet count is not known before scanning. Reserving by file size would allocate
+    // far more than needed for logs with long packets, so the vector just grows.
+    QVector<packetIndex> index;
+
+    quint64 lastTime = 0;
+    qint64 pos = 0;
+    while (pos + timeStampSize < size)
+    {
+        const qint64 packetPos = pos + timeStampSize;
+        const int length = packetSize(data + packetPos, size - packetPos);
+        const qint64 nextPos = packetPos + length;
+
+        // A valid packet is followed by the time stamp of the next one or by the end of the file.
+        // If not, we are out of sync and search the next packet byte by byte.
+        if ((length == 0) || (nextPos > size) ||
+            ((nextPos + timeStampSize < size) && (packetSize(data + nextPos + timeStampSize, size - nextPos - timeStampSize) == 0)))
+        {
+            ++pos;
+            continue;
+        }
+
+        packetIndex packet;
+        packet.m_offset = packetPos;
+        packet.m_size = length;
+        // Time stamps must not go back in time to allow binary search
+        packet.m_timeUsec = qMax(lastTime, qFromBigEndian<quint64>(data + pos));
+        lastTime = packet.m_timeUsec;
+        index.append(packet);
+
+        pos = nextPos;
+    }
+    index.squeeze();
+    return index;
+}
+
+int TLogReplayLink::findPacket(quint64 timeUsec) const
+{
+    const auto iter = std::lower_bound(m_index.constBegin(), m_index.constEnd(), timeUsec,
+                                       [](const packetIndex &packet, quint64 time) { return packet.m_timeUsec < time; });
+    return static_cast<int>(iter - m_index.constBegin());
+}
+
+void TLogReplayLink::replayPacket(const uchar *data, const packetIndex &packet)
+{
+    mavlink_message_t message;
+    mavlink_status_t status;
+    for (int i = 0; i < packet.m_size; ++i)
+    {
+        if (mavlink_parse_char(14, data[packet.m_offset + i], &message, &status) == MAVLINK_FRAMING_OK)
+        {
+            handleMessage(message);
+        }
+    }
+}
+
+void TLogReplayLink::handleMessage(const mavlink_message_t &message)
+{
+    if (message.sysid == QGC::MavlinkID())
+    {
+        //GCS packet, ignore it
+        return;
+    }
+
+    UASInterface* uas = UASManager::instance()->getUASForId(message.sysid);
+    if (!uas && message.msgid == MAVLINK_MSG_ID_HEARTBEAT)
+    {
+        mavlink_heartbeat_t heartbeat;
+        // Reset version field to 0
+        heartbeat.mavlink_version = 0;
+        mavlink_msg_heartbeat_decode(&message, &heartbeat);
+
+        // Create a new UAS object
+        if (heartbeat.autopilot == MAV_AUTOPILOT_ARDUPILOTMEGA)
+        {
+            ArduPilotMegaMAV* mav = new ArduPilotMegaMAV(0, message.sysid);
+            mav->setSystemType((int)heartbeat.type);
+            uas = mav;
+            // Make UAS aware that this link can be used to communicate with the actual robot
+            uas->addLink(this);
+            UASObject *obj = new UASObject();
+            LinkManager::instance()->addSimObject(message.sysid,obj);
+
+            // Now add UAS to "official" list, which makes the whole application aware of it
+            UASManager::instance()->addUAS(uas);
+        }
+    }
+    else if (uas)
+    {
+        uas->receiveMessage(this,message);
+        LinkManager::instance()->getUasObject(message.sysid)->messageReceived(this,message);
+        m_mavlinkDecoder->receiveMessage(this,message);
+        if (m_mavlinkInspector)
+        {
+            m_mavlinkInspector->receiveMessage(this,message);
+        }
+    }
+    else
+    {
+        //no UAS, and not a heartbeat
+    }
+}
+
 void TLogReplayLink::run()
 {
-    m_pause = false;
     m_threadRun = true;
+    QFile file(m_logFile);
+    const uchar *data = nullptr;
+    if (file.open(QIODevice::ReadOnly) && (file.size() > 0))
+    {
+        data = file.map(0, file.size());
+    }
+    if (data == nullptr)
+    {
+        QLOG_ERROR() << "TLogReplayLink: Could not open or map" << m_logFile << file.errorString();
+        emit connected(false);
+        return;
+    }
+
+    {   // index must not be used by seek requests while it is build
+        QVector<packetIndex> index = buildIndex(data, file.size());
+        QMutexLocker lock(&m_variableAccessMutex);
+        m_index.swap(index);
+        QLOG_DEBUG() << "TLogReplayLink: Indexed" << m_index.size() << "packets in" << m_logFile;
+    }
+
     emit connected(this);
     emit connected(true);
     emit connected();
-    QFile file(m_logFile);
-    file.open(QIODevice::ReadOnly);
-    int bytesize = 0;
-    qint64 msecs = QDateTime::currentMSecsSinceEpoch();
     MainWindow::instance()->toolBar().disableConnectWidget(true);
     MainWindow::instance()->toolBar().overrideDisableConnectWidget(true);
-    int privSpeedVar = 100;
-    mavlink_message_t message;
-    mavlink_status_t status;
-    QByteArray timebuf;
-    bool firsttime = true;
-    int delay = 0;
-    qint64 lastLogTime = 0;
-    qint64 lastPcTime = 0;
-    bool nexttime = false;
-    qint64 privatepos = 0;
-    while (!file.atEnd() && m_threadRun)
-    {
-        if (QDateTime::currentMSecsSinceEpoch() - msecs > 1000)
-        {
-            msecs = QDateTime::currentMSecsSinceEpoch();
-            m_variableAccessMutex.lock();
 
-            //m_speedVar is a value, between 25 and 175. These are speed percentages.
-            privSpeedVar = m_speedVar; //50 - ((m_speedVar) / 4);
-            if (privatepos != m_posVar)
+    const quint64 startTime = m_index.isEmpty() ? 0 : m_index.first().m_timeUsec;
+    const qint64 duration = m_index.isEmpty() ? 0 : static_cast<qint64>(m_index.last().m_timeUsec - startTime) / 1000;
+
+    mavlink_reset_channel_status(14);
+    int current = 0;            // next packet to replay
+    int speed = 100;
+    bool anchorValid = false;   // anchor is the wall clock time a log time stamp is replayed at
+    qint64 anchorPcTime = 0;
+    quint64 anchorLogTime = 0;
+    qint64 lastProgress = 0;
+
+    while (m_threadRun && (current < m_index.size()))
+    {
+        bool paused = false;
+        bool step = false;
+        {   // scope for lock
+            QMutexLocker lock(&m_variableAccessMutex);
+            if (speed != m_speedVar)
             {
-                privatepos = m_posVar;
-                if (privatepos > 0 && privatepos < 100)
-                {
-                    file.seek((privatepos / 100.0) * file.size());
-                }
+                speed = m_speedVar;
+                anchorValid = false;
             }
-            m_variableAccessMutex.unlock();
-        }
-        emit logProgress(file.pos(),file.size());
-        QByteArray bytes = file.read(128);
-        bytesize+=128;
-
-        for (int i=0;i<bytes.size();i++)
-        {
-            unsigned int decodeState = mavlink_parse_char(14, (uint8_t)(bytes[i]), &message, &status);
-            if (decodeState != 1)
+            if (m_seekIndex != s_NoSeek)
             {
-                //Not a mavlink byte!
-                if (nexttime)
-                {
-                    timebuf.append(bytes[i]);
-                }
-                if (timebuf.size() == 8)
-                {
-                    nexttime = false;
-
-                    //Should be a timestamp for the next packet.
-                    quint64 logmsecs = quint64(static_cast<unsigned char>(timebuf.at(0))) << 56;
-                    logmsecs += quint64(static_cast<unsigned char>(timebuf.at(1))) << 48;
-                    logmsecs += quint64(static_cast<unsigned char>(timebuf.at(2))) << 40;
-                    logmsecs += quint64(static_cast<unsigned char>(timebuf.at(3))) << 32;
-                    logmsecs += quint64(static_cast<unsigned char>(timebuf.at(4))) << 24;
-                    logmsecs += quint64(static_cast<unsigned char>(timebuf.at(5))) << 16;
-                    logmsecs += quint64(static_cast<unsigned char>(timebuf.at(6))) << 8;
-                    logmsecs += quint64(static_cast<unsigned char>(timebuf.at(7))) << 0;
-
-                    timebuf.clear();
-
-                    if (firsttime)
-                    {
-                        firsttime = false;
-                        lastLogTime = logmsecs;
-                        lastPcTime = QDateTime::currentMSecsSinceEpoch();
-                    }
-                    else
-                    {
-                        //Difference in time between the last time we read a timestamp, and this time
-                        qint64 pcdiff = QDateTime::currentMSecsSinceEpoch() - lastPcTime;
-                        lastPcTime = QDateTime::currentMSecsSinceEpoch();
-
-                        //Difference in time between the last timestamp we fired off, and this one
-                        qint64 logdiff = logmsecs - lastLogTime;
-                        lastLogTime = logmsecs;
-                        logdiff /= 1000;
-
-                        if (logdiff < pcdiff)
-                        {
-                            //The next mavlink packet was fired faster than our loop is running, send it immediatly
-                            //Fire immediatly
-                            delay = 0;
-                        }
-                        else
-                        {
-                            //The next mavlink packet was sent logdiff-pcdiff millseconds after the current time
-                            delay = logdiff-pcdiff;
-
-                        }
-                    }
-
-                }
+                current = qBound(0, m_seekIndex, m_index.size() - 1);
+                m_seekIndex = s_NoSeek;
+                anchorValid = false;
+                mavlink_reset_channel_status(14);
             }
-            else if (decodeState == 1)
+            paused = m_pause;
+            if (!paused)
             {
-                nexttime = true;
-                //Good decode
-                if (message.sysid == QGC::MavlinkID())
+                m_stepRequests = 0;
+            }
+            else if (m_stepRequests != 0)
+            {
+                if (m_stepRequests < 0)
                 {
-                    //GCS packet, ignore it
+                    // step back means replaying the packet before the last replayed one
+                    current = qMax(0, current - 1 + m_stepRequests);
+                    m_stepRequests = 0;
+                    mavlink_reset_channel_status(14);
                 }
                 else
                 {
-                    UASInterface* uas = UASManager::instance()->getUASForId(message.sysid);
-                    if (!uas && message.msgid == MAVLINK_MSG_ID_HEARTBEAT)
-                    {
-                        mavlink_heartbeat_t heartbeat;
-                        // Reset version field to 0
-                        heartbeat.mavlink_version = 0;
-                        mavlink_msg_heartbeat_decode(&message, &heartbeat);
-
-
-                        // Create a new UAS object
-                        if (heartbeat.autopilot == MAV_AUTOPILOT_ARDUPILOTMEGA)
-                        {
-                            ArduPilotMegaMAV* mav = new ArduPilotMegaMAV(0, message.sysid);
-                            mav->setSystemType((int)heartbeat.type);
-                            uas = mav;
-                            // Make UAS aware that this link can be used to communicate with the actual robot
-                            uas->addLink(this);
-                            UASObject *obj = new UASObject();
-                            LinkManager::instance()->addSimObject(message.sysid,obj);
-
-                            // Now add UAS to "official" list, which makes the whole application aware of it
-                            UASManager::instance()->addUAS(uas);
-
-                        }
-                    }
-                    else if (uas)
-                    {
-                        if (delay > 0 && delay < 10000)
-                        {
-                            //Split the delay into 100msec chunks, to allow for canceling.
-                            int realdelay = delay / ((double)privSpeedVar / 100.0);
-                            int repeat = realdelay / 100;
-                            for (int i=0;i<repeat;i++)
-                            {
-                                msleep(100);
-                                if (!m_threadRun)
-                                {
-                                    //Break out
-                                    MainWindow::instance()->toolBar().overrideDisableConnectWidget(false);
-                                    MainWindow::instance()->toolBar().disableConnectWidget(false);
-                                    emit disconnected(this);
-                                    emit disconnected();
-                                    emit connected(false);
-                                    UASManager::instance()->removeUAS(UASManager::instance()->getActiveUAS());
-                                    return;
-                                }
-                            }
-                            msleep(realdelay - repeat);
-                            //msleep(delay / ((double)privSpeedVar / 100.0));
-                        }
-                        else
-                        {
-                            msleep(1);
-                        }
-                        uas->receiveMessage(this,message);
-                        LinkManager::instance()->getUasObject(message.sysid)->messageReceived(this,message);
-                        m_mavlinkDecoder->receiveMessage(this,message);
-                        if (m_mavlinkInspector)
-                        {
-                            m_mavlinkInspector->receiveMessage(this,message);
-                        }
-                    }
-                    else
-                    {
-                        //no UAS, and not a heartbeat
-                    }
+                    --m_stepRequests;
                 }
+                step = true;
+            }
+        }
+
+        const packetIndex &packet = m_index.at(current);
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        if (paused && !step)
+        {
+            anchorValid = false;
+            msleep(s_WaitSliceMsec);
+            continue;
+        }
 
+        if (!paused && (speed > s_FastAsPossible))
+        {
+            if (!anchorValid)
+            {
+                anchorValid = true;
+                anchorPcTime = now;
+                anchorLogTime = packet.m_timeUsec;
+            }
+            const qint64 logDiff = static_cast<qint64>(packet.m_timeUsec - anchorLogTime) / 1000;
+            const qint64 wait = anchorPcTime + (logDiff * 100) / speed - now;
+            if (wait > s_MaxDelayMsec)
+            {
+                // Do not wait for big gaps in the log
+                anchorValid = false;
+                continue;
+            }
+            if (wait > 0)
+            {
+                // Sleep in short slices to react on seek, pause and stop
+                msleep(static_cast<unsigned long>(wait < s_WaitSliceMsec ? wait : s_WaitSliceMsec));
+                continue;
             }
         }
-        while (m_pause)
+
+        replayPacket(data, packet);
+        ++current;
+
+        if (step || (now - lastProgress >= s_ProgressIntervalMsec))
         {
-            msleep(100);
+            lastProgress = now;
+            emit logProgress(static_cast<qint64>(packet.m_timeUsec - startTime) / 1000, duration);
         }
     }
+    emit logProgress(duration, duration);
+
     if (m_threadRun)
     {
         m_toBeDeleted = true;
     }
+    UASInterface *activeUas = UASManager::instance()->getActiveUAS();
     LinkManager *lm = LinkManager::instance();
-    if (lm){
-        LinkManager::instance()->removeSimObject(UASManager::instance()->getActiveUAS()->getSystemId());
+    if (lm && activeUas){
+        LinkManager::instance()->removeSimObject(activeUas->getSystemId());
     } else {
         QLOG_ERROR() << "TLogReplayLink: failed to get Linkmanager instance";
     }
@@ -313,7 +396,7 @@ void TLogReplayLink::run()
     emit disconnected(this);
     emit disconnected();
     emit connected(false);
-    UASManager::instance()->removeUAS(UASManager::instance()->getActiveUAS());
+    UASManager::instance()->removeUAS(activeUas);
 }
 
 void TLogReplayLink::setLog(QString logfile)
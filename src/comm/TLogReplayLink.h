@@ -5,6 +5,9 @@
 #include "MAVLinkDecoder.h"
 #include "QGCMAVLinkInspector.h"
 #include <QMutex>
+#include <QVector>
+
+class QFile;
 
 class TLogReplayLink : public LinkInterface
 {
@@ -32,9 +35,37 @@ public:
     void stop();
     bool toBeDeleted();
 
-    //Speed is 1-100, being slowest to fastest
+    static constexpr int s_FastAsPossible = 0;  /// Speed for replaying without any delay
+
+    /**
+     * @brief setSpeed sets the replay speed
+     * @param speed - speed in percent of real time. 100 is real time, 200 twice as fast.
+     *        s_FastAsPossible (or any value <= 0) replays without any delay.
+     */
     void setSpeed(int speed);
-    void setPosition(qint64 pos);
+
+    /**
+     * @brief setPosition moves the replay to the first packet at or after a position
+     * @param msec - position in milliseconds from the start of the log
+     */
+    void setPosition(qint64 msec);
+
+    /**
+     * @brief seekToTime moves the replay to the first packet at or after a time stamp
+     * @param timeUsec - time stamp of the log in microseconds since epoch
+     */
+    void seekToTime(quint64 timeUsec);
+
+    /**
+     * @brief stepForward replays the next packet. Used while the replay is paused.
+     */
+    void stepForward();
+
+    /**
+     * @brief stepBackward replays the packet before the last replayed one.
+     *        Used while the replay is paused.
+     */
+    void stepBackward();
     void disableTimeouts() { }
     void enableTimeouts() { }
 signals:
@@ -48,18 +79,77 @@ signals:
     void communicationError(const QString& linkname, const QString& error);
     void communicationUpdate(const QString& linkname, const QString& text);
     void deleteLink(LinkInterface* const link);*/
+    /**
+     * @brief logProgress is emitted while replaying
+     * @param pos - time of the current packet in milliseconds from the start of the log
+     * @param total - duration of the log in milliseconds
+     */
     void logProgress(qint64 pos,qint64 total);
 public slots:
 private slots:
     void run();
     void readBytes();
 private:
+    /**
+     * @brief The packetIndex struct is the index entry of one packet in the tlog.
+     *        Every packet is preceded by a 64 bit big endian time stamp in microseconds.
+     */
+    struct packetIndex
+    {
+        qint64 m_offset;        /// Offset of the first byte of the mavlink packet in the file
+        int m_size;             /// Size of the mavlink packet in bytes
+        quint64 m_timeUsec;     /// Time stamp of the packet. Never smaller than the one of the packet before
+    };
+
+    static const int s_NoSeek = -1;                 /// m_seekIndex value if no seek is requested
+    static const qint64 s_MaxDelayMsec = 10000;     /// Gaps bigger than this are not replayed in real time
+    static const qint64 s_WaitSliceMsec = 50;       /// Max sleep time so commands are handled in time
+    static const qint64 s_ProgressIntervalMsec = 100;   /// Interval for emitting logProgress()
+
+    /**
+     * @brief buildIndex searches all packets in the log
+     * @param data - pointer to the log data
+     * @param size - size of the log data
+     * @return index of all packets
+     */
+    static QVector<packetIndex> buildIndex(const uchar *data, qint64 size);
+
+    /**
+     * @brief packetSize calculates the size of the mavlink packet starting at data
+     * @param data - pointer to the first byte of the packet
+     * @param available - bytes available at data
+     * @return size of the packet in bytes, 0 if there is no valid packet start
+     */
+    static int packetSize(const uchar *data, qint64 available);
+
+    /**
+     * @brief findPacket delivers the index of the first packet at or after a time stamp
+     * @param timeUsec - the time stamp
+     * @return the index of the packet
+     */
+    int findPacket(quint64 timeUsec) const;
+
+    /**
+     * @brief replayPacket decodes one packet of the log and passes the message on
+     * @param data - pointer to the log data
+     * @param packet - index entry of the packet
+     */
+    void replayPacket(const uchar *data, const packetIndex &packet);
+
+    /**
+     * @brief handleMessage passes a message to the UAS. Creates the UAS if needed
+     * @param message - the decoded message
+     */
+    void handleMessage(const mavlink_message_t &message);
+
+    QVector<packetIndex> m_index;   /// Index of all packets. Set by the replay thread, seek requests read it under m_variableAccessMutex
     QString m_logFile;
     bool m_toBeDeleted;
     bool m_threadRun;
     QMutex m_variableAccessMutex;
     int m_speedVar;
-    qint64 m_posVar;
+    int m_seekIndex;    /// Index of the next packet to replay after a seek, s_NoSeek if no seek requested
+    int m_stepRequests; /// Number of packets to replay while paused
     bool m_pause;
     MAVLinkDecoder *m_mavlinkDecoder;
     QGCMAVLinkInspector *m_mavlinkInspector;
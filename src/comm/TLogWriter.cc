@@ -0,0 +1,153 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief TLogWriter
+ *          Writes the tlog of the MAVLinkProtocol in an own thread.
+ *
+ */
+
+#include "TLogWriter.h"
+#include "logging.h"
+
+TLogWriter::TLogWriter(const QString &fileName, QObject *parent) :
+    QThread(parent),
+    m_file(fileName)
+{
+    m_chunk.resize(s_ChunkSize);
+}
+
+TLogWriter::~TLogWriter()
+{
+    close();
+}
+
+bool TLogWriter::open()
+{
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        QLOG_WARN() << "TLogWriter: Unable to open" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+
+    m_stop = false;
+    start(QThread::LowPriority);
+    return true;
+}
+
+void TLogWriter::close()
+{
+    if (isRunning())
+    {
+        {
+            QMutexLocker lock(&m_stopMutex);
+            m_stop = true;
+            m_stopCondition.wakeAll();
+        }
+        wait();
+    }
+
+    if (m_file.isOpen())
+    {
+        // the thread is stopped - write what is left
+        commit();
+        m_file.close();
+        QLOG_DEBUG() << "TLogWriter: closed" << m_file.fileName() << "frames:" << queuedFrames()
+                     << "dropped:" << droppedFrames();
+    }
+}
+
+QString TLogWriter::fileName() const
+{
+    return m_file.fileName();
+}
+
+bool TLogWriter::writeFrame(const char *frame, int size)
+{
+    if (m_buffer.writeAll(frame, size))
+    {
+        m_queuedFrames.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+quint64 TLogWriter::queuedFrames() const
+{
+    return m_queuedFrames.load(std::memory_order_relaxed);
+}
+
+quint64 TLogWriter::droppedFrames() const
+{
+    return m_droppedFrames.load(std::memory_order_relaxed);
+}
+
+void TLogWriter::run()
+{
+    bool stop = false;
+    while (!stop)
+    {
+        {
+            QMutexLocker lock(&m_stopMutex);
+            if (!m_stop)
+            {
+                m_stopCondition.wait(&m_stopMutex, s_CommitInterval);
+            }
+            stop = m_stop;
+        }
+
+        if (!commit())
+        {
+            QLOG_WARN() << "TLogWriter: write error on" << m_file.fileName() << m_file.errorString();
+            emit writeFailed(m_file.fileName());
+            return;
+        }
+
+        const quint64 queued = queuedFrames();
+        const quint64 dropped = droppedFrames();
+        if (queued != m_reportedQueued || dropped != m_reportedDropped)
+        {
+            m_reportedQueued = queued;
+            m_reportedDropped = dropped;
+            emit statisticsChanged(queued, dropped);
+        }
+    }
+}
+
+bool TLogWriter::commit()
+{
+    bool written = false;
+    int size = 0;
+    while ((size = m_buffer.read(m_chunk.data(), m_chunk.size())) > 0)
+    {
+        if (m_file.write(m_chunk.constData(), size) != size)
+        {
+            return false;
+        }
+        written = true;
+    }
+
+    // one flush per commit hands the whole group to the OS
+    return !written || m_file.flush();
+}
@@ -0,0 +1,147 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief TLogWriter
+ *          Writes the tlog of the MAVLinkProtocol in an own thread.
+ *
+ */
+
+#ifndef TLOGWRITER_H
+#define TLOGWRITER_H
+
+#include "LinkByteRingBuffer.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+
+/**
+ * @brief The TLogWriter class records tlog frames without blocking the receive path.
+ *
+ *        The MAVLinkProtocol hands over complete frames (8 byte big endian timestamp
+ *        followed by the packet) using writeFrame(). This only copies the frame into a
+ *        lock free ring buffer. The writer thread wakes up every s_CommitInterval ms and
+ *        writes everything queued in a few big chunks (group commit). A slow disk only
+ *        fills the ring buffer. If it is full, whole frames are dropped and counted, so
+ *        the memory stays bounded and the tlog stays readable.
+ */
+class TLogWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief TLogWriter - CTOR
+     * @param fileName - name of the tlog. New frames are appended.
+     * @param parent - parent object
+     */
+    explicit TLogWriter(const QString &fileName, QObject *parent = nullptr);
+
+    /**
+     * @brief ~TLogWriter - DTOR calls close()
+     */
+    ~TLogWriter() override;
+
+    /**
+     * @brief open opens the file and starts the writer thread
+     * @return true on success, false if the file can not be opened
+     */
+    bool open();
+
+    /**
+     * @brief close stops the writer thread, writes all queued frames and closes the file
+     */
+    void close();
+
+    /**
+     * @brief fileName - name of the tlog
+     */
+    QString fileName() const;
+
+    /**
+     * @brief writeFrame queues one frame. Must only be called by one thread (the
+     *        thread of the MAVLinkProtocol). Never blocks.
+     * @param frame - the serialised frame
+     * @param size - size of the frame in bytes
+     * @return true if the frame was queued, false if it was dropped
+     */
+    bool writeFrame(const char *frame, int size);
+
+    /**
+     * @brief queuedFrames - number of frames accepted for writing
+     */
+    quint64 queuedFrames() const;
+
+    /**
+     * @brief droppedFrames - number of frames dropped because the queue was full
+     */
+    quint64 droppedFrames() const;
+
+signals:
+    /**
+     * @brief statisticsChanged is emitted by the writer thread after a commit
+     *        if the counters changed.
+     * @param queuedFrames - @see queuedFrames()
+     * @param droppedFrames - @see droppedFrames()
+     */
+    void statisticsChanged(quint64 queuedFrames, quint64 droppedFrames);
+
+    /**
+     * @brief writeFailed is emitted by the writer thread if writing to the file failed.
+     *        The thread stops afterwards.
+     * @param fileName - name of the tlog
+     */
+    void writeFailed(const QString &fileName);
+
+protected:
+    void run() override;
+
+private:
+    static constexpr int s_BufferSize     = 4 * 1024 * 1024;   /// Max bytes queued for writing
+    static constexpr int s_ChunkSize      = 256 * 1024;        /// Bytes written with one call
+    static constexpr int s_CommitInterval = 250;               /// ms between two commits
+
+    /**
+     * @brief commit writes all queued frames to the file
+     * @return true on success, false on write error
+     */
+    bool commit();
+
+    QFile m_file;                               /// the tlog
+    LinkByteRingBuffer m_buffer{s_BufferSize};  /// frames waiting to be written
+    QByteArray m_chunk;                         /// chunk read from m_buffer, only used by the writer thread
+
+    std::atomic<quint64> m_queuedFrames{0};     /// frames accepted by writeFrame()
+    std::atomic<quint64> m_droppedFrames{0};    /// frames dropped by writeFrame()
+    quint64 m_reportedQueued = 0;               /// last queued frames reported by statisticsChanged()
+    quint64 m_reportedDropped = 0;              /// last dropped frames reported by statisticsChanged()
+
+    QMutex m_stopMutex;                         /// protects m_stop, never touched by writeFrame()
+    QWaitCondition m_stopCondition;             /// wakes the writer thread on close()
+    bool m_stop = false;                        /// true if the writer thread shall end
+};
+
+#endif // TLOGWRITER_H
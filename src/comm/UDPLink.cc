@@ -41,12 +41,13 @@ This file is part of the QGROUNDCONTROL project
 #include "LinkManager.h"
 #include "QGC.h"
 
+static const int UDP_RECONNECT_TIMER = 500; //msecs
 
 UDPLink::UDPLink(QHostAddress host, quint16 port) :
     socket(NULL),
     connectState(false),
-    _shouldRestartConnection(false),
-    _running(false)
+    _running(false),
+    _sendScheduled(false)
 {
     this->host = host;
     this->port = port;
@@ -61,12 +62,10 @@ UDPLink::~UDPLink()
 {
     // Tell the thread to exit
     _running = false;
+    quit();
 
     // Wait for it to exit
     wait();
-    while(_outQueue.count() > 0) {
-        delete _outQueue.dequeue();
-    }
     this->deleteLater();
 }
 
@@ -76,55 +75,50 @@ UDPLink::~UDPLink()
  **/
 void UDPLink::run()
 {
-    forever {
-        if (!isConnected() && !host.isNull() && port != 0 ) {
-            hardwareConnect();
-            msleep(50);
-            continue;
-        }
-
-        if (_shouldRestartConnection) {
-            _shouldRestartConnection = false;
-            hardwareConnect();
-            msleep(50);
-            continue;
-        }
-
-        if (!socket) {
-            msleep(50);
-            continue;
-        }
-
-        bool loop = socket->hasPendingDatagrams();
-        if(loop) {
-            readBytes();
+    // All objects created here live in this thread, so the lambdas below are
+    // called by the event loop as soon as a datagram arrives or a packet is
+    // queued for sending.
+    QObject context;
+    QTimer reconnectTimer;
+    reconnectTimer.setSingleShot(true);
+    reconnectTimer.setInterval(UDP_RECONNECT_TIMER);
+
+    auto bindSocket = [this, &context, &reconnectTimer]()
+    {
+        reconnectTimer.stop();
+        if (!hardwareConnect()) {
+            reconnectTimer.start();
+            return;
         }
+        QObject::connect(socket, &QUdpSocket::readyRead, &context, [this]() { readBytes(); });
+        // Serve what arrived or was queued before the socket was bound
+        readBytes();
+        _dequeBytes();
+    };
+    QObject::connect(&reconnectTimer, &QTimer::timeout, &context, bindSocket);
+    QObject::connect(this, &UDPLink::_restartConnection, &context, bindSocket, Qt::QueuedConnection);
+    QObject::connect(this, &UDPLink::_outQueueReady, &context, [this]() { _dequeBytes(); }, Qt::QueuedConnection);
+
+    if (!host.isNull() && port != 0) {
+        bindSocket();
+    }
 
-        //-- Loop right away if busy
-        if((_dequeBytes() || loop) && _running)
-            continue;
-
-        if (!_running) {
-            socket->deleteLater();
-            socket = NULL;
-            connectState = false;
-            emit disconnected();
-            emit connected(false);
-            emit disconnected(this);
-            QLOG_INFO() << "UDPLink:" << "Terminando a thread:";
-            break;
-        }
+    exec();
 
-        //-- Settle down (it gets here if there is nothing to read or write)
-        msleep(50);
-    }
+    delete socket;
+    socket = NULL;
+    connectState = false;
+    emit disconnected();
+    emit connected(false);
+    emit disconnected(this);
+    QLOG_INFO() << "UDPLink:" << "Terminando a thread:";
 }
 
 void UDPLink::setAddress(QHostAddress host)
 {
     this->host = host;
     emit linkChanged(this);
-    _shouldRestartConnection = true;
+    emit _restartConnection();
 }
 
 void UDPLink::setPort(int port)
@@ -133,7 +127,7 @@ void UDPLink::setPort(int port)
     this->name = tr("UDP Link (port:%1)").arg(this->port);
     emit nameChanged(this->name);
     emit linkChanged(this);
-    _shouldRestartConnection = true;
+    emit _restartConnection();
 }
 
 /**
@@ -159,6 +153,7 @@ void UDPLink::addHost(const QString& host)
                     address = hostAddresses.at(i);
                 }
             }
+            QMutexLocker locker(&dataMutex);
             hosts.append(address);
             QLOG_DEBUG() << "Address:" << address.toString();
             // Set port according to user input
@@ -171,13 +166,13 @@ void UDPLink::addHost(const QString& host)
         if (info.error() == QHostInfo::NoError)
         {
             // Add host
+            QMutexLocker locker(&dataMutex);
             hosts.append(info.addresses().first());
             // Set port according to default (this port)
             ports.append(port);
         }
     }
     emit linkChanged(this);
-        _shouldRestartConnection = true;
 }
 
 void UDPLink::removeHost(const QString& hostname)
@@ -196,7 +191,8 @@ void UDPLink::removeHost(const QString& hostname)
             address = hostAddresses.at(i);
         }
     }
-    for (int i = 0; i < hosts.count(); ++i)
+    QMutexLocker locker(&dataMutex);
+    for (int i = hosts.count() - 1; i >= 0; --i)
     {
         if (hosts.at(i) == address)
         {
@@ -204,34 +200,45 @@ void UDPLink::removeHost(const QString& hostname)
             ports.removeAt(i);
         }
     }
-    _shouldRestartConnection = true;
 }
 
 void UDPLink::writeBytes(const char* data, qint64 size)
 {
-    if (!socket) {
+    if (!connectState) {
         return;
     }
-    QByteArray* qdata = new QByteArray(data, size);
-    QMutexLocker lock(&_mutex);
-    _outQueue.enqueue(qdata);
+    {
+        QMutexLocker lock(&_mutex);
+        _outQueue.enqueue(QByteArray(data, size));
+    }
+    // Wake up the link thread, once for all packets queued in the meantime
+    if (!_sendScheduled.exchange(true)) {
+        emit _outQueueReady();
+    }
 }
 
-bool UDPLink::_dequeBytes()
+void UDPLink::_dequeBytes()
 {
-    QMutexLocker lock(&_mutex);
-    if(_outQueue.count() > 0) {
-        QByteArray* qdata = _outQueue.dequeue();
-        lock.unlock();
-        _sendBytes(qdata->data(), qdata->size());
-        delete qdata;
-        lock.relock();
+    // Clear the flag first so packets queued while sending schedule a new call
+    _sendScheduled.store(false);
+
+    QQueue<QByteArray> queue;
+    {
+        QMutexLocker lock(&_mutex);
+        queue.swap(_outQueue);
+    }
+    if (!socket) {
+        return;
+    }
+    while (!queue.isEmpty()) {
+        const QByteArray data = queue.dequeue();
+        _sendBytes(data.constData(), data.size());
     }
-    return (_outQueue.count() > 0);
 }
 
 void UDPLink::_sendBytes(const char* data, qint64 size)
 {
+    QMutexLocker locker(&dataMutex);
     // Broadcast to all connected systems
     for (int h = 0; h < hosts.size(); h++)
     {
@@ -274,40 +281,36 @@ void UDPLink::_sendBytes(const char* data, qint64 size)
  **/
 void UDPLink::readBytes()
 {
+    if (!socket) {
+        return;
+    }
+
+    // All pending datagrams are handed on in one buffer, this saves an allocation
+    // and a signal per datagram. The protocol copies the bytes into the ring buffer
+    // of the link right in this thread.
+    QByteArray data;
     while (socket->hasPendingDatagrams())
     {
-        QByteArray datagram;
-        datagram.resize(socket->pendingDatagramSize());
+        const qint64 size = socket->pendingDatagramSize();
+        const int offset = data.size();
+        data.resize(offset + static_cast<int>(size > 0 ? size : 0));
 
         QHostAddress sender;
         quint16 senderPort;
-        socket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
-
-        // FIXME TODO Check if this method is better than retrieving the data by individual processes
-        emit bytesReceived(this, datagram);
-
-        // Log this data reception for this timestep
-        QMutexLocker dataRateLocker(&dataRateMutex);
-        logDataRateToBuffer(inDataWriteAmounts, inDataWriteTimes, &inDataIndex, datagram.length(), QDateTime::currentMSecsSinceEpoch());
+        const qint64 bytesRead = socket->readDatagram(data.data() + offset, size, &sender, &senderPort);
+        data.resize(offset + static_cast<int>(bytesRead > 0 ? bytesRead : 0));
 
 #ifdef UDPLINK_DEBUG
         // Echo data for debugging purposes
-        std::cerr << __FILE__ << __LINE__ << "Received datagram:" << std::endl;
-//        int i;
-//        for (i=0; i<s; i++)
-//        {
-//            unsigned int v=data[i];
-//            fprintf(stderr,"%02x ", v);
-//        }
-//        std::cerr << std::endl;
+        std::cerr << __FILE__ << __LINE__ << "Received datagram:" << bytesRead << " bytes" << std::endl;
 #endif
 
         // Add host to broadcast list if not yet present
+        QMutexLocker locker(&dataMutex);
         if (!hosts.contains(sender))
         {
             hosts.append(sender);
             ports.append(senderPort);
-            //        ports->insert(sender, senderPort);
         }
         else
         {
@@ -317,6 +320,15 @@ void UDPLink::readBytes()
         if(!_running)
             break;
     }
+
+    if (data.isEmpty()) {
+        return;
+    }
+    emit bytesReceived(this, data);
+
+    // Log this data reception for this timestep
+    QMutexLocker dataRateLocker(&dataRateMutex);
+    logDataRateToBuffer(inDataWriteAmounts, inDataWriteTimes, &inDataIndex, data.length(), QDateTime::currentMSecsSinceEpoch());
 }
 
 
@@ -339,6 +351,7 @@ bool UDPLink::disconnect()
 {
     QLOG_INFO() << "UDP disconnect";
     _running = false;
+    quit();
     return true;
 }
 
@@ -350,6 +363,7 @@ bool UDPLink::disconnect()
 bool UDPLink::connect()
 {
     QLOG_INFO() << "UDPLink::UDP connect " << host << ":" << port;
+    _running = true;
     start(NormalPriority);
     return true;
 }
@@ -370,7 +384,6 @@ bool UDPLink::hardwareConnect(void)
         emit connected(false);
         emit communicationError("UDP Link Error", "Error binding UDP port");
     }
-    _running = true;
     return connectState;
 }
 
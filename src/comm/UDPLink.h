@@ -41,6 +41,7 @@ This file is part of the QGROUNDCONTROL project
 #include <QQueue>
 #include <QByteArray>
 #include <QNetworkProxy>
+#include <atomic>
 
 class UDPLink : public LinkInterface
 {
@@ -75,9 +76,11 @@ public:
     int getDataBitsType() const;
     int getStopBitsType() const;
     QList<QHostAddress> getHosts() const {
+        QMutexLocker locker(&dataMutex);
         return hosts;
     }
     QList<quint16> getPorts() const {
+        QMutexLocker locker(&dataMutex);
         return ports;
     }
 
@@ -86,12 +89,19 @@ public:
     qint64 getCurrentInDataRate() const;
     qint64 getCurrentOutDataRate() const;
 
+    /**
+     * @brief Runs the event loop of the link. The socket lives in this thread
+     *        and is served as soon as it is readable or packets are queued.
+     */
     void run();
 
     int getId() const;
 
     LinkType getLinkType() { return UDP_LINK; }
 
+    /** @brief Packets are queued and sent by the thread of the link */
+    bool isWriteThreadSafe() const { return true; }
+
 public slots:
     void setAddress(QHostAddress host);
     void setPort(int port);
@@ -112,18 +122,23 @@ public slots:
     bool connect();
     bool disconnect();
 
+signals:
+    /** @brief Internal: rebind the socket in the thread of the link */
+    void _restartConnection();
+    /** @brief Internal: packets were queued by writeBytes() */
+    void _outQueueReady();
+
 private:
     QString name;
     QHostAddress host;
     quint16 port;
     int id;
     QUdpSocket* socket;
-    bool connectState;
-    bool _shouldRestartConnection;
+    std::atomic<bool> connectState;     ///< written by the link thread, read by the GUI thread
     QList<QHostAddress> hosts;
     QList<quint16> ports;
 
-    QMutex dataMutex;
+    mutable QMutex dataMutex;   ///< Protects hosts and ports
 
     void setName(QString name);
 
@@ -132,9 +147,10 @@ private:
 
     bool                _running;
     QMutex              _mutex;
-    QQueue<QByteArray*> _outQueue;
+    QQueue<QByteArray>  _outQueue;
+    std::atomic<bool>   _sendScheduled;     ///< true if _dequeBytes() is already queued
 
-    bool _dequeBytes    ();
+    void _dequeBytes    ();
     void _sendBytes     (const char* data, qint64 size);
 
 
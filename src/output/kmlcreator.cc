@@ -1,12 +1,13 @@
 #include "logging.h"
 
 #include "kmlcreator.h"
-#include "ArduPilotMegaMAV.h"
+#include "ArduPilotMessages.h"
 
 #include <qstringlist.h>
 #include <QFile>
 #include <QDir>
 #include <QFileInfo>
+#include <QDateTime>
 #include <QProcess>
 #include <QWaitCondition>
 #include <QMutex>
@@ -323,7 +324,8 @@ KMLCreator::KMLCreator() :
     m_newNKQ1(false),
     m_newAHR2(false),
     m_newATT(false),
-    m_mav_type((MAV_TYPE)0)
+    m_mav_type((MAV_TYPE)0),
+    m_gpsOffset(0)
 {
 }
 
@@ -334,7 +336,8 @@ KMLCreator::KMLCreator(MAV_TYPE mav_type, double iconInterval) :
     m_newAHR2(false),
     m_newATT(false),
     m_mav_type(mav_type),
-    m_iconInterval(iconInterval)
+    m_iconInterval(iconInterval),
+    m_gpsOffset(0)
 {
 }
 
@@ -353,7 +356,6 @@ void KMLCreator::start(QString &fn) {
 
 void KMLCreator::processLine(QString &line)
 {
-    static qint64 gpsOffset = 0;
     if(line.indexOf("FMT,") == 0) {
         FormatLine fl = FormatLine::from(line);
         if(fl.hasData()) {
@@ -369,7 +371,7 @@ void KMLCreator::processLine(QString &line)
             if(gps.hasData()) {
                 qint64 timeUS = gps.timeUS().toInt();
                 qint64 utc_ms = gps.getUtc_ms();
-                gpsOffset = utc_ms * 1000LL - timeUS;
+                m_gpsOffset = utc_ms * 1000LL - timeUS;
                 m_summary->add(gps);
 
                 Placemark* pm = lastPlacemark();
@@ -386,7 +388,7 @@ void KMLCreator::processLine(QString &line)
         }
     }
     // POS, ATT, AHR2, NKQ1, and XKQ1 messages are all logged at 25Hz (by default).
-    else if(line.indexOf("POS,") == 0 && (gpsOffset > 0)) {
+    else if(line.indexOf("POS,") == 0 && (m_gpsOffset > 0)) {
         Placemark* pm = lastPlacemark();
         if(!pm) {
             QLOG_WARN() << "No placemark";
@@ -414,7 +416,7 @@ void KMLCreator::processLine(QString &line)
         if(fl.hasData()) {
             POSRecord pos = POSRecord::from(fl, line);
             // create a gps record using attitude from POS and other data from most recent GPS msg
-            GPSRecord gps = gpsFromPOS(pos, gpsOffset, pm->mGPS);
+            GPSRecord gps = gpsFromPOS(pos, m_gpsOffset, pm->mGPS);
 
             if(gps.hasData()) {
                 m_summary->add(gps);
@@ -381,6 +381,9 @@ private:
 
     MAV_TYPE m_mav_type;
     double m_iconInterval;
+
+    // offset from GPS time to TimeUS, per log so several logs can be exported in parallel
+    qint64 m_gpsOffset;
 };
 
 } // namespace kml
@@ -0,0 +1,581 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief LogParserBenchmark
+ *          Measures log loading speed and datamodel access of the log analysis.
+ *
+ */
+
+#include "LogParserBenchmark.h"
+#include "AutoTest.h"
+
+#include "Loghandling/IParserCallback.h"
+#include "Loghandling/BinLogParser.h"
+#include "Loghandling/AsciiLogParser.h"
+#include "Loghandling/TlogParser.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <limits>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+const double s_MiB = 1024.0 * 1024.0;
+
+/**
+ * @brief The benchmarkCallback class collects the errors of one parser run
+ */
+class benchmarkCallback : public IParserCallback
+{
+public:
+    QStringList m_errors;
+
+    virtual void onProgress(const qint64 /*pos*/, const qint64 /*size*/)
+    {
+    }
+
+    virtual void onError(const QString &errorMsg)
+    {
+        m_errors.append(errorMsg);
+    }
+};
+
+#if defined(Q_OS_LINUX)
+/**
+ * @brief readProcStatus reads a memory value of this process from /proc/self/status
+ * @param key - name of the value like "VmRSS:"
+ * @return the value in bytes, -1 if it could not be read
+ */
+qint64 readProcStatus(const QByteArray &key)
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return -1;
+    }
+    // Files in /proc have no size, so they must be read as a whole
+    for (const auto &line : status.readAll().split('\n'))
+    {
+        if (line.startsWith(key))
+        {
+            bool ok = false;
+            const qint64 kiloBytes = line.mid(key.size()).trimmed().split(' ').first().toLongLong(&ok);
+            return ok ? kiloBytes * 1024 : -1;
+        }
+    }
+    return -1;
+}
+#endif
+
+/**
+ * @brief residentMemory delivers the current resident memory of this process
+ * @return bytes, -1 if unknown
+ */
+qint64 residentMemory()
+{
+#if defined(Q_OS_LINUX)
+    return readProcStatus("VmRSS:");
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<qint64>(counters.WorkingSetSize);
+    }
+    return -1;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief peakResidentMemory delivers the highest resident memory of this process
+ *        since the last resetPeakResidentMemory() or since its start
+ * @return bytes, -1 if unknown
+ */
+qint64 peakResidentMemory()
+{
+#if defined(Q_OS_LINUX)
+    return readProcStatus("VmHWM:");
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<qint64>(counters.PeakWorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return -1;
+    }
+#if defined(Q_OS_MAC)
+    return static_cast<qint64>(usage.ru_maxrss);            // bytes on macOS
+#else
+    return static_cast<qint64>(usage.ru_maxrss) * 1024;     // kB on the BSDs
+#endif
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief resetPeakResidentMemory sets the peak resident memory to the current one.
+ *        Only supported on Linux (since 4.0).
+ * @return true if the peak was reset
+ */
+bool resetPeakResidentMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile clearRefs("/proc/self/clear_refs");
+    return clearRefs.open(QIODevice::WriteOnly) && (clearRefs.write("5") == 1);
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief configToJson delivers the settings that make results of two runs comparable
+ */
+QJsonObject configToJson(const LogParserBenchmark::options &opts)
+{
+    QJsonObject config;
+    config.insert("targetSize", static_cast<double>(opts.m_log.m_targetSize));
+    config.insert("seed", QString::number(opts.m_log.m_seed));
+    config.insert("imuRate", opts.m_log.m_imuRate);
+    config.insert("imuInstances", opts.m_log.m_imuInstances);
+    config.insert("attitudeRate", opts.m_log.m_attitudeRate);
+    config.insert("baroRate", opts.m_log.m_baroRate);
+    config.insert("gpsRate", opts.m_log.m_gpsRate);
+    config.insert("parameterCount", opts.m_log.m_parameterCount);
+    config.insert("textInterval", opts.m_log.m_textInterval);
+    config.insert("modeInterval", opts.m_log.m_modeInterval);
+    return config;
+}
+}
+
+LogParserBenchmark::options LogParserBenchmark::s_Options;
+
+void LogParserBenchmark::setOptions(const options &opts)
+{
+    s_Options = opts;
+}
+
+LogParserBenchmark::LogParserBenchmark()
+{
+}
+
+void LogParserBenchmark::initTestCase()
+{
+    QString dir = s_Options.m_logDir;
+    if (dir.isEmpty())
+    {
+        m_tempDirPtr.reset(new QTemporaryDir());
+        QVERIFY2(m_tempDirPtr->isValid(), "Unable to create a temporary directory for the logs");
+        dir = m_tempDirPtr->path();
+    }
+    else
+    {
+        QVERIFY2(QDir().mkpath(dir), qPrintable("Unable to create the log directory " + dir));
+    }
+
+    if (!s_Options.m_baselineFile.isEmpty())
+    {
+        QFile file(s_Options.m_baselineFile);
+        QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable("Unable to open the baseline " + s_Options.m_baselineFile));
+        const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+        QVERIFY2(document.isObject(), qPrintable(s_Options.m_baselineFile + " is no benchmark result file"));
+        m_baseline = document.object().value("measurements").toObject();
+        if (document.object().value("config").toObject() != configToJson(s_Options))
+        {
+            QWARN("The baseline was measured with other log settings, the comparison is not meaningful");
+        }
+    }
+
+    QVERIFY(generateLog(SyntheticLogGenerator::logFormat::Binary, dir));
+    QVERIFY(generateLog(SyntheticLogGenerator::logFormat::Ascii, dir));
+    QVERIFY(generateLog(SyntheticLogGenerator::logFormat::Tlog, dir));
+}
+
+void LogParserBenchmark::cleanupTestCase()
+{
+    // The datamodel of a binary log still maps its file
+    m_binStoragePtr.reset();
+
+    if (!s_Options.m_resultFile.isEmpty())
+    {
+        QJsonObject root;
+        root.insert("config", configToJson(s_Options));
+        root.insert("qtVersion", QString(qVersion()));
+        root.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        root.insert("measurements", m_results);
+
+        QFile file(s_Options.m_resultFile);
+        QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Truncate),
+                 qPrintable("Unable to write the results to " + s_Options.m_resultFile));
+        file.write(QJsonDocument(root).toJson());
+    }
+
+    m_tempDirPtr.reset();
+}
+
+void LogParserBenchmark::parseBinLog()
+{
+    m_binStoragePtr.reset();
+    benchmarkParser(parserType::BinaryMapped, "parseBinLog", &m_binStoragePtr);
+}
+
+void LogParserBenchmark::parseBinLogUnmapped()
+{
+    benchmarkParser(parserType::BinaryUnmapped, "parseBinLogUnmapped");
+}
+
+void LogParserBenchmark::parseAsciiLog()
+{
+    benchmarkParser(parserType::Ascii, "parseAsciiLog");
+}
+
+void LogParserBenchmark::parseTlog()
+{
+    benchmarkParser(parserType::Tlog, "parseTlog");
+}
+
+void LogParserBenchmark::getValues()
+{
+    const LogdataStorage::Ptr storagePtr = binStorage();
+    QVERIFY2(storagePtr, "The binary log could not be parsed");
+
+    // All plottable fields, named like the plot selection tree of the log analysis does
+    QStringList names;
+    const QMap<QString, QStringList> fields = storagePtr->getFmtValues(true);
+    for (auto iter = fields.constBegin(); iter != fields.constEnd(); ++iter)
+    {
+        for (const auto &label : iter.value())
+        {
+            names.append(iter.key() + "." + label);
+        }
+    }
+    QVERIFY2(!names.isEmpty(), "The datamodel has no plottable fields");
+
+    QVector<double> xValues;
+    QVector<double> yValues;
+    qint64 totalNsecs = 0;
+    qint64 maxNsecs = 0;
+    qint64 values = 0;
+    int calls = 0;
+    for (int repetition = 0; repetition < qMax(1, s_Options.m_repetitions); ++repetition)
+    {
+        for (const auto &name : names)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            const bool found = storagePtr->getValues(name, true, xValues, yValues);
+            const qint64 nsecs = timer.nsecsElapsed();
+
+            QVERIFY2(found, qPrintable("No values for " + name));
+            QCOMPARE(xValues.size(), yValues.size());
+            totalNsecs += nsecs;
+            maxNsecs = qMax(maxNsecs, nsecs);
+            values += yValues.size();
+            ++calls;
+        }
+    }
+
+    const double meanMsecs = static_cast<double>(totalNsecs) / 1e6 / calls;
+    report("getValues.fields", names.size(), "fields", true);
+    report("getValues.meanLatency", meanMsecs, "ms", false);
+    report("getValues.maxLatency", static_cast<double>(maxNsecs) / 1e6, "ms", false);
+    report("getValues.valueRate", static_cast<double>(values) / qMax(1e-9, static_cast<double>(totalNsecs) / 1e9),
+           "values/s", true);
+    QTest::setBenchmarkResult(meanMsecs, QTest::WalltimeMilliseconds);
+
+    const QString regressions = takeRegressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions));
+}
+
+void LogParserBenchmark::tableModelAccess()
+{
+    const LogdataStorage::Ptr storagePtr = binStorage();
+    QVERIFY2(storagePtr, "The binary log could not be parsed");
+
+    const int rows = storagePtr->rowCount();
+    const int columns = storagePtr->columnCount();
+    QVERIFY2((rows > 0) && (columns > 0), "The datamodel is empty");
+
+    qint64 totalNsecs = 0;
+    qint64 maxPageNsecs = 0;
+    qint64 cells = 0;
+    qint64 characters = 0;
+    for (int position = 0; position < s_ScrollPositions; ++position)
+    {
+        // Pages spread over the whole log like a user dragging the scroll bar of the table view
+        const int firstRow = static_cast<int>(static_cast<qint64>(rows - 1) * position / qMax(1, s_ScrollPositions - 1));
+        const int endRow = qMin(rows, firstRow + s_VisibleRows);
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int row = firstRow; row < endRow; ++row)
+        {
+            for (int column = 0; column < columns; ++column)
+            {
+                // The view displays every cell as text
+                characters += storagePtr->data(storagePtr->index(row, column)).toString().size();
+                ++cells;
+            }
+        }
+        // Selecting a row changes the header to the labels of its type
+        storagePtr->selectedRowChanged(storagePtr->index(firstRow, 0));
+        for (int column = 0; column < columns; ++column)
+        {
+            characters += storagePtr->headerData(column, Qt::Horizontal).toString().size();
+        }
+        const qint64 nsecs = timer.nsecsElapsed();
+
+        totalNsecs += nsecs;
+        maxPageNsecs = qMax(maxPageNsecs, nsecs);
+    }
+    QVERIFY(characters > 0);
+
+    const double meanPageMsecs = static_cast<double>(totalNsecs) / 1e6 / s_ScrollPositions;
+    report("tableModel.cellLatency", static_cast<double>(totalNsecs) / cells, "ns", false);
+    report("tableModel.meanPageLatency", meanPageMsecs, "ms", false);
+    report("tableModel.maxPageLatency", static_cast<double>(maxPageNsecs) / 1e6, "ms", false);
+    QTest::setBenchmarkResult(meanPageMsecs, QTest::WalltimeMilliseconds);
+
+    const QString regressions = takeRegressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions));
+}
+
+bool LogParserBenchmark::generateLog(SyntheticLogGenerator::logFormat format, const QString &dir)
+{
+    generatedLog log;
+    log.m_fileName = QDir(dir).filePath("synthetic." + SyntheticLogGenerator::fileSuffix(format));
+
+    QElapsedTimer timer;
+    timer.start();
+    SyntheticLogGenerator generator(s_Options.m_log);
+    log.m_result = generator.writeFile(format, log.m_fileName);
+    if (log.m_result.m_bytes == 0)
+    {
+        QWARN(qPrintable("Unable to write " + log.m_fileName));
+        return false;
+    }
+
+    QTextStream out(stdout);
+    out << "LOG    " << log.m_fileName << ": " << QString::number(log.m_result.m_bytes / s_MiB, 'f', 1) << " MiB, "
+        << log.m_result.m_messages << " messages, " << QString::number(log.m_result.m_duration, 'f', 0)
+        << " s flight, written in " << timer.elapsed() << " ms\n";
+    out.flush();
+
+    m_logs.insert(static_cast<int>(format), log);
+    return true;
+}
+
+LogParserBenchmark::parseRun LogParserBenchmark::parse(parserType type)
+{
+    parseRun run;
+    run.m_seconds = std::numeric_limits<double>::max();
+
+    for (int repetition = 0; repetition < qMax(1, s_Options.m_repetitions); ++repetition)
+    {
+        // Release the datamodel of the last run before measuring the memory
+        run.m_storagePtr.reset();
+        LogdataStorage::Ptr storagePtr(new LogdataStorage());
+
+        const bool peakReset = resetPeakResidentMemory();
+        const qint64 memoryBefore = residentMemory();
+        QElapsedTimer timer;
+        timer.start();
+        runParser(type, storagePtr, run);
+        const double seconds = static_cast<double>(timer.nsecsElapsed()) / 1e9;
+        const qint64 peakMemory = peakResidentMemory();
+
+        run.m_seconds = qMin(run.m_seconds, seconds);
+        run.m_peakMemory = qMax(run.m_peakMemory, peakMemory);
+        if (peakReset && (memoryBefore >= 0) && (peakMemory >= 0))
+        {
+            run.m_memoryGrowth = qMax(run.m_memoryGrowth, peakMemory - memoryBefore);
+        }
+        run.m_rows = storagePtr->rowCount();
+        run.m_storagePtr = storagePtr;
+
+        if (!run.m_errors.isEmpty())
+        {
+            break;
+        }
+    }
+    return run;
+}
+
+void LogParserBenchmark::runParser(parserType type, LogdataStorage::Ptr storagePtr, parseRun &run) const
+{
+    QFile logfile(m_logs.value(static_cast<int>(logFormatOf(type))).m_fileName);
+    if (!logfile.open(QIODevice::ReadOnly))
+    {
+        run.m_errors.append("Unable to open " + logfile.fileName() + ": " + logfile.errorString());
+        return;
+    }
+
+    benchmarkCallback callback;
+    switch (type)
+    {
+    case parserType::BinaryMapped:
+    case parserType::BinaryUnmapped:
+    {
+        BinLogParser parser(storagePtr, &callback);
+        parser.setUseMappedFile(type == parserType::BinaryMapped);
+        run.m_status = parser.parse(logfile);
+        break;
+    }
+    case parserType::Ascii:
+    {
+        AsciiLogParser parser(storagePtr, &callback);
+        run.m_status = parser.parse(logfile);
+        break;
+    }
+    case parserType::Tlog:
+    {
+        TlogParser parser(storagePtr, &callback);
+        run.m_status = parser.parse(logfile);
+        break;
+    }
+    }
+    run.m_errors.append(callback.m_errors);
+}
+
+void LogParserBenchmark::benchmarkParser(parserType type, const QString &name, LogdataStorage::Ptr *storagePtr)
+{
+    const generatedLog log = m_logs.value(static_cast<int>(logFormatOf(type)));
+    QVERIFY2(!log.m_fileName.isEmpty(), "The log was not generated");
+
+    const parseRun run = parse(type);
+    QVERIFY2(run.m_errors.isEmpty(), qPrintable(run.m_errors.join("; ")));
+    QVERIFY2(run.m_rows > 0, "The datamodel is empty after parsing");
+    if (run.m_status.getParsingState() != AP2DataPlotStatus::OK)
+    {
+        QWARN(qPrintable(name + ": " + run.m_status.getErrorOverview()));
+    }
+
+    const double seconds = qMax(1e-9, run.m_seconds);
+    report(name + ".time", run.m_seconds * 1000.0, "ms", false);
+    report(name + ".throughput", log.m_result.m_bytes / s_MiB / seconds, "MiB/s", true);
+    report(name + ".messageRate", log.m_result.m_messages / seconds, "messages/s", true);
+    report(name + ".rowRate", run.m_rows / seconds, "rows/s", true);
+    if (run.m_peakMemory >= 0)
+    {
+        report(name + ".peakMemory", run.m_peakMemory / s_MiB, "MiB", false);
+    }
+    if (run.m_memoryGrowth >= 0)
+    {
+        report(name + ".memoryGrowth", run.m_memoryGrowth / s_MiB, "MiB", false);
+    }
+    QTest::setBenchmarkResult(log.m_result.m_bytes / seconds, QTest::BytesPerSecond);
+
+    if (storagePtr != nullptr)
+    {
+        *storagePtr = run.m_storagePtr;
+    }
+
+    const QString regressions = takeRegressions();
+    QVERIFY2(regressions.isEmpty(), qPrintable(regressions));
+}
+
+LogdataStorage::Ptr LogParserBenchmark::binStorage()
+{
+    if (!m_binStoragePtr)
+    {
+        parseRun run;
+        LogdataStorage::Ptr storagePtr(new LogdataStorage());
+        runParser(parserType::BinaryMapped, storagePtr, run);
+        if (run.m_errors.isEmpty() && (storagePtr->rowCount() > 0))
+        {
+            m_binStoragePtr = storagePtr;
+        }
+    }
+    return m_binStoragePtr;
+}
+
+void LogParserBenchmark::report(const QString &name, double value, const QString &unit, bool higherIsBetter)
+{
+    QJsonObject measurement;
+    measurement.insert("value", value);
+    measurement.insert("unit", unit);
+    measurement.insert("higherIsBetter", higherIsBetter);
+    m_results.insert(name, measurement);
+
+    QString comparison;
+    const double baseline = m_baseline.value(name).toObject().value("value").toDouble();
+    if (baseline > 0.0)
+    {
+        const double change = (value - baseline) / baseline;
+        comparison = QString("  (baseline %1, %2%3%)").arg(baseline, 0, 'f', 3)
+                                                      .arg(change >= 0.0 ? "+" : "")
+                                                      .arg(change * 100.0, 0, 'f', 1);
+        const bool regression = higherIsBetter ? (change < -s_Options.m_tolerance) : (change > s_Options.m_tolerance);
+        if (regression)
+        {
+            m_regressions.append(QString("%1 is %2 %3, baseline %4 %3").arg(name).arg(value, 0, 'f', 3)
+                                                                         .arg(unit).arg(baseline, 0, 'f', 3));
+        }
+    }
+
+    QTextStream out(stdout);
+    out << "RESULT " << name.leftJustified(36) << QString::number(value, 'f', 3).rightJustified(16) << ' '
+        << unit << comparison << '\n';
+    out.flush();
+}
+
+QString LogParserBenchmark::takeRegressions()
+{
+    const QString regressions = m_regressions.join("; ");
+    m_regressions.clear();
+    return regressions;
+}
+
+SyntheticLogGenerator::logFormat LogParserBenchmark::logFormatOf(parserType type)
+{
+    switch (type)
+    {
+    case parserType::Ascii:
+        return SyntheticLogGenerator::logFormat::Ascii;
+    case parserType::Tlog:
+        return SyntheticLogGenerator::logFormat::Tlog;
+    case parserType::BinaryMapped:
+    case parserType::BinaryUnmapped:
+        break;
+    }
+    return SyntheticLogGenerator::logFormat::Binary;
+}
+
+DECLARE_TEST(LogParserBenchmark)
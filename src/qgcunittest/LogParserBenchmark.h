@@ -0,0 +1,195 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief LogParserBenchmark
+ *          Measures log loading speed and datamodel access of the log analysis.
+ *
+ */
+
+#ifndef LOGPARSERBENCHMARK_H
+#define LOGPARSERBENCHMARK_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QScopedPointer>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "SyntheticLogGenerator.h"
+#include "Loghandling/AP2DataPlotStatus.h"
+#include "Loghandling/LogdataStorage.h"
+
+/**
+ * @brief The LogParserBenchmark class parses synthetic logs with BinLogParser,
+ *        AsciiLogParser and TlogParser and measures parse throughput, peak memory,
+ *        LogdataStorage::getValues() latency and the latency of the table model.
+ *
+ *        Every measurement is printed, reported to QtTest and can be written to a
+ *        JSON file. If a result file of an earlier run is given as baseline, a test
+ *        fails if one of its measurements is worse than the baseline by more than
+ *        the tolerance.
+ */
+class LogParserBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * @brief The options struct holds the settings of a benchmark run
+     */
+    struct options
+    {
+        SyntheticLogGenerator::config m_log;    /// size and message mix of the logs
+        int m_repetitions = 3;                  /// parse runs per log, the fastest one counts
+        QString m_logDir;                       /// directory for the logs. Empty uses a temporary one.
+        QString m_resultFile;                   /// JSON file for the results. Empty writes none.
+        QString m_baselineFile;                 /// JSON result file of an earlier run. Empty compares nothing.
+        double m_tolerance = 0.15;              /// allowed relative deviation from the baseline
+    };
+
+    /**
+     * @brief setOptions sets the options for all following runs. Must be called
+     *        before the test is executed.
+     */
+    static void setOptions(const options &opts);
+
+    LogParserBenchmark();
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void parseBinLog();
+    void parseBinLogUnmapped();
+    void parseAsciiLog();
+    void parseTlog();
+    void getValues();
+    void tableModelAccess();
+
+private:
+
+    static const int s_VisibleRows = 40;        /// rows a table view shows at once
+    static const int s_ScrollPositions = 250;   /// number of pages read by tableModelAccess()
+
+    /**
+     * @brief The parserType enum lists the parser variants measured
+     */
+    enum class parserType
+    {
+        BinaryMapped,
+        BinaryUnmapped,
+        Ascii,
+        Tlog
+    };
+
+    /**
+     * @brief The parseRun struct holds the measurements of parsing a log
+     */
+    struct parseRun
+    {
+        double m_seconds = 0.0;             /// time of the fastest run
+        qint64 m_peakMemory = -1;           /// highest peak resident memory of all runs in bytes, -1 if unknown
+        qint64 m_memoryGrowth = -1;         /// highest growth of the resident memory during a run in bytes
+        int m_rows = 0;                     /// rows in the datamodel
+        AP2DataPlotStatus m_status;         /// parser status of the last run
+        QStringList m_errors;               /// errors reported to the parser callback
+        LogdataStorage::Ptr m_storagePtr;   /// datamodel of the last run
+    };
+
+    /**
+     * @brief The generatedLog struct describes one of the synthetic logs
+     */
+    struct generatedLog
+    {
+        QString m_fileName;
+        SyntheticLogGenerator::result m_result;
+    };
+
+    static options s_Options;
+
+    QScopedPointer<QTemporaryDir> m_tempDirPtr;     /// holds the logs if no log dir is given
+    QHash<int, generatedLog> m_logs;                /// the logs by SyntheticLogGenerator::logFormat
+    LogdataStorage::Ptr m_binStoragePtr;            /// datamodel of the binary log for the access benchmarks
+    QJsonObject m_baseline;                         /// measurements of the baseline by name
+    QJsonObject m_results;                          /// measurements of this run by name
+    QStringList m_regressions;                      /// measurements worse than the baseline in the current test
+
+    /**
+     * @brief generateLog writes a synthetic log into the log dir
+     * @return false if writing failed
+     */
+    bool generateLog(SyntheticLogGenerator::logFormat format, const QString &dir);
+
+    /**
+     * @brief parse parses a generated log s_Options.m_repetitions times
+     * @param type - the parser to use
+     */
+    parseRun parse(parserType type);
+
+    /**
+     * @brief runParser parses a log once
+     * @param type - the parser to use
+     * @param storagePtr - empty datamodel
+     * @param run - status and errors are stored here
+     */
+    void runParser(parserType type, LogdataStorage::Ptr storagePtr, parseRun &run) const;
+
+    /**
+     * @brief benchmarkParser parses a log, reports all measurements and verifies the result
+     * @param type - the parser to use
+     * @param name - name of the measurements
+     * @param storagePtr - gets the datamodel of the last run if not nullptr
+     */
+    void benchmarkParser(parserType type, const QString &name, LogdataStorage::Ptr *storagePtr = nullptr);
+
+    /**
+     * @brief binStorage delivers the datamodel of the binary log, parses the log if needed
+     */
+    LogdataStorage::Ptr binStorage();
+
+    /**
+     * @brief report prints a measurement, stores it in the results and compares
+     *        it with the baseline
+     * @param name - unique name of the measurement like "parseBinLog.throughput"
+     * @param value - the measured value
+     * @param unit - unit of the value for printing
+     * @param higherIsBetter - true for throughput, false for latencies and memory
+     */
+    void report(const QString &name, double value, const QString &unit, bool higherIsBetter);
+
+    /**
+     * @brief takeRegressions delivers the regressions of the current test and clears them
+     */
+    QString takeRegressions();
+
+    /**
+     * @brief logFormatOf delivers the log format a parser reads
+     */
+    static SyntheticLogGenerator::logFormat logFormatOf(parserType type);
+};
+
+#endif // LOGPARSERBENCHMARK_H
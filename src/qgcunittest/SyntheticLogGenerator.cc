@@ -0,0 +1,722 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief SyntheticLogGenerator
+ *          Writes deterministic ArduPilot logs (.bin, .log, .tlog) for benchmarking
+ *          the log parsers.
+ *
+ */
+
+#include "SyntheticLogGenerator.h"
+
+#include <mavlink.h>
+
+#include <QFile>
+#include <QtCore/qmath.h>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+const quint64 s_BootTimeUs = 1500000;               /// time stamp of the first message in µs since boot
+const quint64 s_EpochUs = 1700000000000000ULL;      /// time of the boot in µs since epoch for tlogs
+const quint8 s_SystemId = 1;
+const quint8 s_ComponentId = 1;
+
+/** @brief Unit IDs and names like ArduPilot writes them in UNIT messages */
+const struct
+{
+    char m_id;
+    const char *m_name;
+} s_Units[] = {
+    { '-', "" }, { '#', "instance" }, { 's', "s" }, { 'm', "m" }, { 'n', "m/s" },
+    { 'o', "m/s/s" }, { 'E', "rad/s" }, { 'd', "deg" }, { 'h', "degheading" },
+    { 'D', "deglatitude" }, { 'U', "deglongitude" }, { 'O', "degC" }, { 'P', "Pa" },
+    { 'S', "satellites" }, { 'z', "Hz" }
+};
+
+/** @brief Multiplier IDs and values like ArduPilot writes them in MULT messages */
+const struct
+{
+    char m_id;
+    double m_value;
+} s_Multipliers[] = {
+    { '-', 0.0 }, { '?', 1.0 }, { '0', 1.0 }, { 'B', 1e-2 }, { 'C', 1e-3 }, { 'F', 1e-6 }, { 'G', 1e-7 }
+};
+
+/** @brief Flight modes of the simulated flight, ArduCopter numbering */
+const struct
+{
+    quint8 m_number;
+    const char *m_name;
+} s_Modes[] = {
+    { 0, "STABILIZE" }, { 2, "ALT_HOLD" }, { 5, "LOITER" }, { 3, "AUTO" }, { 6, "RTL" }
+};
+
+const char *const s_Texts[] = {
+    "EKF3 IMU0 is using GPS",
+    "EKF3 IMU1 is using GPS",
+    "GPS 1: detected as u-blox at 230400 baud",
+    "Reached command #3",
+    "PreArm: synthetic benchmark log"
+};
+
+/** @brief Prefixes of the generated parameter names */
+const char *const s_ParameterGroups[] = {
+    "ATC_", "PSC_", "INS_", "EK3_", "BATT_", "SERVO", "RC", "GPS_", "COMPASS_", "LOG_"
+};
+
+template <typename T, int N>
+constexpr int arraySize(const T (&)[N])
+{
+    return N;
+}
+
+template <typename T>
+void putValue(char *&pos, T value)
+{
+    value = qToLittleEndian(value);
+    memcpy(pos, &value, sizeof(T));
+    pos += sizeof(T);
+}
+
+void putText(char *&pos, const QByteArray &text, int size)
+{
+    memset(pos, 0, static_cast<size_t>(size));
+    memcpy(pos, text.constData(), static_cast<size_t>(qMin(text.size(), size)));
+    pos += size;
+}
+}
+
+SyntheticLogGenerator::messageType::messageType(quint8 id, const char *name, const char *format, const char *labels,
+                                                const char *units, const char *multipliers) :
+    m_id(id),
+    m_name(name),
+    m_format(format),
+    m_labels(labels),
+    m_units(units),
+    m_multipliers(multipliers),
+    m_length(3 + SyntheticLogGenerator::payloadLength(format))
+{
+}
+
+SyntheticLogGenerator::SyntheticLogGenerator(const config &conf) :
+    m_config(conf),
+    m_format(logFormat::Binary),
+    mp_device(nullptr),
+    m_writeError(false),
+    m_randomState(0)
+{
+    m_config.m_imuRate = qMax(1, m_config.m_imuRate);
+
+    m_types << messageType(128, "FMT", "BBnNZ", "Type,Length,Name,Format,Columns", nullptr, nullptr)
+            << messageType(177, "UNIT", "QbZ", "TimeUS,Id,Label", "s--", "F--")
+            << messageType(178, "MULT", "Qbd", "TimeUS,Id,Mult", "s--", "F--")
+            << messageType(179, "FMTU", "QBNN", "TimeUS,FmtType,UnitIds,MultIds", "s---", "F---")
+            << messageType(64, "PARM", "QNf", "TimeUS,Name,Value", "s--", "F--")
+            << messageType(65, "MODE", "QMBB", "TimeUS,Mode,ModeNum,Rsn", "s---", "F---")
+            << messageType(66, "MSG", "QZ", "TimeUS,Message", "s-", "F-")
+            << messageType(67, "IMU", "QBffffffIIfBBHH",
+                           "TimeUS,I,GyrX,GyrY,GyrZ,AccX,AccY,AccZ,EG,EA,T,GH,AH,GHz,AHz",
+                           "s#EEEooo--O--zz", "F-000000-----00")
+            << messageType(68, "ATT", "QccccCCCC", "TimeUS,DesRoll,Roll,DesPitch,Pitch,DesYaw,Yaw,ErrRP,ErrYaw",
+                           "sddddhhdh", "FBBBBBBBB")
+            << messageType(69, "BARO", "QBffcfIf", "TimeUS,I,Alt,Press,Temp,CRt,SMS,Offset",
+                           "s#mPOnsm", "F-00B0C0")
+            << messageType(70, "GPS", "QBBIHBcLLeffffB",
+                           "TimeUS,I,Status,GMS,GWk,NSats,HDop,Lat,Lng,Alt,Spd,GCrs,VZ,Yaw,U",
+                           "s#-s-S-DUmnhnh-", "F--C-0BGGB000--");
+}
+
+SyntheticLogGenerator::result SyntheticLogGenerator::write(logFormat format, QIODevice &device)
+{
+    m_format = format;
+    mp_device = &device;
+    m_buffer.clear();
+    m_buffer.reserve(s_WriteBlockSize + 1024);
+    m_result = result();
+    m_writeError = false;
+
+    // splitmix64 of the seed, the state of xorshift must not be 0
+    quint64 seed = m_config.m_seed + 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    m_randomState = (seed ^ (seed >> 31)) | 1;
+
+    if (format == logFormat::Tlog)
+    {
+        writeTlog();
+    }
+    else
+    {
+        writeDataflash();
+    }
+    flush();
+    mp_device = nullptr;
+
+    if (m_writeError)
+    {
+        m_result.m_bytes = 0;
+    }
+    return m_result;
+}
+
+SyntheticLogGenerator::result SyntheticLogGenerator::writeFile(logFormat format, const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return result();
+    }
+    result fileResult = write(format, file);
+    file.close();
+    if (file.error() != QFileDevice::NoError)
+    {
+        fileResult.m_bytes = 0;
+    }
+    return fileResult;
+}
+
+QString SyntheticLogGenerator::fileSuffix(logFormat format)
+{
+    switch (format)
+    {
+    case logFormat::Binary:
+        return QString("bin");
+    case logFormat::Ascii:
+        return QString("log");
+    case logFormat::Tlog:
+        return QString("tlog");
+    }
+    return QString();
+}
+
+void SyntheticLogGenerator::writeDataflash()
+{
+    // Header like ArduPilot writes it: formats, units and multipliers, then the parameters
+    const messageType &fmt = type("FMT");
+    for (const auto &logType : m_types)
+    {
+        writeMessage(fmt, { static_cast<double>(logType.m_id), static_cast<double>(logType.m_length) },
+                     { logType.m_name, logType.m_format, logType.m_labels });
+    }
+
+    quint64 timeUs = s_BootTimeUs;
+    for (const auto &unit : s_Units)
+    {
+        writeMessage(type("UNIT"), { static_cast<double>(timeUs), static_cast<double>(unit.m_id) }, { unit.m_name });
+    }
+    for (const auto &multiplier : s_Multipliers)
+    {
+        writeMessage(type("MULT"), { static_cast<double>(timeUs), static_cast<double>(multiplier.m_id), multiplier.m_value });
+    }
+    for (const auto &logType : m_types)
+    {
+        if (logType.m_units != nullptr)
+        {
+            writeMessage(type("FMTU"), { static_cast<double>(timeUs), static_cast<double>(logType.m_id) },
+                         { logType.m_units, logType.m_multipliers });
+        }
+    }
+
+    const messageType &parm = type("PARM");
+    for (int i = 0; i < m_config.m_parameterCount; ++i)
+    {
+        // The first one lets the parser detect a copter
+        const QByteArray name = (i == 0) ? QByteArray("ATC_RAT_RLL_P")
+                                         : QByteArray(s_ParameterGroups[i % arraySize(s_ParameterGroups)])
+                                           + QByteArray::number(i);
+        writeMessage(parm, { static_cast<double>(timeUs), qRound(noise() * 10000.0) / 100.0 }, { name });
+        timeUs += 100;
+    }
+
+    const messageType &mode = type("MODE");
+    const messageType &msg = type("MSG");
+    const messageType &imu = type("IMU");
+    const messageType &att = type("ATT");
+    const messageType &baro = type("BARO");
+    const messageType &gps = type("GPS");
+
+    const int imuRate = m_config.m_imuRate;
+    const qint64 textSteps = static_cast<qint64>(m_config.m_textInterval) * imuRate;
+    const qint64 modeSteps = static_cast<qint64>(m_config.m_modeInterval) * imuRate;
+    const quint64 startUs = timeUs;
+    qint64 messagesLastSecond = m_result.m_messages;
+
+    for (qint64 step = 0; !targetReached(); ++step)
+    {
+        if ((step % imuRate == 0) && (step > 0))
+        {
+            if (m_result.m_messages == messagesLastSecond)
+            {
+                break;  // all messages are disabled, the log would never reach its size
+            }
+            messagesLastSecond = m_result.m_messages;
+        }
+
+        const double t = static_cast<double>(step) / imuRate;
+        timeUs = startUs + static_cast<quint64>(step) * 1000000 / static_cast<quint64>(imuRate);
+        const double time = static_cast<double>(timeUs);
+        m_result.m_duration = t;
+
+        // Smooth flight with some noise on the sensors
+        const double roll = 15.0 * qSin(0.3 * t);
+        const double pitch = 10.0 * qSin(0.23 * t + 1.0);
+        const double yaw = std::fmod(20.0 * t, 360.0);
+        const double altitude = 30.0 * (1.0 - qCos(0.05 * t));
+        const double climbRate = 1.5 * qSin(0.05 * t);
+
+        if (modeSteps > 0 && step % modeSteps == 0)
+        {
+            const auto &flightMode = s_Modes[(step / modeSteps) % arraySize(s_Modes)];
+            writeMessage(mode, { time, static_cast<double>(flightMode.m_number), static_cast<double>(flightMode.m_number), 1.0 },
+                         { flightMode.m_name });
+        }
+        if (textSteps > 0 && step % textSteps == 0)
+        {
+            writeMessage(msg, { time }, { s_Texts[(step / textSteps) % arraySize(s_Texts)] });
+        }
+
+        for (int instance = 0; instance < m_config.m_imuInstances; ++instance)
+        {
+            writeMessage(imu, { time, static_cast<double>(instance),
+                                qDegreesToRadians(4.5 * qCos(0.3 * t)) + 0.02 * noise(),
+                                qDegreesToRadians(2.3 * qCos(0.23 * t + 1.0)) + 0.02 * noise(),
+                                qDegreesToRadians(20.0) + 0.02 * noise(),
+                                0.3 * noise(), 0.3 * noise(), -9.81 + 0.5 * noise(),
+                                0.0, 0.0, 45.0 + instance + 0.1 * noise(), 1.0, 1.0,
+                                static_cast<double>(imuRate), static_cast<double>(imuRate) });
+        }
+
+        if (due(step, m_config.m_attitudeRate))
+        {
+            writeMessage(att, { time, roll, roll + 0.5 * noise(), pitch, pitch + 0.5 * noise(), yaw,
+                                std::fmod(yaw + 360.0 + noise(), 360.0), 0.02 + 0.01 * noise(), 0.05 + 0.02 * noise() });
+        }
+
+        if (due(step, m_config.m_baroRate))
+        {
+            const double baroAltitude = altitude + 0.2 * noise();
+            writeMessage(baro, { time, 0.0, baroAltitude, 101325.0 - 12.0 * baroAltitude, 25.3 + 0.1 * noise(),
+                                 climbRate + 0.1 * noise(), static_cast<double>(timeUs / 1000), 0.0 });
+        }
+
+        if (due(step, m_config.m_gpsRate))
+        {
+            writeMessage(gps, { time, 0.0, 6.0, 345600000.0 + qRound(t * 1000.0), 2300.0, 14.0 + qRound(noise()),
+                                0.8 + 0.05 * noise(), -35.363261 + 0.0005 * qSin(0.02 * t), 149.165230 + 0.0005 * qCos(0.02 * t),
+                                584.0 + altitude, 5.0 + 0.2 * noise(), yaw, -climbRate, 0.0, 1.0 });
+        }
+    }
+}
+
+void SyntheticLogGenerator::writeTlog()
+{
+    // The channel status holds the sequence number, restart it so every log is the same
+    mavlink_get_channel_status(MAVLINK_COMM_0)->current_tx_seq = 0;
+
+    mavlink_message_t message;
+    quint8 frame[MAVLINK_MAX_PACKET_LEN];
+    quint64 timeUs = s_BootTimeUs;
+
+    // A ground station downloads the parameters first
+    for (int i = 0; i < m_config.m_parameterCount; ++i)
+    {
+        mavlink_param_value_t param;
+        memset(&param, 0, sizeof(param));
+        const QByteArray name = (i == 0) ? QByteArray("ATC_RAT_RLL_P")
+                                         : QByteArray(s_ParameterGroups[i % arraySize(s_ParameterGroups)])
+                                           + QByteArray::number(i);
+        strncpy(param.param_id, name.constData(), sizeof(param.param_id));
+        param.param_value = static_cast<float>(qRound(noise() * 10000.0) / 100.0);
+        param.param_type = MAV_PARAM_TYPE_REAL32;
+        param.param_count = static_cast<quint16>(m_config.m_parameterCount);
+        param.param_index = static_cast<quint16>(i);
+        mavlink_msg_param_value_encode_chan(s_SystemId, s_ComponentId, MAVLINK_COMM_0, &message, &param);
+        writeTlogMessage(s_EpochUs + timeUs, frame, mavlink_msg_to_send_buffer(frame, &message));
+        timeUs += 100;
+    }
+
+    const int imuRate = m_config.m_imuRate;
+    const qint64 textSteps = static_cast<qint64>(m_config.m_textInterval) * imuRate;
+    const qint64 modeSteps = static_cast<qint64>(m_config.m_modeInterval) * imuRate;
+    const quint64 startUs = timeUs;
+    qint64 messagesLastSecond = m_result.m_messages;
+
+    for (qint64 step = 0; !targetReached(); ++step)
+    {
+        if ((step % imuRate == 0) && (step > 0))
+        {
+            if (m_result.m_messages == messagesLastSecond)
+            {
+                break;  // all messages are disabled, the log would never reach its size
+            }
+            messagesLastSecond = m_result.m_messages;
+        }
+
+        const double t = static_cast<double>(step) / imuRate;
+        timeUs = startUs + static_cast<quint64>(step) * 1000000 / static_cast<quint64>(imuRate);
+        const quint32 timeMs = static_cast<quint32>(timeUs / 1000);
+        m_result.m_duration = t;
+
+        const double roll = 15.0 * qSin(0.3 * t);
+        const double pitch = 10.0 * qSin(0.23 * t + 1.0);
+        const double yaw = std::fmod(20.0 * t, 360.0);
+        const double altitude = 30.0 * (1.0 - qCos(0.05 * t));
+        const double climbRate = 1.5 * qSin(0.05 * t);
+
+        if (step % imuRate == 0)
+        {
+            mavlink_heartbeat_t heartbeat;
+            memset(&heartbeat, 0, sizeof(heartbeat));
+            heartbeat.type = MAV_TYPE_QUADROTOR;
+            heartbeat.autopilot = MAV_AUTOPILOT_ARDUPILOTMEGA;
+            heartbeat.base_mode = MAV_MODE_FLAG_CUSTOM_MODE_ENABLED | MAV_MODE_FLAG_SAFETY_ARMED;
+            heartbeat.custom_mode = (modeSteps > 0) ? s_Modes[(step / modeSteps) % arraySize(s_Modes)].m_number
+                                                    : s_Modes[0].m_number;
+            heartbeat.system_status = MAV_STATE_ACTIVE;
+            heartbeat.mavlink_version = 3;
+            mavlink_msg_heartbeat_encode_chan(s_SystemId, s_ComponentId, MAVLINK_COMM_0, &message, &heartbeat);
+            writeTlogMessage(s_EpochUs + timeUs, frame, mavlink_msg_to_send_buffer(frame, &message));
+        }
+
+        if (textSteps > 0 && step % textSteps == 0)
+        {
+            mavlink_statustext_t statustext;
+            memset(&statustext, 0, sizeof(statustext));
+            statustext.severity = MAV_SEVERITY_INFO;
+            strncpy(statustext.text, s_Texts[(step / textSteps) % arraySize(s_Texts)], sizeof(statustext.text));
+            mavlink_msg_statustext_encode_chan(s_SystemId, s_ComponentId, MAVLINK_COMM_0, &message, &statustext);
+            writeTlogMessage(s_EpochUs + timeUs, frame, mavlink_msg_to_send_buffer(frame, &message));
+        }
+
+        for (int instance = 0; instance < m_config.m_imuInstances; ++instance)
+        {
+            mavlink_raw_imu_t imu;
+            memset(&imu, 0, sizeof(imu));
+            imu.time_usec = timeUs;
+            imu.xacc = static_cast<qint16>(qRound(30.0 * noise()));
+            imu.yacc = static_cast<qint16>(qRound(30.0 * noise()));
+            imu.zacc = static_cast<qint16>(qRound(-1000.0 + 50.0 * noise()));
+            imu.xgyro = static_cast<qint16>(qRound(1000.0 * qDegreesToRadians(4.5 * qCos(0.3 * t)) + 20.0 * noise()));
+            imu.ygyro = static_cast<qint16>(qRound(1000.0 * qDegreesToRadians(2.3 * qCos(0.23 * t + 1.0)) + 20.0 * noise()));
+            imu.zgyro = static_cast<qint16>(qRound(1000.0 * qDegreesToRadians(20.0) + 20.0 * noise()));
+            imu.xmag = static_cast<qint16>(qRound(200.0 * qCos(qDegreesToRadians(yaw))));
+            imu.ymag = static_cast<qint16>(qRound(200.0 * qSin(qDegreesToRadians(yaw))));
+            imu.zmag = -400;
+            imu.id = static_cast<quint8>(instance);
+            imu.temperature = static_cast<qint16>(qRound((45.0 + instance + 0.1 * noise()) * 100.0));
+            mavlink_msg_raw_imu_encode_chan(s_SystemId, s_ComponentId, MAVLINK_COMM_0, &message, &imu);
+            writeTlogMessage(s_EpochUs + timeUs, frame, mavlink_msg_to_send_buffer(frame, &message));
+        }
+
+        if (due(step, m_config.m_attitudeRate))
+        {
+            mavlink_attitude_t attitude;
+            memset(&attitude, 0, sizeof(attitude));
+            attitude.time_boot_ms = timeMs;
+            attitude.roll = static_cast<float>(qDegreesToRadians(roll + 0.5 * noise()));
+            attitude.pitch = static_cast<float>(qDegreesToRadians(pitch + 0.5 * noise()));
+            attitude.yaw = static_cast<float>(qDegreesToRadians(yaw > 180.0 ? yaw - 360.0 : yaw));
+            attitude.rollspeed = static_cast<float>(qDegreesToRadians(4.5 * qCos(0.3 * t)));
+            attitude.pitchspeed = static_cast<float>(qDegreesToRadians(2.3 * qCos(0.23 * t + 1.0)));
+            attitude.yawspeed = static_cast<float>(qDegreesToRadians(20.0));
+            mavlink_msg_attitude_encode_chan(s_SystemId, s_ComponentId, MAVLINK_COMM_0, &message, &attitude);
+            writeTlogMessage(s_EpochUs + timeUs, frame, mavlink_msg_to_send_buffer(frame, &message));
+        }
+
+        if (due(step, m_config.m_baroRate))
+        {
+            mavlink_scaled_pressure_t pressure;
+            memset(&pressure, 0, sizeof(pressure));
+            pressure.time_boot_ms = timeMs;
+            pressure.press_abs = static_cast<float>((101325.0 - 12.0 * (altitude + 0.2 * noise())) / 100.0);
+            pressure.temperature = static_cast<qint16>(qRound((25.3 + 0.1 * noise()) * 100.0));
+            mavlink_msg_scaled_pressure_encode_chan(s_SystemId, s_ComponentId, MAVLINK_COMM_0, &message, &pressure);
+            writeTlogMessage(s_EpochUs + timeUs, frame, mavlink_msg_to_send_buffer(frame, &message));
+        }
+
+        if (due(step, m_config.m_gpsRate))
+        {
+            mavlink_gps_raw_int_t gps;
+            memset(&gps, 0, sizeof(gps));
+            gps.time_usec = timeUs;
+            gps.fix_type = GPS_FIX_TYPE_RTK_FLOAT;
+            gps.lat = static_cast<qint32>(qRound64((-35.363261 + 0.0005 * qSin(0.02 * t)) * 1e7));
+            gps.lon = static_cast<qint32>(qRound64((149.165230 + 0.0005 * qCos(0.02 * t)) * 1e7));
+            gps.alt = static_cast<qint32>(qRound((584.0 + altitude) * 1000.0));
+            gps.eph = static_cast<quint16>(qRound((0.8 + 0.05 * noise()) * 100.0));
+            gps.epv = 120;
+            gps.vel = static_cast<quint16>(qRound((5.0 + 0.2 * noise()) * 100.0));
+            gps.cog = static_cast<quint16>(qRound(yaw * 100.0));
+            gps.satellites_visible = static_cast<quint8>(14 + qRound(noise()));
+            mavlink_msg_gps_raw_int_encode_chan(s_SystemId, s_ComponentId, MAVLINK_COMM_0, &message, &gps);
+            writeTlogMessage(s_EpochUs + timeUs, frame, mavlink_msg_to_send_buffer(frame, &message));
+        }
+    }
+}
+
+void SyntheticLogGenerator::writeMessage(const messageType &type, const QVector<double> &numbers, const QList<QByteArray> &texts)
+{
+    int number = 0;
+    int text = 0;
+
+    if (m_format == logFormat::Binary)
+    {
+        char message[256];
+        char *pos = message;
+        *pos++ = static_cast<char>(0xA3);
+        *pos++ = static_cast<char>(0x95);
+        *pos++ = static_cast<char>(type.m_id);
+
+        for (const char *field = type.m_format; *field != '\0'; ++field)
+        {
+            switch (*field)
+            {
+            case 'n':
+                putText(pos, texts.value(text++), 4);
+                continue;
+            case 'N':
+                putText(pos, texts.value(text++), 16);
+                continue;
+            case 'Z':
+                putText(pos, texts.value(text++), 64);
+                continue;
+            case 'M':
+                ++text;     // binary logs only contain the number of the mode
+                break;
+            default:
+                break;
+            }
+
+            const double value = numbers.value(number++);
+            switch (*field)
+            {
+            case 'b':
+                putValue(pos, static_cast<qint8>(qRound(value)));
+                break;
+            case 'B':
+            case 'M':
+                putValue(pos, static_cast<quint8>(qRound(value)));
+                break;
+            case 'h':
+                putValue(pos, static_cast<qint16>(qRound(value)));
+                break;
+            case 'H':
+                putValue(pos, static_cast<quint16>(qRound(value)));
+                break;
+            case 'i':
+                putValue(pos, static_cast<qint32>(qRound64(value)));
+                break;
+            case 'I':
+                putValue(pos, static_cast<quint32>(qRound64(value)));
+                break;
+            case 'f':
+                putValue(pos, static_cast<float>(value));
+                break;
+            case 'd':
+                putValue(pos, value);
+                break;
+            case 'c':
+                putValue(pos, static_cast<qint16>(qRound(value * 100.0)));
+                break;
+            case 'C':
+                putValue(pos, static_cast<quint16>(qRound(value * 100.0)));
+                break;
+            case 'e':
+                putValue(pos, static_cast<qint32>(qRound64(value * 100.0)));
+                break;
+            case 'E':
+                putValue(pos, static_cast<quint32>(qRound64(value * 100.0)));
+                break;
+            case 'L':
+                putValue(pos, static_cast<qint32>(qRound64(value * 1e7)));
+                break;
+            case 'q':
+                putValue(pos, static_cast<qint64>(qRound64(value)));
+                break;
+            case 'Q':
+                putValue(pos, static_cast<quint64>(qRound64(value)));
+                break;
+            default:
+                Q_ASSERT_X(false, "SyntheticLogGenerator::writeMessage", "unsupported format character");
+                break;
+            }
+        }
+        Q_ASSERT(pos - message == type.m_length);
+        append(message, static_cast<int>(pos - message));
+    }
+    else
+    {
+        QByteArray line(type.m_name);
+        for (const char *field = type.m_format; *field != '\0'; ++field)
+        {
+            line.append(", ");
+            switch (*field)
+            {
+            case 'n':
+            case 'N':
+            case 'Z':
+                line.append(texts.value(text++));
+                continue;
+            case 'M':
+                ++number;   // ascii logs contain the name of the mode
+                line.append(texts.value(text++));
+                continue;
+            default:
+                break;
+            }
+
+            const double value = numbers.value(number++);
+            switch (*field)
+            {
+            case 'f':
+                line.append(QByteArray::number(value, 'g', 7));
+                break;
+            case 'd':
+                line.append(QByteArray::number(value, 'g', 12));
+                break;
+            case 'c':
+            case 'C':
+            case 'e':
+            case 'E':
+                line.append(QByteArray::number(value, 'f', 2));
+                break;
+            case 'L':
+                line.append(QByteArray::number(value, 'f', 7));
+                break;
+            case 'Q':
+                line.append(QByteArray::number(static_cast<quint64>(qRound64(value))));
+                break;
+            default:
+                line.append(QByteArray::number(qRound64(value)));
+                break;
+            }
+        }
+        line.append('\n');
+        append(line.constData(), line.size());
+    }
+    ++m_result.m_messages;
+}
+
+void SyntheticLogGenerator::writeTlogMessage(quint64 timeUs, const quint8 *frame, int length)
+{
+    const quint64 timeStamp = qToBigEndian(timeUs);
+    append(reinterpret_cast<const char *>(&timeStamp), sizeof(timeStamp));
+    append(reinterpret_cast<const char *>(frame), length);
+    ++m_result.m_messages;
+}
+
+void SyntheticLogGenerator::append(const char *data, int length)
+{
+    m_buffer.append(data, length);
+    m_result.m_bytes += length;
+    if (m_buffer.size() >= s_WriteBlockSize)
+    {
+        flush();
+    }
+}
+
+void SyntheticLogGenerator::flush()
+{
+    if (!m_buffer.isEmpty() && !m_writeError)
+    {
+        m_writeError = mp_device->write(m_buffer) != m_buffer.size();
+    }
+    m_buffer.clear();
+}
+
+bool SyntheticLogGenerator::targetReached() const
+{
+    return m_writeError || (m_result.m_bytes >= m_config.m_targetSize);
+}
+
+bool SyntheticLogGenerator::due(qint64 step, int rate) const
+{
+    if (rate <= 0)
+    {
+        return false;
+    }
+    if (step == 0 || rate >= m_config.m_imuRate)
+    {
+        return true;
+    }
+    return (step * rate) / m_config.m_imuRate != ((step - 1) * rate) / m_config.m_imuRate;
+}
+
+double SyntheticLogGenerator::noise()
+{
+    // xorshift64*
+    m_randomState ^= m_randomState >> 12;
+    m_randomState ^= m_randomState << 25;
+    m_randomState ^= m_randomState >> 27;
+    const quint64 value = (m_randomState * 0x2545F4914F6CDD1DULL) >> 11;
+    return static_cast<double>(value) / 4503599627370496.0 - 1.0;   // 2^52, value has 53 bits
+}
+
+const SyntheticLogGenerator::messageType &SyntheticLogGenerator::type(const char *name) const
+{
+    for (const auto &logType : m_types)
+    {
+        if (qstrcmp(logType.m_name, name) == 0)
+        {
+            return logType;
+        }
+    }
+    Q_ASSERT_X(false, "SyntheticLogGenerator::type", name);
+    return m_types.first();
+}
+
+int SyntheticLogGenerator::payloadLength(const char *format)
+{
+    int length = 0;
+    for (const char *field = format; *field != '\0'; ++field)
+    {
+        switch (*field)
+        {
+        case 'b': case 'B': case 'M':
+            length += 1;
+            break;
+        case 'h': case 'H': case 'c': case 'C':
+            length += 2;
+            break;
+        case 'i': case 'I': case 'f': case 'e': case 'E': case 'L': case 'n':
+            length += 4;
+            break;
+        case 'd': case 'q': case 'Q':
+            length += 8;
+            break;
+        case 'N':
+            length += 16;
+            break;
+        case 'Z': case 'a':
+            length += 64;
+            break;
+        default:
+            break;
+        }
+    }
+    return length;
+}
@@ -0,0 +1,217 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief SyntheticLogGenerator
+ *          Writes deterministic ArduPilot logs (.bin, .log, .tlog) for benchmarking
+ *          the log parsers.
+ *
+ */
+
+#ifndef SYNTHETICLOGGENERATOR_H
+#define SYNTHETICLOGGENERATOR_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The SyntheticLogGenerator class writes a simulated flight of a copter as
+ *        dataflash log (binary or ascii) or as telemetry log. The content only depends
+ *        on the config, so every run of a benchmark parses the same bytes.
+ *
+ *        Dataflash logs start like real ones with the FMT, UNIT, MULT, FMTU and PARM
+ *        messages. They are followed by IMU (several instances), ATT, BARO and GPS
+ *        messages at their configured rates and a MODE or MSG message now and then.
+ *        Telemetry logs contain the matching MAVLink messages, each with the 8 byte
+ *        time stamp a tlog has in front of every message.
+ */
+class SyntheticLogGenerator
+{
+public:
+
+    /**
+     * @brief The logFormat enum lists the formats the generator can write
+     */
+    enum class logFormat
+    {
+        Binary,     /// dataflash log (.bin)
+        Ascii,      /// dataflash log as text (.log)
+        Tlog        /// telemetry log (.tlog)
+    };
+
+    /**
+     * @brief The config struct describes size and message mix of the log.
+     *        A rate of 0 disables the message.
+     */
+    struct config
+    {
+        qint64 m_targetSize = 64 * 1024 * 1024; /// size of the log in bytes. The last time step may exceed it.
+        quint64 m_seed = 1;                     /// seed of the noise added to the signals
+        int m_imuRate = 400;                    /// Hz, rate of every IMU instance. Also the time step of the log, must be > 0.
+        int m_imuInstances = 2;                 /// number of IMUs
+        int m_attitudeRate = 50;                /// Hz
+        int m_baroRate = 20;                    /// Hz
+        int m_gpsRate = 5;                      /// Hz
+        int m_parameterCount = 900;             /// number of PARM messages at the start of the log
+        int m_textInterval = 30;                /// s between two MSG messages
+        int m_modeInterval = 120;               /// s between two MODE messages
+    };
+
+    /**
+     * @brief The result struct describes a written log
+     */
+    struct result
+    {
+        qint64 m_bytes = 0;                     /// bytes written
+        qint64 m_messages = 0;                  /// messages written
+        double m_duration = 0.0;                /// simulated flight time in s
+    };
+
+    /**
+     * @brief SyntheticLogGenerator - CTOR
+     * @param conf - size and message mix of the logs
+     */
+    explicit SyntheticLogGenerator(const config &conf);
+
+    /**
+     * @brief write writes a log to a device
+     * @param format - format of the log
+     * @param device - device opened for writing
+     * @return size, message count and duration of the log. m_bytes is 0 if writing failed.
+     */
+    result write(logFormat format, QIODevice &device);
+
+    /**
+     * @brief writeFile writes a log to a file
+     * @param format - format of the log
+     * @param fileName - name of the file. An existing file is overwritten.
+     * @return size, message count and duration of the log. m_bytes is 0 if writing failed.
+     */
+    result writeFile(logFormat format, const QString &fileName);
+
+    /**
+     * @brief fileSuffix delivers the usual suffix of a log format like "bin"
+     */
+    static QString fileSuffix(logFormat format);
+
+private:
+
+    static const int s_WriteBlockSize = 1024 * 1024;    /// Bytes collected before writing to the device
+
+    /**
+     * @brief The messageType struct describes a dataflash message type like its FMT and
+     *        FMTU messages do.
+     */
+    struct messageType
+    {
+        quint8 m_id;
+        const char *m_name;
+        const char *m_format;
+        const char *m_labels;
+        const char *m_units;        /// one unit ID per field, nullptr if the type has no FMTU
+        const char *m_multipliers;  /// one multiplier ID per field
+        int m_length;               /// length of a binary message including the header
+
+        messageType(quint8 id, const char *name, const char *format, const char *labels,
+                    const char *units, const char *multipliers);
+    };
+
+    config m_config;
+    logFormat m_format;
+    QIODevice *mp_device;
+    QByteArray m_buffer;                /// data not yet written to mp_device
+    result m_result;
+    bool m_writeError;
+    quint64 m_randomState;              /// state of the noise generator
+    QList<messageType> m_types;         /// all dataflash types, FMT first
+
+    /**
+     * @brief writeDataflash writes a binary or ascii log
+     */
+    void writeDataflash();
+
+    /**
+     * @brief writeTlog writes a telemetry log
+     */
+    void writeTlog();
+
+    /**
+     * @brief writeMessage writes one dataflash message in the current format
+     * @param type - type of the message
+     * @param numbers - values of all fields except n, N and Z in field order. Values of fields
+     *                  stored scaled in binary logs (c, C, e, E, L) are passed unscaled.
+     * @param texts - values of all string fields (n, N, Z) and the names of the flight modes (M)
+     *                in field order. Ascii logs contain the name of a mode, binary logs its number.
+     */
+    void writeMessage(const messageType &type, const QVector<double> &numbers, const QList<QByteArray> &texts = QList<QByteArray>());
+
+    /**
+     * @brief writeTlogMessage writes the time stamp and the MAVLink frame of a message
+     * @param timeUs - time stamp of the message in µs since epoch
+     * @param frame - the MAVLink frame
+     * @param length - length of the frame
+     */
+    void writeTlogMessage(quint64 timeUs, const quint8 *frame, int length);
+
+    /**
+     * @brief append adds bytes to the write buffer and writes the buffer if it is full
+     */
+    void append(const char *data, int length);
+
+    /**
+     * @brief flush writes the write buffer to the device
+     */
+    void flush();
+
+    /**
+     * @brief targetReached is true if the log reached the configured size or writing failed
+     */
+    bool targetReached() const;
+
+    /**
+     * @brief due checks whether a message with a rate is written at an IMU time step
+     * @param step - number of the IMU time step
+     * @param rate - rate of the message in Hz
+     */
+    bool due(qint64 step, int rate) const;
+
+    /**
+     * @brief noise delivers a deterministic pseudo random number in [-1, 1)
+     */
+    double noise();
+
+    /**
+     * @brief type delivers a dataflash type by name
+     */
+    const messageType &type(const char *name) const;
+
+    /**
+     * @brief payloadLength calculates the binary length of a format string
+     */
+    static int payloadLength(const char *format);
+};
+
+#endif // SYNTHETICLOGGENERATOR_H
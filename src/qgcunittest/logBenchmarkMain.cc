@@ -0,0 +1,205 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief Main of logbenchmark - benchmark of the log parsers and the
+ *          datamodel of the log analysis.
+ *
+ */
+
+#include "AutoTest.h"
+#include "LogParserBenchmark.h"
+#include "logging.h"
+
+#include <QTextStream>
+#include <QVector>
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+#define ENDL endl
+#else
+#define ENDL Qt::endl
+#endif
+
+// Create the base logging category as defined in logging.h
+Q_LOGGING_CATEGORY(apmGeneral, "apm.general");
+
+namespace
+{
+    /**
+     * @brief printHelp prints the benchmark options. All other options are passed to QtTest.
+     */
+    void printHelp(const char *application)
+    {
+        QTextStream out(stdout);
+        out << "Usage: " << application << " [benchmark options] [QtTest options] [test functions]" << ENDL << ENDL
+            << "Generates synthetic .bin, .log and .tlog files and measures the log parsers." << ENDL << ENDL
+            << "Benchmark options:" << ENDL
+            << "  --size-mb <MiB>          size of each generated log (default 64)" << ENDL
+            << "  --seed <number>          seed of the signal noise (default 1)" << ENDL
+            << "  --imu-rate <Hz>          rate of every IMU instance (default 400)" << ENDL
+            << "  --imu-instances <count>  number of IMUs (default 2)" << ENDL
+            << "  --att-rate <Hz>          rate of ATT (default 50, 0 disables)" << ENDL
+            << "  --baro-rate <Hz>         rate of BARO (default 20, 0 disables)" << ENDL
+            << "  --gps-rate <Hz>          rate of GPS (default 5, 0 disables)" << ENDL
+            << "  --params <count>         number of PARM messages (default 900)" << ENDL
+            << "  --text-interval <s>      time between two MSG messages (default 30, 0 disables)" << ENDL
+            << "  --mode-interval <s>      time between two MODE messages (default 120, 0 disables)" << ENDL
+            << "  --repetitions <count>    parse runs per log, the fastest counts (default 3)" << ENDL
+            << "  --log-dir <dir>          keep the generated logs in this directory" << ENDL
+            << "  --results <file>         write all measurements to this JSON file" << ENDL
+            << "  --baseline <file>        fail if a measurement is worse than in this result file" << ENDL
+            << "  --tolerance <percent>    allowed deviation from the baseline (default 15)" << ENDL
+            << "  --verbose                print the debug output of the parsers" << ENDL
+            << "  --bench-help             print this help" << ENDL << ENDL
+            << "Use -help for the QtTest options." << ENDL;
+    }
+}
+
+/**
+ * @brief Starts the benchmark
+ *
+ * @param argc Number of commandline arguments
+ * @param argv Commandline arguments
+ * @return number of failed tests, 2 for invalid options
+ */
+int main(int argc, char *argv[])
+{
+    LogParserBenchmark::options opts;
+    bool verbose = false;
+
+    // Our own options are removed, the remaining ones are passed to QtTest
+    QVector<char *> testArguments;
+    testArguments.append(argv[0]);
+    for (int i = 1; i < argc; ++i)
+    {
+        const QByteArray argument(argv[i]);
+        if (argument == "--verbose")
+        {
+            verbose = true;
+            continue;
+        }
+        if (argument == "--bench-help")
+        {
+            printHelp(argv[0]);
+            return 0;
+        }
+        if (!argument.startsWith("--"))
+        {
+            testArguments.append(argv[i]);
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            QTextStream(stderr) << "Missing value for " << argument << ENDL;
+            return 2;
+        }
+
+        const QByteArray value(argv[i + 1]);
+        bool ok = true;
+        if (argument == "--size-mb")
+        {
+            opts.m_log.m_targetSize = static_cast<qint64>(value.toDouble(&ok) * 1024.0 * 1024.0);
+            ok = ok && (opts.m_log.m_targetSize > 0);
+        }
+        else if (argument == "--seed")
+        {
+            opts.m_log.m_seed = value.toULongLong(&ok);
+        }
+        else if (argument == "--imu-rate")
+        {
+            opts.m_log.m_imuRate = value.toInt(&ok);
+            ok = ok && (opts.m_log.m_imuRate > 0);
+        }
+        else if (argument == "--imu-instances")
+        {
+            opts.m_log.m_imuInstances = value.toInt(&ok);
+            ok = ok && (opts.m_log.m_imuInstances >= 0);
+        }
+        else if (argument == "--att-rate")
+        {
+            opts.m_log.m_attitudeRate = value.toInt(&ok);
+        }
+        else if (argument == "--baro-rate")
+        {
+            opts.m_log.m_baroRate = value.toInt(&ok);
+        }
+        else if (argument == "--gps-rate")
+        {
+            opts.m_log.m_gpsRate = value.toInt(&ok);
+        }
+        else if (argument == "--params")
+        {
+            opts.m_log.m_parameterCount = value.toInt(&ok);
+        }
+        else if (argument == "--text-interval")
+        {
+            opts.m_log.m_textInterval = value.toInt(&ok);
+        }
+        else if (argument == "--mode-interval")
+        {
+            opts.m_log.m_modeInterval = value.toInt(&ok);
+        }
+        else if (argument == "--repetitions")
+        {
+            opts.m_repetitions = value.toInt(&ok);
+            ok = ok && (opts.m_repetitions > 0);
+        }
+        else if (argument == "--log-dir")
+        {
+            opts.m_logDir = QString::fromLocal8Bit(value);
+        }
+        else if (argument == "--results")
+        {
+            opts.m_resultFile = QString::fromLocal8Bit(value);
+        }
+        else if (argument == "--baseline")
+        {
+            opts.m_baselineFile = QString::fromLocal8Bit(value);
+        }
+        else if (argument == "--tolerance")
+        {
+            opts.m_tolerance = value.toDouble(&ok) / 100.0;
+            ok = ok && (opts.m_tolerance >= 0.0);
+        }
+        else
+        {
+            // Unknown long options belong to QtTest
+            testArguments.append(argv[i]);
+            continue;
+        }
+
+        if (!ok)
+        {
+            QTextStream(stderr) << "Invalid value " << value << " for " << argument << ENDL;
+            return 2;
+        }
+        ++i;
+    }
+
+    QLoggingCategory::setFilterRules(verbose ? QStringLiteral("apm.general.debug=true")
+                                             : QStringLiteral("apm.general.debug=false\napm.general.info=false"));
+    LogParserBenchmark::setOptions(opts);
+
+    testArguments.append(nullptr);
+    return AutoTest::run(testArguments.size() - 1, testArguments.data());
+}
@@ -0,0 +1,1438 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief Implementation of the special log messages and their formatters
+ *
+ */
+
+#include "ArduPilotMessages.h"
+#include "logging.h"
+
+#include <QTextStream>
+
+MessageBase::MessageBase(const quint32 index, const double timeStamp, const QString &name, const QColor &color) :
+    m_Index(index),
+    m_TimeStamp(timeStamp),
+    m_TypeName(name),
+    m_Color(color)
+{}
+
+quint32 MessageBase::getIndex() const
+{
+    return m_Index;
+}
+
+double MessageBase::getTimeStamp() const
+{
+    return m_TimeStamp;
+}
+
+QString MessageBase::typeName() const
+{
+    return m_TypeName;
+}
+
+QColor MessageBase::typeColor() const
+{
+    return m_Color;
+}
+
+//********
+
+const QString ErrorMessage::TypeName("ERR");
+
+ErrorMessage::ErrorMessage() : m_SubSys(0), m_ErrorCode(0)
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(150,0,0);
+}
+
+ErrorMessage::ErrorMessage(const QString &TimeFieldName) : m_SubSys(0), m_ErrorCode(0)
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(150,0,0);
+    m_TimeFieldName = TimeFieldName;
+}
+
+ErrorMessage::ErrorMessage(const quint32 index, const double timeStamp, const quint32 subSys, const quint32 errCode) :
+    MessageBase(index, timeStamp, TypeName, QColor(150,0,0)),
+    m_SubSys(subSys),
+    m_ErrorCode(errCode)
+{}
+
+quint32 ErrorMessage::getSubsystemCode() const
+{
+    return m_SubSys;
+}
+
+quint32 ErrorMessage::getErrorCode() const
+{
+    return m_ErrorCode;
+}
+
+bool ErrorMessage::setFromNameValuePairList(const QList<NameValuePair> &values, const double timeDivider)
+{
+    bool rc1 = false;
+    bool rc2 = false;
+    bool rc3 = false;
+    bool rc4 = false;
+
+    for(int i = 0; i < values.size(); ++i)
+    {
+        if(values.at(i).first == "Index")
+        {
+            m_Index = values.at(i).second.toUInt();
+            rc1 = true;
+        }
+        else if(values.at(i).first == m_TimeFieldName)
+        {
+            m_TimeStamp = values.at(i).second.toDouble();
+            m_TimeStamp /= timeDivider;
+            rc2 = true;
+        }
+        else if(values.at(i).first == "ECode")
+        {
+            m_ErrorCode = values.at(i).second.toUInt();
+            rc3 = true;
+        }
+        else if(values.at(i).first == "Subsys")
+        {
+            m_SubSys = values.at(i).second.toUInt();
+            rc4 = true;
+        }
+    }
+    return rc1 && rc2 && rc3 && rc4;
+}
+
+QString ErrorMessage::toString() const
+{
+    QString output;
+    QTextStream outputStream(&output);
+
+    outputStream << " Subsystem:" << m_SubSys << " Errorcode:" << m_ErrorCode;
+    return output;
+}
+
+//********
+
+const QString ModeMessage::TypeName("MODE");
+
+ModeMessage::ModeMessage() : m_Mode(0), m_ModeNum(0), m_Reason(0)
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(50,125,0);
+}
+
+ModeMessage::ModeMessage(const QString &TimeFieldName) : m_Mode(0), m_ModeNum(0), m_Reason(0)
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(50,125,0);
+    m_TimeFieldName = TimeFieldName;
+}
+
+ModeMessage::ModeMessage(const quint32 index, const double timeStamp, const quint32 mode, const quint32 modeNum, const quint32 reason) :
+    MessageBase(index, timeStamp, TypeName, QColor(50,125,0)),
+    m_Mode(mode),
+    m_ModeNum(modeNum),
+    m_Reason(reason)
+{}
+
+quint32 ModeMessage::getMode() const
+{
+    return m_Mode;
+}
+
+quint32 ModeMessage::getModeNum() const
+{
+    return m_ModeNum;
+}
+
+quint32 ModeMessage::getReason() const
+{
+    return m_Reason;
+}
+
+bool ModeMessage::setFromNameValuePairList(const QList<NameValuePair> &values, const double timeDivider)
+{
+    bool rc1 = false;
+    bool rc2 = false;
+    bool rc3 = false;
+
+    for(int i = 0; i < values.size(); ++i)
+    {
+        if(values.at(i).first == "Index")
+        {
+            m_Index = values.at(i).second.toUInt();
+            rc2 = true;
+        }
+        else if(values.at(i).first == m_TimeFieldName)
+        {
+            m_TimeStamp = values.at(i).second.toDouble();
+            m_TimeStamp /= timeDivider;
+            rc3 = true;
+        }
+        else if(values.at(i).first == "Mode")
+        {
+            m_Mode = values.at(i).second.toUInt();
+            rc1 = true;
+        }
+        else if(values.at(i).first == "ModeNum")
+        {
+            m_ModeNum = values.at(i).second.toUInt();
+            // ModeNum does not influence the returncode as its optional
+        }
+        else if(values.at(i).first == "Rsn")
+        {
+            m_Reason = values.at(i).second.toUInt();
+            // Reason does not influence the returncode as its optional. Came with AC 3.4
+        }
+    }
+    return rc1 && rc2 && rc3;
+}
+
+
+QString ModeMessage::toString() const
+{
+    QString output;
+    QTextStream outputStream(&output);
+
+    outputStream << " Mode:" << m_Mode << " ModeNum:" << m_ModeNum << " Reason:" << m_Reason;
+    return output;
+}
+
+//********
+
+const QString EventMessage::TypeName("EV");
+
+EventMessage::EventMessage() : m_EventID(0)
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(0,0,125);
+}
+
+EventMessage::EventMessage(const QString &TimeFieldName) : m_EventID(0)
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(0,0,125);
+    m_TimeFieldName = TimeFieldName;
+}
+
+EventMessage::EventMessage(const quint32 index, const double timeStamp, const quint32 eventID) :
+    MessageBase(index, timeStamp, TypeName, QColor(0,0,125)),
+    m_EventID(eventID)
+{}
+
+quint32 EventMessage::getEventID() const
+{
+    return m_EventID;
+}
+
+bool EventMessage::setFromNameValuePairList(const QList<NameValuePair> &values, const double timeDivider)
+{
+    bool rc1 = false;
+    bool rc2 = false;
+    bool rc3 = false;
+
+    for(int i = 0; i < values.size(); ++i)
+    {
+        if(values.at(i).first == "Index")
+        {
+            m_Index = values.at(i).second.toUInt();
+            rc1 = true;
+        }
+        else if(values.at(i).first == m_TimeFieldName)
+        {
+            m_TimeStamp = values.at(i).second.toDouble();
+            m_TimeStamp /= timeDivider;
+            rc2 = true;
+        }
+        else if(values.at(i).first == "Id")
+        {
+            m_EventID = values.at(i).second.toUInt();
+            rc3 = true;
+        }
+    }
+    return rc1 && rc2 && rc3;
+}
+
+QString EventMessage::toString() const
+{
+    QString output;
+    QTextStream outputStream(&output);
+
+    outputStream << " Event ID:" << m_EventID;
+    return output;
+}
+
+//********
+
+const QString MsgMessage::TypeName("MSG");
+
+MsgMessage::MsgMessage()
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(0,0,0);
+}
+
+MsgMessage::MsgMessage(const QString &TimeFieldName)
+{
+    // Set up base class vars for this message
+    m_TypeName = TypeName;
+    m_Color    = QColor(0,0,0);
+    m_TimeFieldName = TimeFieldName;
+}
+
+MsgMessage::MsgMessage(const quint32 index, const double timeStamp, const QString &message) :
+    MessageBase(index, timeStamp, TypeName, QColor(0,0,0)),
+    m_Message(message)
+{}
+
+bool MsgMessage::setFromNameValuePairList(const QList<NameValuePair> &values, const double timeDivider)
+{
+    bool rc1 = false;
+    bool rc2 = false;
+    bool rc3 = false;
+
+    for(int i = 0; i < values.size(); ++i)
+    {
+        if(values.at(i).first == "Index")
+        {
+            m_Index = values.at(i).second.toUInt();
+            rc1 = true;
+        }
+        else if(values.at(i).first == m_TimeFieldName)
+        {
+            m_TimeStamp = values.at(i).second.toDouble();
+            m_TimeStamp /= timeDivider;
+            rc2 = true;
+        }
+        else if(values.at(i).first == "Message")
+        {
+            m_Message = values.at(i).second.toString();
+            rc3 = true;
+        }
+    }
+    return rc1 && rc2 && rc3;
+}
+
+QString MsgMessage::toString() const
+{
+    return m_Message;
+}
+
+//********
+
+MessageBase::Ptr MessageFactory::CreateMessageOfType(const QString &type, const QList<QPair<QString, QVariant> > &values, const QString &timeFieldName, const double &timeDivider)
+{
+    MessageBase::Ptr messagePtr;
+
+    if (type == ErrorMessage::TypeName)
+    {
+        messagePtr = MessageBase::Ptr(new ErrorMessage(timeFieldName));
+    }
+    else if (type == ModeMessage::TypeName)
+    {
+        messagePtr = MessageBase::Ptr(new ModeMessage(timeFieldName));
+    }
+    else if (type == EventMessage::TypeName)
+    {
+        messagePtr = MessageBase::Ptr(new EventMessage(timeFieldName));
+    }
+    else if (type == MsgMessage::TypeName)
+    {
+        messagePtr = MessageBase::Ptr(new MsgMessage(timeFieldName));
+    }
+
+    if(!messagePtr)
+    {
+        QLOG_WARN() << "MessageFactory::CreateMessageOfType: No message of type '" << type << "' could be created";
+        return MessageBase::Ptr();
+    }
+    else
+    {
+        if(!messagePtr->setFromNameValuePairList(values, timeDivider))
+        {
+            QLOG_WARN() << "MessageFactory::CreateMessageOfType: Not all data could be read from variant list "
+                        << "The data of type " << type << " might be corrupted.";
+        }
+        return messagePtr;
+    }
+}
+
+
+//******** Message Formatters ********
+
+
+QString Universal::MessageFormatter::format(const EventMessage &message)
+{
+    // Interpretation taken from Ardupilot
+    // last verification 11.07.2023
+
+    QString output;
+    QTextStream outputStream(&output);
+
+    switch(message.getEventID())
+    {
+    case 7:
+        outputStream << "AP-State";
+        break;
+    case 8:
+        outputStream << "System time set";
+        break;
+    case 9:
+        outputStream << "Init simple bearing";
+        break;
+    case 10:
+        outputStream << "Armed";
+        break;
+    case 11:
+        outputStream << "Disarmed";
+        break;
+    case 15:
+        outputStream << "Auto-Armed";
+        break;
+    case 16:
+        outputStream << "Takeoff";
+        break;
+    case 17:
+        outputStream << "Land Complete Maybe";
+        break;
+    case 18:
+        outputStream << "Land Complete";
+        break;
+    case 19:
+        outputStream << "Lost GPS";
+        break;
+    case 21:
+        outputStream << "Flip Start";
+        break;
+    case 22:
+        outputStream << "Flip End";
+        break;
+    case 25:
+        outputStream << "Home Set";
+        break;
+    case 26:
+        outputStream << "Simple Mode ON";
+        break;
+    case 27:
+        outputStream << "Simple Mode OFF";
+        break;
+    case 28:
+        outputStream << "Not Landed";
+        break;
+    case 29:
+        outputStream << "SuperSimple Mode ON";
+        break;
+    case 30:
+        outputStream << "Autotune Initialized";
+        break;
+    case 31:
+        outputStream << "Autotune Off";
+        break;
+    case 32:
+        outputStream << "Autotune Restart";
+        break;
+    case 33:
+        outputStream << "Autotune Success";
+        break;
+    case 34:
+        outputStream << "Autotune Failed";
+        break;
+    case 35:
+        outputStream << "Autotune Reached Limit";
+        break;
+    case 36:
+        outputStream << "Autotune Pilot Testing";
+        break;
+    case 37:
+        outputStream << "Autotune Saved Gains";
+        break;
+    case 38:
+        outputStream << "Save Trim";
+        break;
+    case 39:
+        outputStream << "Save/Add WP";
+        break;
+    case 40:
+        outputStream << "WP Clear Mission RTL";
+        break;
+    case 41:
+        outputStream << "Fence enable";
+        break;
+    case 42:
+        outputStream << "Fence disable";
+        break;
+    case 43:
+        outputStream << "Acro Trainer disabled";
+        break;
+    case 44:
+        outputStream << "Acro Trainer leveling";
+        break;
+    case 45:
+        outputStream << "Acro Trainer limited";
+        break;
+    case 46:
+        outputStream << "EPM grab";
+        break;
+    case 47:
+        outputStream << "EPM realease";
+        break;
+    case 48:
+        outputStream << "EPM neutral";      // Deprecated
+        break;
+    case 49:
+        outputStream << "Parachute disabled";
+        break;
+    case 50:
+        outputStream << "Parachute enabled";
+        break;
+    case 51:
+        outputStream << "Parachute released";
+        break;
+    case 52:
+        outputStream << "Landing gear delpoyed";
+        break;
+    case 53:
+        outputStream << "Landing gear retracted";
+        break;
+    case 54:
+        outputStream << "Motor emergency stop";
+        break;
+    case 55:
+        outputStream << "Motor emergency stop clear";
+        break;
+    case 56:
+        outputStream << "Motor interlock disabled";
+        break;
+    case 57:
+        outputStream << "Motor interlock enabled";
+        break;
+    case 58:
+        outputStream << "Motor runup complete";         // heli only
+        break;
+    case 59:
+        outputStream << "Motor speed below critical";   // heli only
+        break;
+    case 60:
+        outputStream << "EKF alt reset";
+        break;
+    case 61:
+        outputStream << "Land cancelled by pilot";
+        break;
+    case 62:
+        outputStream << "EKF yaw reset";
+        break;
+    case 63:
+        outputStream << "Avoidance ADSB enable";
+        break;
+    case 64:
+        outputStream << "Avoidance ADSB disable";
+        break;
+    case 65:
+        outputStream << "Avoidance proximity enable";
+        break;
+    case 66:
+        outputStream << "Avoidance proximity disable";
+        break;
+    case 67:
+        outputStream << "Primary GPS changed";
+        break;
+    case 68:
+        outputStream << "Winch relaxed";
+        break;
+    case 69:
+        outputStream << "Winch length control";
+        break;
+    case 70:
+        outputStream << "Winch rate control";
+        break;
+    case 71:
+        outputStream << "ZigZag store A";
+        break;
+    case 72:
+        outputStream << "ZigZag store B";
+        break;
+    case 73:
+        outputStream << "Land repo active";
+        break;
+    case 74:
+        outputStream << "Standby enable";
+        break;
+    case 75:
+        outputStream << "Standby disable";
+        break;
+
+    case 81:
+        outputStream << "Fence floor disable";
+        break;
+    case 82:
+        outputStream << "Fence floor enable";
+        break;
+
+    case 85:
+        outputStream << "EKF src primary";
+        break;
+    case 86:
+        outputStream << "EKF src secondary";
+        break;
+    case 87:
+        outputStream << "EKF src tertiary";
+        break;
+
+    case 90:
+        outputStream << "Airspeed primary changed";
+        break;
+
+    case 163:
+        outputStream << "Surfaced";
+        break;
+    case 164:
+        outputStream << "Not surfaced";
+        break;
+    case 165:
+        outputStream << "Bottomed";
+        break;
+    case 166:
+        outputStream << "Not bottomed";
+        break;
+
+
+    default:
+        outputStream << "Unknown Event: " << message.getEventID();
+        break;
+    }
+
+    return output;
+}
+
+//********
+
+QString Copter::MessageFormatter::format(MessageBase::Ptr &p_message)
+{
+    QString retval("Unknown Type");
+    if (p_message)
+    {
+        if (p_message->typeName() == ErrorMessage::TypeName)
+        {
+            // can use the internal pointer here avoiding dynamic pointer cast with refcount increase
+            retval = format(*dynamic_cast<ErrorMessage*>(p_message.data()));
+        }
+        else if (p_message->typeName() == ModeMessage::TypeName)
+        {
+            retval = format(*dynamic_cast<ModeMessage*>(p_message.data()));
+        }
+        else if (p_message->typeName() == EventMessage::TypeName)
+        {
+            // Event messages are the same for plane and copters
+            retval = Universal::MessageFormatter::format(*dynamic_cast<EventMessage*>(p_message.data()));
+        }
+        else // The msgMessage does not need a formatter -> handled by else
+        {
+            retval = p_message->toString();
+        }
+    }
+    else
+    {
+        QLOG_ERROR() << "CopterMessageFormatter::format() called with nullpointer";
+    }
+    return retval;
+}
+
+QString Copter::MessageFormatter::format(const ErrorMessage &message)
+{
+    // SubSys ans ErrorCode interpretation was taken from
+    // Ardupilot/ArduCopter/defines.h
+    // last verification 04.03.2018
+
+    QString output;
+    QTextStream outputStream(&output);
+
+    bool EcodeUsed = false;
+
+    switch (message.getSubsystemCode())
+    {
+    case 1:
+        outputStream << "Main:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Ins-Delay";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 2:
+        outputStream << "Radio:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Late Frame detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 3:
+        outputStream << "Compass:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Failed to read data";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 4:
+        outputStream << "OptFlow:";
+        break;
+
+    case 5:
+        outputStream << "FS-Radio:";
+        break;
+
+    case 6:
+        outputStream << "FS-Batt:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 7:
+        outputStream << "FS-GPS:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 8:
+        outputStream << "FS-GCS:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 9:
+        outputStream << "FS-Fence:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 10:
+    {
+        ModeMessage tmpMsg(0, 0, message.getErrorCode(), 0, 0);
+        outputStream << "Flight-Mode "  << Copter::MessageFormatter::format(tmpMsg) <<" refused.";
+        EcodeUsed = true;
+        break;
+    }
+
+    case 11:
+        outputStream << "GPS:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Glitch detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 12:
+        outputStream << "Crash-Check:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Crash Detected";
+            EcodeUsed = true;
+        }
+        else if (message.getErrorCode() == 2)
+        {
+            outputStream << "Control Lost";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 13:
+        outputStream << "FLIP:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Abandoned";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 14:
+        outputStream << "Autotune:";
+        break;
+
+    case 15:
+        outputStream << "Parachute:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Too low to eject";
+            EcodeUsed = true;
+        }
+        else if (message.getErrorCode() == 3)
+        {
+            outputStream << "Copter Landed";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 16:
+        outputStream << "EKF-Check:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Bad Variance detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 17:
+        outputStream << "FS-EKF-INAV:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 18:
+        outputStream << "Baro:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Glitch detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 19:
+        outputStream << "CPU:";
+        break;
+
+    case 20:
+        outputStream << "FS-ADSB:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 21:
+        outputStream << "Terrain:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Missing Terrain Data";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 22:
+        outputStream << "Navigation:";
+        if (message.getErrorCode() == 2)
+        {
+            outputStream << "Failed to set destination";
+            EcodeUsed = true;
+        }
+        else if (message.getErrorCode() == 3)
+        {
+            outputStream << "Restarted RTL";
+            EcodeUsed = true;
+        }
+        else if (message.getErrorCode() == 4)
+        {
+            outputStream << "Failed Circle init";
+            EcodeUsed = true;
+        }
+        else if (message.getErrorCode() == 5)
+        {
+            outputStream << "Destination outside fence";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 23:
+        outputStream << "FS-Terrain:";
+        if (message.getErrorCode() == 1)
+        {
+            outputStream << "Detected";
+            EcodeUsed = true;
+        }
+        break;
+
+    case 24:
+        outputStream << "EKF primary:";
+        break;
+
+    default:
+        outputStream << "SubSys:" << message.getSubsystemCode() << " ECode:" << message.getErrorCode();
+        EcodeUsed = true;
+        break;
+
+    }
+
+    if (!EcodeUsed)
+    {
+        switch (message.getErrorCode())
+        {
+        case 0:
+            outputStream << "Everything OK!";
+            break;
+
+        case 1:
+            outputStream << "Failed to init";
+            break;
+
+        case 4:
+            outputStream << "Is Unhealthy";
+            break;
+
+        default:
+            outputStream << "Unknown ErrorCode(" << message.getErrorCode() << ")";
+            break;
+        }
+    }
+
+    return output;
+}
+
+QString Copter::MessageFormatter::format(const ModeMessage &message)
+{
+    // Interpretation taken from
+    // Ardupilot/ArduCopter/defines.h
+    // last verification 04.03.2018
+
+    QString output;
+    QTextStream outputStream(&output);
+
+    switch (message.getMode())
+    {
+    case Copter::STABILIZE:
+        outputStream << "Stabilize";
+        break;
+    case Copter::ACRO:
+        outputStream << "Acro";
+        break;
+    case Copter::ALT_HOLD:
+        outputStream << "Alt Hold";
+        break;
+    case Copter::AUTO:
+        outputStream << "Auto";
+        break;
+    case Copter::GUIDED:
+        outputStream << "Guided";
+        break;
+    case Copter::LOITER:
+        outputStream << "Loiter";
+        break;
+    case Copter::RTL:
+        outputStream << "RTL";
+        break;
+    case Copter::CIRCLE:
+        outputStream << "Circle";
+        break;
+    case Copter::LAND:
+        outputStream << "Land";
+        break;
+    case Copter::DRIFT:
+        outputStream << "Drift";
+        break;
+    case Copter::SPORT:
+        outputStream << "Sport";
+        break;
+    case Copter::FLIP:
+        outputStream << "Flip";
+        break;
+    case Copter::AUTOTUNE:
+        outputStream << "Auto Tune";
+        break;
+    case Copter::POS_HOLD:
+        outputStream << "Pos Hold";
+        break;
+    case Copter::BRAKE:
+        outputStream << "Brake";
+        break;
+    case Copter::THROW:
+        outputStream << "Throw";
+        break;
+    case Copter::AVOID_ADSB:
+        outputStream << "Avoid-ADSB";
+        break;
+    case Copter::GUIDED_NOGPS:
+        outputStream << "Guided no GPS";
+        break;
+    case Copter::SMART_RTL:
+        outputStream << "Smart RTL";
+        break;
+    case Copter::FLOWHOLD:
+        outputStream << "Flowhold";
+        break;
+    case Copter::FOLLOW:
+        outputStream << "Follow";
+        break;
+    case Copter::ZIGZAG:
+        outputStream << "ZigZag";
+        break;
+    default:
+        outputStream << "Unknown Mode:" << message.getMode();
+        break;
+    }
+
+    // only if we have a valid reason
+    if (message.getReason() != 0)
+    {
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+        outputStream << endl << "by " ;
+#else
+        outputStream << Qt::endl << "by " ;
+#endif
+
+        switch (message.getReason())
+        {
+        case 1:
+            outputStream << "radio";
+            break;
+        case 2:
+            outputStream << "GCS cmd";
+            break;
+        case 3:
+            outputStream << "radio FS";
+            break;
+        case 4:
+            outputStream << "battery FS";
+            break;
+        case 5:
+            outputStream << "GCS FS";
+            break;
+        case 6:
+            outputStream << "EKF FS";
+            break;
+        case 7:
+            outputStream << "GPS Glitch";
+            break;
+        case 8:
+            outputStream << "mission end";
+            break;
+        case 9:
+            outputStream << "throttle land escape";
+            break;
+        case 10:
+            outputStream << "fence breach";
+            break;
+        case 11:
+            outputStream << "terrain FS";
+            break;
+        case 12:
+            outputStream << "brake timeout";
+            break;
+        case 13:
+            outputStream << "Flip complete";
+            break;
+        case 14:
+            outputStream << "Avoidance";
+            break;
+        case 15:
+            outputStream << "Avoidance recovery";
+            break;
+        case 16:
+            outputStream << "Throw complete";
+            break;
+        case 17:
+            outputStream << "Flight termination";
+            break;
+        case 18:
+            outputStream << "Toy mode";
+            break;
+        default:
+            outputStream << "unknown reason:" << message.getReason();
+            break;
+        }
+    }
+
+    return output;
+}
+
+//********
+
+QString Plane::MessageFormatter::format(MessageBase::Ptr &p_message)
+{
+    QString retval("Unknown Type");
+    if (p_message)
+    {
+        if (p_message->typeName() == ModeMessage::TypeName)
+        {
+            // can use the internal pointer here avoiding dynamic pointer cast with refcount increase
+            retval = format(*dynamic_cast<ModeMessage*>(p_message.data()));
+        }
+        else if (p_message->typeName() == EventMessage::TypeName)
+        {
+            // Event messages are the same for plane and copters
+            retval = Universal::MessageFormatter::format(*dynamic_cast<EventMessage*>(p_message.data()));
+        }
+        else
+        {
+            retval = p_message->toString();
+        }
+    }
+    else
+    {
+        QLOG_ERROR() << "PlaneMessageFormatter::format() called with nullpointer";
+    }
+    return retval;
+}
+
+QString Plane::MessageFormatter::format(const ModeMessage &message)
+{
+    // Interpretation taken from
+    // ardupilot/ArduPlane/mode.h
+    // last verification 03.07.2023
+
+    QString output;
+    QTextStream outputStream(&output);
+
+    switch (message.getMode())
+    {
+    case Plane::MANUAL:
+        outputStream << "Manual";
+        break;
+    case Plane::CIRCLE:
+        outputStream << "Circle";
+        break;
+    case Plane::STABILIZE:
+        outputStream << "Stabilize";
+        break;
+    case Plane::TRAINING:
+        outputStream << "Training";
+        break;
+    case Plane::ACRO:
+        outputStream << "Acro";
+        break;
+    case Plane::FLY_BY_WIRE_A:
+        outputStream << "Fly by wire A";
+        break;
+    case Plane::FLY_BY_WIRE_B:
+        outputStream << "Fly by wire B";
+        break;
+    case Plane::CRUISE:
+        outputStream << "Cruise";
+        break;
+    case Plane::AUTOTUNE:
+        outputStream << "Autotune";
+        break;
+    case Plane::LAND:
+        outputStream << "Land";
+        break;
+    case Plane::AUTO:
+        outputStream << "Auto";
+        break;
+    case Plane::RTL:
+        outputStream << "RTL";
+        break;
+    case Plane::LOITER:
+        outputStream << "Loiter";
+        break;
+    case Plane::GUIDED:
+        outputStream << "Guided";
+        break;
+    case Plane::INITIALIZING:
+        outputStream << "Initializing";
+        break;
+    case Plane::QSTABILIZE:
+        outputStream << "Q-Stabilize";
+        break;
+    case Plane::QHOVER:
+        outputStream << "Q-Hover";
+        break;
+    case Plane::QLOITER:
+        outputStream << "Q-Loiter";
+        break;
+    case Plane::QLAND:
+        outputStream << "Q-Land";
+        break;
+    case Plane::QRTL:
+        outputStream << "Q-RTL";
+        break;
+    case Plane::QAUTOTUNE:
+        outputStream << "Q-Autotune";
+        break;
+    case Plane::QACRO:
+        outputStream << "Q-Acro";
+        break;
+    case Plane::THERMAL:
+        outputStream << "Thermal";
+        break;
+    case Plane::LOITER_ALT_QLAND:
+        outputStream << "Loiter Alt Q-Land";
+        break;
+    default:
+        outputStream << "Unknown Mode:" << message.getMode();
+        break;
+    }
+
+    // only if we have a valid reason
+    if (message.getReason() != 0)
+    {
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+        outputStream << endl << "by " ;
+#else
+        outputStream << Qt::endl << "by " ;
+#endif
+
+        switch (message.getReason())
+        {
+        case 1:
+            outputStream << "Radio";
+            break;
+        case 2:
+            outputStream << "GCS";
+            break;
+        case 3:
+            outputStream << "Radio-Failsafe";
+            break;
+        case 4:
+            outputStream << "Battery-Failsafe";
+            break;
+        case 5:
+            outputStream << "GCS-Failsafe";
+            break;
+        case 6:
+            outputStream << "EKF-Failsafe";
+            break;
+        case 7:
+            outputStream << "GPS-Glitch";
+            break;
+        case 8:
+            outputStream << "Mission-End";
+            break;
+        case 9:
+            outputStream << "Thr-Land-Escape";
+            break;
+        case 10:
+            outputStream << "Fence-Breached";
+            break;
+        case 11:
+            outputStream << "Terrain-Failsafe";
+            break;
+        case 12:
+            outputStream << "Breake-Timeout";
+            break;
+        case 13:
+            outputStream << "Flip-Complete";
+            break;
+        case 14:
+            outputStream << "Avoidance";
+            break;
+        case 15:
+            outputStream << "Avoidance-Recov";
+            break;
+        case 16:
+            outputStream << "Throw-Complete";
+            break;
+        case 17:
+            outputStream << "Terminate";
+            break;
+        case 18:
+            outputStream << "Toy-Mode";
+            break;
+        case 19:
+            outputStream << "Crash-Failsafe";
+            break;
+        case 20:
+            outputStream << "Soar-FBW-B";
+            break;
+        case 21:
+            outputStream << "Soar-Ther-Det";
+            break;
+        case 22:
+            outputStream << "Soar-Ther-Est";
+            break;
+        case 23:
+            outputStream << "VTOL-Trans-Fail";
+            break;
+        case 24:
+            outputStream << "VTOL-Takeoff-Fail";
+            break;
+        case 25:
+            outputStream << "Failsafe";
+            break;
+        case 26:
+            outputStream << "Init";
+            break;
+        case 27:
+            outputStream << "Surface-Complete";
+            break;
+        case 28:
+            outputStream << "Bad-Depth";
+            break;
+        case 29:
+            outputStream << "Leak-Failsafe";
+            break;
+        case 30:
+            outputStream << "Servotest";
+            break;
+        case 31:
+            outputStream << "Startup";
+            break;
+        case 32:
+            outputStream << "Script";
+            break;
+        case 33:
+            outputStream << "Unavailable";
+            break;
+        case 34:
+            outputStream << "Autorot-Start";
+            break;
+        case 35:
+            outputStream << "Autorot-Bailout";
+            break;
+        case 36:
+            outputStream << "Soar-Too Hight";
+            break;
+        case 37:
+            outputStream << "Soar-Too Low";
+            break;
+        case 38:
+            outputStream << "Soar-Drift";
+            break;
+        case 39:
+            outputStream << "RTL-Done VTOL Land";
+            break;
+        case 40:
+            outputStream << "RTL-Done Wing Land";
+            break;
+        case 41:
+            outputStream << "Mission-Cmd";
+            break;
+        case 42:
+            outputStream << "FRSky-Cmd";
+            break;
+        case 43:
+            outputStream << "Fence-Prev.Mode";
+            break;
+        case 44:
+            outputStream << "QRTL";
+            break;
+        case 45:
+            outputStream << "Auto-RTL Exit";
+            break;
+        case 46:
+            outputStream << "Loter-Alt-QLand";
+            break;
+        case 47:
+            outputStream << "Loiter-Alt-VTOL";
+            break;
+        case 48:
+            outputStream << "Radio-Failsafe-Recov.";
+            break;
+        case 49:
+            outputStream << "QLand-instead-RTL";
+            break;
+        case 50:
+            outputStream << "DeadReckon-Failsafe";
+            break;
+
+        }
+    }
+
+    return output;
+}
+
+//********
+
+QString Rover::MessageFormatter::format(MessageBase::Ptr &p_message)
+{
+    QString retval("Unknown Type");
+    if (p_message)
+    {
+        // Only mode message formatter is implemented for rovers
+        if (p_message->typeName() == ModeMessage::TypeName)
+        {
+            // can use the internal pointer here avoiding dynamic pointer cast with refcount increase
+            retval = format(*dynamic_cast<ModeMessage*>(p_message.data()));
+        }
+        else
+        {
+            retval = p_message->toString();
+        }
+    }
+    else
+    {
+        QLOG_ERROR() << "RoverMessageFormatter::format() called with nullpointer";
+    }
+    return retval;
+}
+
+QString Rover::MessageFormatter::format(const ModeMessage &message)
+{
+    // Interpretation taken from
+    // Ardupilot/APMRover2/defines.h
+    // last verification 24.01.2016
+
+    QString output;
+    QTextStream outputStream(&output);
+
+    switch (message.getMode())
+    {
+    case Rover::MANUAL:
+        outputStream << "Manual";
+        break;
+    case Rover::LEARNING:
+        outputStream << "Learning";
+        break;
+    case Rover::STEERING:
+        outputStream << "Steering";
+        break;
+    case Rover::HOLD:
+        outputStream << "Hold";
+        break;
+    case Rover::AUTO:
+        outputStream << "Auto";
+        break;
+    case Rover::RTL:
+        outputStream << "RTL";
+        break;
+    case Rover::GUIDED:
+        outputStream << "Guided";
+        break;
+    case Rover::INITIALIZING:
+        outputStream << "Initialising";
+        break;
+    default:
+        outputStream << "Unknown Mode:" << message.getMode();
+        break;
+    }
+    return output;
+}
@@ -27,7 +27,6 @@ This file is part of the APM_PLANNER project
 #include "configuration.h"
 
 #include <QMessageBox>
-#include <math.h>
 
 #define LDD_COLUMN_ID 0
 #define LDD_COLUMN_TIME 1
@@ -35,8 +34,6 @@ This file is part of the APM_PLANNER project
 #define LDD_COLUMN_CHECKBOX 3
 #define LOG_EXT QString(".bin")
 
-static const uint32_t LOG_PACKET_SIZE = 90;
-static const int LOG_RETRY_TIMER = 700; //msecs
 
 LogDownloadDescriptor::LogDownloadDescriptor(uint logID, uint time_utc,
                                              uint logSize)
@@ -74,13 +71,10 @@ LogDownloadDialog::LogDownloadDialog(QWidget *parent) :
     QDialog(parent),
     ui(new Ui::LogDownloadDialog),
     m_uas(NULL),
-    m_downloadSet(NULL),
-    m_downloadFile(NULL),
-    m_downloadID(0),
-    m_downloadLastTimestamp(0),
-    m_downloadOffset(0),
-    m_lastDownloadOffset(0),
-    m_downloadMaxSize(100)
+    m_transfer(NULL),
+    m_downloadCount(0),
+    m_downloadCountMax(0),
+    m_downloadFailed(0)
 {
     ui->setupUi(this); 
 
@@ -96,9 +90,6 @@ LogDownloadDialog::LogDownloadDialog(QWidget *parent) :
     connect(ui->erasePushButton, SIGNAL(clicked()), this, SLOT(eraseAllLogs()));
     connect(ui->checkAllBox, SIGNAL(clicked()), this, SLOT(checkAll()));
 
-    // configure retransimission timer.
-    connect(&m_timer, SIGNAL(timeout()), this, SLOT(processDownloadedLogData()));
-
     QStringList headerList;
     headerList << tr("ID") << tr("Time") << tr("Size") << tr("Download?");
 
@@ -113,22 +104,12 @@ LogDownloadDialog::LogDownloadDialog(QWidget *parent) :
 
 void LogDownloadDialog::resetDownload()
 {
-    if (m_downloadSet){
-        delete m_downloadSet;
-        m_downloadSet = NULL;
-    }
-
-    if (m_downloadFile){
-        m_downloadFile->close();
-        m_downloadFile->deleteLater();
-        m_downloadFile = NULL;
+    if (m_transfer){
+        m_transfer->cancel();
+        m_transfer->deleteLater();
+        m_transfer = NULL;
     }
-
-    m_downloadID = 0;
-    m_downloadFilename.clear();
     m_downloadStart = QElapsedTimer();
-    m_downloadLastTimestamp = 0;
-    m_downloadOffset = 0;
 }
 
 void LogDownloadDialog::cancelButtonClicked()
@@ -136,6 +117,7 @@ void LogDownloadDialog::cancelButtonClicked()
     if(m_uas){
         m_uas->logRequestEnd();
     }
+    m_fileSaveList.clear();
     resetDownload();
     accept();
 }
@@ -211,8 +193,10 @@ void LogDownloadDialog::getSelectedLogs()
                          << m_fileSaveList.last()->logFilename()  << " to download list";
         }
     }
-    m_downloadCount = 1;//st
+    m_downloadCount = 0;
     m_downloadCountMax = m_fileSaveList.count();
+    m_downloadFailed = 0;
+    resetDownload();
     startNextDownloadRequest();
 }
 
@@ -231,37 +215,44 @@ void LogDownloadDialog::eraseAllLogs()
 
 void LogDownloadDialog::startNextDownloadRequest()
 {
-    QTimer::singleShot(500, this, SLOT(triggerNextDownloadRequest()));
-}
+    if (m_uas == NULL || m_fileSaveList.isEmpty() || m_transfer)
+        return;
 
-void LogDownloadDialog::triggerNextDownloadRequest()
-{
     QLOG_DEBUG() << "Start next log download";
-    if (m_uas && !m_fileSaveList.isEmpty()){
+    LogDownloadDescriptor *descriptor = m_fileSaveList.takeFirst();
+    ++m_downloadCount;
+    m_transfer = new LogDownloadTransfer(m_uas, descriptor->logID(), descriptor->logSize(),
+                                         uniqueLogFileName(QGC::logDirectory() + "/" + descriptor->logFilename()), this);
+    connect(m_transfer, SIGNAL(progressChanged(quint64,quint32)), this, SLOT(transferProgress(quint64,quint32)));
+    connect(m_transfer, SIGNAL(finished(bool)), this, SLOT(transferFinished(bool)));
+
+    m_downloadStart.start();
+    ui->statusLabel->setText(tr("Downloading %1/%2").arg(m_downloadCount).arg(m_downloadCountMax));
+    ui->statusLabel->show();
+    ui->progressBar->setMaximum(static_cast<int>(descriptor->logSize()));
+    ui->progressBar->setValue(0);
+    ui->progressBar->show();
+
+    if (!m_transfer->start()){
         resetDownload();
-        LogDownloadDescriptor *descriptor = m_fileSaveList.takeFirst();
-        m_downloadID = descriptor->logID();
-        m_downloadFilename = descriptor->logFilename();
-        m_downloadMaxSize = descriptor->logSize();
-        issueDownloadRequest();
+        ++m_downloadFailed;
+        // Go on with the next log
+        QTimer::singleShot(0, this, SLOT(startNextDownloadRequest()));
     }
 }
 
-void LogDownloadDialog::issueDownloadRequest()
+QString LogDownloadDialog::uniqueLogFileName(const QString &fileName) const
 {
-    QCoreApplication::processEvents(QEventLoop::AllEvents, 2000);
-        // Open a file for the log to be downloaded
-    m_downloadFile = new QFile(QGC::logDirectory() +"/" + m_downloadFilename);
-
     // Append a number to the end if the filename already exists
-    if(m_downloadFile->exists()){
+    QString uniqueName = fileName;
+    if(QFile::exists(uniqueName)){
         uint num_dups = 0;
-        QStringList filename_spl = m_downloadFile->fileName().split('.');
-        if (filename_spl.size()>0)
+        QStringList filename_spl = fileName.split('.');
+        if (filename_spl.size()>1)
         {
-            while(m_downloadFile->exists()){
+            while(QFile::exists(uniqueName)){
                 num_dups ++;
-                m_downloadFile->setFileName(filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1]);
+                uniqueName = filename_spl[0] + '_' + QString::number(num_dups) + '.' + filename_spl[1];
             }
         }
         else
@@ -269,30 +260,17 @@ void LogDownloadDialog::issueDownloadRequest()
             // Filename does not have an extension, avoid a crash and append a number on the end
             // This can not (currently) happen at runtime unless either a define goes away, or the code is otherwise broken elsewhere, but better safe with an error
             // in the log than sorry with a crash report.
-            QLOG_ERROR() << "Download filename is not properly formatted!" << m_downloadFile->fileName();
+            QLOG_ERROR() << "Download filename is not properly formatted!" << fileName;
             QLOG_ERROR() << "The above should NEVER happen, please file a bug report with this log!";
-            QString filename_orig = m_downloadFile->fileName();
-            while(m_downloadFile->exists()){
+            while(QFile::exists(uniqueName)){
                 num_dups ++;
-                m_downloadFile->setFileName(filename_orig + '_' + QString::number(num_dups));
+                uniqueName = fileName + '_' + QString::number(num_dups);
             }
         }
     }
-    if(m_downloadFile && m_downloadFile->open(QIODevice::WriteOnly)){
-        QLOG_INFO() << "Log file ready for writing:" << m_downloadFilename << " size:" << m_downloadMaxSize;
-        Q_ASSERT(m_downloadOffset == 0);
-        m_lastDownloadOffset = 0;
-        m_uas->logRequestData(m_downloadID, m_downloadOffset, LOG_PACKET_SIZE);
-        updateProgress();
-        m_downloadStart.start();
-        m_timer.start(LOG_RETRY_TIMER);
-        m_downloadSet = new QSet<uint>();
-    } else {
-        QLOG_ERROR() << "failed to open file to save log:" << m_downloadFilename;
-    }
+    return uniqueName;
 }
 
-
 void LogDownloadDialog::logEntry(int uasId, uint32_t time_utc, uint32_t size, uint16_t id,
                                  uint16_t num_logs, uint16_t last_log_num)
 {
@@ -336,20 +314,17 @@ void LogDownloadDialog::logEntry(int uasId, uint32_t time_utc, uint32_t size, ui
 void LogDownloadDialog::logData(uint32_t uasId, uint32_t ofs, uint16_t id,
                                      uint8_t count, const char *data)
 {
-    Q_UNUSED(id);
 //#define SIMULATE_PACKET_LOSS
 #ifdef SIMULATE_PACKET_LOSS
     QLOG_DEBUG() << "logData ofs:" << ofs << " id:" << id << " count:" << count
                  /*<< " data:" << data*/;
 #endif
-    if (m_uas == NULL || m_downloadSet == NULL)
+    if (m_uas == NULL || m_transfer == NULL)
         return;
     if (m_uas->getUASID() != static_cast<int>(uasId))
         return;
-    if(m_downloadFile == NULL){
-        QLOG_ERROR() << "No file open to save log info";
+    if (m_transfer->logID() != id)
         return;
-    }
 #ifdef SIMULATE_PACKET_LOSS
     //Simulate packet loss for testing in debug mode
     if ((rand() % 100) < 20){
@@ -357,126 +332,51 @@ void LogDownloadDialog::logData(uint32_t uasId, uint32_t ofs, uint16_t id,
         return;
     }
 #endif
-    if (ofs != m_downloadOffset){
-        QLOG_DEBUG() << "seek to " << ofs;
-        m_downloadFile->seek(ofs);
-        m_downloadOffset = ofs;
-        updateProgress();
-    }
-    if (count != 0){
-        int bytesWritten = m_downloadFile->write(data, count);
-        if ((bytesWritten == -1)||(bytesWritten != count)){
-            QLOG_ERROR() << "Log File write bytesWritten:" << bytesWritten << "out of: count=" << count;
-//            QMessageBox::critical(this,tr("Corrupt File")
-//                                  ,tr("Error saving %1.\n file save is corupt."),QMessageBox::Ok);
-            // [TODO] Abort.
-        }
-        m_downloadFile->flush();
-        m_downloadSet->insert(static_cast<uint>(floor(ofs / LOG_PACKET_SIZE)));
-        m_downloadOffset += count;
-        updateProgress();
-    }
-    m_downloadLastTimestamp = QDateTime::currentDateTime().toMSecsSinceEpoch();
-    if ( count==0 || (count<LOG_PACKET_SIZE
-                      && (static_cast<uint>(m_downloadSet->count()) == 1+(static_cast<uint>( floor(ofs / LOG_PACKET_SIZE) ))))){
-        double dt = m_downloadStart.elapsed()/1000.0;
-        double speed = (static_cast<double>(m_downloadFile->size())/dt)/1000.0;
-        QLOG_INFO() << "Finished downloading "<< m_downloadFilename
-                    << "(" << dt << " seconds, "<< speed <<"kbyte/sec)";
-        m_downloadFile->flush();
-        m_timer.stop();
-        updateProgress();
-        m_uas->logRequestEnd();
-        QCoreApplication::processEvents();
-
-        if (m_downloadFile->size() == 0) {
-            // If the file size is zero, retry
-            QLOG_DEBUG() << "File Size is zero, retry";
-            m_downloadOffset = 0;
-            m_lastDownloadOffset = 0;
-            delete m_downloadSet;
-            m_downloadSet = new QSet<uint>();
-            m_timer.start(LOG_RETRY_TIMER);
-            m_downloadStart.start();
-            m_downloadFile->close();
-            delete m_downloadFile;
-            m_downloadFile = NULL;
-            issueDownloadRequest();
-            return;
-        }
-        m_downloadFile->close();
-        QCoreApplication::processEvents();
-        ui->progressBar->setValue(m_downloadMaxSize);
-        if (!(m_downloadCount == m_downloadCountMax)){
-            m_downloadCount++;
-            startNextDownloadRequest();
-        } else {
-            ui->statusLabel->setText("Finished");
-            QTimer::singleShot(500, ui->progressBar, SLOT(hide()));
-            QTimer::singleShot(500, ui->statusLabel, SLOT(hide()));
-            resetDownload();
-        }
+    m_transfer->handleData(ofs, count, data);
+}
+
+void LogDownloadDialog::transferProgress(quint64 receivedBytes, quint32 logSize)
+{
+    if (m_downloadStart.isValid() && m_downloadStart.elapsed() > 0){
+        const double speed = static_cast<double>(receivedBytes) / m_downloadStart.elapsed();  // byte/ms = kbyte/s
+        ui->statusLabel->setText(tr("Downloading %1/%2 (%3 kB/s)").arg(m_downloadCount).arg(m_downloadCountMax)
+                                 .arg(speed, 0, 'f', 1));
     }
-    QCoreApplication::processEvents();
+    ui->progressBar->setMaximum(static_cast<int>(logSize));
+    ui->progressBar->setValue(static_cast<int>(receivedBytes));
 }
 
-void LogDownloadDialog::processDownloadedLogData()
+void LogDownloadDialog::transferFinished(bool success)
 {
-    // Process incoming log data and trigger next request for more
-    if (m_downloadSet==NULL || m_downloadSet->size() == 0)
+    if (m_transfer == NULL)
         return;
 
-    uint highest = 0;
-
-    QSet<uint>::const_iterator iter;
-    iter = m_downloadSet->constBegin();
-    while (iter != m_downloadSet->constEnd()){
-        uint value = *iter;
-        if (value > highest)
-            highest = value;
-        ++iter;
+    double dt = m_downloadStart.elapsed()/1000.0;
+    if (success){
+        double speed = dt > 0.0 ? (static_cast<double>(m_transfer->receivedBytes())/dt)/1000.0 : 0.0;
+        QLOG_INFO() << "Finished downloading "<< m_transfer->fileName()
+                    << "(" << dt << " seconds, "<< speed <<"kbyte/sec)";
+    } else {
+        QLOG_ERROR() << "Failed to download" << m_transfer->fileName();
+        ++m_downloadFailed;
     }
+    resetDownload();
 
-    QList<uint> diff;
-    for( uint count = 0; count < highest; count++){
-        if(!m_downloadSet->contains(count))
-            diff.append(count);
+    if (!m_fileSaveList.isEmpty()){
+        // The vehicle serves the next request right away
+        startNextDownloadRequest();
+        return;
     }
-    QLOG_DEBUG() << "highest:"<< highest << "Diff size:" << diff.size();
-    if(diff.size() == 0){
-        m_uas->logRequestData(m_downloadID, (highest+1)*LOG_PACKET_SIZE, 0xFFFFFFFF);
-        m_timer.start(LOG_RETRY_TIMER);
 
-    } else {
-        int num_requests = 0;
-        while (num_requests < 20){
-            uint start = diff.takeFirst();
-            uint end = start;
-            while(diff.contains(end+1)){
-                end+=1;
-                diff.removeAt(end);
-            }
-            ui->statusLabel->setText(tr("Retransmitting %1").arg(start));
-            m_uas->logRequestData(m_downloadID, (start*LOG_PACKET_SIZE), (end+1-start)*LOG_PACKET_SIZE);
-            num_requests +=1;
-            if(diff.size() == 0)
-                break;
-            QCoreApplication::processEvents();
-        }
+    if (m_uas){
+        m_uas->logRequestEnd();
     }
-    QCoreApplication::processEvents();
-}
-
-void LogDownloadDialog::updateProgress()
-{
-    if ( m_downloadOffset > m_lastDownloadOffset + 720){
-        m_lastDownloadOffset = m_downloadOffset;
-        QString status =  QString("Downloading %1/%2").arg(m_downloadCount).arg(m_downloadCountMax);
-        ui->statusLabel->setText(status);
-        ui->statusLabel->show();
-        ui->progressBar->setMaximum(m_downloadMaxSize);
-        ui->progressBar->setValue(m_downloadOffset);
-        ui->progressBar->show();
+    if (m_downloadFailed > 0){
+        ui->statusLabel->setText(tr("Finished, %1 of %2 downloads failed").arg(m_downloadFailed).arg(m_downloadCountMax));
+    } else {
+        ui->statusLabel->setText(tr("Finished"));
+        QTimer::singleShot(500, ui->progressBar, SLOT(hide()));
+        QTimer::singleShot(500, ui->statusLabel, SLOT(hide()));
     }
 }
 
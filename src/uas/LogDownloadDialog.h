@@ -24,9 +24,9 @@ This file is part of the APM_PLANNER project
 #define LOGDOWNLOADDIALOG_H
 
 #include "UASInterface.h"
+#include "LogDownloadTransfer.h"
 #include <QDialog>
 #include <QElapsedTimer>
-#include <QFile>
 
 namespace Ui {
 class LogDownloadDialog;
@@ -69,19 +69,18 @@ public slots:
 
 private slots:
     void checkAll();
-    void processDownloadedLogData();
     void doneButtonClicked();
     void cancelButtonClicked();
-    void triggerNextDownloadRequest();
+    void startNextDownloadRequest();
     void eraseAllLogs();
+    void transferProgress(quint64 receivedBytes, quint32 logSize);
+    void transferFinished(bool success);
 
 private:
     void removeConnections(UASInterface* uas);
     void makeConnections(UASInterface* uas);
-    void startNextDownloadRequest();
-    void issueDownloadRequest();
+    QString uniqueLogFileName(const QString &fileName) const;
 
-    void updateProgress();
     void resetDownload();
 
 private:
@@ -90,18 +89,11 @@ private:
     QList<LogDownloadDescriptor*> m_logEntriesList; // id & filename to save data to.
     QList<LogDownloadDescriptor*> m_fileSaveList; // id & filename to save data to.
 
-    QSet<uint> *m_downloadSet;
-    QFile* m_downloadFile;
-    uint m_downloadID;
-    QString m_downloadFilename;
+    LogDownloadTransfer *m_transfer;  // the running download, NULL if none
     QElapsedTimer m_downloadStart;
-    uint m_downloadLastTimestamp;
-    uint m_downloadOffset;
-    uint m_lastDownloadOffset;
-    uint m_downloadMaxSize;
     int m_downloadCount;
     int m_downloadCountMax;
-    QTimer m_timer;
+    int m_downloadFailed;
 };
 
 #endif // LOGDOWNLOADDIALOG_H
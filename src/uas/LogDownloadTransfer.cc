@@ -0,0 +1,355 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file
+ *   @brief Download engine for one dataflash log using LOG_REQUEST_DATA / LOG_DATA
+ *
+ */
+
+#include "LogDownloadTransfer.h"
+#include "logging.h"
+
+LogDownloadRanges::LogDownloadRanges() :
+    m_bytes(0)
+{
+}
+
+void LogDownloadRanges::clear()
+{
+    m_ranges.clear();
+    m_bytes = 0;
+}
+
+void LogDownloadRanges::add(quint32 start, quint32 end)
+{
+    if (start >= end)
+    {
+        return;
+    }
+
+    QMap<quint32, quint32>::iterator iter = m_ranges.upperBound(start);
+    if (iter != m_ranges.begin())
+    {
+        QMap<quint32, quint32>::iterator previous = iter - 1;
+        if (previous.value() >= start)
+        {
+            if (previous.value() >= end)
+            {
+                return; // already known
+            }
+            // merge with the range in front
+            start = previous.key();
+            m_bytes -= previous.value() - previous.key();
+            iter = m_ranges.erase(previous);
+        }
+    }
+    // merge with all ranges covered or touched
+    while (iter != m_ranges.end() && iter.key() <= end)
+    {
+        if (iter.value() > end)
+        {
+            end = iter.value();
+        }
+        m_bytes -= iter.value() - iter.key();
+        iter = m_ranges.erase(iter);
+    }
+
+    m_ranges.insert(start, end);
+    m_bytes += end - start;
+}
+
+bool LogDownloadRanges::contains(quint32 start, quint32 end) const
+{
+    if (start >= end)
+    {
+        return true;
+    }
+    QMap<quint32, quint32>::const_iterator iter = m_ranges.upperBound(start);
+    if (iter == m_ranges.constBegin())
+    {
+        return false;
+    }
+    --iter;
+    return iter.value() >= end;
+}
+
+quint64 LogDownloadRanges::bytes() const
+{
+    return m_bytes;
+}
+
+QList<LogDownloadRanges::range> LogDownloadRanges::gaps(quint32 limit, int maxGaps) const
+{
+    QList<range> holes;
+    quint32 position = 0;
+    for (QMap<quint32, quint32>::const_iterator iter = m_ranges.constBegin();
+         iter != m_ranges.constEnd() && position < limit && holes.size() < maxGaps; ++iter)
+    {
+        if (iter.key() > position)
+        {
+            holes.append(range(position, iter.key() < limit ? iter.key() : limit));
+        }
+        position = iter.value();
+    }
+    if (position < limit && holes.size() < maxGaps)
+    {
+        holes.append(range(position, limit));
+    }
+    return holes;
+}
+
+//************************************************************************************************************
+
+LogDownloadTransfer::LogDownloadTransfer(UASInterface *uas, uint logID, quint32 logSize,
+                                         const QString &fileName, QObject *parent) :
+    QObject(parent),
+    m_uas(uas),
+    m_logID(logID),
+    m_logSize(logSize),
+    m_file(fileName),
+    m_window(s_InitialWindow),
+    m_requestedEnd(0),
+    m_requestStart(0),
+    m_requestEnd(0),
+    m_holesInWindow(false),
+    m_packetInterval(0.0),
+    m_retries(0),
+    m_running(false)
+{
+    m_checkTimer.setInterval(s_CheckInterval);
+    connect(&m_checkTimer, SIGNAL(timeout()), this, SLOT(checkTransfer()));
+}
+
+LogDownloadTransfer::~LogDownloadTransfer()
+{
+    cancel();
+}
+
+bool LogDownloadTransfer::start()
+{
+    if (!m_file.open(QIODevice::WriteOnly))
+    {
+        QLOG_ERROR() << "failed to open file to save log:" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+    QLOG_INFO() << "Log file ready for writing:" << m_file.fileName() << " size:" << m_logSize;
+
+    m_running = true;
+    m_received.clear();
+    m_lastData.start();
+    m_checkTimer.start();
+
+    if (m_logSize == 0)
+    {
+        // Nothing to download
+        finish(true);
+        return true;
+    }
+    requestNext();
+    return true;
+}
+
+void LogDownloadTransfer::cancel()
+{
+    if (m_running)
+    {
+        m_running = false;
+        m_checkTimer.stop();
+        m_file.close();
+    }
+}
+
+uint LogDownloadTransfer::logID() const
+{
+    return m_logID;
+}
+
+QString LogDownloadTransfer::fileName() const
+{
+    return m_file.fileName();
+}
+
+quint32 LogDownloadTransfer::logSize() const
+{
+    return m_logSize;
+}
+
+quint64 LogDownloadTransfer::receivedBytes() const
+{
+    return m_received.bytes();
+}
+
+void LogDownloadTransfer::handleData(uint32_t ofs, uint8_t count, const char *data)
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    // average packet interval, used for the retry timeout
+    const double interval = static_cast<double>(m_lastData.restart());
+    m_packetInterval = m_packetInterval > 0.0 ? m_packetInterval * 0.9 + interval * 0.1 : interval;
+    m_retries = 0;
+
+    if (count < s_PacketSize)
+    {
+        // A short packet marks the end of the log, an empty one lies behind it.
+        const quint32 end = ofs + count;
+        if (count > 0 || end < m_logSize)
+        {
+            m_logSize = end;
+        }
+    }
+    else if (ofs + count > m_logSize)
+    {
+        m_logSize = ofs + count;    // The log is longer than reported
+    }
+
+    if (count > 0 && !m_received.contains(ofs, ofs + count))
+    {
+        if (m_file.pos() != ofs && !m_file.seek(ofs))
+        {
+            QLOG_ERROR() << "Log File seek to" << ofs << "failed:" << m_file.errorString();
+            finish(false);
+            return;
+        }
+        const qint64 bytesWritten = m_file.write(data, count);
+        if (bytesWritten != count)
+        {
+            QLOG_ERROR() << "Log File write bytesWritten:" << bytesWritten << "out of: count=" << count;
+            finish(false);
+            return;
+        }
+        if (ofs > 0 && !m_received.contains(ofs - 1, ofs))
+        {
+            m_holesInWindow = true;
+        }
+        m_received.add(ofs, ofs + count);
+    }
+
+    if (m_received.contains(0, m_logSize))
+    {
+        finish(true);
+    }
+    else if (ofs >= m_requestStart && (count == 0 || (ofs < m_requestEnd && ofs + count >= m_requestEnd)))
+    {
+        // The running request is served, adapt the window and go on without delay.
+        // Packets still in flight from a replaced request do not count.
+        if (m_holesInWindow)
+        {
+            m_window = m_window / 2 > s_MinWindow ? m_window / 2 : s_MinWindow;
+        }
+        else
+        {
+            m_window = m_window * 2 < s_MaxWindow ? m_window * 2 : s_MaxWindow;
+        }
+        requestNext();
+    }
+}
+
+void LogDownloadTransfer::checkTransfer()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    emit progressChanged(m_received.bytes(), m_logSize);
+
+    if (m_lastData.elapsed() < retryTimeout())
+    {
+        return;
+    }
+
+    if (++m_retries > s_MaxRetries)
+    {
+        QLOG_ERROR() << "Log download of" << m_file.fileName() << "stalled, giving up";
+        finish(false);
+        return;
+    }
+    QLOG_DEBUG() << "Log download stalled, retry" << m_retries;
+    m_window = m_window / 2 > s_MinWindow ? m_window / 2 : s_MinWindow;
+    m_lastData.restart();
+    requestNext();
+}
+
+void LogDownloadTransfer::requestNext()
+{
+    quint32 start = 0;
+    quint32 count = 0;
+
+    const quint32 holeLimit = m_requestedEnd < m_logSize ? m_requestedEnd : m_logSize;
+    const QList<LogDownloadRanges::range> holes = m_received.gaps(holeLimit, 1);
+    if (!holes.isEmpty())
+    {
+        start = holes.first().first;
+        count = holes.first().second - start;
+    }
+    else if (m_requestedEnd < m_logSize)
+    {
+        start = m_requestedEnd;
+        count = m_logSize - start;
+    }
+    else
+    {
+        // Everything below the reported size was received, ask if there is more
+        start = m_logSize;
+        count = s_PacketSize;
+    }
+
+    if (count > m_window)
+    {
+        count = m_window;
+    }
+    m_requestStart = start;
+    m_requestEnd = start + count;
+    if (m_requestEnd > m_requestedEnd)
+    {
+        m_requestedEnd = m_requestEnd;
+    }
+    m_holesInWindow = false;
+    m_uas->logRequestData(m_logID, start, count);
+}
+
+void LogDownloadTransfer::finish(bool success)
+{
+    if (!m_running)
+    {
+        return;
+    }
+    m_running = false;
+    m_checkTimer.stop();
+    m_file.close();
+    emit progressChanged(m_received.bytes(), m_logSize);
+    emit finished(success);
+}
+
+int LogDownloadTransfer::retryTimeout() const
+{
+    // Allow some lost packets in a row before asking again
+    const int timeout = static_cast<int>(m_packetInterval * 20.0);
+    if (timeout < s_MinRetryTimeout)
+    {
+        return s_MinRetryTimeout;
+    }
+    return timeout > s_MaxRetryTimeout ? s_MaxRetryTimeout : timeout;
+}
@@ -0,0 +1,202 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file
+ *   @brief Download engine for one dataflash log using LOG_REQUEST_DATA / LOG_DATA
+ *
+ */
+
+#ifndef LOGDOWNLOADTRANSFER_H
+#define LOGDOWNLOADTRANSFER_H
+
+#include "UASInterface.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QPair>
+#include <QTimer>
+
+/**
+ * @brief The LogDownloadRanges class is a set of disjoint byte ranges [start, end).
+ *        Adjacent and overlapping ranges are merged, so a log received in order
+ *        is always one single range no matter how many packets it took.
+ */
+class LogDownloadRanges
+{
+public:
+    typedef QPair<quint32, quint32> range;   ///< start and end (exclusive)
+
+    LogDownloadRanges();
+
+    /**
+     * @brief clear removes all ranges
+     */
+    void clear();
+
+    /**
+     * @brief add adds the range [start, end)
+     */
+    void add(quint32 start, quint32 end);
+
+    /**
+     * @brief contains - true if the whole range [start, end) is in the set
+     */
+    bool contains(quint32 start, quint32 end) const;
+
+    /**
+     * @brief bytes - number of bytes in the set
+     */
+    quint64 bytes() const;
+
+    /**
+     * @brief gaps delivers the holes below limit, lowest first
+     * @param limit - holes are searched in [0, limit)
+     * @param maxGaps - max number of holes to deliver
+     * @return the holes
+     */
+    QList<range> gaps(quint32 limit, int maxGaps) const;
+
+private:
+    QMap<quint32, quint32> m_ranges;    ///< start -> end of each range
+    quint64 m_bytes;                    ///< number of bytes in all ranges
+};
+
+/**
+ * @brief The LogDownloadTransfer class downloads one log into a file.
+ *
+ *        The vehicle streams the requested range and a new LOG_REQUEST_DATA
+ *        replaces the running one. So the log is requested in windows, and the
+ *        next window is requested as soon as the last packet of the current one
+ *        arrives - there is no idle time between the windows. Holes left by lost
+ *        packets are tracked in a LogDownloadRanges and re-requested before the
+ *        next window. The window grows while the link is clean and shrinks on
+ *        loss. If the link stays quiet longer than the retry timeout, which
+ *        follows the measured packet rate, the next request is sent again.
+ *
+ *        Packets are written without flushing, QFile buffers them.
+ */
+class LogDownloadTransfer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief LogDownloadTransfer - CTOR
+     * @param uas - the vehicle to download from
+     * @param logID - id of the log
+     * @param logSize - size reported by LOG_ENTRY
+     * @param fileName - the file to write, an existing file is replaced
+     * @param parent - parent object
+     */
+    LogDownloadTransfer(UASInterface *uas, uint logID, quint32 logSize, const QString &fileName, QObject *parent = 0);
+    ~LogDownloadTransfer();
+
+    /**
+     * @brief start opens the file and sends the first request
+     * @return true on success, false if the file can not be opened
+     */
+    bool start();
+
+    /**
+     * @brief cancel stops the download and closes the file. finished() is not emitted.
+     */
+    void cancel();
+
+    uint logID() const;
+    QString fileName() const;
+    quint32 logSize() const;
+    quint64 receivedBytes() const;
+
+    /**
+     * @brief handleData processes one LOG_DATA packet of this log
+     * @param ofs - offset of the data
+     * @param count - number of bytes, 0 if ofs is beyond the end of the log
+     * @param data - the bytes
+     */
+    void handleData(uint32_t ofs, uint8_t count, const char *data);
+
+signals:
+    /**
+     * @brief progressChanged is emitted periodically while downloading
+     * @param receivedBytes - bytes received so far
+     * @param logSize - size of the log
+     */
+    void progressChanged(quint64 receivedBytes, quint32 logSize);
+
+    /**
+     * @brief finished is emitted when the log is complete or the download failed.
+     *        The file is closed at this point.
+     * @param success - true if the whole log was written
+     */
+    void finished(bool success);
+
+private slots:
+    void checkTransfer();
+
+private:
+    static const quint32 s_PacketSize       = 90;           ///< Payload of a full LOG_DATA packet
+    static const quint32 s_MinWindow        = 16 * 90;      ///< Smallest request in bytes
+    static const quint32 s_InitialWindow    = 64 * 90;      ///< First request in bytes
+    static const quint32 s_MaxWindow        = 4096 * 90;    ///< Biggest request in bytes
+    static const int s_CheckInterval        = 100;          ///< ms between two checks for a stalled link
+    static const int s_MinRetryTimeout      = 300;          ///< ms without data before re-requesting
+    static const int s_MaxRetryTimeout      = 3000;         ///< ms without data before re-requesting at most
+    static const int s_MaxRetries           = 20;           ///< Re-requests in a row without any data before giving up
+
+    /**
+     * @brief requestNext requests the first hole or, if there is none, the next window
+     */
+    void requestNext();
+
+    /**
+     * @brief finish closes the file, stops the timer and emits finished()
+     */
+    void finish(bool success);
+
+    /**
+     * @brief retryTimeout - ms without data until the request is repeated
+     */
+    int retryTimeout() const;
+
+    UASInterface *m_uas;
+    uint m_logID;
+    quint32 m_logSize;              ///< bytes to download, corrected by the last LOG_DATA
+    QFile m_file;
+    LogDownloadRanges m_received;   ///< bytes written to m_file
+
+    quint32 m_window;               ///< size of the next window
+    quint32 m_requestedEnd;         ///< end of the highest window requested
+    quint32 m_requestStart;         ///< start of the running request
+    quint32 m_requestEnd;           ///< end of the running request
+    bool m_holesInWindow;           ///< a hole was found while the running request was served
+
+    QTimer m_checkTimer;
+    QElapsedTimer m_lastData;       ///< time since the last packet
+    double m_packetInterval;        ///< average ms between two packets
+    int m_retries;                  ///< re-requests in a row without data
+    bool m_running;
+};
+
+#endif // LOGDOWNLOADTRANSFER_H
@@ -133,6 +133,7 @@ UAS::UAS(MAVLinkProtocol* protocol, int id) : UASInterface(),
     airSpeed(std::numeric_limits<double>::quiet_NaN()),
     groundSpeed(std::numeric_limits<double>::quiet_NaN()),
     waypointManager(this),
+    mp_telemetryStore(new UASTelemetryStore(id)),
 
     attitudeKnown(false),
     attitudeStamped(false),
@@ -172,6 +173,12 @@ UAS::UAS(MAVLinkProtocol* protocol, int id) : UASInterface(),
     setBatterySpecs(QString("9V,9.5V,12.6V"));
     connect(statusTimeout, SIGNAL(timeout()), this, SLOT(updateState()));
     connect(this, SIGNAL(systemSpecsChanged(int)), this, SLOT(writeSettings()));
+    // Every emitted value ends up in the store. Widgets showing only the latest value
+    // get them coalesced at display rate from there.
+    connect(this, SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),
+            mp_telemetryStore.data(), SLOT(setValue(int,QString,QString,QVariant,quint64)), Qt::DirectConnection);
+    connect(this, SIGNAL(valuesChanged(MAVLinkValueBatch)),
+            mp_telemetryStore.data(), SLOT(setValues(MAVLinkValueBatch)), Qt::DirectConnection);
     statusTimeout->start(500);
     readSettings(); 
     // Initial signals
@@ -707,6 +714,11 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
                 attitudeKnown = true;
                 emit attitudeChanged(this, getRoll(), getPitch(), getYaw(), time);
                 emit attitudeRotationRatesChanged(uasId, attitude.rollspeed, attitude.pitchspeed, attitude.yawspeed, time);
+
+                // Written to the store only, emitting them would cost three more signals per sample
+                mp_telemetryStore->setValue(uasId,statusName().arg("Roll"),"deg",QVariant(getRoll() * (180.0/M_PI)),time);
+                mp_telemetryStore->setValue(uasId,statusName().arg("Pitch"),"deg",QVariant(getPitch() * (180.0/M_PI)),time);
+                mp_telemetryStore->setValue(uasId,statusName().arg("Yaw"),"deg",QVariant(getYaw() * (180.0/M_PI)),time);
             }
         }
             break;
@@ -1031,6 +1043,7 @@ void UAS::receiveMessage(LinkInterface* link, mavlink_message_t message)
         {
             mavlink_command_ack_t ack;
             mavlink_msg_command_ack_decode(&message, &ack);
+            commandAcknowledged(ack.command);
             switch (ack.result)
             {
             case MAV_RESULT_ACCEPTED:
@@ -2068,16 +2081,27 @@ void UAS::sendHeartbeat()
 void UAS::sendMessage(LinkInterface* link, mavlink_message_t message)
 {
     if(!link) return;
+    // Messages are packed on MAVLINK_COMM_0. Frame them again on the channel of the link
+    // so they use the MAVLink version detected for this link and its sequence numbers.
+    const int channel = p_protocol ? p_protocol->getLinkChannel(link) : -1;
+    const mavlink_msg_entry_t *entry = mavlink_get_msg_entry(message.msgid);
+    if ((channel >= 0) && entry)
+    {
+        mavlink_finalize_message_chan(&message, message.sysid, message.compid, static_cast<uint8_t>(channel),
+                                      entry->min_msg_len, entry->max_msg_len, entry->crc_extra);
+    }
     // Create buffer
     uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
     // Write message into buffer, prepending start sign
     int len = mavlink_msg_to_send_buffer(buffer, &message);
-    //static uint8_t messageKeys[256] = MAVLINK_MESSAGE_CRCS;
-    //mavlink_finalize_message_chan(&message, systemId, componentId, link->getId(), 0, message.len, messageKeys[message.msgid]);
 
     // If link is connected
     if (link->isConnected())
     {
+        if (message.msgid == MAVLINK_MSG_ID_COMMAND_LONG)
+        {
+            commandSent(mavlink_msg_command_long_get_command(&message));
+        }
         // Send the portion of the buffer now occupied by the message
         link->writeBytes((const char*)buffer, len);
     }
@@ -2087,6 +2111,36 @@ void UAS::sendMessage(LinkInterface* link, mavlink_message_t message)
     }
 }
 
+void UAS::commandSent(quint16 command)
+{
+    if (!m_commandClock.isValid())
+    {
+        m_commandClock.start();
+    }
+    // A command sent again is measured from its last transmission
+    m_commandSendTimes.insert(command, m_commandClock.nsecsElapsed());
+}
+
+void UAS::commandAcknowledged(quint16 command)
+{
+    // Round trip through the links, the vehicle and the protocol. This is the end to end
+    // command latency of the link, so changes to the link threads can be compared.
+    const auto iter = m_commandSendTimes.find(command);
+    if (iter == m_commandSendTimes.end())
+    {
+        return;
+    }
+    const double latency = static_cast<double>(m_commandClock.nsecsElapsed() - iter.value()) / 1000000.0;
+    m_commandSendTimes.erase(iter);
+
+    m_commandLatencySum += latency;
+    m_commandLatencyMax = qMax(m_commandLatencyMax, latency);
+    ++m_commandLatencyCount;
+    QLOG_DEBUG() << "UAS" << uasId << "command" << command << "acknowledged after" << latency << "ms - mean"
+                 << m_commandLatencySum / m_commandLatencyCount << "ms, max" << m_commandLatencyMax << "ms over"
+                 << m_commandLatencyCount << "commands";
+}
+
 /**
  * @param value battery voltage
  */
@@ -4025,6 +4079,11 @@ void UAS::valueChangedRec(const int uasId, const QString& name, const QString& u
     emit valueChanged(uasId,name,unit,value,msec);
 }
 
+void UAS::valuesChangedRec(const MAVLinkValueBatch& values)
+{
+    emit valuesChanged(values);
+}
+
 void UAS::textMessageReceivedRec(int uasid, int componentid, int severity, const QString& text)
 {
     emit textMessageReceived(uasid,componentid,severity,text);
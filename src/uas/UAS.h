@@ -36,6 +36,9 @@ This file is part of the QGROUNDCONTROL project
 
 #include <MAVLinkProtocol.h>
 
+#include <QElapsedTimer>
+#include <QHash>
+#include <QScopedPointer>
 #include <QVector3D>
 
 /**
@@ -526,6 +529,7 @@ protected: //COMMENTS FOR TEST UNIT
     double groundSpeed;          ///< Groundspeed
     double bearingToWaypoint;    ///< Bearing to next waypoint
     UASWaypointManager waypointManager;
+    QScopedPointer<UASTelemetryStore, QScopedPointerDeleteLater> mp_telemetryStore;   ///< Latest value of all values emitted by this UAS, lives in the GUI thread
 
     /// ATTITUDE
     bool attitudeKnown;             ///< True if attitude was received, false else
@@ -561,6 +565,18 @@ protected: //COMMENTS FOR TEST UNIT
 
     MAVLinkProtocol* p_protocol = nullptr;
 
+    /// COMMAND LATENCY
+    QElapsedTimer m_commandClock;                   ///< Time base of the command round trip measurement
+    QHash<quint16, qint64> m_commandSendTimes;      ///< Send time in ns of every unacknowledged COMMAND_LONG by command ID
+    double m_commandLatencySum = 0.0;               ///< Sum of all measured round trips in ms
+    double m_commandLatencyMax = 0.0;               ///< Longest measured round trip in ms
+    quint32 m_commandLatencyCount = 0;              ///< Number of measured round trips
+
+    /** @brief Remember the send time of a COMMAND_LONG to measure its round trip */
+    void commandSent(quint16 command);
+    /** @brief Measure and log the round trip of an acknowledged command */
+    void commandAcknowledged(quint16 command);
+
 public:
     void setHeartbeatEnabled(bool enabled) { m_heartbeatsEnabled = enabled; }
     /** @brief Set the current battery type */
@@ -594,6 +610,10 @@ public:
     UASWaypointManager* getWaypointManager() {
         return &waypointManager;
     }
+    /** @brief Get the store holding the latest value of every telemetry field **/
+    UASTelemetryStore* getTelemetryStore() {
+        return mp_telemetryStore.data();
+    }
     /** @brief Get reference to the param manager **/
     QGCUASParamManager* getParamManager() const {
         return paramManager;
@@ -769,6 +789,7 @@ public slots:
 
     void protocolStatusMessageRec(const QString& title, const QString& message);
     void valueChangedRec(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec);
+    void valuesChangedRec(const MAVLinkValueBatch& values);
     void textMessageReceivedRec(int uasid, int componentid, int severity, const QString& text);
     void receiveLossChangedRec(int id,float value);
 
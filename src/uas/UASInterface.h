@@ -40,7 +40,9 @@ This file is part of the QGROUNDCONTROL project
 
 #include "LinkInterface.h"
 #include "ProtocolInterface.h"
+#include "MAVLinkFieldRegistry.h"
 #include "UASWaypointManager.h"
+#include "UASTelemetryStore.h"
 #include "QGCUASParamManager.h"
 #include "RadioCalibration/RadioCalibrationData.h"
 
@@ -159,6 +161,8 @@ public:
 
     /** @brief Get reference to the waypoint manager **/
     virtual UASWaypointManager* getWaypointManager(void) = 0;
+    /** @brief Get the store holding the latest value of every telemetry field **/
+    virtual UASTelemetryStore* getTelemetryStore() = 0;
     /** @brief Get reference to the param manager **/
     virtual QGCUASParamManager* getParamManager() const = 0;
     // TODO Will be removed
@@ -290,6 +294,7 @@ public slots:
      */
     virtual void protocolStatusMessageRec(const QString& title, const QString& message)=0;
     virtual void valueChangedRec(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec)=0;
+    virtual void valuesChangedRec(const MAVLinkValueBatch& values)=0;
     virtual void textMessageReceivedRec(int uasid, int componentid, int severity, const QString& text)=0;
     virtual void receiveLossChangedRec(int id,float value)=0;
 
@@ -535,6 +540,16 @@ signals:
       * @param msec the timestamp of the message, in milliseconds
       */
     void valueChanged(const int uasid, const QString& name, const QString& unit, const QVariant &value,const quint64 msecs);
+    /**
+      * @brief All values of one received MAVLink message have changed
+      *
+      * Name and unit of each value can be looked up by its field ID in the MAVLinkFieldRegistry.
+      * Values of the decoder are only emitted by this signal, valueChanged() is used for the
+      * values calculated by the UAS and for named values like NAMED_VALUE_FLOAT.
+      *
+      * @param values all values of the message
+      */
+    void valuesChanged(const MAVLinkValueBatch& values);
 
     void voltageChanged(int uasId, double voltage);
     void waypointUpdated(int uasId, int id, double x, double y, double z, double yaw, bool autocontinue, bool active);
@@ -0,0 +1,218 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief UASTelemetryStore
+ *          Latest value of every telemetry field of one vehicle, delivered to
+ *          the UI as one coalesced snapshot per display frame.
+ *
+ */
+
+#include "UASTelemetryStore.h"
+
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QThread>
+
+UASTelemetryStore::UASTelemetryStore(int uasId) :
+    QObject(nullptr),
+    m_uasId(uasId),
+    m_sequence(0),
+    m_emittedSequence(0),
+    m_snapshotScheduled(false),
+    m_refreshTimer(this)
+{
+    qRegisterMetaType<UASTelemetrySnapshot>("UASTelemetrySnapshot");
+
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(1000 / s_DefaultRefreshRate);
+    connect(&m_refreshTimer, SIGNAL(timeout()), this, SLOT(emitSnapshot()));
+
+    // The timer is a child and moves along
+    moveToThread(QCoreApplication::instance()->thread());
+}
+
+void UASTelemetryStore::setRefreshRate(int rate)
+{
+    m_refreshTimer.setInterval(1000 / (rate < 1 ? 1 : rate));
+}
+
+quint64 UASTelemetryStore::sequence() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_sequence;
+}
+
+int UASTelemetryStore::findKey(const QString &name, const QString &unit) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_keysByName.value(qMakePair(name, unit), -1);
+}
+
+UASTelemetryValue UASTelemetryStore::latestValue(int key) const
+{
+    QMutexLocker locker(&m_mutex);
+    if ((key < 0) || (key >= m_values.size()))
+    {
+        return UASTelemetryValue();
+    }
+    return m_values.at(key);
+}
+
+QVector<UASTelemetryValue> UASTelemetryStore::changedSince(quint64 sequence) const
+{
+    QVector<UASTelemetryValue> values;
+    QMutexLocker locker(&m_mutex);
+    for (const auto &value : m_values)
+    {
+        if (value.m_sequence > sequence)
+        {
+            values.append(value);
+        }
+    }
+    return values;
+}
+
+void UASTelemetryStore::setValue(const int uasId, const QString &name, const QString &unit, const QVariant &value, const quint64 msec)
+{
+    if (uasId != m_uasId)
+    {
+        return;
+    }
+    bool ok = false;
+    const double doubleValue = value.toDouble(&ok);
+    if (!ok)
+    {
+        return;     // text values are not telemetry
+    }
+
+    QMutexLocker locker(&m_mutex);
+    int key = m_namedKeys.value(qMakePair(name, unit), -1);
+    if (key < 0)
+    {
+        // Remove the "M1:" system prefix once per field
+        key = addField(name.mid(name.indexOf(':') + 1), unit, -1, -1);
+        m_namedKeys.insert(qMakePair(name, unit), key);
+    }
+    update(key, doubleValue, msec);
+}
+
+void UASTelemetryStore::setValues(const MAVLinkValueBatch &values)
+{
+    if (values.m_uasId != m_uasId)
+    {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    for (int i = 0; i < values.count(); ++i)
+    {
+        const quint64 cacheKey = values.cacheKey(i);
+        auto iter = m_batchKeys.constFind(cacheKey);
+        if (iter == m_batchKeys.constEnd())
+        {
+            const MAVLinkFieldRegistry::fieldInfo &info = MAVLinkFieldRegistry::instance().info(values.m_fieldIds[i]);
+            const int compId = values.m_multiComponent ? values.m_compId : -1;
+            QString name = info.m_name;
+            if (compId >= 0)
+            {
+                name.prepend('C' + QString::number(compId) + ':');
+            }
+            iter = m_batchKeys.insert(cacheKey, addField(name, info.m_unit, values.m_fieldIds[i], compId));
+        }
+        update(iter.value(), values.m_values[i], values.m_msec);
+    }
+}
+
+void UASTelemetryStore::update(int key, double value, quint64 msec)
+{
+    UASTelemetryValue &entry = m_values[key];
+    if (entry.m_sequence <= m_emittedSequence)
+    {
+        m_dirtyKeys.append(key);    // first change since the last snapshot
+    }
+    entry.m_value = value;
+    entry.m_msec = msec;
+    entry.m_sequence = ++m_sequence;
+
+    if (!m_snapshotScheduled)
+    {
+        // The timer can only be started in the GUI thread
+        m_snapshotScheduled = true;
+        if (QThread::currentThread() == thread())
+        {
+            m_refreshTimer.start();
+        }
+        else
+        {
+            QMetaObject::invokeMethod(this, "startRefreshTimer", Qt::QueuedConnection);
+        }
+    }
+}
+
+void UASTelemetryStore::startRefreshTimer()
+{
+    if (!m_refreshTimer.isActive())
+    {
+        m_refreshTimer.start();
+    }
+}
+
+int UASTelemetryStore::addField(const QString &name, const QString &unit, int fieldId, int compId)
+{
+    UASTelemetryValue entry;
+    entry.m_key = m_values.size();
+    entry.m_fieldId = fieldId;
+    entry.m_compId = compId;
+    entry.m_name = name;
+    entry.m_unit = unit;
+    m_values.append(entry);
+    m_keysByName.insert(qMakePair(name, unit), entry.m_key);
+    return entry.m_key;
+}
+
+void UASTelemetryStore::emitSnapshot()
+{
+    UASTelemetrySnapshot snapshot;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_snapshotScheduled = false;
+        if (m_dirtyKeys.isEmpty())
+        {
+            return;
+        }
+
+        snapshot.m_uasId = m_uasId;
+        snapshot.m_sequence = m_sequence;
+        snapshot.m_values.reserve(m_dirtyKeys.size());
+        for (int key : m_dirtyKeys)
+        {
+            snapshot.m_values.append(m_values.at(key));
+        }
+        m_dirtyKeys.clear();
+        m_emittedSequence = m_sequence;
+    }
+
+    // Emitted unlocked, receivers may read the store
+    emit snapshotChanged(snapshot);
+}
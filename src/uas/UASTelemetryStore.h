@@ -0,0 +1,181 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief UASTelemetryStore
+ *          Latest value of every telemetry field of one vehicle, delivered to
+ *          the UI as one coalesced snapshot per display frame.
+ *
+ */
+
+#ifndef UASTELEMETRYSTORE_H
+#define UASTELEMETRYSTORE_H
+
+#include "MAVLinkFieldRegistry.h"
+
+#include <QHash>
+#include <QMetaType>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+
+/**
+ * @brief The UASTelemetryValue struct holds the latest value of one telemetry field
+ */
+struct UASTelemetryValue
+{
+    int m_key = -1;             /// key of the field in the store, stable for the lifetime of the store
+    int m_fieldId = -1;         /// field ID of the MAVLinkFieldRegistry, -1 for values calculated by the UAS
+    int m_compId = -1;          /// component of the sender if more than one sends this message, -1 otherwise
+    QString m_name;             /// name without system prefix like "GCS Status.Roll" or "ATTITUDE.roll"
+    QString m_unit;             /// unit or C type of the value
+    double m_value = 0.0;       /// the value
+    quint64 m_msec = 0;         /// time stamp of the value in ms since epoch
+    quint64 m_sequence = 0;     /// sequence number of the last update
+};
+
+/**
+ * @brief The UASTelemetrySnapshot struct holds all fields of one vehicle which
+ *        changed since the previous snapshot.
+ */
+struct UASTelemetrySnapshot
+{
+    int m_uasId = 0;                        /// system ID of the vehicle
+    quint64 m_sequence = 0;                 /// sequence number of the newest value in this snapshot
+    QVector<UASTelemetryValue> m_values;    /// the changed fields with their latest value
+};
+
+Q_DECLARE_METATYPE(UASTelemetrySnapshot)
+
+/**
+ * @brief The UASTelemetryStore class keeps the latest value of every telemetry field of
+ *        one vehicle. It is fed with all values the UAS emits and delivers the changed
+ *        fields as one snapshot at display rate, no matter how many samples arrived in
+ *        between. Widgets which only show the latest value should use snapshotChanged()
+ *        instead of UASInterface::valueChanged() and valuesChanged().
+ *
+ *        Fields are interned once: each field gets a key which is stable for the
+ *        lifetime of the store, so receivers can cache everything they derive from
+ *        the name by key.
+ *
+ *        The store always lives in the GUI thread, so snapshots are delivered even if the
+ *        UAS lives in a thread without an event loop like the one of a tlog replay. The
+ *        values are written in the thread of the UAS, everything is protected by a mutex.
+ *        The store has no parent and should be deleted by deleteLater().
+ */
+class UASTelemetryStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int s_DefaultRefreshRate = 25;     /// snapshots per second
+
+    explicit UASTelemetryStore(int uasId);
+
+    /**
+     * @brief setRefreshRate sets the max number of snapshots per second. Must be
+     *        called in the GUI thread.
+     * @param rate - snapshots per second, values < 1 are treated as 1
+     */
+    void setRefreshRate(int rate);
+
+    /**
+     * @brief sequence delivers the sequence number of the newest value
+     */
+    quint64 sequence() const;
+
+    /**
+     * @brief findKey delivers the key of a field
+     * @param name - name of the field without system prefix
+     * @param unit - unit of the field
+     * @return the key, -1 if the field was not received yet
+     */
+    int findKey(const QString &name, const QString &unit) const;
+
+    /**
+     * @brief latestValue delivers the latest value of a field
+     * @param key - key of the field
+     * @return the value, a value with key -1 if key is unknown
+     */
+    UASTelemetryValue latestValue(int key) const;
+
+    /**
+     * @brief changedSince delivers all fields updated after a sequence number. Can be
+     *        used to fetch the complete state by passing 0.
+     * @param sequence - sequence number of the last value already known
+     * @return the fields
+     */
+    QVector<UASTelemetryValue> changedSince(quint64 sequence) const;
+
+public slots:
+    /**
+     * @brief setValue stores a single named value like emitted by UASInterface::valueChanged()
+     */
+    void setValue(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec);
+
+    /**
+     * @brief setValues stores all values of a decoded message
+     */
+    void setValues(const MAVLinkValueBatch& values);
+
+signals:
+    /**
+     * @brief snapshotChanged is emitted at most with the refresh rate if fields changed
+     * @param snapshot - the changed fields
+     */
+    void snapshotChanged(const UASTelemetrySnapshot &snapshot);
+
+private slots:
+    void startRefreshTimer();
+    void emitSnapshot();
+
+private:
+    /**
+     * @brief update stores a value and schedules the next snapshot. m_mutex must be locked.
+     */
+    void update(int key, double value, quint64 msec);
+
+    /**
+     * @brief addField interns a new field. m_mutex must be locked.
+     * @return key of the new field
+     */
+    int addField(const QString &name, const QString &unit, int fieldId, int compId);
+
+    int m_uasId;                                        /// system ID of the vehicle
+    mutable QMutex m_mutex;                             /// protects everything below except m_refreshTimer
+    quint64 m_sequence;                                 /// sequence number of the newest value
+    quint64 m_emittedSequence;                          /// sequence number of the newest value already emitted
+    QVector<UASTelemetryValue> m_values;                /// latest value of each field by key
+    QVector<int> m_dirtyKeys;                           /// keys of the fields changed since the last snapshot
+    QHash<QPair<QString, QString>, int> m_namedKeys;    /// key of each named value by name (with prefix) and unit
+    QHash<QPair<QString, QString>, int> m_keysByName;   /// key of each field by name (without prefix) and unit
+    QHash<quint64, int> m_batchKeys;                    /// key of each decoded field by MAVLinkValueBatch::cacheKey()
+    bool m_snapshotScheduled;                           /// true from the first change until the next snapshot
+    QTimer m_refreshTimer;                              /// only used in the GUI thread
+};
+
+#endif // UASTELEMETRYSTORE_H
@@ -43,14 +43,22 @@ This file is part of the APM_PLANNER project
 #include "MainWindow.h"
 #include "ArduPilotMegaMAV.h"
 #include <QSettings>
+#include <QDir>
 
 #include "Loghandling/LogExporter.h"
 #include "Loghandling/LogAnalysis.h"
 
 #define ROW_HEIGHT_PADDING 3 //Number of additional pixels over font height for each row for the table/excel view.
 
+namespace
+{
+    const int s_DefaultRetentionMinutes = 30;  // Values older than this are dropped from the live graphs
+}
+
 AP2DataPlot2D::AP2DataPlot2D(QWidget *parent) : QWidget(parent),
     m_updateTimer(nullptr),
+    m_onlineCapacity(AP2DataPlotBuffer::s_DefaultCapacity),
+    m_onlineRetention(s_DefaultRetentionMinutes * 60.0),
     m_graphCount(0),
     m_plot(nullptr),
     m_wideAxisRect(nullptr),
@@ -137,6 +145,17 @@ void AP2DataPlot2D::loadSettings()
     ui.showValuesCheckBox->setChecked(settings.value("SHOW_VALUES", Qt::Unchecked).toBool());
     ui.autoScrollCheckBox->setChecked(settings.value("AUTO_SCROLL", Qt::Unchecked).toBool());
     ui.modeDisplayCheckBox->setChecked(settings.value("SHOW_MODE", Qt::Checked).toBool());
+
+    // Bounds of the live graphs. A retention of 0 minutes keeps values until the capacity is reached
+    m_onlineRetention = settings.value("ONLINE_RETENTION_MINUTES", s_DefaultRetentionMinutes).toDouble() * 60.0;
+    m_onlineCapacity = settings.value("ONLINE_MAX_VALUES", AP2DataPlotBuffer::s_DefaultCapacity).toInt();
+    if (settings.value("ONLINE_SPILL_TO_DISK", false).toBool())
+    {
+        QString fileName = QGC::logDirectory() + QDir::separator() + "graph_"
+                + QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss") + ".csv";
+        m_spillFilePtr.reset(new AP2DataPlotSpillFile(fileName));
+        m_spillFilePtr->setStartTime(m_startIndex);
+    }
     settings.endGroup();
 }
 
@@ -147,6 +166,9 @@ void AP2DataPlot2D::saveSettings()
     settings.setValue("SHOW_VALUES", ui.showValuesCheckBox->isChecked());
     settings.setValue("AUTO_SCROLL", ui.autoScrollCheckBox->isChecked());
     settings.setValue("SHOW_MODE", ui.modeDisplayCheckBox->isChecked());
+    settings.setValue("ONLINE_RETENTION_MINUTES", m_onlineRetention / 60.0);
+    settings.setValue("ONLINE_MAX_VALUES", m_onlineCapacity);
+    settings.setValue("ONLINE_SPILL_TO_DISK", !m_spillFilePtr.isNull());
     settings.sync();
 }
 
@@ -430,12 +452,17 @@ void AP2DataPlot2D::activeUASSet(UASInterface* uas)
     if (m_uas)
     {
         disconnect(m_uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
+        disconnect(m_uas,SIGNAL(valuesChanged(MAVLinkValueBatch)),this,SLOT(valuesChanged(MAVLinkValueBatch)));
         disconnect(m_uas,SIGNAL(navModeChanged(int,int,QString)),this,SLOT(navModeChanged(int,int,QString)));
         disconnect(m_uas,SIGNAL(connected()),this,SLOT(connected()));
         disconnect(m_uas,SIGNAL(disconnected()),this,SLOT(disconnected()));
     }
     m_currentIndex = QDateTime::currentMSecsSinceEpoch();
     m_startIndex = m_currentIndex;
+    if (m_spillFilePtr)
+    {
+        m_spillFilePtr->setStartTime(m_startIndex);
+    }
     m_scrollStartIndex = 0;
     ui.horizontalScrollBar->blockSignals(true);
     ui.horizontalScrollBar->setMinimum(m_scrollStartIndex);
@@ -443,6 +470,7 @@ void AP2DataPlot2D::activeUASSet(UASInterface* uas)
     m_uas = uas;
 
     connect(m_uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
+    connect(m_uas,SIGNAL(valuesChanged(MAVLinkValueBatch)),this,SLOT(valuesChanged(MAVLinkValueBatch)));
     connect(m_uas,SIGNAL(navModeChanged(int,int,QString)),this,SLOT(navModeChanged(int,int,QString)));
 
     //textMessageReceived(uasId, message.compid, severity, text);
@@ -501,7 +529,6 @@ void AP2DataPlot2D::navModeChanged(int uasid, int mode, const QString& text)
 
 void AP2DataPlot2D::updateValue(const int uasId, const QString& name, const QString& unit, const double value, const quint64 msec,bool integer)
 {
-    Q_UNUSED(msec)
     Q_UNUSED(unit)
     if (m_uas->getUASID() != uasId)
     {
@@ -515,15 +542,49 @@ void AP2DataPlot2D::updateValue(const int uasId, const QString& name, const QStr
         // name looks like M1:ATTITUDE.Pitch or M1:BATTERY_STATUS.voltages.0
         propername  = parts[1];
     }
+    updateGraphValue(propername, value, msec, integer);
+}
+
+void AP2DataPlot2D::valuesChanged(const MAVLinkValueBatch& values)
+{
+    if (m_uas->getUASID() != values.m_uasId)
+    {
+        return;
+    }
+
+    const MAVLinkFieldRegistry &registry = MAVLinkFieldRegistry::instance();
+    for (int i = 0; i < values.count(); ++i)
+    {
+        // Build the graph name only once per field
+        const quint64 key = values.cacheKey(i);
+        auto iter = m_fieldNameCache.find(key);
+        if (iter == m_fieldNameCache.end())
+        {
+            QString propername = registry.info(values.m_fieldIds[i]).m_name;
+            if (values.m_multiComponent)
+            {
+                propername.prepend('C' + QString::number(values.m_compId) + ':');
+            }
+            iter = m_fieldNameCache.insert(key, propername);
+        }
+        updateGraphValue(iter.value(), values.m_values[i], values.m_msec, registry.isInteger(values.m_fieldIds[i]));
+    }
+}
 
-    if (!m_onlineValueMap.contains(propername))
+void AP2DataPlot2D::updateGraphValue(const QString& propername, const double value, const quint64 msec, bool integer)
+{
+    Q_UNUSED(msec)
+    QMap<QString,AP2DataPlotBuffer>::iterator valueIter = m_onlineValueMap.find(propername);
+    if (valueIter == m_onlineValueMap.end())
     {
         ui.dataSelectionScreen->addItem(propername);
+        valueIter = m_onlineValueMap.insert(propername, AP2DataPlotBuffer(propername, m_onlineCapacity, m_onlineRetention, m_spillFilePtr.data()));
     }
 
     qint64 msec_current = QDateTime::currentMSecsSinceEpoch();
     m_currentIndex = msec_current;
     qint64 newmsec = (msec_current - m_startIndex);// + m_timeDiff;
+    valueIter->append(newmsec / 1000.0, value);
     if (m_graphCount > 0 && ui.autoScrollCheckBox->isChecked())
     {
         double diff = (newmsec / 1000.0) - m_wideAxisRect->axis(QCPAxis::atBottom,0)->range().upper;
@@ -537,24 +598,16 @@ void AP2DataPlot2D::updateValue(const int uasId, const QString& name, const QStr
     if (m_graphClassMap.contains(propername))
     {
         m_graphClassMap[propername].axisIndex = newmsec / 1000.0;// + 18000000;
-        m_graphClassMap.value(propername).graph->addData(m_graphClassMap.value(propername).axisIndex,value);
+        QCPGraph *graph = m_graphClassMap.value(propername).graph;
+        graph->addData(m_graphClassMap.value(propername).axisIndex,value);
+        // The graph holds the same values as the online buffer - drop what the buffer dropped
+        if (graph->data()->constBegin()->key < valueIter->firstKey())
+        {
+            graph->data()->removeBefore(valueIter->firstKey());
+        }
         m_scrollEndIndex = newmsec /  1000.0;
         //ui.horizontalScrollBar->setMinimum(m_startIndex);
         ui.horizontalScrollBar->setMaximum(m_scrollEndIndex);
-        //Set a timeout for 30 minutes from now, 1800 seconds.
-        qint64 current = QDateTime::currentMSecsSinceEpoch();
-        //This is 30 minutes
-        m_onlineValueTimeoutList.append(QPair<qint64,double>(current + 1800000,msec));
-        //This is 1 minute
-        //m_onlineValueTimeoutList.append(QPair<qint64,double>(current + 60000,m_currentIndex));
-        if (m_onlineValueTimeoutList[0].first <= current)
-        {
-            for (QMap<QString,Graph>::const_iterator i = m_graphClassMap.constBegin();i!=m_graphClassMap.constEnd();i++)
-            {
-//                i.value().graph->removeData(0,m_onlineValueTimeoutList[0].second);
-            }
-            m_onlineValueTimeoutList.removeAt(0);
-        }
         if (m_graphClassMap.value(propername).groupName != "" && m_graphClassMap.value(propername).groupName != "MANUAL")
         {
             //Current graph is in a group
@@ -592,7 +645,6 @@ void AP2DataPlot2D::updateValue(const int uasId, const QString& name, const QStr
             m_graphClassMap.value(propername).axis->setNumberPrecision(0);
         }
     }
-    m_onlineValueMap[propername].append(QPair<double,double>(newmsec / 1000.0,value));
 }
 
 void AP2DataPlot2D::valueChanged(const int uasId, const QString& name, const QString& unit, const QVariant& value,const quint64 msec)
@@ -639,6 +691,11 @@ AP2DataPlot2D::~AP2DataPlot2D()
 {
     QLOG_DEBUG() << "AP2DataPlot2D::~AP2DataPlot2D()";
     saveSettings();
+    // the spill file shall contain the whole session. It is flushed when it is destroyed.
+    for (auto &buffer : m_onlineValueMap)
+    {
+        buffer.spillAll();
+    }
     if (m_updateTimer)
     {
         m_updateTimer->stop();
@@ -667,23 +724,7 @@ void AP2DataPlot2D::itemEnabled(QString name)
     {
         QVector<double> xlist;
         QVector<double> ylist;
-
-        double min = m_onlineValueMap[name][0].second;
-        double max = m_onlineValueMap[name][0].second;
-        for (int j=0;j<m_onlineValueMap[name].size();j++)
-        {
-            xlist.append(m_onlineValueMap[name][j].first);
-            double val = m_onlineValueMap[name][j].second;
-            if (val > max)
-            {
-                max = val;
-            }
-            if (val < min)
-            {
-                min = val;
-            }
-            ylist.append(val);
-        }
+        m_onlineValueMap.value(name).copyTo(xlist, ylist);
         QCPAxis *axis = m_wideAxisRect->addAxis(QCPAxis::atLeft);
         axis->setLabel(name);
         QColor color = QColor::fromRgb(rand()%255,rand()%255,rand()%255);
@@ -692,7 +733,7 @@ void AP2DataPlot2D::itemEnabled(QString name)
         axis->setNumberFormat("f");
         QCPGraph *mainGraph1 = m_plot->addGraph(m_wideAxisRect->axis(QCPAxis::atBottom), m_wideAxisRect->axis(QCPAxis::atLeft,m_graphCount++));
         m_graphNameList.append(name);
-        mainGraph1->setData(xlist, ylist);
+        mainGraph1->setData(xlist, ylist, true);
         mainGraph1->rescaleValueAxis();
 
         if (m_graphCount == 1)
@@ -770,9 +811,19 @@ void AP2DataPlot2D::clearGraph()
     m_graphNameList.clear();
     m_graphCount = 0;
 
+    // the spill file shall contain the whole session
+    for (auto &buffer : m_onlineValueMap)
+    {
+        buffer.spillAll();
+    }
     m_currentIndex = QDateTime::currentMSecsSinceEpoch();
     m_startIndex = m_currentIndex;
     m_onlineValueMap.clear();
+    if (m_spillFilePtr)
+    {
+        m_spillFilePtr->flush();
+        m_spillFilePtr->setStartTime(m_startIndex);
+    }
     m_plot->replot();
 }
 
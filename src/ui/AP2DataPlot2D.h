@@ -38,6 +38,7 @@ This file is part of the APM_PLANNER project
 #include "AP2DataPlotThread.h"
 #include "dataselectionscreen.h"
 #include "AP2DataPlotAxisDialog.h"
+#include "AP2DataPlotBuffer.h"
 #include "ui_AP2DataPlot2D.h"
 
 #include <QWidget>
@@ -87,6 +88,8 @@ private slots:
 
     //ValueChanged functions for getting mavlink values
     void valueChanged(const int uasid, const QString& name, const QString& unit, const QVariant& value,const quint64 msecs);
+    //Called with all values of one mavlink message
+    void valuesChanged(const MAVLinkValueBatch& values);
     //Called by every valueChanged function to actually save the value/graph it.
     void updateValue(const int uasId, const QString& name, const QString& unit, const double value, const quint64 msec,bool integer = true);
 
@@ -108,6 +111,10 @@ private slots:
 
     void childGraphDestroyed(QObject *obj);
 
+private:
+    //Adds a value to the graph with the given name
+    void updateGraphValue(const QString& propername, const double value, const quint64 msec, bool integer);
+
 private:
 
     void showEvent(QShowEvent *evt) override;
@@ -156,12 +163,18 @@ private:
     QMap<QString,QList<QString> > m_graphGrouping;
     //Map from group titles to the value axis range.
     QMap<QString,QCPRange> m_graphGroupRanges;
-    //Graph name to list of values for "online" mode
-    QMap<QString,QList<QPair<double,double> > > m_onlineValueMap;
+    //Graph name to bounded list of values for "online" mode
+    QMap<QString,AP2DataPlotBuffer> m_onlineValueMap;
     // Child windows which were opened by open log
     QList<QWidget*> m_childGraphList;
 
-    QList<QPair<qint64,double> > m_onlineValueTimeoutList;
+    int m_onlineCapacity;       // max number of values per graph in "online" mode
+    double m_onlineRetention;   // max age of values in "online" mode in seconds
+    // Receives the values dropped from m_onlineValueMap and the ones still held on clear and close, if spilling is enabled
+    QScopedPointer<AP2DataPlotSpillFile> m_spillFilePtr;
+
+    //Graph names of the mavlink fields by MAVLinkValueBatch::cacheKey()
+    QHash<quint64,QString> m_fieldNameCache;
 
     //List of graph names, used in m_axisList, m_graphMap,m_graphToGroupMap and the like as the graph name
     QList<QString> m_graphNameList;
@@ -0,0 +1,192 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file
+ *   @brief Bounded storage for the live graphs of AP2DataPlot
+ *
+ */
+
+#include "AP2DataPlotBuffer.h"
+#include "logging.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+AP2DataPlotSpillFile::AP2DataPlotSpillFile(const QString &fileName) :
+    m_file(fileName),
+    m_startTime(0),
+    m_failed(false)
+{
+}
+
+AP2DataPlotSpillFile::~AP2DataPlotSpillFile()
+{
+    flush();
+}
+
+void AP2DataPlotSpillFile::setStartTime(qint64 msecsSinceEpoch)
+{
+    m_startTime = msecsSinceEpoch;
+}
+
+void AP2DataPlotSpillFile::write(const QString &name, double key, double value)
+{
+    if (!m_file.isOpen())
+    {
+        if (m_failed)
+        {
+            return;
+        }
+        QDir().mkpath(QFileInfo(m_file).absolutePath());
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            QLOG_WARN() << "AP2DataPlotSpillFile: Unable to open" << m_file.fileName() << m_file.errorString();
+            m_failed = true;
+            return;
+        }
+        QLOG_INFO() << "AP2DataPlotSpillFile: Writing graph values to" << m_file.fileName();
+        m_stream.setDevice(&m_file);
+        m_stream << "Time [ms since epoch],Graph,Value\n";
+    }
+
+    m_stream << m_startTime + qRound64(key * 1000.0) << ',' << name << ',' << QString::number(value, 'g', 10) << '\n';
+}
+
+void AP2DataPlotSpillFile::flush()
+{
+    if (m_file.isOpen())
+    {
+        m_stream.flush();
+    }
+}
+
+//************************************************************************************************************
+
+AP2DataPlotBuffer::AP2DataPlotBuffer(const QString &name, int capacity, double retention, AP2DataPlotSpillFile *p_spillFile) :
+    m_name(name),
+    m_head(0),
+    m_count(0),
+    m_capacity(capacity > 0 ? capacity : 1),
+    m_retention(retention),
+    mp_spillFile(p_spillFile)
+{
+}
+
+void AP2DataPlotBuffer::append(double key, double value)
+{
+    if (m_count == m_samples.size())
+    {
+        if (m_samples.size() < m_capacity)
+        {
+            grow();
+        }
+        else
+        {
+            dropFirst();
+        }
+    }
+
+    sample &newSample = m_samples[(m_head + m_count) % m_samples.size()];
+    newSample.m_key = key;
+    newSample.m_value = value;
+    ++m_count;
+
+    if (m_retention > 0.0)
+    {
+        const double oldestKey = key - m_retention;
+        while (m_count > 1 && m_samples.at(m_head).m_key < oldestKey)
+        {
+            dropFirst();
+        }
+    }
+}
+
+int AP2DataPlotBuffer::size() const
+{
+    return m_count;
+}
+
+bool AP2DataPlotBuffer::isEmpty() const
+{
+    return m_count == 0;
+}
+
+const AP2DataPlotBuffer::sample &AP2DataPlotBuffer::at(int index) const
+{
+    return m_samples.at((m_head + index) % m_samples.size());
+}
+
+double AP2DataPlotBuffer::firstKey() const
+{
+    return m_samples.at(m_head).m_key;
+}
+
+void AP2DataPlotBuffer::copyTo(QVector<double> &keys, QVector<double> &values) const
+{
+    keys.resize(m_count);
+    values.resize(m_count);
+    for (int i = 0; i < m_count; ++i)
+    {
+        const sample &current = at(i);
+        keys[i] = current.m_key;
+        values[i] = current.m_value;
+    }
+}
+
+void AP2DataPlotBuffer::spillAll()
+{
+    if (mp_spillFile)
+    {
+        for (int i = 0; i < m_count; ++i)
+        {
+            const sample &current = at(i);
+            mp_spillFile->write(m_name, current.m_key, current.m_value);
+        }
+    }
+    m_head = 0;
+    m_count = 0;
+}
+
+void AP2DataPlotBuffer::dropFirst()
+{
+    if (mp_spillFile)
+    {
+        const sample &oldest = m_samples.at(m_head);
+        mp_spillFile->write(m_name, oldest.m_key, oldest.m_value);
+    }
+    m_head = (m_head + 1) % m_samples.size();
+    --m_count;
+}
+
+void AP2DataPlotBuffer::grow()
+{
+    int newSize = m_samples.isEmpty() ? s_InitialSize : m_samples.size() * 2;
+    newSize = newSize < m_capacity ? newSize : m_capacity;
+
+    QVector<sample> newSamples(newSize);
+    for (int i = 0; i < m_count; ++i)
+    {
+        newSamples[i] = at(i);
+    }
+    m_samples.swap(newSamples);
+    m_head = 0;
+}
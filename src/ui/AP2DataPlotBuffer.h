@@ -0,0 +1,180 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file
+ *   @brief Bounded storage for the live graphs of AP2DataPlot
+ *
+ */
+
+#ifndef AP2DATAPLOTBUFFER_H
+#define AP2DATAPLOTBUFFER_H
+
+#include <QFile>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+
+/**
+ * @brief The AP2DataPlotSpillFile class writes the samples which were evicted from
+ *        the live graph buffers to a csv file, so nothing is lost when the retention
+ *        of the graphs is limited. The samples still held when the graphs are cleared
+ *        or closed are written as well (see AP2DataPlotBuffer::spillAll()). The file
+ *        is only created when the first sample is written.
+ */
+class AP2DataPlotSpillFile
+{
+public:
+    /**
+     * @brief AP2DataPlotSpillFile - CTOR
+     * @param fileName - name of the csv file to write
+     */
+    explicit AP2DataPlotSpillFile(const QString &fileName);
+
+    /**
+     * @brief ~AP2DataPlotSpillFile - DTOR flushes and closes the file
+     */
+    ~AP2DataPlotSpillFile();
+
+    /**
+     * @brief setStartTime sets the time the keys of the samples are relative to
+     * @param msecsSinceEpoch - start of the graphing in ms since epoch
+     */
+    void setStartTime(qint64 msecsSinceEpoch);
+
+    /**
+     * @brief write writes one sample
+     * @param name - name of the graph
+     * @param key - time of the sample in seconds relative to the start time
+     * @param value - value of the sample
+     */
+    void write(const QString &name, double key, double value);
+
+    /**
+     * @brief flush writes all buffered samples to disk
+     */
+    void flush();
+
+private:
+    QFile m_file;               ///< the csv file
+    QTextStream m_stream;       ///< buffered stream on m_file
+    qint64 m_startTime;         ///< ms since epoch the keys are relative to
+    bool m_failed;              ///< true if the file could not be opened. No further tries.
+};
+
+/**
+ * @brief The AP2DataPlotBuffer class is a ring buffer holding the samples of one live
+ *        graph. It never holds more than its capacity and drops samples which are older
+ *        than the retention time. Memory is allocated on demand, so rarely sent values
+ *        do not reserve the whole capacity. Dropped samples are handed to the spill
+ *        file if there is one.
+ */
+class AP2DataPlotBuffer
+{
+public:
+    static const int s_DefaultCapacity = 65536;     ///< Default max number of samples per graph
+
+    /**
+     * @brief The sample struct holds one value of a graph
+     */
+    struct sample
+    {
+        double m_key;       ///< time in seconds since start of graphing
+        double m_value;     ///< the value
+    };
+
+    /**
+     * @brief AP2DataPlotBuffer - CTOR
+     * @param name - name of the graph, used for the spill file
+     * @param capacity - max number of samples held
+     * @param retention - max age of the samples in seconds. 0 means no limit.
+     * @param p_spillFile - receives the dropped samples, may be nullptr
+     */
+    AP2DataPlotBuffer(const QString &name = QString(), int capacity = s_DefaultCapacity,
+                      double retention = 0.0, AP2DataPlotSpillFile *p_spillFile = nullptr);
+
+    /**
+     * @brief append adds a sample and drops the samples which exceed the capacity
+     *        or the retention time.
+     * @param key - time in seconds, must not be smaller than the key of the last sample
+     * @param value - the value
+     */
+    void append(double key, double value);
+
+    /**
+     * @brief size - number of samples held
+     */
+    int size() const;
+
+    /**
+     * @brief isEmpty - true if no sample is held
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief at delivers a sample
+     * @param index - 0 is the oldest sample
+     * @return the sample
+     */
+    const sample &at(int index) const;
+
+    /**
+     * @brief firstKey - key of the oldest sample. Only valid if not empty.
+     */
+    double firstKey() const;
+
+    /**
+     * @brief copyTo fills the vectors with all samples, oldest first
+     * @param keys - filled with the keys
+     * @param values - filled with the values
+     */
+    void copyTo(QVector<double> &keys, QVector<double> &values) const;
+
+    /**
+     * @brief spillAll hands all held samples to the spill file and empties the buffer.
+     *        Must be called before the buffer is discarded, otherwise only the samples
+     *        dropped so far are in the spill file.
+     */
+    void spillAll();
+
+private:
+    static const int s_InitialSize = 64;    ///< Initial allocation
+
+    QString m_name;                         ///< name of the graph
+    QVector<sample> m_samples;              ///< ring storage, grows up to m_capacity
+    int m_head;                             ///< index of the oldest sample in m_samples
+    int m_count;                            ///< number of valid samples
+    int m_capacity;                         ///< max number of samples
+    double m_retention;                     ///< max age of samples in seconds, 0 - no limit
+    AP2DataPlotSpillFile *mp_spillFile;     ///< receives dropped samples, may be nullptr
+
+    /**
+     * @brief dropFirst drops the oldest sample
+     */
+    void dropFirst();
+
+    /**
+     * @brief grow enlarges the ring storage and moves the samples to its front
+     */
+    void grow();
+};
+
+#endif // AP2DATAPLOTBUFFER_H
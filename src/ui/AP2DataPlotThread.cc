@@ -28,11 +28,15 @@ This file is part of the APM_PLANNER project
  */
 
 #include <QTextBlock>
+#include <QSettings>
+#include <QCoreApplication>
+#include <QDateTime>
 #include "AP2DataPlotThread.h"
 #include "logging.h"
 #include "Loghandling/BinLogParser.h"
 #include "Loghandling/AsciiLogParser.h"
 #include "Loghandling/TlogParser.h"
+#include "Loghandling/LogdataCache.h"
 
 
 AP2DataPlotThread::AP2DataPlotThread(LogdataStorage::Ptr storagePtr, QObject *parent) :
@@ -51,6 +55,9 @@ AP2DataPlotThread::AP2DataPlotThread(LogdataStorage::Ptr storagePtr, QObject *pa
 AP2DataPlotThread::~AP2DataPlotThread()
 {
     QLOG_DEBUG() << "Destroyed AP2DataPlotThread:" << this;
+    // The cache may still be written after done() was emitted - abort it
+    m_stop = true;
+    wait();
 }
 
 void AP2DataPlotThread::loadFile(const QString &file)
@@ -101,10 +108,25 @@ void AP2DataPlotThread::run()
 
     QLOG_DEBUG() << "AP2DataPlotThread::run(): Log loading start -" << logfile.size() << "bytes";
 
+    QSettings settings;
+    settings.beginGroup("LOGANALYSIS_SETTINGS");
+    const bool useLogCache = settings.value("USE_LOG_CACHE", true).toBool();
+    const bool mapBinaryLogs = settings.value("MAP_BINARY_LOGS", true).toBool();
+    settings.endGroup();
+
+    // A log which was parsed before can be restored from its cache
+    if (useLogCache && LogdataCache::read(m_fileName, *m_dataStoragePtr, plotState))
+    {
+        QLOG_INFO() << "Plot Log loading from cache took" << (QDateTime::currentMSecsSinceEpoch() - msecs) / 1000.0 << "seconds";
+        emit done(plotState);
+        return;
+    }
+
     if (m_fileName.toLower().endsWith(".bin"))
     {
         //It's a binary file
         BinLogParser parser(m_dataStoragePtr, this);
+        parser.setUseMappedFile(mapBinaryLogs);
         mp_logParser = &parser;
         plotState = parser.parse(logfile);
         mp_logParser = 0;
@@ -142,7 +164,20 @@ void AP2DataPlotThread::run()
     {
         QLOG_INFO() << "Plot Log loading took" << (QDateTime::currentMSecsSinceEpoch() - msecs) / 1000.0 << "seconds -"
                     << logfile.pos() << "of" << logfile.size() << "bytes used";
+
+        // The datamodel is used by the GUI after done(), so the cache content is
+        // taken before. Only writing it to disk is done afterwards.
+        QByteArray cacheData;
+        if (useLogCache)
+        {
+            cacheData = LogdataCache::serialize(m_fileName, *m_dataStoragePtr, plotState);
+        }
         emit done(plotState);
+
+        if (!cacheData.isEmpty())
+        {
+            LogdataCache::writeData(m_fileName, cacheData, &m_stop);
+        }
     }
 }
 
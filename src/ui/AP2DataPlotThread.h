@@ -32,6 +32,7 @@ This file is part of the APM_PLANNER project
 #define AP2DATAPLOTTHREAD_H
 
 #include <QThread>
+#include <atomic>
 #include "Loghandling/IParserCallback.h"
 #include "Loghandling/ILogParser.h"
 
@@ -53,7 +54,8 @@ public:
     explicit AP2DataPlotThread(LogdataStorage::Ptr storagePtr, QObject *parent = 0);
 
     /**
-     * @brief ~AP2DataPlotThread - DTOR
+     * @brief ~AP2DataPlotThread - DTOR. Aborts a running parsing or cache
+     *        writing and waits for the thread.
      */
     ~AP2DataPlotThread();
 
@@ -88,7 +90,7 @@ signals:
 private:
 
     QString m_fileName;     /// Filename of the file to be parsed
-    bool m_stop;            /// true if parsing shall be stopped
+    std::atomic<bool> m_stop;   /// true if parsing or cache writing shall be stopped
 
     LogdataStorage::Ptr m_dataStoragePtr;   /// Pointer to the datamodel for storing the data
 
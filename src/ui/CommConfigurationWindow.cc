@@ -51,6 +51,7 @@ This file is part of the QGROUNDCONTROL project
 #include "QGCUDPClientLinkConfiguration.h"
 #include "QGCTCPLinkConfiguration.h"
 #include "LinkManager.h"
+#include "MAVLinkRouterConfiguration.h"
 #include "MainWindow.h"
 
 #include <QDir>
@@ -155,6 +156,9 @@ CommConfigurationWindow::CommConfigurationWindow(int linkid, ProtocolInterface*
         ui.linkType->setCurrentIndex(ui.linkType->findData(QGC_LINK_UDP_CLIENT));
     }
 
+    // Frames received on this link can be forwarded to other links
+    ui.verticalLayout_2->insertWidget(1, new MAVLinkRouterConfiguration(linkid, this));
+
     // Display the widget
     this->window()->setWindowTitle(tr("Settings for ") + LinkManager::instance()->getLinkName(linkid));
     this->hide();
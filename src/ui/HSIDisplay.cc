@@ -44,6 +44,7 @@ This file is part of the QGROUNDCONTROL project
 #include <QGraphicsScene>
 #include <QHBoxLayout>
 #include <QDoubleSpinBox>
+#include <QHash>
 #include <qmath.h>
 
 HSIDisplay::HSIDisplay(QWidget *parent) :
@@ -149,9 +150,13 @@ HSIDisplay::HSIDisplay(QWidget *parent) :
     userSetPointSet(false),
     userXYSetPointSet(false),
     userZSetPointSet(false),
-    userYawSetPointSet(false)
+    userYawSetPointSet(false),
+    m_ringLayerMetricWidth(0.0)
 {
     refreshTimer->setInterval(updateInterval);
+    // Only repaint if something visible changed
+    disconnect(refreshTimer, SIGNAL(timeout()), this, SLOT(triggerUpdate()));
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshIfChanged()));
 
     columns = 1;
     this->setAutoFillBackground(true);
@@ -229,7 +234,71 @@ void HSIDisplay::paintEvent(QPaintEvent * event)
     //    static quint64 interval = 0;
     //    //QLOG_DEBUG() << "INTERVAL:" << MG::TIME::getGroundTimeNow() - interval << __FILE__ << __LINE__;
     //    interval = MG::TIME::getGroundTimeNow();
+    m_refresh.beginFrame();
     renderOverlay();
+    m_refresh.endFrame();
+}
+
+const InstrumentRefresh &HSIDisplay::instrumentRefresh() const
+{
+    return m_refresh;
+}
+
+void HSIDisplay::refreshIfChanged()
+{
+    if (m_refresh.needsRepaint(displayState()))
+    {
+        triggerUpdate();
+    }
+}
+
+QVector<qint64> HSIDisplay::displayState() const
+{
+    // Waypoints are not part of the state, they are repainted within InstrumentRefresh::s_MaxFrameAge
+    double scale = width()/vwidth;
+    if (height()/vheight < scale) scale = height()/vheight;
+    const double metersPerPixel = metricWidth / (vwidth * scale);
+
+    QVector<qint64> state;
+    state << width() << height()
+          << InstrumentRefresh::quantize(metricWidth, 0.1)
+          << static_cast<int>((yaw/M_PI)*180.0f) % 360
+          << InstrumentRefresh::quantize(x, 0.01) << InstrumentRefresh::quantize(y, 0.01)
+          << InstrumentRefresh::quantize(z, 0.01) << InstrumentRefresh::quantize(speed, 0.01)
+          << InstrumentRefresh::quantize(lat, 0.01) << InstrumentRefresh::quantize(lon, 0.01)
+          << InstrumentRefresh::quantize(alt, 0.01)
+          << (localAvailable > 0) << (globalAvailable > 0)
+          << InstrumentRefresh::quantize(posXSet, 0.01) << InstrumentRefresh::quantize(posYSet, 0.01)
+          << InstrumentRefresh::quantize(attXSet, 0.01) << InstrumentRefresh::quantize(attYSet, 0.01)
+          << InstrumentRefresh::quantize(bodyXSetCoordinate, metersPerPixel)
+          << InstrumentRefresh::quantize(bodyYSetCoordinate, metersPerPixel)
+          << InstrumentRefresh::quantize(bodyZSetCoordinate, metersPerPixel)
+          << InstrumentRefresh::quantize(bodyYawSet, 0.01)
+          << InstrumentRefresh::quantize(uiXSetCoordinate, metersPerPixel)
+          << InstrumentRefresh::quantize(uiYSetCoordinate, metersPerPixel)
+          << InstrumentRefresh::quantize(uiZSetCoordinate, metersPerPixel)
+          << InstrumentRefresh::quantize(uiYawSet, 0.01)
+          << positionSetPointKnown << setPointKnown << userSetPointSet << dragStarted << mavInitialized
+          << qHash(statusMessage)
+          << rateControlKnown << rateControlEnabled << attControlKnown << attControlEnabled
+          << xyControlKnown << xyControlEnabled << zControlKnown << zControlEnabled
+          << yawControlKnown << yawControlEnabled
+          << positionFixKnown << positionFix << gpsFixKnown << gpsFix
+          << visionFixKnown << visionFix << iruFixKnown << iruFix
+          << gyroKnown << gyroON << gyroOK << accelKnown << accelON << accelOK
+          << magKnown << magON << magOK << pressureKnown << pressureON << pressureOK
+          << diffPressureKnown << diffPressureON << diffPressureOK << flowKnown << flowON << flowOK
+          << laserKnown << laserON << laserOK << viconKnown << viconON << viconOK
+          << actuatorsKnown << actuatorsON << actuatorsOK;
+    if (uas)
+    {
+        state << uas->getAirframe() << uas->getColor().rgba();
+    }
+    foreach (const GPSSatellite *sat, gpsSatellites)
+    {
+        state << sat->id << sat->used << qRound(sat->azimuth) << qRound(sat->elevation) << qRound(sat->snr);
+    }
+    return state;
 }
 
 void HSIDisplay::renderOverlay()
@@ -266,13 +335,27 @@ void HSIDisplay::renderOverlay()
     pen.setColor(ringColor);
     pen.setWidth(refLineWidthToPen(1.0f));
     painter.setPen(pen);
-    const int ringCount = 2;
-    for (int i = 0; i < ringCount; i++)
+
+    // The range rings only change with the size and the zoom, render them once
+    if (m_ringLayer.isNull() || (m_ringLayerSize != size()) || (m_ringLayerMetricWidth != metricWidth))
     {
-        float radius = (vwidth - (topMargin + bottomMargin)*0.3f) / (1.35f * i+1) / 2.0f - bottomMargin / 2.0f;
-        drawCircle(xCenterPos, yCenterPos, radius, 1.0f, ringColor, &painter);
-        paintText(tr("%1 m").arg(refToMetric(radius), 5, 'f', 1, ' '), QGC::colorCyan, 1.6f, vwidth/2-4, vheight/2+radius+2.2, &painter);
+        m_ringLayerSize = size();
+        m_ringLayerMetricWidth = metricWidth;
+        m_ringLayer = InstrumentRefresh::createLayer(this, viewport()->size());
+        QPainter ringPainter(&m_ringLayer);
+        ringPainter.setRenderHint(QPainter::Antialiasing, true);
+        ringPainter.setRenderHint(QPainter::HighQualityAntialiasing, true);
+        ringPainter.setBrush(Qt::NoBrush);
+        ringPainter.setPen(pen);
+        const int ringCount = 2;
+        for (int i = 0; i < ringCount; i++)
+        {
+            float radius = (vwidth - (topMargin + bottomMargin)*0.3f) / (1.35f * i+1) / 2.0f - bottomMargin / 2.0f;
+            drawCircle(xCenterPos, yCenterPos, radius, 1.0f, ringColor, &ringPainter);
+            paintText(tr("%1 m").arg(refToMetric(radius), 5, 'f', 1, ' '), QGC::colorCyan, 1.6f, vwidth/2-4, vheight/2+radius+2.2, &ringPainter);
+        }
     }
+    painter.drawPixmap(0, 0, m_ringLayer);
 
     // Draw orientation labels
     // Translate and rotate coordinate frame
@@ -861,13 +944,11 @@ void HSIDisplay::setActiveUAS(UASInterface* uas)
 
     if (this->uas != NULL) {
         disconnect(this->uas, SIGNAL(gpsSatelliteStatusChanged(int,int,float,float,float,bool)), this, SLOT(updateSatellite(int,int,float,float,float,bool)));
-        disconnect(this->uas, SIGNAL(localPositionChanged(UASInterface*,double,double,double,quint64)), this, SLOT(updateLocalPosition(UASInterface*,double,double,double,quint64)));
-        disconnect(this->uas, SIGNAL(globalPositionChanged(UASInterface*,double,double,double,quint64)), this, SLOT(updateGlobalPosition(UASInterface*,double,double,double,quint64)));
+        disconnect(this->uas->getTelemetryStore(), SIGNAL(snapshotChanged(UASTelemetrySnapshot)), this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
         disconnect(this->uas, SIGNAL(attitudeThrustSetPointChanged(UASInterface*,double,double,double,double,quint64)), this, SLOT(updateAttitudeSetpoints(UASInterface*,double,double,double,double,quint64)));
         disconnect(this->uas, SIGNAL(positionSetPointsChanged(int,float,float,float,float,quint64)), this, SLOT(updatePositionSetpoints(int,float,float,float,float,quint64)));
         disconnect(uas, SIGNAL(userPositionSetPointsChanged(int,float,float,float,float)), this, SLOT(updateUserPositionSetpoints(int,float,float,float,float)));
         disconnect(this->uas, SIGNAL(velocityChanged_NED(UASInterface*,double,double,double,quint64)), this, SLOT(updateSpeed(UASInterface*,double,double,double,quint64)));
-        disconnect(this->uas, SIGNAL(attitudeChanged(UASInterface*,double,double,double,quint64)), this, SLOT(updateAttitude(UASInterface*,double,double,double,quint64)));
 
         disconnect(this->uas, SIGNAL(attitudeControlEnabled(bool)), this, SLOT(updateAttitudeControllerEnabled(bool)));
         disconnect(this->uas, SIGNAL(positionXYControlEnabled(bool)), this, SLOT(updatePositionXYControllerEnabled(bool)));
@@ -892,13 +973,13 @@ void HSIDisplay::setActiveUAS(UASInterface* uas)
     }
 
     connect(uas, SIGNAL(gpsSatelliteStatusChanged(int,int,float,float,float,bool)), this, SLOT(updateSatellite(int,int,float,float,float,bool)));
-    connect(uas, SIGNAL(localPositionChanged(UASInterface*,double,double,double,quint64)), this, SLOT(updateLocalPosition(UASInterface*,double,double,double,quint64)));
-    connect(uas, SIGNAL(globalPositionChanged(UASInterface*,double,double,double,quint64)), this, SLOT(updateGlobalPosition(UASInterface*,double,double,double,quint64)));
+    // Attitude and position are only drawn, display rate is enough
+    m_telemetryRoles.clear();
+    connect(uas->getTelemetryStore(), SIGNAL(snapshotChanged(UASTelemetrySnapshot)), this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
     connect(uas, SIGNAL(attitudeThrustSetPointChanged(UASInterface*,double,double,double,double,quint64)), this, SLOT(updateAttitudeSetpoints(UASInterface*,double,double,double,double,quint64)));
     connect(uas, SIGNAL(positionSetPointsChanged(int,float,float,float,float,quint64)), this, SLOT(updatePositionSetpoints(int,float,float,float,float,quint64)));
     connect(uas, SIGNAL(userPositionSetPointsChanged(int,float,float,float,float)), this, SLOT(updateUserPositionSetpoints(int,float,float,float,float)));
     connect(uas, SIGNAL(velocityChanged_NED(UASInterface*,double,double,double,quint64)), this, SLOT(updateSpeed(UASInterface*,double,double,double,quint64)));
-    connect(uas, SIGNAL(attitudeChanged(UASInterface*,double,double,double,quint64)), this, SLOT(updateAttitude(UASInterface*,double,double,double,quint64)));
 
     connect(uas, SIGNAL(attitudeControlEnabled(bool)), this, SLOT(updateAttitudeControllerEnabled(bool)));
     connect(uas, SIGNAL(positionXYControlEnabled(bool)), this, SLOT(updatePositionXYControllerEnabled(bool)));
@@ -1078,6 +1159,74 @@ void HSIDisplay::updateGlobalPosition(UASInterface*, double lat, double lon, dou
     globalAvailable = usec;
 }
 
+HSIDisplay::TelemetryRole HSIDisplay::telemetryRole(const UASTelemetryValue &value)
+{
+    if (value.m_name == "GCS Status.Roll" && value.m_unit == "deg") return RoleRoll;
+    if (value.m_name == "GCS Status.Pitch" && value.m_unit == "deg") return RolePitch;
+    if (value.m_name == "GCS Status.Yaw" && value.m_unit == "deg") return RoleYaw;
+    if (value.m_name == "GCS Status.localX") return RoleLocalX;
+    if (value.m_name == "GCS Status.localY") return RoleLocalY;
+    if (value.m_name == "GCS Status.localZ") return RoleLocalZ;
+    if (value.m_name == "GCS Status.Latitude") return RoleLatitude;
+    if (value.m_name == "GCS Status.Longitude") return RoleLongitude;
+    if (value.m_name == "GCS Metric.Alt MSL") return RoleAltitude;
+    return RoleNone;
+}
+
+void HSIDisplay::telemetryChanged(const UASTelemetrySnapshot &snapshot)
+{
+    if (!uas || snapshot.m_uasId != uas->getUASID())
+        return;
+
+    foreach (const UASTelemetryValue &value, snapshot.m_values)
+    {
+        QHash<int, int>::const_iterator iter = m_telemetryRoles.constFind(value.m_key);
+        if (iter == m_telemetryRoles.constEnd())
+        {
+            iter = m_telemetryRoles.insert(value.m_key, telemetryRole(value));
+        }
+
+        switch (iter.value())
+        {
+        case RoleRoll:
+            roll = value.m_value / 180.0 * M_PI;
+            break;
+        case RolePitch:
+            pitch = value.m_value / 180.0 * M_PI;
+            break;
+        case RoleYaw:
+            yaw = value.m_value / 180.0 * M_PI;
+            break;
+        case RoleLocalX:
+            x = value.m_value;
+            localAvailable = value.m_msec;
+            break;
+        case RoleLocalY:
+            y = value.m_value;
+            localAvailable = value.m_msec;
+            break;
+        case RoleLocalZ:
+            z = value.m_value;
+            localAvailable = value.m_msec;
+            break;
+        case RoleLatitude:
+            lat = value.m_value;
+            globalAvailable = value.m_msec;
+            break;
+        case RoleLongitude:
+            lon = value.m_value;
+            globalAvailable = value.m_msec;
+            break;
+        case RoleAltitude:
+            alt = value.m_value;
+            globalAvailable = value.m_msec;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 void HSIDisplay::updateSatellite(int uasid, int satid, float elevation, float azimuth, float snr, bool used)
 {
     Q_UNUSED(uasid);
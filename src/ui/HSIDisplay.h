@@ -38,9 +38,11 @@ This file is part of the QGROUNDCONTROL project
 #include <QMap>
 #include <QPair>
 #include <QMouseEvent>
+#include <QPixmap>
 #include <cmath>
 
 #include "HDDisplay.h"
+#include "InstrumentRefresh.h"
 #include "MG.h"
 
 class HSIDisplay : public HDDisplay
@@ -50,6 +52,9 @@ public:
     HSIDisplay(QWidget *parent = 0);
     ~HSIDisplay();
 
+    /** @brief Repaint statistics and frame time of this instrument */
+    const InstrumentRefresh &instrumentRefresh() const;
+
 public slots:
     void setActiveUAS(UASInterface* uas);
     /** @brief Set the width in meters this widget shows from top */
@@ -61,6 +66,8 @@ public slots:
     void updatePositionSetpoints(int uasid, float xDesired, float yDesired, float zDesired, float yawDesired, quint64 usec);
     void updateLocalPosition(UASInterface*, double x, double y, double z, quint64 usec);
     void updateGlobalPosition(UASInterface*, double lat, double lon, double alt, quint64 usec);
+    /** @brief Attitude and position of the active UAS changed */
+    void telemetryChanged(const UASTelemetrySnapshot &snapshot);
     void updateSpeed(UASInterface* uas, double vx, double vy, double vz, quint64 time);
     void updatePositionLock(UASInterface* uas, bool lock);
     void updateAttitudeControllerEnabled(bool enabled);
@@ -179,6 +186,8 @@ signals:
 
 protected slots:
     void renderOverlay();
+    /** @brief Repaint if a displayed value changed by at least one pixel */
+    void refreshIfChanged();
     void drawGPS(QPainter &painter);
     void drawObjects(QPainter &painter);
     void drawPositionDirection(float xRef, float yRef, float radius, const QColor& color, QPainter* painter);
@@ -419,6 +428,33 @@ protected:
     bool userYawSetPointSet;   ///< User set the YAW position already
 
 private:
+    /** @brief Telemetry fields shown by the HSI */
+    enum TelemetryRole
+    {
+        RoleNone,
+        RoleRoll,
+        RolePitch,
+        RoleYaw,
+        RoleLocalX,
+        RoleLocalY,
+        RoleLocalZ,
+        RoleLatitude,
+        RoleLongitude,
+        RoleAltitude
+    };
+
+    /** @brief Looks up which member a telemetry field is shown in */
+    static TelemetryRole telemetryRole(const UASTelemetryValue &value);
+
+    /** @brief The displayed values quantized to the pixels they move, see InstrumentRefresh */
+    QVector<qint64> displayState() const;
+
+    QHash<int, int> m_telemetryRoles;   ///< TelemetryRole by key of the telemetry store
+
+    InstrumentRefresh m_refresh;
+    QPixmap m_ringLayer;                ///< Range rings with their labels
+    QSize m_ringLayerSize;              ///< Widget size m_ringLayer was rendered for
+    double m_ringLayerMetricWidth;      ///< metricWidth m_ringLayer was rendered for
 };
 
 #endif // HSIDISPLAY_H
@@ -44,6 +44,7 @@ This file is part of the QGROUNDCONTROL project
 #include <QDesktopServices>
 #include <QFileDialog>
 #include <QPaintEvent>
+#include <QHash>
 
 
 #include <qmath.h>
@@ -123,7 +124,8 @@ HUD::HUD(int width, int height, QWidget* parent)
       imageLoggingEnabled(false),
       xImageFactor(1.0),
       yImageFactor(1.0),
-      imageRequested(false)
+      imageRequested(false),
+      videoImageKey(0)
 {
     // Fill with black background
     QImage fill = QImage(width, height, QImage::Format_Indexed8);
@@ -145,7 +147,7 @@ HUD::HUD(int width, int height, QWidget* parent)
 
     // Refresh timer
     refreshTimer->setInterval(updateInterval);
-    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(repaint()));
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshIfChanged()));
 
     // Resize to correct size and fill with image
     QWidget::resize(this->width(), this->height());
@@ -477,7 +479,9 @@ void HUD::paintRollPitchStrips()
 void HUD::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
+    refresh.beginFrame();
     paintHUD();
+    refresh.endFrame();
 }
 
 void HUD::paintHUD()
@@ -561,8 +565,13 @@ void HUD::paintHUD()
         painter.begin(this);
         painter.setRenderHint(QPainter::Antialiasing, true);
         painter.setRenderHint(QPainter::HighQualityAntialiasing, true);
-        QPixmap pmap = QPixmap::fromImage(glImage).scaledToWidth(width());
-        painter.drawPixmap(0, (height() - pmap.height()) / 2, pmap);
+        // The scaled image is kept until a new image arrives or the width changes
+        if (videoPixmap.isNull() || (videoImageKey != glImage.cacheKey()) || (videoPixmap.width() != width()))
+        {
+            videoPixmap = QPixmap::fromImage(glImage).scaledToWidth(width());
+            videoImageKey = glImage.cacheKey();
+        }
+        painter.drawPixmap(0, (height() - videoPixmap.height()) / 2, videoPixmap);
 
         // END OF OPENGL PAINTING
 
@@ -573,12 +582,23 @@ void HUD::paintHUD()
             // QT PAINTING
             //makeCurrent();
 
+            // Draw all fixed indicators, rendered once per size
+            if (staticLayer.isNull() || (staticLayerSize != size()))
+            {
+                staticLayerSize = size();
+                staticLayer = InstrumentRefresh::createLayer(this, staticLayerSize);
+                QPainter layerPainter(&staticLayer);
+                layerPainter.setRenderHint(QPainter::Antialiasing, true);
+                layerPainter.setRenderHint(QPainter::HighQualityAntialiasing, true);
+                layerPainter.translate((this->vwidth/2.0+xCenterOffset)*scalingFactor, (this->vheight/2.0+yCenterOffset)*scalingFactor);
+                paintFixedIndicators(&layerPainter);
+            }
+            painter.drawPixmap(0, 0, staticLayer);
+
             painter.translate((this->vwidth/2.0+xCenterOffset)*scalingFactor, (this->vheight/2.0+yCenterOffset)*scalingFactor);
 
             // COORDINATE FRAME IS NOW (0,0) at CENTER OF WIDGET
 
-
-            // Draw all fixed indicators
             // BATTERY
             paintText(fuelStatus, fuelColor, 6.0f, (-vwidth/2.0) + 10, -vheight/2.0 + 6, &painter);
             // Waypoint
@@ -590,65 +610,10 @@ void HUD::paintHUD()
             painter.setBrush(Qt::NoBrush);
             painter.setPen(linePen);
 
-            // YAW INDICATOR
-            //
-            //      .
-            //    .   .
-            //   .......
-            //
-            const float yawIndicatorWidth = 12.0f;
-            const float yawIndicatorY = vheight/2.0f - 15.0f;
-            QPolygon yawIndicator(4);
-            yawIndicator.setPoint(0, QPoint(refToScreenX(0.0f), refToScreenY(yawIndicatorY)));
-            yawIndicator.setPoint(1, QPoint(refToScreenX(yawIndicatorWidth/2.0f), refToScreenY(yawIndicatorY+yawIndicatorWidth)));
-            yawIndicator.setPoint(2, QPoint(refToScreenX(-yawIndicatorWidth/2.0f), refToScreenY(yawIndicatorY+yawIndicatorWidth)));
-            yawIndicator.setPoint(3, QPoint(refToScreenX(0.0f), refToScreenY(yawIndicatorY)));
-            painter.drawPolyline(yawIndicator);
-            painter.setPen(linePen);
-
-            // CENTER
-
-            // HEADING INDICATOR
-            //
-            //    __      __
-            //       \/\/
-            //
-            const float hIndicatorWidth = 20.0f;
-            const float hIndicatorY = -25.0f;
-            const float hIndicatorYLow = hIndicatorY + hIndicatorWidth / 6.0f;
-            const float hIndicatorSegmentWidth = hIndicatorWidth / 7.0f;
-            QPolygon hIndicator(7);
-            hIndicator.setPoint(0, QPoint(refToScreenX(0.0f-hIndicatorWidth/2.0f), refToScreenY(hIndicatorY)));
-            hIndicator.setPoint(1, QPoint(refToScreenX(0.0f-hIndicatorWidth/2.0f+hIndicatorSegmentWidth*1.75f), refToScreenY(hIndicatorY)));
-            hIndicator.setPoint(2, QPoint(refToScreenX(0.0f-hIndicatorSegmentWidth*1.0f), refToScreenY(hIndicatorYLow)));
-            hIndicator.setPoint(3, QPoint(refToScreenX(0.0f), refToScreenY(hIndicatorY)));
-            hIndicator.setPoint(4, QPoint(refToScreenX(0.0f+hIndicatorSegmentWidth*1.0f), refToScreenY(hIndicatorYLow)));
-            hIndicator.setPoint(5, QPoint(refToScreenX(0.0f+hIndicatorWidth/2.0f-hIndicatorSegmentWidth*1.75f), refToScreenY(hIndicatorY)));
-            hIndicator.setPoint(6, QPoint(refToScreenX(0.0f+hIndicatorWidth/2.0f), refToScreenY(hIndicatorY)));
-            painter.drawPolyline(hIndicator);
-
-
-            // SETPOINT
-            const float centerWidth = 8.0f;
-            // TODO
-            //painter.drawEllipse(QPointF(refToScreenX(qMin(10.0f, values.value("roll desired", 0.0f) * 10.0f)), refToScreenY(qMin(10.0f, values.value("pitch desired", 0.0f) * 10.0f))), refToScreenX(centerWidth/2.0f), refToScreenX(centerWidth/2.0f));
-
-            const float centerCrossWidth = 20.0f;
-            // left
-            painter.drawLine(QPointF(refToScreenX(-centerWidth / 2.0f), refToScreenY(0.0f)), QPointF(refToScreenX(-centerCrossWidth / 2.0f), refToScreenY(0.0f)));
-            // right
-            painter.drawLine(QPointF(refToScreenX(centerWidth / 2.0f), refToScreenY(0.0f)), QPointF(refToScreenX(centerCrossWidth / 2.0f), refToScreenY(0.0f)));
-            // top
-            painter.drawLine(QPointF(refToScreenX(0.0f), refToScreenY(-centerWidth / 2.0f)), QPointF(refToScreenX(0.0f), refToScreenY(-centerCrossWidth / 2.0f)));
-
-
-
             // COMPASS
             const float compassY = -vheight/2.0f + 6.0f;
-            QRectF compassRect(QPointF(refToScreenX(-12.0f), refToScreenY(compassY)), QSizeF(refToScreenX(24.0f), refToScreenY(12.0f)));
             painter.setBrush(Qt::NoBrush);
             painter.setPen(linePen);
-            painter.drawRoundedRect(compassRect, 3, 3);
             QString yawAngle;
 
             //    const float yawDeg = ((values.value("yaw", 0.0f)/M_PI)*180.0f)+180.f;
@@ -686,11 +651,9 @@ void HUD::paintHUD()
             painter.setPen(linePen);
 
             drawChangeIndicatorGauge(-vGaugeSpacing, 35.0f, 15.0f, 10.0f, gaugeAltitude, defaultColor, &painter, false);
-            paintText("alt m", defaultColor, 5.5f, -73.0f, 50, &painter);
 
             // Right speed gauge
             drawChangeIndicatorGauge(vGaugeSpacing, 35.0f, 15.0f, 10.0f, totalSpeed, defaultColor, &painter, false);
-            paintText("v m/s", defaultColor, 5.5f, 55.0f, 50, &painter);
 
 
             // Waypoint name
@@ -743,6 +706,118 @@ void HUD::paintHUD()
 }
 
 
+/**
+ * Paint the indicators which do not move, they are rendered once per widget size
+ *
+ * @param painter painter with (0,0) at the center of the HUD
+ */
+void HUD::paintFixedIndicators(QPainter* painter)
+{
+    QPen linePen(Qt::SolidLine);
+    linePen.setWidth(refLineWidthToPen(1.0f));
+    linePen.setColor(defaultColor);
+    painter->setBrush(Qt::NoBrush);
+    painter->setPen(linePen);
+
+    // YAW INDICATOR
+    //
+    //      .
+    //    .   .
+    //   .......
+    //
+    const float yawIndicatorWidth = 12.0f;
+    const float yawIndicatorY = vheight/2.0f - 15.0f;
+    QPolygon yawIndicator(4);
+    yawIndicator.setPoint(0, QPoint(refToScreenX(0.0f), refToScreenY(yawIndicatorY)));
+    yawIndicator.setPoint(1, QPoint(refToScreenX(yawIndicatorWidth/2.0f), refToScreenY(yawIndicatorY+yawIndicatorWidth)));
+    yawIndicator.setPoint(2, QPoint(refToScreenX(-yawIndicatorWidth/2.0f), refToScreenY(yawIndicatorY+yawIndicatorWidth)));
+    yawIndicator.setPoint(3, QPoint(refToScreenX(0.0f), refToScreenY(yawIndicatorY)));
+    painter->drawPolyline(yawIndicator);
+
+    // HEADING INDICATOR
+    //
+    //    __      __
+    //       \/\/
+    //
+    const float hIndicatorWidth = 20.0f;
+    const float hIndicatorY = -25.0f;
+    const float hIndicatorYLow = hIndicatorY + hIndicatorWidth / 6.0f;
+    const float hIndicatorSegmentWidth = hIndicatorWidth / 7.0f;
+    QPolygon hIndicator(7);
+    hIndicator.setPoint(0, QPoint(refToScreenX(0.0f-hIndicatorWidth/2.0f), refToScreenY(hIndicatorY)));
+    hIndicator.setPoint(1, QPoint(refToScreenX(0.0f-hIndicatorWidth/2.0f+hIndicatorSegmentWidth*1.75f), refToScreenY(hIndicatorY)));
+    hIndicator.setPoint(2, QPoint(refToScreenX(0.0f-hIndicatorSegmentWidth*1.0f), refToScreenY(hIndicatorYLow)));
+    hIndicator.setPoint(3, QPoint(refToScreenX(0.0f), refToScreenY(hIndicatorY)));
+    hIndicator.setPoint(4, QPoint(refToScreenX(0.0f+hIndicatorSegmentWidth*1.0f), refToScreenY(hIndicatorYLow)));
+    hIndicator.setPoint(5, QPoint(refToScreenX(0.0f+hIndicatorWidth/2.0f-hIndicatorSegmentWidth*1.75f), refToScreenY(hIndicatorY)));
+    hIndicator.setPoint(6, QPoint(refToScreenX(0.0f+hIndicatorWidth/2.0f), refToScreenY(hIndicatorY)));
+    painter->drawPolyline(hIndicator);
+
+    // CENTER CROSS
+    const float centerWidth = 8.0f;
+    const float centerCrossWidth = 20.0f;
+    // left
+    painter->drawLine(QPointF(refToScreenX(-centerWidth / 2.0f), refToScreenY(0.0f)), QPointF(refToScreenX(-centerCrossWidth / 2.0f), refToScreenY(0.0f)));
+    // right
+    painter->drawLine(QPointF(refToScreenX(centerWidth / 2.0f), refToScreenY(0.0f)), QPointF(refToScreenX(centerCrossWidth / 2.0f), refToScreenY(0.0f)));
+    // top
+    painter->drawLine(QPointF(refToScreenX(0.0f), refToScreenY(-centerWidth / 2.0f)), QPointF(refToScreenX(0.0f), refToScreenY(-centerCrossWidth / 2.0f)));
+
+    // COMPASS frame, the heading is painted into it
+    const float compassY = -vheight/2.0f + 6.0f;
+    QRectF compassRect(QPointF(refToScreenX(-12.0f), refToScreenY(compassY)), QSizeF(refToScreenX(24.0f), refToScreenY(12.0f)));
+    painter->drawRoundedRect(compassRect, 3, 3);
+
+    // GAUGE labels
+    paintText("alt m", defaultColor, 5.5f, -73.0f, 50, painter);
+    paintText("v m/s", defaultColor, 5.5f, 55.0f, 50, painter);
+}
+
+/**
+ * @return the displayed values quantized to the resolution they are visible at
+ */
+QVector<qint64> HUD::displayState() const
+{
+    double scale = width()/vwidth;
+    if (height()/vheight < scale) scale = height()/vheight;
+
+    // Pitch lines are drawn 1.8 mm per degree, roll turns them around the center
+    const double pitchPixelsPerRad = 180.0 / M_PI * 1.8 * scale;
+    const double rollPixelsPerRad = vwidth / 2.0 * scale;
+
+    float yawDeg = (yaw / M_PI) * 180.0f;
+    if (yawDeg < 0) yawDeg += 360;
+
+    QVector<qint64> state;
+    state << width() << height() << HUDInstrumentsEnabled << videoEnabled
+          << glImage.cacheKey() << qHash(nextOfflineImage)
+          << static_cast<int>(yawDeg) % 360
+          << InstrumentRefresh::quantize(zSpeed, 0.01)
+          << InstrumentRefresh::quantize(totalAcc, 0.01)
+          << InstrumentRefresh::quantize((alt != 0) ? alt : -zPos, 0.1)
+          << InstrumentRefresh::quantize(totalSpeed, 0.1)
+          << qHash(fuelStatus) << fuelColor.rgba() << qHash(waypointName);
+    foreach (const QVector3D &att, attitudes)
+    {
+        state << InstrumentRefresh::quantize(att.x(), 1.0 / rollPixelsPerRad)
+              << InstrumentRefresh::quantize(att.y(), 1.0 / pitchPixelsPerRad);
+    }
+    return state;
+}
+
+void HUD::refreshIfChanged()
+{
+    if (refresh.needsRepaint(displayState()))
+    {
+        update();
+    }
+}
+
+const InstrumentRefresh &HUD::instrumentRefresh() const
+{
+    return refresh;
+}
+
 /**
  * @param pitch pitch angle in degrees (-180 to 180)
  */
@@ -39,7 +39,9 @@ This file is part of the QGROUNDCONTROL project
 #include <QFontDatabase>
 #include <QTimer>
 #include <QVector3D>
+#include <QPixmap>
 #include "UASInterface.h"
+#include "InstrumentRefresh.h"
 
 /**
  * @brief Displays a Head Up Display (HUD)
@@ -57,6 +59,8 @@ public:
 
     void setImageSize(int width, int height, int depth, int channels);
     void resize(int w, int h);
+    /** @brief Repaint statistics and frame time of this instrument */
+    const InstrumentRefresh &instrumentRefresh() const;
 
 public slots:
 //    void initializeGL();
@@ -104,6 +108,10 @@ protected slots:
     /** @brief Paint text on top of the image and OpenGL drawings */
     void paintText(QString text, QColor color, float fontSize, float refX, float refY, QPainter* painter);
     void paintHUD();
+    /** @brief Paint the indicators which do not move */
+    void paintFixedIndicators(QPainter* painter);
+    /** @brief Repaint if a displayed value changed by at least one pixel */
+    void refreshIfChanged();
     void paintPitchLinePos(QString text, float refPosX, float refPosY, QPainter* painter);
     void paintPitchLineNeg(QString text, float refPosX, float refPosY, QPainter* painter);
 
@@ -231,6 +239,15 @@ protected:
     bool imageRequested;
     QString imageLogDirectory;
     unsigned int imageLogCounter;
+
+    /** @brief The displayed values quantized to the pixels they move, see InstrumentRefresh */
+    QVector<qint64> displayState() const;
+
+    InstrumentRefresh refresh; ///< Repaint decision and frame time
+    QPixmap staticLayer;       ///< The fixed indicators, see paintFixedIndicators()
+    QSize staticLayerSize;     ///< Widget size staticLayer was rendered for
+    QPixmap videoPixmap;       ///< glImage scaled to the widget width
+    qint64 videoImageKey;      ///< Cache key of the glImage in videoPixmap
 };
 
 #endif // HUD_H
@@ -0,0 +1,128 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief InstrumentRefresh
+ *          Repaint decision and frame time measurement for the instrument widgets.
+ *
+ */
+
+#include "InstrumentRefresh.h"
+
+#include <QWidget>
+#include <QtCore/qmath.h>
+#include <limits>
+
+InstrumentRefresh::InstrumentRefresh() :
+    m_averageFrameTime(0.0),
+    m_lastFrameTime(0.0),
+    m_paintedFrames(0),
+    m_skippedFrames(0)
+{
+}
+
+bool InstrumentRefresh::needsRepaint(const QVector<qint64> &state)
+{
+    if (m_lastRepaint.isValid() && (m_lastRepaint.elapsed() < s_MaxFrameAge) && (state == m_state))
+    {
+        ++m_skippedFrames;
+        return false;
+    }
+    m_state = state;
+    m_lastRepaint.start();
+    return true;
+}
+
+void InstrumentRefresh::invalidate()
+{
+    m_lastRepaint.invalidate();
+}
+
+void InstrumentRefresh::beginFrame()
+{
+    m_frameTimer.start();
+}
+
+void InstrumentRefresh::endFrame()
+{
+    if (!m_frameTimer.isValid())
+    {
+        return;
+    }
+    m_lastFrameTime = static_cast<double>(m_frameTimer.nsecsElapsed()) / 1000000.0;
+    m_frameTimer.invalidate();
+
+    // Exponential moving average over roughly the last 16 frames
+    if (m_paintedFrames == 0)
+    {
+        m_averageFrameTime = m_lastFrameTime;
+    }
+    else
+    {
+        m_averageFrameTime += (m_lastFrameTime - m_averageFrameTime) / 16.0;
+    }
+    ++m_paintedFrames;
+}
+
+double InstrumentRefresh::averageFrameTime() const
+{
+    return m_averageFrameTime;
+}
+
+double InstrumentRefresh::lastFrameTime() const
+{
+    return m_lastFrameTime;
+}
+
+quint64 InstrumentRefresh::paintedFrames() const
+{
+    return m_paintedFrames;
+}
+
+quint64 InstrumentRefresh::skippedFrames() const
+{
+    return m_skippedFrames;
+}
+
+qint64 InstrumentRefresh::quantize(double value, double step)
+{
+    if (qIsNaN(value) || qIsInf(value) || (step <= 0.0))
+    {
+        return std::numeric_limits<qint64>::min();
+    }
+    const double steps = value / step;
+    if (qAbs(steps) > 1e15)
+    {
+        return steps > 0 ? std::numeric_limits<qint64>::max() : std::numeric_limits<qint64>::min() + 1;
+    }
+    return qRound64(steps);
+}
+
+QPixmap InstrumentRefresh::createLayer(const QWidget *widget, const QSize &size)
+{
+    const qreal ratio = widget->devicePixelRatioF();
+    QPixmap layer(size * ratio);
+    layer.setDevicePixelRatio(ratio);
+    layer.fill(Qt::transparent);
+    return layer;
+}
@@ -0,0 +1,105 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief InstrumentRefresh
+ *          Repaint decision and frame time measurement for the instrument widgets.
+ *
+ */
+
+#ifndef INSTRUMENTREFRESH_H
+#define INSTRUMENTREFRESH_H
+
+#include <QElapsedTimer>
+#include <QPixmap>
+#include <QVector>
+
+class QWidget;
+
+/**
+ * @brief The InstrumentRefresh class decides on every tick of the refresh timer of an
+ *        instrument whether the instrument has to be repainted, and measures the time
+ *        spent painting.
+ *
+ *        The instrument describes what it would paint as a list of integers, its values
+ *        quantized to the resolution they are visible at, mostly one pixel. It is only
+ *        repainted if this state differs from the state at the last repaint, or if the
+ *        last repaint is older than s_MaxFrameAge, so parts not covered by the state
+ *        are still kept up to date.
+ */
+class InstrumentRefresh
+{
+public:
+    static const int s_MaxFrameAge = 1000;      /// ms, repaint at least once per second
+
+    InstrumentRefresh();
+
+    /**
+     * @brief needsRepaint compares the state with the state of the last repaint
+     *        and remembers it if they differ.
+     * @param state - the quantized values the instrument would paint
+     * @return true if the instrument has to be repainted
+     */
+    bool needsRepaint(const QVector<qint64> &state);
+
+    /** @brief forces the next call of needsRepaint() to return true */
+    void invalidate();
+
+    /** @brief beginFrame and endFrame enclose the painting code of paintEvent() */
+    void beginFrame();
+    void endFrame();
+
+    /** @brief average time of one paintEvent() in ms */
+    double averageFrameTime() const;
+    /** @brief time of the last paintEvent() in ms */
+    double lastFrameTime() const;
+    /** @brief number of paintEvent() calls */
+    quint64 paintedFrames() const;
+    /** @brief number of refresh timer ticks without repaint */
+    quint64 skippedFrames() const;
+
+    /**
+     * @brief quantize converts a value to the number of steps it is away from zero.
+     *        NaN and infinite values deliver a value of their own.
+     */
+    static qint64 quantize(double value, double step);
+
+    /**
+     * @brief createLayer creates a transparent pixmap for caching the static parts of an
+     *        instrument. The pixmap matches the pixel density of the widget's screen.
+     * @param widget - the instrument
+     * @param size - size of the layer in widget coordinates
+     */
+    static QPixmap createLayer(const QWidget *widget, const QSize &size);
+
+private:
+    QVector<qint64> m_state;            /// state at the last repaint
+    QElapsedTimer m_lastRepaint;
+    QElapsedTimer m_frameTimer;
+    double m_averageFrameTime;
+    double m_lastFrameTime;
+    quint64 m_paintedFrames;
+    quint64 m_skippedFrames;
+};
+
+#endif // INSTRUMENTREFRESH_H
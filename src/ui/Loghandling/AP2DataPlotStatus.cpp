@@ -152,4 +152,43 @@ QString AP2DataPlotStatus::getDetailedErrorText() const
     return out;
 }
 
+QDataStream &operator<<(QDataStream &stream, const AP2DataPlotStatus &status)
+{
+    stream << static_cast<qint32>(status.m_lastParsingState) << static_cast<qint32>(status.m_globalState)
+           << static_cast<qint32>(status.m_loadedLogType) << static_cast<qint32>(status.m_noMessageBytes);
+
+    stream << static_cast<qint32>(status.m_errors.size());
+    for(const auto &entry : status.m_errors)
+    {
+        stream << static_cast<qint32>(entry.m_state) << static_cast<qint32>(entry.m_index) << entry.m_errortext;
+    }
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, AP2DataPlotStatus &status)
+{
+    qint32 lastState = 0;
+    qint32 globalState = 0;
+    qint32 logType = 0;
+    qint32 noMessageBytes = 0;
+    qint32 errorCount = 0;
+    stream >> lastState >> globalState >> logType >> noMessageBytes >> errorCount;
+
+    status.m_lastParsingState = static_cast<AP2DataPlotStatus::parsingState>(lastState);
+    status.m_globalState = static_cast<AP2DataPlotStatus::parsingState>(globalState);
+    status.m_loadedLogType = static_cast<MAV_TYPE>(logType);
+    status.m_noMessageBytes = noMessageBytes;
+
+    status.m_errors.clear();
+    for(int i = 0; (i < errorCount) && (stream.status() == QDataStream::Ok); ++i)
+    {
+        qint32 state = 0;
+        qint32 index = 0;
+        QString text;
+        stream >> state >> index >> text;
+        status.m_errors.push_back(AP2DataPlotStatus::errorEntry(static_cast<AP2DataPlotStatus::parsingState>(state), index, text));
+    }
+    return stream;
+}
+
 #undef ENDL
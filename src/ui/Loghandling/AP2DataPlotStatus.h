@@ -32,6 +32,7 @@ This file is part of the APM_PLANNER project
 
 #include <QString>
 #include <QVector>
+#include <QDataStream>
 
 // Mavlink include is only used for MAV_TYPE constant defined in the protocol
 #include <mavlink_types.h>
@@ -169,6 +170,17 @@ public:
      */
     QString getDetailedErrorText() const;
 
+    /**
+     * @brief operator << writes the complete status to a stream. Used to cache
+     *        the status of a parsed log.
+     */
+    friend QDataStream &operator<<(QDataStream &stream, const AP2DataPlotStatus &status);
+
+    /**
+     * @brief operator >> reads a status written by operator <<.
+     */
+    friend QDataStream &operator>>(QDataStream &stream, AP2DataPlotStatus &status);
+
 private:
     /**
      * @brief The errorEntry struct
@@ -30,6 +30,282 @@ This file is part of the APM_PLANNER project
 #include "AsciiLogParser.h"
 #include "logging.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFuture>
+#include <QQueue>
+#include <cstring>
+#include <limits>
+
+/**
+ * @brief The fieldConverter struct holds the functions converting the tokens of one format
+ *        directly from the bytes of the log. Only the common number notations are converted
+ *        here, everything else is handed over to the Qt conversion so the results are exactly
+ *        the same as the ones of the name value pair path.
+ */
+struct AsciiLogParser::fieldConverter
+{
+    static const int s_MaxFastDigits = 18;          /// More digits may overflow a qint64
+    static const int s_MaxFastDoubleDigits = 19;    /// More digits may overflow the quint64 mantissa
+    static const int s_MaxExactPowerOfTen = 22;     /// Highest power of ten which is exact as double
+
+    /**
+     * @brief fastInteger converts a token consisting of an optional sign and up to 18 digits
+     * @return true on success, false if the token has another notation
+     */
+    static bool fastInteger(const char *begin, const char *end, qint64 &value)
+    {
+        const char *pos = begin;
+        bool negative = false;
+        if((pos < end) && ((*pos == '-') || (*pos == '+')))
+        {
+            negative = *pos == '-';
+            ++pos;
+        }
+        if((pos == end) || ((end - pos) > s_MaxFastDigits))
+        {
+            return false;
+        }
+        qint64 result = 0;
+        for(; pos < end; ++pos)
+        {
+            const unsigned int digit = static_cast<unsigned int>(static_cast<unsigned char>(*pos)) - '0';
+            if(digit > 9)
+            {
+                return false;
+            }
+            result = result * 10 + digit;
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    static bool parseSigned32(const char *begin, const char *end, asciiValue &value)
+    {
+        bool ok = fastInteger(begin, end, value.m_int);
+        if(!ok)
+        {
+            value.m_int = QByteArray(begin, static_cast<int>(end - begin)).toLongLong(&ok);
+        }
+        return ok && (value.m_int >= std::numeric_limits<qint32>::min()) && (value.m_int <= std::numeric_limits<qint32>::max());
+    }
+
+    static bool parseUnsigned32(const char *begin, const char *end, asciiValue &value)
+    {
+        return parseUnsigned64(begin, end, value) && (value.m_uint <= std::numeric_limits<quint32>::max());
+    }
+
+    static bool parseSigned64(const char *begin, const char *end, asciiValue &value)
+    {
+        bool ok = fastInteger(begin, end, value.m_int);
+        if(!ok)
+        {
+            value.m_int = QByteArray(begin, static_cast<int>(end - begin)).toLongLong(&ok);
+        }
+        return ok;
+    }
+
+    static bool parseUnsigned64(const char *begin, const char *end, asciiValue &value)
+    {
+        qint64 result = 0;
+        if((begin < end) && (*begin != '-') && fastInteger(begin, end, result))
+        {
+            value.m_uint = static_cast<quint64>(result);
+            return true;
+        }
+        bool ok = false;
+        value.m_uint = QByteArray(begin, static_cast<int>(end - begin)).toULongLong(&ok);
+        return ok;
+    }
+
+    /**
+     * @brief parseFloatingPoint converts decimal numbers. Numbers with up to 19 digits and a
+     *        small exponent are exact: the mantissa and the power of ten are exact doubles,
+     *        so the one multiplication or division rounds correctly.
+     */
+    static bool parseFloatingPoint(const char *begin, const char *end, asciiValue &value)
+    {
+        static const double s_PowersOfTen[s_MaxExactPowerOfTen + 1] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const char *pos = begin;
+        bool negative = false;
+        if((pos < end) && ((*pos == '-') || (*pos == '+')))
+        {
+            negative = *pos == '-';
+            ++pos;
+        }
+
+        quint64 mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        for(; (pos < end) && (static_cast<unsigned int>(static_cast<unsigned char>(*pos)) - '0' <= 9); ++pos, ++digits)
+        {
+            mantissa = mantissa * 10 + static_cast<unsigned int>(*pos - '0');
+        }
+        if((pos < end) && (*pos == '.'))
+        {
+            for(++pos; (pos < end) && (static_cast<unsigned int>(static_cast<unsigned char>(*pos)) - '0' <= 9); ++pos, ++digits)
+            {
+                mantissa = mantissa * 10 + static_cast<unsigned int>(*pos - '0');
+                --exponent;
+            }
+        }
+        bool fast = (digits > 0) && (digits <= s_MaxFastDoubleDigits);
+        if(fast && (pos < end) && ((*pos == 'e') || (*pos == 'E')))
+        {
+            ++pos;
+            bool negativeExponent = false;
+            if((pos < end) && ((*pos == '-') || (*pos == '+')))
+            {
+                negativeExponent = *pos == '-';
+                ++pos;
+            }
+            int exponentValue = 0;
+            const char *exponentStart = pos;
+            for(; (pos < end) && (static_cast<unsigned int>(static_cast<unsigned char>(*pos)) - '0' <= 9) && (exponentValue < 1000); ++pos)
+            {
+                exponentValue = exponentValue * 10 + (*pos - '0');
+            }
+            fast = pos != exponentStart;
+            exponent += negativeExponent ? -exponentValue : exponentValue;
+        }
+
+        if(fast && (pos == end) && (mantissa <= (Q_UINT64_C(1) << 53)) &&
+           (exponent >= -s_MaxExactPowerOfTen) && (exponent <= s_MaxExactPowerOfTen))
+        {
+            const double result = exponent < 0 ? static_cast<double>(mantissa) / s_PowersOfTen[-exponent]
+                                               : static_cast<double>(mantissa) * s_PowersOfTen[exponent];
+            value.m_double = negative ? -result : result;
+            return true;
+        }
+
+        bool ok = false;
+        value.m_double = QByteArray(begin, static_cast<int>(end - begin)).toDouble(&ok);
+        return ok && !qIsInf(value.m_double);
+    }
+
+    template <typename T>
+    static void appendSigned(LogdataColumn &column, const asciiValue &value, const char *token, int length)
+    {
+        Q_UNUSED(token)
+        Q_UNUSED(length)
+        static_cast<LogdataTypedColumn<T> &>(column).appendValue(static_cast<T>(value.m_int));
+    }
+
+    template <typename T>
+    static void appendUnsigned(LogdataColumn &column, const asciiValue &value, const char *token, int length)
+    {
+        Q_UNUSED(token)
+        Q_UNUSED(length)
+        static_cast<LogdataTypedColumn<T> &>(column).appendValue(static_cast<T>(value.m_uint));
+    }
+
+    template <typename T>
+    static void appendFloatingPoint(LogdataColumn &column, const asciiValue &value, const char *token, int length)
+    {
+        Q_UNUSED(token)
+        Q_UNUSED(length)
+        static_cast<LogdataTypedColumn<T> &>(column).appendValue(static_cast<T>(value.m_double));
+    }
+
+    static void appendString(LogdataColumn &column, const asciiValue &value, const char *token, int length)
+    {
+        Q_UNUSED(value)
+        column.append(QString::fromUtf8(token, length));
+    }
+
+    /**
+     * @brief select delivers the functions and the column for a format character
+     * @param format - the format character
+     * @param parse - set to the parse function, nullptr for strings
+     * @param append - set to the append function
+     * @param column - set to a new column
+     * @return true on success, false if the format is unknown
+     */
+    static bool select(char format, parseFunction &parse, appendFunction &append, LogdataColumn::Ptr &column)
+    {
+        switch(format)
+        {
+        case 'b':   // int8_t
+            parse = &parseSigned32;
+            append = &appendSigned<qint8>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<qint8>());
+            return true;
+        case 'h':   // int16_t
+            parse = &parseSigned32;
+            append = &appendSigned<qint16>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<qint16>());
+            return true;
+        case 'i':   // int32_t
+            parse = &parseSigned32;
+            append = &appendSigned<qint32>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<qint32>());
+            return true;
+        case 'q':   // int64_t
+            parse = &parseSigned64;
+            append = &appendSigned<qint64>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<qint64>());
+            return true;
+        case 'B':   // uint8_t
+            parse = &parseUnsigned32;
+            append = &appendUnsigned<quint8>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<quint8>());
+            return true;
+        case 'H':   // uint16_t
+            parse = &parseUnsigned32;
+            append = &appendUnsigned<quint16>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<quint16>());
+            return true;
+        case 'I':   // uint32_t
+            parse = &parseUnsigned32;
+            append = &appendUnsigned<quint32>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<quint32>());
+            return true;
+        case 'Q':   // uint64_t
+            parse = &parseUnsigned64;
+            append = &appendUnsigned<quint64>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<quint64>());
+            return true;
+        case 'f':   // float
+            parse = &parseFloatingPoint;
+            append = &appendFloatingPoint<float>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<float>());
+            return true;
+        case 'd':   // double
+        case 'c':   // int16_t * 100 - already scaled in ascii logs
+        case 'C':   // uint16_t * 100
+        case 'e':   // int32_t * 100
+        case 'E':   // uint32_t * 100
+        case 'L':   // int32_t lat / lon
+            parse = &parseFloatingPoint;
+            append = &appendFloatingPoint<double>;
+            column = LogdataColumn::Ptr(new LogdataTypedColumn<double>());
+            return true;
+        case 'n':   // char[4]
+        case 'N':   // char[16]
+        case 'Z':   // char[64]
+        case 'M':   // flight mode - a string in ascii logs
+            parse = nullptr;
+            append = &appendString;
+            column = LogdataColumn::Ptr(new LogdataStringColumn());
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief isSpace - true for all chars QString::trimmed() removes from ascii text
+     */
+    static bool isSpace(char c)
+    {
+        return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\v') || (c == '\f') || (c == '\r');
+    }
+};
+
 
 bool AsciiLogParser::asciiDescriptor::isValid() const
 {
@@ -90,118 +366,285 @@ AP2DataPlotStatus AsciiLogParser::parse(QFile &logfile)
         return m_logLoadingState;
     }
 
+    QByteArray block;   // holds the incomplete last line of the previous block at its start
     while (!logfile.atEnd() && !m_stop)
     {
         m_callbackObject->onProgress(logfile.pos(),logfile.size());
-        QString line = logfile.readLine();
-        line = line.remove(QChar('\n'));
-        line = line.remove(QChar('\r'));
-        m_tokensToParse.clear();
-        m_tokensToParse = line.split(QChar(s_TokenSeperator));
+        const int carry = block.size();
+        block.resize(carry + static_cast<int>(s_ReadBlockSize));
+        const qint64 bytesRead = logfile.read(block.data() + carry, s_ReadBlockSize);
+        block.resize(carry + static_cast<int>(bytesRead > 0 ? bytesRead : 0));
+        if (bytesRead <= 0)
+        {
+            break;
+        }
+
+        // Only complete lines are parsed. The rest is parsed with the next block.
+        const int size = logfile.atEnd() ? block.size() : block.lastIndexOf('\n') + 1;
+        if (!parseBlock(block, size))
+        {
+            return m_logLoadingState;
+        }
+        block.remove(0, size);
+    }
+    if (!block.isEmpty() && !m_stop)
+    {
+        // file could not be read to its end
+        if (!parseBlock(block, block.size()))
+        {
+            return m_logLoadingState;
+        }
+    }
+
+    if (m_noMessageBytes > 0)
+    {
+        QLOG_DEBUG() << "AsciiLogParser::parse(): Non packet bytes found in log file. " << m_noMessageBytes << " bytes filtered out. This may be a corrupt log";
+        m_logLoadingState.setNoMessageBytes(m_noMessageBytes);
+    }
+
+    if(m_hasUnitData)
+    {
+       QStringList errors = m_dataStoragePtr->setupUnitData(m_activeTimestamp.m_name, m_activeTimestamp.m_divisor);
+       for(const auto &error : errors)
+       {
+           QLOG_WARN() << error;
+           m_logLoadingState.corruptFMTRead(static_cast<int>(m_MessageCounter), "Unit or scaling error. " + error);
+       }
+    }
+    else
+    {
+        m_dataStoragePtr->setTimeStamp(m_activeTimestamp.m_name, m_activeTimestamp.m_divisor);
+    }
+
+    return m_logLoadingState;
+}
+
+AsciiLogParser::asciiChunk AsciiLogParser::tokenizeChunk(const char *data, int start, int end,
+                                                      const QHash<QByteArray, parserList> &parsers)
+{
+    asciiChunk chunk;
+    int pos = start;
+    while (pos < end)
+    {
+        const char *lineStart = data + pos;
+        const char *lineEnd = static_cast<const char *>(memchr(lineStart, '\n', static_cast<size_t>(end - pos)));
+        const int next = lineEnd != nullptr ? static_cast<int>(lineEnd - data) + 1 : end;
+        if (lineEnd == nullptr)
+        {
+            lineEnd = data + end;
+        }
+        while ((lineEnd > lineStart) && (lineEnd[-1] == '\r'))
+        {
+            --lineEnd;
+        }
+        const char *nameEnd = static_cast<const char *>(memchr(lineStart, s_TokenSeperator, static_cast<size_t>(lineEnd - lineStart)));
 
-        if(m_tokensToParse.size() > 0)
+        asciiLine line;
+        line.m_offset = pos;
+        line.m_length = static_cast<int>(lineEnd - lineStart);
+        line.m_nameLength = static_cast<int>((nameEnd != nullptr ? nameEnd : lineEnd) - lineStart);
+        line.m_firstToken = chunk.m_tokens.size();
+        line.m_tokenCount = 0;
+        line.m_firstValue = -1;
+        pos = next;
+
+        // Only lines of known types are tokenized here. All others are parsed by name.
+        const auto parserIter = parsers.constFind(QByteArray::fromRawData(lineStart, line.m_nameLength));
+        if ((parserIter == parsers.constEnd()) || (nameEnd == nullptr))
+        {
+            chunk.m_lines.push_back(line);
+            continue;
+        }
+
+        const char *tokenStart = nameEnd + 1;
+        while (true)
         {
-            if(m_tokensToParse.at(s_TypeIndex) == s_FMTMessageName)
+            const char *tokenEnd = static_cast<const char *>(memchr(tokenStart, s_TokenSeperator, static_cast<size_t>(lineEnd - tokenStart)));
+            const char *separator = tokenEnd != nullptr ? tokenEnd : lineEnd;
+            const char *trimmedStart = tokenStart;
+            const char *trimmedEnd = separator;
+            while ((trimmedStart < trimmedEnd) && fieldConverter::isSpace(*trimmedStart))
+            {
+                ++trimmedStart;
+            }
+            while ((trimmedEnd > trimmedStart) && fieldConverter::isSpace(trimmedEnd[-1]))
+            {
+                --trimmedEnd;
+            }
+            asciiToken token;
+            token.m_offset = static_cast<int>(trimmedStart - data);
+            token.m_length = static_cast<int>(trimmedEnd - trimmedStart);
+            chunk.m_tokens.push_back(token);
+            ++line.m_tokenCount;
+            if (tokenEnd == nullptr)
             {
-                asciiDescriptor descriptor;
-                if(parseFMTMessage(descriptor))
+                break;
+            }
+            tokenStart = tokenEnd + 1;
+        }
+
+        const parserList &fieldParsers = parserIter.value();
+        if (fieldParsers.size() == line.m_tokenCount)
+        {
+            line.m_firstValue = chunk.m_values.size();
+            for (int i = 0; i < fieldParsers.size(); ++i)
+            {
+                asciiValue value;
+                value.m_uint = 0;
+                const asciiToken &token = chunk.m_tokens.at(line.m_firstToken + i);
+                if ((fieldParsers.at(i) != nullptr) &&
+                    !fieldParsers.at(i)(data + token.m_offset, data + token.m_offset + token.m_length, value))
                 {
-                    // do some special handling if needed
-                    specialDescriptorHandling(descriptor);
-                    if(m_activeTimestamp.valid())
-                    {
-                        descriptor.finalize(m_activeTimestamp);
-                        if(!extendedStoreDescriptor(descriptor))
-                        {
-                            return m_logLoadingState;
-                        }
-                    }
-                    else
+                    // parsing by name reports the error
+                    chunk.m_values.resize(line.m_firstValue);
+                    line.m_firstValue = -1;
+                    break;
+                }
+                chunk.m_values.push_back(value);
+            }
+        }
+        chunk.m_lines.push_back(line);
+    }
+    return chunk;
+}
+
+bool AsciiLogParser::parseBlock(const QByteArray &block, int size)
+{
+    // Split the block into line aligned chunks and tokenize them in parallel. The
+    // workers get a copy of the parse functions as new types may be added while
+    // the chunks are stored.
+    const char *data = block.constData();
+    QQueue<QFuture<asciiChunk> > pendingChunks;
+    int start = 0;
+    while (start < size)
+    {
+        int end = start + s_ChunkSize;
+        if (end >= size)
+        {
+            end = size;
+        }
+        else
+        {
+            const char *lineEnd = static_cast<const char *>(memchr(data + end, '\n', static_cast<size_t>(size - end)));
+            end = lineEnd != nullptr ? static_cast<int>(lineEnd - data) + 1 : size;
+        }
+        pendingChunks.enqueue(QtConcurrent::run(&AsciiLogParser::tokenizeChunk, data, start, end, m_typedParsers));
+        start = end;
+    }
+
+    bool rc = true;
+    while (!pendingChunks.isEmpty() && rc && !m_stop)
+    {
+        const asciiChunk chunk = pendingChunks.dequeue().result();
+        for (const auto &line : chunk.m_lines)
+        {
+            if (line.m_firstValue >= 0)
+            {
+                auto typeIter = m_typedTypes.find(QByteArray::fromRawData(data + line.m_offset, line.m_nameLength));
+                storeTypedLine(typeIter.value(), data, chunk, line);
+            }
+            else if (!parseLine(QString::fromUtf8(data + line.m_offset, line.m_length)))
+            {
+                rc = false;
+                break;
+            }
+        }
+    }
+
+    // the workers read the block - never leave one running
+    while (!pendingChunks.isEmpty())
+    {
+        pendingChunks.dequeue().waitForFinished();
+    }
+    return rc;
+}
+
+bool AsciiLogParser::parseLine(const QString &line)
+{
+    m_tokensToParse.clear();
+    m_tokensToParse = line.split(QChar(s_TokenSeperator));
+
+    if(m_tokensToParse.size() > 0)
+    {
+        if(m_tokensToParse.at(s_TypeIndex) == s_FMTMessageName)
+        {
+            asciiDescriptor descriptor;
+            if(parseFMTMessage(descriptor))
+            {
+                // do some special handling if needed
+                specialDescriptorHandling(descriptor);
+                if(m_activeTimestamp.valid())
+                {
+                    descriptor.finalize(m_activeTimestamp);
+                    if(!extendedStoreDescriptor(descriptor))
                     {
-                        checkForValidTimestamp(descriptor);
-                        m_descriptorForDeferredStorage.push_back(descriptor);
+                        return false;
                     }
                 }
                 else
                 {
-                    // Parsing of FMT failed - all data of this line is dropped
-                    // error message is generated by parseFMTMessage
-                    m_noMessageBytes += line.size();
+                    checkForValidTimestamp(descriptor);
+                    m_descriptorForDeferredStorage.push_back(descriptor);
                 }
             }
-            // Data packet
-            else if(m_nameToDescriptorMap.contains(m_tokensToParse.at(0)))
+            else
             {
-                QList<NameValuePair> NameValuePairList;
-                asciiDescriptor descriptor = m_nameToDescriptorMap.value(m_tokensToParse.at(0));
-                m_tokensToParse.pop_front();    // remove the already parsed token
+                // Parsing of FMT failed - all data of this line is dropped
+                // error message is generated by parseFMTMessage
+                m_noMessageBytes += line.size();
+            }
+        }
+        // Data packet
+        else if(m_nameToDescriptorMap.contains(m_tokensToParse.at(0)))
+        {
+            QList<NameValuePair> NameValuePairList;
+            asciiDescriptor descriptor = m_nameToDescriptorMap.value(m_tokensToParse.at(0));
+            m_tokensToParse.pop_front();    // remove the already parsed token
 
-                if(parseDataByDescriptor(NameValuePairList, descriptor))
+            if(parseDataByDescriptor(NameValuePairList, descriptor))
+            {
+                if(NameValuePairList.size() >= 1)   // need at least one element
                 {
-                    if(NameValuePairList.size() >= 1)   // need at least one element
+                    if(!extendedStoreNameValuePairList(NameValuePairList, descriptor))
                     {
-                        if(!extendedStoreNameValuePairList(NameValuePairList, descriptor))
-                        {
-                            return m_logLoadingState;
-                        }
-                        if(m_loadedLogType == MAV_TYPE_GENERIC)
-                        {
-                            detectMavType(NameValuePairList);
-                        }
+                        return false;
                     }
-                    else
+                    if(m_loadedLogType == MAV_TYPE_GENERIC)
                     {
-                        QLOG_DEBUG() << "AsciiLogParser::parse():No values within data message " + descriptor.m_name;
-                        m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
-                                                          "No values within data message " + descriptor.m_name);
-                        m_noMessageBytes += line.size();
+                        detectMavType(NameValuePairList);
                     }
                 }
                 else
                 {
-                    // Parsing of data failed - all data of this line is dropped
-                    // error message is generated by parseDataByDescriptor
+                    QLOG_DEBUG() << "AsciiLogParser::parse():No values within data message " + descriptor.m_name;
+                    m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
+                                                      "No values within data message " + descriptor.m_name);
                     m_noMessageBytes += line.size();
                 }
             }
             else
             {
-                QLOG_DEBUG() << "AsciiLogParser::parse():Read data without having a valid format descriptor - Message type is " + m_tokensToParse.at(0);
-                m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
-                                                  "Read data without having a valid format descriptor - "
-                                                  "Message type is " + m_tokensToParse.at(0));
+                // Parsing of data failed - all data of this line is dropped
+                // error message is generated by parseDataByDescriptor
                 m_noMessageBytes += line.size();
             }
         }
         else
         {
-            QLOG_DEBUG() << "AsciiLogParser::parse(): No tokens found in line: " << line;
-            m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter), "No data for parsing found.");
+            QLOG_DEBUG() << "AsciiLogParser::parse():Read data without having a valid format descriptor - Message type is " + m_tokensToParse.at(0);
+            m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
+                                              "Read data without having a valid format descriptor - "
+                                              "Message type is " + m_tokensToParse.at(0));
             m_noMessageBytes += line.size();
         }
     }
-
-    if (m_noMessageBytes > 0)
-    {
-        QLOG_DEBUG() << "AsciiLogParser::parse(): Non packet bytes found in log file. " << m_noMessageBytes << " bytes filtered out. This may be a corrupt log";
-        m_logLoadingState.setNoMessageBytes(m_noMessageBytes);
-    }
-
-    if(m_hasUnitData)
-    {
-       QStringList errors = m_dataStoragePtr->setupUnitData(m_activeTimestamp.m_name, m_activeTimestamp.m_divisor);
-       for(const auto &error : errors)
-       {
-           QLOG_WARN() << error;
-           m_logLoadingState.corruptFMTRead(static_cast<int>(m_MessageCounter), "Unit or scaling error. " + error);
-       }
-    }
     else
     {
-        m_dataStoragePtr->setTimeStamp(m_activeTimestamp.m_name, m_activeTimestamp.m_divisor);
+        QLOG_DEBUG() << "AsciiLogParser::parse(): No tokens found in line: " << line;
+        m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter), "No data for parsing found.");
+        m_noMessageBytes += line.size();
     }
-
-    return m_logLoadingState;
+    return true;
 }
 
 bool AsciiLogParser::parseFMTMessage(asciiDescriptor &desc)
@@ -247,6 +690,7 @@ bool AsciiLogParser::storeDescriptor(asciiDescriptor desc)
                 }
 
                 m_dataStoragePtr->addDataType(desc.m_name, desc.m_ID, desc.m_length, desc.m_format, desc.m_labels, desc.m_timeStampIndex);
+                setupTypedType(m_nameToDescriptorMap.value(desc.m_name));
             }
         }
         else
@@ -266,6 +710,105 @@ bool AsciiLogParser::storeDescriptor(asciiDescriptor desc)
 }
 
 
+void AsciiLogParser::setupTypedType(const asciiDescriptor &desc)
+{
+    // Unit, multiplier and format unit messages are not stored as data but need special handling.
+    // PARM messages are needed for the MAV type detection. All of them are rare so they
+    // are parsed by name.
+    if((desc.m_ID == m_idUnitMessage) || (desc.m_ID == m_idMultMessage) ||
+       (desc.m_ID == m_idFMTUMessage) || (desc.m_name == "PARM") || desc.m_format.isEmpty())
+    {
+        return;
+    }
+
+    typedTypeInfo info;
+    info.m_descriptor = desc;
+    info.m_typeIndex = m_dataStoragePtr->getTypeIndex(desc.m_name);
+    if(info.m_typeIndex == -1)
+    {
+        return;
+    }
+
+    parserList parsers;
+    parsers.reserve(desc.m_format.size());
+    info.m_appends.reserve(desc.m_format.size());
+    info.m_columns.reserve(desc.m_format.size());
+    info.m_timeColumnPtr = QSharedPointer<LogdataTypedColumn<quint64> >(new LogdataTypedColumn<quint64>());
+    for(int i = 0; i < desc.m_format.size(); ++i)
+    {
+        const char format = desc.m_format.at(i).toLatin1();
+        parseFunction parse = nullptr;
+        appendFunction append = nullptr;
+        LogdataColumn::Ptr column;
+        if(!fieldConverter::select(format, parse, append, column))
+        {
+            return; // unknown format. Let the parsing by name do the error handling
+        }
+        if(!desc.hasNoTimestamp() && (i == desc.m_timeStampIndex))
+        {
+            // time stamps must be corrected while parsing - only integer time stamps are supported
+            if(QString("bhiqBHIQ").indexOf(QChar(format)) < 0)
+            {
+                return;
+            }
+            info.m_signedTime = QString("bhiq").indexOf(QChar(format)) >= 0;
+            append = nullptr;
+            column = info.m_timeColumnPtr;
+        }
+        parsers.push_back(parse);
+        info.m_appends.push_back(append);
+        info.m_columns.push_back(column);
+    }
+
+    QVector<LogdataColumn::Ptr> columns = info.m_columns;
+    if(desc.hasNoTimestamp())
+    {
+        // The datamodel has an additional time stamp column at the front of the message
+        columns.push_front(info.m_timeColumnPtr);
+    }
+
+    if(m_dataStoragePtr->setDataColumns(info.m_typeIndex, columns))
+    {
+        const QByteArray name = desc.m_name.toUtf8();
+        m_typedTypes.insert(name, info);
+        m_typedParsers.insert(name, parsers);
+    }
+    else
+    {
+        QLOG_WARN() << "AsciiLogParser::setupTypedType():" << m_dataStoragePtr->getError();
+    }
+}
+
+void AsciiLogParser::storeTypedLine(typedTypeInfo &info, const char *data, const asciiChunk &chunk, const asciiLine &line)
+{
+    quint64 timeStamp = 0;
+    if(info.m_descriptor.hasNoTimestamp())
+    {
+        timeStamp = highestTimestamp();
+    }
+    else
+    {
+        const asciiValue &time = chunk.m_values.at(line.m_firstValue + info.m_descriptor.m_timeStampIndex);
+        timeStamp = handleTimeStamp(info.m_signedTime ? static_cast<quint64>(time.m_int) : time.m_uint,
+                                    info.m_descriptor.m_name);
+    }
+    info.m_timeColumnPtr->appendValue(timeStamp);
+
+    for(int i = 0; i < info.m_appends.size(); ++i)
+    {
+        if(info.m_appends.at(i) != nullptr)
+        {
+            const asciiToken &token = chunk.m_tokens.at(line.m_firstToken + i);
+            info.m_appends.at(i)(*info.m_columns.at(i), chunk.m_values.at(line.m_firstValue + i),
+                                 data + token.m_offset, token.m_length);
+        }
+    }
+    m_dataStoragePtr->addLazyDataRow(info.m_typeIndex, timeStamp);
+
+    m_logLoadingState.validDataRead();
+    m_MessageCounter++;
+}
+
 bool AsciiLogParser::extendedStoreDescriptor(const asciiDescriptor &desc)
 {
     bool rc = true;
@@ -37,6 +37,14 @@ This file is part of the APM_PLANNER project
 /**
  * @brief The AsciiLogParser class is a parser for ASCII ArduPilot
  *        logfiles (.log extension).
+ *
+ *        The file is read in big blocks which are split into line aligned chunks.
+ *        The chunks are tokenized by worker threads directly on the bytes of the
+ *        block. Numbers of all types known when the block was read are converted by
+ *        the workers as well. The results are stored in file order by the parsing
+ *        thread into typed columns of the datamodel. FMT lines, lines of types which
+ *        need special handling and all lines which could not be converted are parsed
+ *        line by line like before.
  */
 class AsciiLogParser : public LogParserBase
 {
@@ -78,6 +86,9 @@ private:
 
     static const int s_MinFmtTokens = 5;        /// Min amount of tokens in a FMT line
 
+    static const qint64 s_ReadBlockSize = 4 * 1024 * 1024;  /// Bytes read from the log file at once
+    static const int s_ChunkSize = 256 * 1024;              /// Bytes per chunk tokenized by one worker
+
     /**
      * @brief The asciiDescriptor class provides a specialized typeDescriptor
      *        with an own isValid method.
@@ -88,14 +99,133 @@ private:
         virtual bool isValid() const;
     };
 
+    /**
+     * @brief The asciiValue union holds one converted number. Which member is valid
+     *        depends on the format of the field.
+     */
+    union asciiValue
+    {
+        qint64 m_int;       /// signed integer formats
+        quint64 m_uint;     /// unsigned integer formats
+        double m_double;    /// floating point formats
+    };
+
+    /**
+     * @brief The asciiToken struct holds the position of a trimmed token in the block
+     */
+    struct asciiToken
+    {
+        int m_offset;       /// offset of the token in the block
+        int m_length;       /// length of the token
+    };
+
+    /**
+     * @brief The asciiLine struct holds the result of tokenizing one line
+     */
+    struct asciiLine
+    {
+        int m_offset;       /// offset of the line in the block
+        int m_length;       /// length of the line without line end
+        int m_nameLength;   /// length of the message type at the start of the line
+        int m_firstToken;   /// index of the first value token in asciiChunk::m_tokens
+        int m_tokenCount;   /// number of value tokens - the message type is no value token
+        int m_firstValue;   /// index of the first value in asciiChunk::m_values, -1 if not converted
+    };
+
+    /**
+     * @brief The asciiChunk struct holds all tokenized lines of one chunk in file order
+     */
+    struct asciiChunk
+    {
+        QVector<asciiLine> m_lines;
+        QVector<asciiToken> m_tokens;
+        QVector<asciiValue> m_values;
+    };
+
+    /**
+     * @brief parseFunction - type of the functions converting a token to a number
+     */
+    using parseFunction = bool (*)(const char *begin, const char *end, asciiValue &value);
+
+    /**
+     * @brief appendFunction - type of the functions appending a value or token to a column
+     */
+    using appendFunction = void (*)(LogdataColumn &column, const asciiValue &value, const char *token, int length);
+
+    using parserList = QVector<parseFunction>;   /// one parse function for every field of a type. nullptr for strings
+
+    struct fieldConverter;  /// parse and append functions for all formats. Defined in the cpp file.
+
+    /**
+     * @brief The typedTypeInfo struct holds everything needed to store the values
+     *        of one message type directly into the columns of the datamodel.
+     */
+    struct typedTypeInfo
+    {
+        asciiDescriptor m_descriptor;                                   /// descriptor of this type
+        int m_typeIndex = -1;                                           /// Index of the type in the datamodel
+        bool m_signedTime = false;                                      /// true if the time stamp is a signed integer
+        QVector<appendFunction> m_appends;                              /// one append function for every field
+        QVector<LogdataColumn::Ptr> m_columns;                          /// one column for every field
+        QSharedPointer<LogdataTypedColumn<quint64> > m_timeColumnPtr;   /// the corrected time stamps
+    };
+
     QHash<QString, asciiDescriptor> m_nameToDescriptorMap;   /// hashMap storing a format descriptor for every message type
 
-    QStringList m_tokensToParse;        /// Tokenized input data to parse
+    QHash<QByteArray, typedTypeInfo> m_typedTypes;      /// all types stored directly into typed columns
+    QHash<QByteArray, parserList> m_typedParsers;       /// parse functions of all types in m_typedTypes. Copied for the workers.
+
+    QStringList m_tokensToParse;        /// Tokenized input data to parse - only used for lines parsed by name
     int m_noMessageBytes;               /// Dropped bytes during parsing
 
     QList<asciiDescriptor> m_descriptorForDeferredStorage; /// temp list for storing descriptors without a timestamp field
 
 
+    /**
+     * @brief tokenizeChunk tokenizes all lines of one chunk and converts the values of all
+     *        lines whose type is in parsers. Runs on a worker thread so it must only read
+     *        the passed data.
+     * @param data - pointer to the block
+     * @param start - offset of the first line of the chunk
+     * @param end - offset of the first byte after the chunk
+     * @param parsers - the parse functions of all types which can be converted
+     * @return all lines of the chunk in file order
+     */
+    static asciiChunk tokenizeChunk(const char *data, int start, int end, const QHash<QByteArray, parserList> &parsers);
+
+    /**
+     * @brief parseBlock parses a block of complete lines
+     * @param block - the block
+     * @param size - number of bytes of the block to parse
+     * @return true - success, false - datamodel failure
+     */
+    bool parseBlock(const QByteArray &block, int size);
+
+    /**
+     * @brief parseLine parses one line by name. Used for FMT lines, all types needing special
+     *        handling and lines which could not be converted by the tokenizer.
+     * @param line - the line without line end
+     * @return true - success, false - datamodel failure
+     */
+    bool parseLine(const QString &line);
+
+    /**
+     * @brief setupTypedType creates the typed columns for a stored descriptor if its values
+     *        can be stored without the name value pair path.
+     * @param desc - the descriptor as stored in the datamodel
+     */
+    void setupTypedType(const asciiDescriptor &desc);
+
+    /**
+     * @brief storeTypedLine stores the converted values of one line into the typed columns.
+     *        Does the time stamp handling so it must be called in file order.
+     * @param info - the typed info of the message type
+     * @param data - pointer to the block
+     * @param chunk - the chunk holding the line
+     * @param line - the line to store
+     */
+    void storeTypedLine(typedTypeInfo &info, const char *data, const asciiChunk &chunk, const asciiLine &line);
+
     /**
      * @brief parseFMTMessage parses a FMT message into a asciiDescriptor.
      * @param desc asciiDescriptor to be filled
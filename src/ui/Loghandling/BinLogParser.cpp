@@ -65,7 +65,8 @@ bool BinLogParser::binDescriptor::isValid() const
 BinLogParser::BinLogParser(LogdataStorage::Ptr storagePtr, IParserCallback *object) :
     LogParserBase (storagePtr, object),
     m_dataPos(0),
-    m_messageType(0)
+    m_messageType(0),
+    m_useMappedFile(true)
 {
     QLOG_DEBUG() << "BinLogParser::BinLogParser - CTOR";
 }
@@ -75,6 +76,11 @@ BinLogParser::~BinLogParser()
     QLOG_DEBUG() << "BinLogParser::BinLogParser - DTOR";
 }
 
+void BinLogParser::setUseMappedFile(bool enable)
+{
+    m_useMappedFile = enable;
+}
+
 AP2DataPlotStatus BinLogParser::parse(QFile &logfile)
 {
     QLOG_DEBUG() << "BinLogParser::parse:" << logfile.fileName();
@@ -85,6 +91,18 @@ AP2DataPlotStatus BinLogParser::parse(QFile &logfile)
         return m_logLoadingState;
     }
 
+    if(m_useMappedFile)
+    {
+        m_mappedFilePtr = LogdataMappedFile::Ptr(new LogdataMappedFile(logfile.fileName()));
+        if(m_mappedFilePtr->map())
+        {
+            parseMapped(logfile);
+            return m_logLoadingState;
+        }
+        QLOG_WARN() << "BinLogParser::parse - Unable to map log file - falling back to block reading";
+        m_mappedFilePtr.reset();
+    }
+
     int noMessageBytes = 0;     // to count all bytes that could no be parsed
 
     while(!logfile.atEnd() && !m_stop)
@@ -112,20 +130,9 @@ AP2DataPlotStatus BinLogParser::parse(QFile &logfile)
                 binDescriptor descriptor;
                 if(parseFMTMessage(descriptor))
                 {
-                    // do some special handling if needed
-                    specialDescriptorHandling(descriptor);
-                    if(m_activeTimestamp.valid())
-                    {
-                        descriptor.finalize(m_activeTimestamp);
-                        if(!extendedStoreDescriptor(descriptor))
-                        {
-                            return m_logLoadingState;
-                        }
-                    }
-                    else
+                    if(!handleFMTMessage(descriptor))
                     {
-                        checkForValidTimestamp(descriptor);
-                        m_descriptorForDeferredStorage.push_back(descriptor);
+                        return m_logLoadingState;
                     }
                 }
                 else
@@ -140,22 +147,9 @@ AP2DataPlotStatus BinLogParser::parse(QFile &logfile)
                 binDescriptor descriptor = m_typeToDescriptorMap.value(m_messageType);
                 if(parseDataByDescriptor(NameValuePairList, descriptor))
                 {
-                    if(NameValuePairList.size() >= 1)   // need at least one element
+                    if(!storeDecodedData(NameValuePairList, descriptor))
                     {
-                        if(!extendedStoreNameValuePairList(NameValuePairList, descriptor))
-                        {
-                            return m_logLoadingState;
-                        }
-                        if((m_loadedLogType == MAV_TYPE_GENERIC) && (descriptor.m_name == "PARM"))
-                        {
-                            detectMavType(NameValuePairList);
-                        }
-                    }
-                    else
-                    {
-                        QLOG_WARN() << "BinLogParser::parse - No values within data message";
-                        m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
-                                                          "No values within data message");
+                        return m_logLoadingState;
                     }
                 }
                 else
@@ -172,6 +166,204 @@ AP2DataPlotStatus BinLogParser::parse(QFile &logfile)
             }
         }
     }
+
+    finishParsing(noMessageBytes);
+    return m_logLoadingState;
+}
+
+bool BinLogParser::parseMapped(QFile &logfile)
+{
+    const char *data = m_mappedFilePtr->data();
+    const qint64 size = m_mappedFilePtr->size();
+    qint64 pos = 0;
+    qint64 lastProgressPos = 0;
+    int noMessageBytes = 0;     // to count all bytes that could no be parsed
+
+    m_mappedTypeInfo.fill(mappedTypeInfo(), 256);   // message type is one byte
+
+    m_callbackObject->onProgress(pos, size);
+    while(((size - pos) > s_MinHeaderSize) && !m_stop)
+    {
+        if((pos - lastProgressPos) > s_ProgressInterval)
+        {
+            m_callbackObject->onProgress(pos, size);
+            lastProgressPos = pos;
+        }
+
+        if((static_cast<quint8>(data[pos]) != s_StartByte1) || (static_cast<quint8>(data[pos + 1]) != s_StartByte2))
+        {
+            noMessageBytes++;
+            pos++;
+            continue;
+        }
+
+        const auto messageType = static_cast<quint8>(data[pos + 2]);
+        const char *payload = data + pos + s_HeaderOffset;
+        const qint64 available = size - pos - s_HeaderOffset;
+
+        // Format (FMT) message
+        if(messageType == s_FMTMessageType)
+        {
+            if(available < s_FMTPayloadSize)
+            {
+                break;  // truncated message at end of file
+            }
+            binDescriptor descriptor;
+            decodeFMTMessage(payload, descriptor);
+            if(!handleFMTMessage(descriptor))
+            {
+                return false;
+            }
+            pos += s_HeaderOffset + s_FMTPayloadSize;
+        }
+        // Data packet
+        else if(m_typeToDescriptorMap.contains(messageType))
+        {
+            mappedTypeInfo &info = m_mappedTypeInfo[messageType];
+            if(info.m_decoding == mappedTypeInfo::decoding::Unknown)
+            {
+                info.m_descriptor = m_typeToDescriptorMap.value(messageType);
+                setupMappedType(info);
+            }
+            if(available < (info.m_descriptor.m_length - s_HeaderOffset))
+            {
+                break;  // truncated message at end of file
+            }
+            if(!storeMappedMessage(payload, pos + s_HeaderOffset, info))
+            {
+                return false;
+            }
+            pos += info.m_descriptor.m_length;
+        }
+        else
+        {
+            QLOG_WARN() << "Read data without having a valid format descriptor - Message type is " << QString::number(messageType);
+            m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
+                                              "Read data without having a valid format descriptor - "
+                                              "Message type is " + QString::number(messageType));
+            pos += s_HeaderOffset;
+        }
+    }
+
+    // values of logs without unit data must be scaled while decoding
+    m_mappedFilePtr->setLegacyScaling(!m_hasUnitData);
+    // let the file position show how far we got
+    logfile.seek(pos);
+
+    finishParsing(noMessageBytes);
+    return true;
+}
+
+void BinLogParser::setupMappedType(mappedTypeInfo &info)
+{
+    const binDescriptor &desc = info.m_descriptor;
+
+    // Unit, multiplier and format unit messages are not stored as data but need special handling.
+    // PARM messages are needed for the MAV type detection. All of them are small so we just
+    // decode them while parsing.
+    if((desc.m_ID == m_idUnitMessage) || (desc.m_ID == m_idMultMessage) ||
+       (desc.m_ID == m_idFMTUMessage) || (desc.m_name == "PARM"))
+    {
+        info.m_decoding = mappedTypeInfo::decoding::Eager;
+        return;
+    }
+
+    // The type is unknown to the datamodel as long as its descriptor is deferred. Leave it
+    // unknown so the setup is tried again with the next message of this type.
+    info.m_typeIndex = m_dataStoragePtr->getTypeIndex(desc.m_name);
+    if(info.m_typeIndex == -1)
+    {
+        return;
+    }
+    info.m_decoding = mappedTypeInfo::decoding::Eager;
+
+    // calculate the offset of each field within the payload
+    QVector<int> fieldOffsets;
+    fieldOffsets.reserve(desc.m_format.size());
+    int offset = 0;
+    for(const QChar &formatChar : desc.m_format)
+    {
+        const int fieldSize = LogdataMappedColumn::fieldSize(formatChar.toLatin1());
+        if(fieldSize == 0)
+        {
+            return; // unknown format. Let the decoding while parsing do the error handling
+        }
+        fieldOffsets.push_back(offset);
+        offset += fieldSize;
+    }
+    if(offset > (desc.m_length - s_HeaderOffset))
+    {
+        return; // descriptor does not match the message length. Let the decoding while parsing do the error handling
+    }
+
+    info.m_offsetsPtr = LogdataMappedColumn::OffsetVectorPtr(new LogdataMappedColumn::OffsetVector());
+    info.m_timeColumnPtr = QSharedPointer<LogdataTypedColumn<quint64> >(new LogdataTypedColumn<quint64>());
+
+    QVector<LogdataColumn::Ptr> columns;
+    columns.reserve(desc.m_format.size() + 1);
+    if(desc.hasNoTimestamp())
+    {
+        // The datamodel has an additional time stamp column at the front of the message
+        columns.push_back(info.m_timeColumnPtr);
+        info.m_timeFieldOffset = -1;
+    }
+    for(int i = 0; i < desc.m_format.size(); ++i)
+    {
+        if(!desc.hasNoTimestamp() && (i == desc.m_timeStampIndex))
+        {
+            // time stamps must be corrected while parsing - they are stored and not decoded from the file
+            columns.push_back(info.m_timeColumnPtr);
+            info.m_timeFieldOffset = fieldOffsets.at(i);
+            info.m_timeFormat = desc.m_format.at(i).toLatin1();
+        }
+        else
+        {
+            columns.push_back(LogdataColumn::Ptr(new LogdataMappedColumn(m_mappedFilePtr, info.m_offsetsPtr, fieldOffsets.at(i),
+                                                                         desc.m_format.at(i).toLatin1())));
+        }
+    }
+
+    if(m_dataStoragePtr->setDataColumns(info.m_typeIndex, columns))
+    {
+        info.m_decoding = mappedTypeInfo::decoding::Lazy;
+    }
+    else
+    {
+        QLOG_WARN() << "BinLogParser::setupMappedType():" << m_dataStoragePtr->getError();
+    }
+}
+
+bool BinLogParser::storeMappedMessage(const char *payload, qint64 payloadOffset, mappedTypeInfo &info)
+{
+    if(info.m_decoding != mappedTypeInfo::decoding::Lazy)
+    {
+        QList<NameValuePair> NameValuePairList;
+        decodeDataByDescriptor(payload, NameValuePairList, info.m_descriptor);
+        return storeDecodedData(NameValuePairList, info.m_descriptor);
+    }
+
+    quint64 timeStamp = 0;
+    if(info.m_timeFieldOffset < 0)
+    {
+        timeStamp = highestTimestamp();
+    }
+    else
+    {
+        timeStamp = handleTimeStamp(LogdataMappedColumn::decodeTimeStamp(payload + info.m_timeFieldOffset, info.m_timeFormat),
+                                    info.m_descriptor.m_name, info.m_lastValidTime);
+    }
+
+    info.m_offsetsPtr->push_back(payloadOffset);
+    info.m_timeColumnPtr->appendValue(timeStamp);
+    m_dataStoragePtr->addLazyDataRow(info.m_typeIndex, timeStamp);
+
+    m_logLoadingState.validDataRead();
+    m_MessageCounter++;
+    return true;
+}
+
+void BinLogParser::finishParsing(int noMessageBytes)
+{
     if (noMessageBytes > 0)
     {
         QLOG_WARN() << "BinLogParser::parse(): Non packet bytes found in log file. " << noMessageBytes << " bytes filtered out. This may be a corrupt log";
@@ -191,8 +383,29 @@ AP2DataPlotStatus BinLogParser::parse(QFile &logfile)
     {
         m_dataStoragePtr->setTimeStamp(m_activeTimestamp.m_name, m_activeTimestamp.m_divisor);
     }
+}
 
-    return m_logLoadingState;
+bool BinLogParser::handleFMTMessage(binDescriptor &desc)
+{
+    // A redefined type must be set up again in mapped mode. Lazy types keep their setup as
+    // their columns already hold data and storeDescriptor() keeps the first descriptor anyway.
+    if((desc.m_ID < static_cast<quint32>(m_mappedTypeInfo.size())) &&
+       (m_mappedTypeInfo.at(desc.m_ID).m_decoding != mappedTypeInfo::decoding::Lazy))
+    {
+        m_mappedTypeInfo[desc.m_ID] = mappedTypeInfo();
+    }
+
+    // do some special handling if needed
+    specialDescriptorHandling(desc);
+    if(m_activeTimestamp.valid())
+    {
+        desc.finalize(m_activeTimestamp);
+        return extendedStoreDescriptor(desc);
+    }
+
+    checkForValidTimestamp(desc);
+    m_descriptorForDeferredStorage.push_back(desc);
+    return true;
 }
 
 bool BinLogParser::headerIsValid()
@@ -209,23 +422,13 @@ bool BinLogParser::headerIsValid()
 
 bool BinLogParser::parseFMTMessage(binDescriptor &desc)
 {
-    desc.m_ID     = static_cast<quint8>(m_dataBlock.at(m_dataPos++));
-    desc.m_length = static_cast<quint8>(m_dataBlock.at(m_dataPos++));
-    if((m_dataBlock.size() - m_dataPos) < (desc.m_length - s_HeaderOffset - 2)) // the -2 is for the 2 increments made in lines above
+    if((m_dataBlock.size() - m_dataPos) < s_FMTPayloadSize)
     {
         return false;   // do not have enough data to parse the packet
     }
 
-    desc.m_name = m_dataBlock.mid(m_dataPos, s_FMTNameSize);
-    m_dataPos += s_FMTNameSize;
-    desc.m_format = m_dataBlock.mid(m_dataPos, s_FMTFormatSize);
-    m_dataPos += s_FMTFormatSize;
-    QString tmpStr = m_dataBlock.mid(m_dataPos, s_FMTLabelsSize);
-    if(tmpStr.size() > 0)
-    {
-        desc.m_labels = tmpStr.split(",");
-    }
-    m_dataPos += s_FMTLabelsSize;
+    decodeFMTMessage(m_dataBlock.constData() + m_dataPos, desc);
+    m_dataPos += s_FMTPayloadSize;
 
     // remove successful parsed data from data block
     m_dataBlock.remove(0, m_dataPos);
@@ -233,6 +436,23 @@ bool BinLogParser::parseFMTMessage(binDescriptor &desc)
     return true;
 }
 
+void BinLogParser::decodeFMTMessage(const char *data, binDescriptor &desc)
+{
+    int pos = 0;
+    desc.m_ID     = static_cast<quint8>(data[pos++]);
+    desc.m_length = static_cast<quint8>(data[pos++]);
+
+    desc.m_name = QByteArray(data + pos, s_FMTNameSize);
+    pos += s_FMTNameSize;
+    desc.m_format = QByteArray(data + pos, s_FMTFormatSize);
+    pos += s_FMTFormatSize;
+    QString tmpStr = QByteArray(data + pos, s_FMTLabelsSize);
+    if(tmpStr.size() > 0)
+    {
+        desc.m_labels = tmpStr.split(",");
+    }
+}
+
 bool BinLogParser::storeDescriptor(binDescriptor desc)
 {
     if(desc.isValid())
@@ -275,7 +495,41 @@ bool BinLogParser::parseDataByDescriptor(QList<NameValuePair> &NameValuePairList
         return false;
     }
 
-    QByteArray data = m_dataBlock.mid(m_dataPos, (desc.m_length - s_HeaderOffset));
+    decodeDataByDescriptor(m_dataBlock.constData() + m_dataPos, NameValuePairList, desc);
+
+    // remove the successful parsed data from the data block
+    m_dataBlock.remove(0, desc.m_length + m_dataPos - s_HeaderOffset);
+    m_dataPos = 0;
+
+    return true;
+}
+
+bool BinLogParser::storeDecodedData(QList<NameValuePair> &NameValuePairList, const binDescriptor &desc)
+{
+    if(NameValuePairList.size() >= 1)   // need at least one element
+    {
+        if(!extendedStoreNameValuePairList(NameValuePairList, desc))
+        {
+            return false;
+        }
+        if((m_loadedLogType == MAV_TYPE_GENERIC) && (desc.m_name == "PARM"))
+        {
+            detectMavType(NameValuePairList);
+        }
+    }
+    else
+    {
+        QLOG_WARN() << "BinLogParser::parse - No values within data message";
+        m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
+                                          "No values within data message");
+    }
+    return true;
+}
+
+void BinLogParser::decodeDataByDescriptor(const char *payload, QList<NameValuePair> &NameValuePairList, const binDescriptor &desc)
+{
+    // no copy - the stream reads directly from the payload
+    QByteArray data = QByteArray::fromRawData(payload, desc.m_length - s_HeaderOffset);
     QDataStream packetstream(data);
     packetstream.setByteOrder(QDataStream::LittleEndian);
     NameValuePairList.clear();
@@ -482,11 +736,6 @@ bool BinLogParser::parseDataByDescriptor(QList<NameValuePair> &NameValuePairList
             break;
         }
     }
-    // remove the successful parsed data from the data block
-    m_dataBlock.remove(0, desc.m_length + m_dataPos - s_HeaderOffset);
-    m_dataPos = 0;
-
-    return true;
 }
 
 bool BinLogParser::extendedStoreDescriptor(const binDescriptor &desc)
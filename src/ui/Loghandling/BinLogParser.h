@@ -33,10 +33,17 @@ This file is part of the APM_PLANNER project
 #include "IParserCallback.h"
 #include "LogParserBase.h"
 #include "LogdataStorage.h"
+#include "LogdataMappedColumn.h"
 
 /**
  * @brief The BinLogParser class is a parser for binary ArduPilot
- *        logfiles aka flash logs
+ *        logfiles aka flash logs.
+ *
+ *        By default the log file is memory mapped. In this mode the parser only
+ *        builds an index of all messages and decodes the time stamps. All other
+ *        values are decoded on demand directly from the mapped file (see
+ *        LogdataMappedColumn). If the file cannot be mapped the parser falls back
+ *        to reading and decoding the file block by block.
  */
 class BinLogParser : public LogParserBase
 {
@@ -62,6 +69,14 @@ public:
      */
     virtual AP2DataPlotStatus parse(QFile &logfile);
 
+    /**
+     * @brief setUseMappedFile enables or disables the memory mapped parsing.
+     *        Must be called before parse().
+     * @param enable - true use memory mapped file (default), false read
+     *                 the file block by block and decode all values.
+     */
+    void setUseMappedFile(bool enable);
+
 private:
 
     static const quint8 s_FMTMessageType  = 0x80; /// Type Id of the format (FMT) message
@@ -74,6 +89,9 @@ private:
     static const int s_FMTNameSize   = 4;        /// Size of the name field in FMT message
     static const int s_FMTFormatSize = 16;       /// Size of the format field in FMT message
     static const int s_FMTLabelsSize = 64;       /// Size of the comma delimited names field in FMT message
+    static const int s_FMTPayloadSize = 2 + s_FMTNameSize + s_FMTFormatSize + s_FMTLabelsSize; /// Size of FMT message without header
+
+    static const qint64 s_ProgressInterval = 65536; /// Bytes between two progress callbacks in mapped mode
 
     static const quint32 s_FloatHardNaN  = 0x7FC00000;         /// Value to detect a quiet/soft float NaN from ardupilot
     static const quint64 s_DoubleHardNaN = 0x7FF8000000000000; /// Value to detect a quiet/soft double NaN from ardupilot
@@ -97,6 +115,62 @@ private:
 
     QList<binDescriptor> m_descriptorForDeferredStorage; /// temp list for storing descriptors without a timestamp field
 
+    /**
+     * @brief The mappedTypeInfo struct holds everything needed to index the
+     *        messages of one type in memory mapped mode.
+     */
+    struct mappedTypeInfo
+    {
+        enum class decoding
+        {
+            Unknown,    /// type was not seen yet
+            Lazy,       /// values are decoded on demand from the mapped file
+            Eager       /// values are decoded while parsing
+        };
+
+        decoding m_decoding = decoding::Unknown;                 /// How messages of this type are decoded
+        int m_typeIndex = -1;                                    /// Index of the type in the datamodel
+        int m_timeFieldOffset = -1;                              /// Byte offset of the time stamp in payload, -1 if there is none
+        char m_timeFormat = 0;                                   /// format of the time stamp field
+        quint64 m_lastValidTime = 0;                             /// last valid time stamp, see LogParserBase::handleTimeStamp
+        binDescriptor m_descriptor;                              /// descriptor of this type
+        LogdataMappedColumn::OffsetVectorPtr m_offsetsPtr;       /// payload offsets of all messages of this type
+        QSharedPointer<LogdataTypedColumn<quint64> > m_timeColumnPtr;  /// the corrected time stamps
+    };
+
+    bool m_useMappedFile;                       /// true if parser shall use a memory mapped file
+    LogdataMappedFile::Ptr m_mappedFilePtr;     /// the mapped log file
+    QVector<mappedTypeInfo> m_mappedTypeInfo;   /// mapped mode info for every message type. Index is the message type
+
+    /**
+     * @brief parseMapped parses the whole mapped log file
+     * @param logfile - the log file. Only used to report the position
+     * @return true - success, false - datamodel failure
+     */
+    bool parseMapped(QFile &logfile);
+
+    /**
+     * @brief setupMappedType decides how messages of a type are handled in mapped mode and
+     *        creates the columns for the datamodel if the type can be decoded lazy.
+     * @param info - the info to set up. m_descriptor must be valid.
+     */
+    void setupMappedType(mappedTypeInfo &info);
+
+    /**
+     * @brief storeMappedMessage indexes one message in mapped mode.
+     * @param payload - pointer to the payload of the message
+     * @param payloadOffset - offset of the payload in the mapped file
+     * @param info - the mapped info of the message type
+     * @return true - success, false - datamodel failure
+     */
+    bool storeMappedMessage(const char *payload, qint64 payloadOffset, mappedTypeInfo &info);
+
+    /**
+     * @brief finishParsing does all the work after the last message was parsed.
+     * @param noMessageBytes - number of bytes which were no message
+     */
+    void finishParsing(int noMessageBytes);
+
     /**
      * @brief headerIsValid checks the first 2 start bytes
      *        and extracts the message type which is stored in m_messageType.
@@ -113,6 +187,21 @@ private:
      */
     bool parseFMTMessage(binDescriptor &desc);
 
+    /**
+     * @brief decodeFMTMessage decodes the FMT message data into a binDescriptor
+     * @param data - pointer to the first byte after the message header. There must be
+     *               at least s_FMTPayloadSize bytes.
+     * @param desc binDescriptor to be filled
+     */
+    static void decodeFMTMessage(const char *data, binDescriptor &desc);
+
+    /**
+     * @brief handleFMTMessage does the special handling for descriptors and stores them
+     * @param desc binDescriptor to be handled
+     * @return true - success, false - datamodel failure
+     */
+    bool handleFMTMessage(binDescriptor &desc);
+
     /**
      * @brief storeDescriptor validates the descriptor adds a time stamp field
      *        if needed and stores it in the datamodel
@@ -139,6 +228,25 @@ private:
      */
     bool parseDataByDescriptor(QList<NameValuePair> &NameValuePairList, const binDescriptor &desc);
 
+    /**
+     * @brief decodeDataByDescriptor decodes the payload of a message like described in
+     *        the descriptor.
+     * @param payload - pointer to the first byte of the payload. There must be at least
+     *                  desc.m_length - s_HeaderOffset bytes.
+     * @param NameValuePairList - conatiner for the decoded data
+     * @param desc - descriptor of the message
+     */
+    void decodeDataByDescriptor(const char *payload, QList<NameValuePair> &NameValuePairList, const binDescriptor &desc);
+
+    /**
+     * @brief storeDecodedData stores the decoded values in the datamodel and
+     *        does the MAV type detection
+     * @param NameValuePairList - the decoded data
+     * @param desc - descriptor of the message
+     * @return true - success, false - datamodel failure
+     */
+    bool storeDecodedData(QList<NameValuePair> &NameValuePairList, const binDescriptor &desc);
+
 };
 
 #endif // BINLOGPARSER_H
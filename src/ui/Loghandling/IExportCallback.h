@@ -0,0 +1,51 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief Callback interface for the log exporters
+ *
+ */
+
+#ifndef IEXPORTCALLBACK_H
+#define IEXPORTCALLBACK_H
+
+class IExportCallback
+{
+public:
+
+    /**
+     * @brief ~IExportCallback DTOR
+     */
+    virtual ~IExportCallback(){}
+
+    /**
+     * @brief onExportProgress is called regulary by the exporters to enable the
+     *        implementer to show the progress and to cancel the export.
+     *
+     * @param percent - progress of the export in percent
+     * @return true - continue the export, false - cancel it
+     */
+    virtual bool onExportProgress(int percent) = 0;
+};
+
+#endif // IEXPORTCALLBACK_H
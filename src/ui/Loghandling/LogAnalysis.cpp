@@ -34,6 +34,38 @@ This file is part of the APM_PLANNER project
 #include "Loghandling/LogExporter.h"
 #include "Loghandling/PresetManager.h"
 
+#include <QApplication>
+#include <QProgressDialog>
+
+namespace
+{
+    /**
+     * @brief The ExportProgressDialog class shows the progress of a log export in
+     *        a modal progress dialog with a cancel button.
+     */
+    class ExportProgressDialog : public IExportCallback
+    {
+    public:
+        explicit ExportProgressDialog(QWidget *parent) :
+            m_progressDialog("Exporting File", "Cancel", 0, 100, parent)
+        {
+            m_progressDialog.setWindowModality(Qt::WindowModal);
+            m_progressDialog.show();
+            QApplication::processEvents();
+        }
+
+        virtual bool onExportProgress(int percent)
+        {
+            m_progressDialog.setValue(percent);
+            QApplication::processEvents();
+            return !m_progressDialog.wasCanceled();
+        }
+
+    private:
+        QProgressDialog m_progressDialog;
+    };
+}
+
 
 LogAnalysisCursor::LogAnalysisCursor(QCustomPlot *parentPlot, double xPosition, CursorType type) :
     QCPItemStraightLine(parentPlot),
@@ -503,16 +535,16 @@ void LogAnalysis::cursorRangeChange()
         activeGraphType::Iterator iter;
         for(iter = m_activeGraphs.begin(); iter != m_activeGraphs.end(); ++iter)
         {
-            QSharedPointer<QCPGraphDataContainer> dataPtr = iter->p_graph->data();
+            const LogGraphDecimator &data = *iter->m_decimatorPtr;
             RangeValues rangeVals;
 
-            int rangeStartIndex = iter->p_graph->findBegin(leftPos);
-            int rangeEndIndex   = iter->p_graph->findBegin(rightPos);
+            int rangeStartIndex = data.findBegin(leftPos);
+            int rangeEndIndex   = data.findBegin(rightPos);
             rangeVals.m_measurements = rangeEndIndex - rangeStartIndex;
 
             for(int i = rangeStartIndex; i < rangeEndIndex; ++i)
             {
-                double value = dataPtr->at(i)->mainValue();
+                double value = data.value(i);
                 rangeVals.m_average += value;
                 rangeVals.m_min = rangeVals.m_min > value ? value : rangeVals.m_min;
                 rangeVals.m_max = rangeVals.m_max < value ? value : rangeVals.m_max;
@@ -614,6 +646,45 @@ void LogAnalysis::plotTextArrow(double index, const QString &text, const QString
     itemline->setSelectable(false);
 }
 
+void LogAnalysis::updateGraphData(GraphElements &element)
+{
+    QVector<double> xlist;
+    QVector<double> ylist;
+    const QCPRange range = element.p_graph->keyAxis()->range();
+
+    if (element.m_decimatorPtr->getVisibleData(range.lower, range.upper, m_plotPtr->width(), xlist, ylist))
+    {
+        element.p_graph->setData(xlist, ylist, true);
+    }
+}
+
+void LogAnalysis::updateAllGraphData()
+{
+    activeGraphType::Iterator iter;
+    for(iter = m_activeGraphs.begin(); iter != m_activeGraphs.end(); ++iter)
+    {
+        updateGraphData(*iter);
+    }
+}
+
+void LogAnalysis::rescaleValueAxis(GraphElements &element)
+{
+    double lower = 0.0;
+    double upper = 0.0;
+    if (element.m_decimatorPtr->valueRange(lower, upper))
+    {
+        QCPRange newRange(lower, upper);
+        if (!QCPRange::validRange(newRange))
+        {
+            // constant data - keep the current size and center the value like QCPAxis::rescale() does
+            const double size = element.p_yAxis->range().size();
+            newRange.lower = lower - size / 2.0;
+            newRange.upper = lower + size / 2.0;
+        }
+        element.p_yAxis->setRange(newRange);
+    }
+}
+
 void LogAnalysis::disableTableFilter()
 {
     // The order of the statements is important to be fast on huge logs (15MB)
@@ -933,6 +1004,7 @@ void LogAnalysis::horizontalScrollMoved(int value)
         m_lastHorizontalScrollVal = value;
         disconnect(xAxis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChanged(QCPRange)));
         xAxis->setRange(value, xAxis->range().size(), Qt::AlignCenter);
+        updateAllGraphData();
         m_plotPtr->replot(QCustomPlot::rpQueuedReplot);
         connect(xAxis, SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChanged(QCPRange)));
     }
@@ -940,6 +1012,9 @@ void LogAnalysis::horizontalScrollMoved(int value)
 
 void LogAnalysis::xAxisChanged(QCPRange range)
 {
+    // refine or coarsen the graphs for the new range
+    updateAllGraphData();
+
     disconnect(ui.horizontalScrollBar, SIGNAL(valueChanged(int)), this, SLOT(horizontalScrollMoved(int)));
     disconnect(ui.verticalScrollBar, SIGNAL(valueChanged(int)), this, SLOT(verticalScrollMoved(int)));
 
@@ -998,8 +1073,9 @@ void LogAnalysis::itemEnabled(QString name)
 
     newPlot.p_graph = m_plotPtr->addGraph(axisRect->axis(QCPAxis::atBottom), newPlot.p_yAxis);
     newPlot.p_graph->setPen(QPen(color, 1));
-    newPlot.p_graph->setData(xlist, ylist);
-    newPlot.p_graph->rescaleValueAxis();
+    newPlot.m_decimatorPtr.reset(new LogGraphDecimator(xlist, ylist));
+    updateGraphData(newPlot);
+    rescaleValueAxis(newPlot);
 
     m_activeGraphs[name] = newPlot;     // store the plot by name
     // Add to gouping dialog
@@ -1270,17 +1346,21 @@ void LogAnalysis::doExport(bool kmlExport, double iconInterval)
         QString outputFileName = dialog.selectedFiles().at(0);
         timer.start();
 
-        if(kmlExport)
         {
-            QLOG_DEBUG() << "iconInterval: " << iconInterval;
+            // the progress dialog is closed when leaving this scope
+            ExportProgressDialog progress(this);
+            if(kmlExport)
+            {
+                QLOG_DEBUG() << "iconInterval: " << iconInterval;
 
-            KmlLogExporter kmlExporter(this, m_loadedLogMavType, iconInterval);
-            result = kmlExporter.exportToFile(outputFileName, m_dataStoragePtr);
-        }
-        else
-        {
-            AsciiLogExporter asciiExporter(this);
-            result = asciiExporter.exportToFile(outputFileName, m_dataStoragePtr);
+                KmlLogExporter kmlExporter(&progress, m_loadedLogMavType, iconInterval);
+                result = kmlExporter.exportToFile(outputFileName, m_dataStoragePtr);
+            }
+            else
+            {
+                AsciiLogExporter asciiExporter(&progress);
+                result = asciiExporter.exportToFile(outputFileName, m_dataStoragePtr);
+            }
         }
 
         QLOG_DEBUG() << "Log export took " << timer.elapsed() << "ms";
@@ -1318,7 +1398,7 @@ void LogAnalysis::graphGroupingChanged(QList<AP2DataPlotAxisDialog::GraphRange>
             iter->m_manualRange = false;
             iter->m_groupName = QString();
         }
-        iter->p_graph->rescaleValueAxis();
+        rescaleValueAxis(*iter);
     }
 
     // Now sort all grouped items into a map, and all manuals into a vector
@@ -1425,7 +1505,7 @@ void LogAnalysis::plotMouseMove(QMouseEvent *evt)
     {
         outStream.setRealNumberPrecision(3);
         double key   = iter->p_graph->keyAxis()->pixelToCoord(evt->x());
-        int keyIndex = iter->p_graph->findBegin(key);
+        int keyIndex = iter->m_decimatorPtr->findBegin(key);
 
         outStream << "\n" << iter.key();
 
@@ -1440,7 +1520,7 @@ void LogAnalysis::plotMouseMove(QMouseEvent *evt)
 
         if(keyIndex)
         {
-            outStream << " val:" << iter->p_graph->dataMainValue(keyIndex);
+            outStream << " val:" << iter->m_decimatorPtr->value(keyIndex);
         }
         else
         {
@@ -1562,7 +1642,7 @@ void LogAnalysis::resetValueScaling()
             iter->m_manualRange = false;
             iter->m_groupName = QString();
         }
-        iter->p_graph->rescaleValueAxis();
+        rescaleValueAxis(*iter);
     }
     m_plotPtr->replot();
 }
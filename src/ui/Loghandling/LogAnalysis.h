@@ -40,6 +40,7 @@ This file is part of the APM_PLANNER project
 #include "qcustomplot.h"
 
 #include "LogdataStorage.h"
+#include "LogGraphDecimator.h"
 #include "AP2DataPlotThread.h"
 #include "AP2DataPlotStatus.h"
 #include "AP2DataPlotAxisDialog.h"
@@ -238,6 +239,7 @@ private:
     {
         QCPAxis  *p_yAxis;     ///< pointer to the y-Axis of this graph
         QCPGraph *p_graph;     ///< pointer to the graph itself
+        LogGraphDecimator::Ptr m_decimatorPtr;  ///< full resolution data - the graph only holds the visible part
         QString m_groupName;   ///< name of the group the plot belongs to.
         bool m_manualRange;    ///< has user defined scaling
         bool m_inGroup;        ///< has group scaling
@@ -340,6 +342,25 @@ private:
      */
     void plotTextArrow(double index, const QString &text, const QString &layerName, const QColor &color);
 
+    /**
+     * @brief updateGraphData - feeds the graph with the points of its decimator needed
+     *        for the current x axis range and the current width of the plot area.
+     * @param element - the graph to update
+     */
+    void updateGraphData(GraphElements &element);
+
+    /**
+     * @brief updateAllGraphData - calls updateGraphData() for all active graphs
+     */
+    void updateAllGraphData();
+
+    /**
+     * @brief rescaleValueAxis - scales the y axis of a graph to the full value range.
+     *        Replaces QCPGraph::rescaleValueAxis() as the graph only holds the visible data.
+     * @param element - the graph to rescale
+     */
+    void rescaleValueAxis(GraphElements &element);
+
     /**
      * @brief This method disables the filtering of m_tableFilterProxyModel
      *        After a call the table model will show all rows again.
@@ -32,6 +32,7 @@ This file is part of the APM_PLANNER project
 
 #include "ui_LogAnalysisMap.h"
 
+#include <QSettings>
 #include <utility>
 
 //************************************************************************************
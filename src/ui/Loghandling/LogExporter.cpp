@@ -30,12 +30,9 @@ This file is part of the APM_PLANNER project
 #include "LogExporter.h"
 #include "logging.h"
 
-#include <QMessageBox>
-#include <QApplication>
-#include <QProgressDialog>
-#include <QScopedPointer>
+#include <QTextStream>
 
-LogExporterBase::LogExporterBase(QWidget *parent) : mp_parent(parent)
+LogExporterBase::LogExporterBase(IExportCallback *p_callback) : m_success(false), mp_callback(p_callback)
 {
     QLOG_DEBUG() << "LogExporterBase::LogExporterBase()";
 }
@@ -48,21 +45,16 @@ LogExporterBase::~LogExporterBase()
 
 QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr)
 {
-    typedef QScopedPointer<QProgressDialog, QScopedPointerDeleteLater> scopedDelLaterPtr;
-
     QLOG_DEBUG() << "LogExporterBase::exportToFile() Filename:" << fileName;
 
+    m_success = false;
+    m_ExportResult.clear();
+
     if(!startExport(fileName))
     {
         return m_ExportResult;
     }
 
-    // create progress dialog
-    scopedDelLaterPtr progressDialogPtr(new QProgressDialog("Exporting File", "Cancel", 0, 100, mp_parent));
-    progressDialogPtr->setWindowModality(Qt::WindowModal);
-    progressDialogPtr->show();
-    QApplication::processEvents();
-
     // Export header data
     QString formatheader = "FMT,128,89,FMT,BBnNZ,Type,Length,Name,Format,Columns";
     writeLine(formatheader);
@@ -130,28 +122,31 @@ QString LogExporterBase::exportToFile(const QString &fileName, LogdataStorage::P
         outputLine.clear();
         measurements.clear();
 
-        if(!(i % 5))
-        {
-            progressDialogPtr->setValue(static_cast<int>(100.0 * (static_cast<double>(i) / static_cast<double>(dataStoragePtr->rowCount()))));
-        }
-        QApplication::processEvents();
-        if(progressDialogPtr->wasCanceled())
+        if(mp_callback && !(i % s_ProgressInterval))
         {
-            progressDialogPtr->close();
-            m_ExportResult.append("Export was canceled by user");
-            QLOG_DEBUG() << m_ExportResult;
-            return m_ExportResult;
+            const int percent = static_cast<int>(100.0 * (static_cast<double>(i) / static_cast<double>(dataStoragePtr->rowCount())));
+            if(!mp_callback->onExportProgress(percent))
+            {
+                m_ExportResult.append("Export was canceled by user");
+                QLOG_DEBUG() << m_ExportResult;
+                return m_ExportResult;
+            }
         }
     }
 
-    progressDialogPtr->close();
     endExport();
+    m_success = true;
     return m_ExportResult;
 }
 
+bool LogExporterBase::isSuccessful() const
+{
+    return m_success;
+}
+
 //***********************************************************************
 
-AsciiLogExporter::AsciiLogExporter(QWidget *parent) : LogExporterBase (parent)
+AsciiLogExporter::AsciiLogExporter(IExportCallback *p_callback) : LogExporterBase (p_callback)
 {
     QLOG_DEBUG() << "AsciiLogExporter::AsciiLogExporter()";
 }
@@ -197,8 +192,8 @@ void AsciiLogExporter::endExport()
 
 //***********************************************************************
 
-KmlLogExporter::KmlLogExporter(QWidget *parent, MAV_TYPE mav_type, double iconInterval) :
-    LogExporterBase (parent), m_kmlExporter(mav_type, iconInterval)
+KmlLogExporter::KmlLogExporter(IExportCallback *p_callback, MAV_TYPE mav_type, double iconInterval) :
+    LogExporterBase (p_callback), m_kmlExporter(mav_type, iconInterval)
 {
     QLOG_DEBUG() << "KmlLogExporter::KmlLogExporter()";
 }
@@ -231,3 +226,311 @@ void KmlLogExporter::endExport()
     m_ExportResult.append(generated);
     QLOG_DEBUG() << m_ExportResult;
 }
+
+//***********************************************************************
+
+LogFieldExporterBase::LogFieldExporterBase(IExportCallback *p_callback) : m_success(false), mp_callback(p_callback)
+{
+    QLOG_DEBUG() << "LogFieldExporterBase::LogFieldExporterBase()";
+}
+
+LogFieldExporterBase::~LogFieldExporterBase()
+{
+    QLOG_DEBUG() << "LogFieldExporterBase::~LogFieldExporterBase()";
+}
+
+QString LogFieldExporterBase::exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr, const QStringList &fields)
+{
+    QLOG_DEBUG() << "LogFieldExporterBase::exportToFile() Filename:" << fileName << "Fields:" << fields;
+
+    m_success = false;
+    m_ExportResult.clear();
+
+    const QMap<QString, QStringList> selection = resolveFields(*dataStoragePtr, fields);
+    if(selection.isEmpty())
+    {
+        m_ExportResult.append("None of the selected fields is contained in the log");
+        QLOG_WARN() << m_ExportResult;
+        return m_ExportResult;
+    }
+
+    if(!startExport(fileName))
+    {
+        return m_ExportResult;
+    }
+
+    int groupCount = 0;
+    fieldGroup group;
+    QVector<double> time;
+    QVector<double> values;
+    for(auto iter = selection.constBegin(); iter != selection.constEnd(); ++iter)
+    {
+        group.m_name = iter.key();
+        group.m_labels.clear();
+        group.m_time.clear();
+        group.m_values.clear();
+
+        for(const auto &label : iter.value())
+        {
+            // the unit is not part of the value name
+            const QString valueName = iter.key() + '.' + label.section('[', 0, 0).trimmed();
+            if(!dataStoragePtr->getValues(valueName, true, time, values))
+            {
+                QLOG_WARN() << "LogFieldExporterBase::exportToFile() no values for" << valueName;
+                continue;
+            }
+            if(group.m_labels.isEmpty())
+            {
+                group.m_time = time;
+            }
+            group.m_labels.append(label);
+            group.m_values.append(values);
+        }
+
+        if(!group.m_labels.isEmpty() && !writeGroup(group))
+        {
+            return m_ExportResult;
+        }
+
+        ++groupCount;
+        if(mp_callback && !mp_callback->onExportProgress(100 * groupCount / selection.size()))
+        {
+            m_ExportResult.append("Export was canceled by user");
+            QLOG_DEBUG() << m_ExportResult;
+            return m_ExportResult;
+        }
+    }
+
+    endExport();
+    m_success = true;
+    return m_ExportResult;
+}
+
+bool LogFieldExporterBase::isSuccessful() const
+{
+    return m_success;
+}
+
+QMap<QString, QStringList> LogFieldExporterBase::resolveFields(const LogdataStorage &storage, const QStringList &fields)
+{
+    const QMap<QString, QStringList> available = storage.getFmtValues(true);
+    if(fields.isEmpty())
+    {
+        return available;
+    }
+
+    QMap<QString, QStringList> selection;
+    for(const auto &field : fields)
+    {
+        bool found = false;
+        for(auto iter = available.constBegin(); iter != available.constEnd(); ++iter)
+        {
+            // group is "TYPE" or "TYPE.Instance:N" for types with instances
+            const QString &group = iter.key();
+            const QString typeName = group.section('.', 0, 0);
+
+            QString valueName;
+            if((field == group) || (field == typeName))
+            {
+                valueName.clear();  // whole group
+            }
+            else if(field.startsWith(group + '.'))
+            {
+                valueName = field.mid(group.size() + 1);
+            }
+            else if(field.startsWith(typeName + '.') && !field.section('.', 1, 1).contains(':'))
+            {
+                valueName = field.mid(typeName.size() + 1);     // same value of all instances
+            }
+            else
+            {
+                continue;
+            }
+
+            QStringList &selectedLabels = selection[group];
+            for(const auto &label : iter.value())
+            {
+                if(valueName.isEmpty() || (label.section('[', 0, 0).trimmed() == valueName))
+                {
+                    found = true;
+                    if(!selectedLabels.contains(label))
+                    {
+                        selectedLabels.append(label);
+                    }
+                }
+            }
+            if(selectedLabels.isEmpty())
+            {
+                selection.remove(group);
+            }
+        }
+
+        if(!found)
+        {
+            QLOG_WARN() << "LogFieldExporterBase::resolveFields() field" << field << "is not contained in the log";
+        }
+    }
+    return selection;
+}
+
+//***********************************************************************
+
+CsvFieldExporter::CsvFieldExporter(IExportCallback *p_callback) : LogFieldExporterBase (p_callback)
+{
+    QLOG_DEBUG() << "CsvFieldExporter::CsvFieldExporter()";
+}
+
+CsvFieldExporter::~CsvFieldExporter()
+{
+    QLOG_DEBUG() << "CsvFieldExporter::~CsvFieldExporter()";
+}
+
+bool CsvFieldExporter::startExport(const QString &fileName)
+{
+    m_baseName = fileName;
+    if(m_baseName.endsWith(".csv", Qt::CaseInsensitive))
+    {
+        m_baseName.chop(4);
+    }
+    m_writtenFiles.clear();
+    return true;
+}
+
+bool CsvFieldExporter::writeGroup(const fieldGroup &group)
+{
+    // ':' is not allowed in file names on all systems
+    QString groupName(group.m_name);
+    groupName.replace(':', '_');
+    QFile outputFile(m_baseName + '.' + groupName + ".csv");
+
+    if(!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        QLOG_WARN() << "CsvFieldExporter::writeGroup() unable to open file" << outputFile.fileName();
+        m_ExportResult.append("Unable to open output file: ");
+        m_ExportResult.append(outputFile.errorString());
+        return false;
+    }
+
+    QByteArray buffer;
+    buffer.reserve(s_WriteBufferSize + 1024);
+    buffer.append("Time [s]");
+    for(const auto &label : group.m_labels)
+    {
+        buffer.append(',');
+        buffer.append(label.toUtf8());
+    }
+    buffer.append("\r\n");
+
+    for(int row = 0; row < group.m_time.size(); ++row)
+    {
+        buffer.append(QByteArray::number(group.m_time.at(row), 'f', 6));
+        for(const auto &values : group.m_values)
+        {
+            buffer.append(',');
+            buffer.append(QByteArray::number(values.at(row), 'g', 10));
+        }
+        buffer.append("\r\n");
+
+        if(buffer.size() >= s_WriteBufferSize)
+        {
+            outputFile.write(buffer);
+            buffer.clear();
+        }
+    }
+    outputFile.write(buffer);
+
+    if(outputFile.error() != QFileDevice::NoError)
+    {
+        QLOG_WARN() << "CsvFieldExporter::writeGroup() error writing" << outputFile.fileName();
+        m_ExportResult.append("Error writing output file: ");
+        m_ExportResult.append(outputFile.errorString());
+        return false;
+    }
+
+    m_writtenFiles.append(outputFile.fileName());
+    return true;
+}
+
+void CsvFieldExporter::endExport()
+{
+    m_ExportResult.append("Successfull exported to ");
+    m_ExportResult.append(m_writtenFiles.join(", "));
+    QLOG_DEBUG() << m_ExportResult;
+}
+
+//***********************************************************************
+
+BinaryFieldExporter::BinaryFieldExporter(IExportCallback *p_callback) : LogFieldExporterBase (p_callback)
+{
+    QLOG_DEBUG() << "BinaryFieldExporter::BinaryFieldExporter()";
+}
+
+BinaryFieldExporter::~BinaryFieldExporter()
+{
+    QLOG_DEBUG() << "BinaryFieldExporter::~BinaryFieldExporter()";
+    if(m_outputFile.isOpen())
+    {
+        m_outputFile.close();
+    }
+}
+
+bool BinaryFieldExporter::startExport(const QString &fileName)
+{
+    m_outputFile.setFileName(fileName);
+    if (!m_outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        QLOG_WARN() << "BinaryFieldExporter::startExport() unable to open file.";
+        m_ExportResult.append("Unable to open output file: ");
+        m_ExportResult.append(m_outputFile.errorString());
+        return false;
+    }
+
+    m_stream.setDevice(&m_outputFile);
+    m_stream.setVersion(QDataStream::Qt_5_0);
+    m_stream.setByteOrder(QDataStream::LittleEndian);
+    m_stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    m_stream << s_Magic << s_Version;
+    return m_stream.status() == QDataStream::Ok;
+}
+
+bool BinaryFieldExporter::writeGroup(const fieldGroup &group)
+{
+    m_stream << group.m_name.toUtf8();
+    m_stream << static_cast<quint32>(group.m_labels.size());
+    for(const auto &label : group.m_labels)
+    {
+        m_stream << label.toUtf8();
+    }
+
+    m_stream << static_cast<quint32>(group.m_time.size());
+    for(const double time : group.m_time)
+    {
+        m_stream << time;
+    }
+    for(const auto &values : group.m_values)
+    {
+        for(const double value : values)
+        {
+            m_stream << value;
+        }
+    }
+
+    if(m_stream.status() != QDataStream::Ok)
+    {
+        QLOG_WARN() << "BinaryFieldExporter::writeGroup() error writing" << m_outputFile.fileName();
+        m_ExportResult.append("Error writing output file: ");
+        m_ExportResult.append(m_outputFile.errorString());
+        return false;
+    }
+    return true;
+}
+
+void BinaryFieldExporter::endExport()
+{
+    m_ExportResult.append("Successfull exported to ");
+    m_ExportResult.append(m_outputFile.fileName());
+    QLOG_DEBUG() << m_ExportResult;
+    m_stream.setDevice(nullptr);
+    m_outputFile.close();
+}
@@ -31,14 +31,20 @@ This file is part of the APM_PLANNER project
 #define LOGEXPORTER_H
 
 #include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QDataStream>
+#include <QMap>
 
 #include "LogdataStorage.h"
+#include "IExportCallback.h"
 #include "src/output/kmlcreator.h"
 
 /**
  * @brief The LogExporterBase class - for different log exporters. It handles
  *        the exporting workflow for every line oriented export.
- *        It provides a progress dialog with a cancel button.
+ *        The progress is reported to an optional IExportCallback which
+ *        can also cancel the export.
  */
 class LogExporterBase
 {
@@ -51,9 +57,9 @@ public:
 
     /**
      * @brief LogExporterBase - CTOR
-     * @param parent - Parent widget needed for progress and info windows.
+     * @param p_callback - Callback for progress reporting. Can be null.
      */
-    explicit LogExporterBase(QWidget *parent);
+    explicit LogExporterBase(IExportCallback *p_callback);
 
     /**
      * @brief ~LogExporterBase - DTOR
@@ -69,13 +75,22 @@ public:
      */
     QString exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr);
 
+    /**
+     * @brief isSuccessful
+     * @return true if the last export was completed
+     */
+    bool isSuccessful() const;
+
 protected:
 
     QString m_ExportResult; /// String containing the result of the export
+    bool m_success;         /// true if the last export was completed
 
 private:
 
-    QWidget *mp_parent; /// pointer to parent widget - do not delete
+    static const int s_ProgressInterval = 1000;   /// Lines exported between two progress reports
+
+    IExportCallback *mp_callback; /// pointer to progress callback - do not delete. Can be null.
 
     /**
      * @brief startExport - must be implemented by derived classes. It has to setup
@@ -116,9 +131,9 @@ public:
 
     /**
      * @brief AsciiLogExporter - CTOR
-     * @param parent - Parent widget needed for progress and info windows.
+     * @param p_callback - Callback for progress reporting. Can be null.
      */
-    AsciiLogExporter(QWidget *parent);
+    explicit AsciiLogExporter(IExportCallback *p_callback);
 
     /**
      * @brief ~AsciiLogExporter - DTOR
@@ -165,9 +180,11 @@ public:
 
     /**
      * @brief KmlLogExporter - CTOR
-     * @param parent - Parent widget needed for progress and info windows.
+     * @param p_callback - Callback for progress reporting. Can be null.
+     * @param mav_type - type of the vehicle. Used to interpret the flight modes
+     * @param iconInterval - minimum time between two plane icons in seconds
      */
-    KmlLogExporter(QWidget *parent, MAV_TYPE mav_type, double iconInterval);
+    KmlLogExporter(IExportCallback *p_callback, MAV_TYPE mav_type, double iconInterval);
 
     /**
      * @brief ~KmlLogExporter - DTOR
@@ -199,5 +216,222 @@ private:
     virtual void endExport();
 };
 
+//***********************************************************************
+
+/**
+ * @brief The LogFieldExporterBase class - for exporters which only export selected
+ *        fields of a log. The values are fetched like they are plotted, which means
+ *        they are scaled to their unit and the time stamps are in seconds. All
+ *        selected fields of one type (or one instance of a type) share the same
+ *        time stamps and are handed to the derived class as one fieldGroup.
+ */
+class LogFieldExporterBase
+{
+public:
+
+    /**
+     * @brief Shared pointer for LogFieldExporterBase objects
+     */
+    typedef QSharedPointer<LogFieldExporterBase> Ptr;
+
+    /**
+     * @brief LogFieldExporterBase - CTOR
+     * @param p_callback - Callback for progress reporting. Can be null.
+     */
+    explicit LogFieldExporterBase(IExportCallback *p_callback);
+
+    /**
+     * @brief ~LogFieldExporterBase - DTOR
+     */
+    virtual ~LogFieldExporterBase();
+
+    /**
+     * @brief exportToFile - exports the selected fields of the LogdataStorage pointed
+     *        by dataStoragePtr.
+     * @param fileName - filename for the export
+     * @param dataStoragePtr - shared pointer to a filled LogdataStorage
+     * @param fields - the fields to export. @see resolveFields()
+     * @return QString with information about the export. Can be shown to the user.
+     */
+    QString exportToFile(const QString &fileName, LogdataStorage::Ptr dataStoragePtr, const QStringList &fields);
+
+    /**
+     * @brief isSuccessful
+     * @return true if the last export was completed
+     */
+    bool isSuccessful() const;
+
+    /**
+     * @brief resolveFields - matches a list of field names against the numeric fields
+     *        of a datamodel. A field can be given like "ATT.Roll" or "IMU.I:0.GyrX".
+     *        A type name like "ATT" selects all fields of the type. For types with
+     *        instances "IMU.GyrX" and "IMU" select all instances.
+     * @param storage - the datamodel
+     * @param fields - the field names. An empty list selects all numeric fields.
+     * @return Map with the group name like "ATT" or "IMU.I:0" as key and the labels
+     *         including their unit as value.
+     */
+    static QMap<QString, QStringList> resolveFields(const LogdataStorage &storage, const QStringList &fields);
+
+protected:
+
+    /**
+     * @brief The fieldGroup struct holds the selected fields of one group
+     */
+    struct fieldGroup
+    {
+        QString m_name;                         /// name of the group like "ATT" or "IMU.I:0"
+        QStringList m_labels;                   /// label of every field including its unit
+        QVector<double> m_time;                 /// time stamps in seconds
+        QVector<QVector<double> > m_values;     /// values of every field - each has the size of m_time
+    };
+
+    QString m_ExportResult; /// String containing the result of the export
+    bool m_success;         /// true if the last export was completed
+
+private:
+
+    IExportCallback *mp_callback; /// pointer to progress callback - do not delete. Can be null.
+
+    /**
+     * @brief startExport - must be implemented by derived classes. It has to setup
+     *        all preconditions needed to call writeGroup afterwards.
+     * @param fileName - filename for the export
+     * @return true on success, false otherwise
+     */
+    virtual bool startExport(const QString &fileName) = 0;
+
+    /**
+     * @brief writeGroup - must be implemented by derived classes. Will be called
+     *        once for every group containing selected fields.
+     * @param group - the values of the group
+     * @return true on success, false otherwise
+     */
+    virtual bool writeGroup(const fieldGroup &group) = 0;
+
+    /**
+     * @brief endExport - must be implemented by derived classes. Will be called by the
+     *        export function at the end of the export process. It should close all used
+     *        resources.
+     */
+    virtual void endExport() = 0;
+};
+
+//***********************************************************************
+
+/**
+ * @brief The CsvFieldExporter class exports the selected fields as CSV. Every group
+ *        is written to its own file named <fileName>.<group>.csv so each file has
+ *        one time stamp per row and no empty cells.
+ */
+class CsvFieldExporter : public LogFieldExporterBase
+{
+public:
+
+    /**
+     * @brief Shared pointer for CsvFieldExporter objects
+     */
+    typedef QSharedPointer<CsvFieldExporter> Ptr;
+
+    /**
+     * @brief CsvFieldExporter - CTOR
+     * @param p_callback - Callback for progress reporting. Can be null.
+     */
+    explicit CsvFieldExporter(IExportCallback *p_callback);
+
+    /**
+     * @brief ~CsvFieldExporter - DTOR
+     */
+    virtual ~CsvFieldExporter();
+
+private:
+
+    static const int s_WriteBufferSize = 1 << 20;   /// bytes collected before writing to the file
+
+    QString m_baseName;         /// file name without the .csv extension
+    QStringList m_writtenFiles; /// names of all written files
+
+    /**
+     * @brief startExport - stores the base name for the output files
+     * @param fileName - file name
+     * @return - true
+     */
+    virtual bool startExport(const QString &fileName);
+
+    /**
+     * @brief writeGroup - writes the group into its own CSV file
+     * @param group - the values of the group
+     * @return - true on success, false otherwise
+     */
+    virtual bool writeGroup(const fieldGroup &group);
+
+    /**
+     * @brief endExport - creates the result message
+     */
+    virtual void endExport();
+};
+
+//***********************************************************************
+
+/**
+ * @brief The BinaryFieldExporter class exports the selected fields into a compact
+ *        binary file. All numbers are little endian, strings are stored as quint32
+ *        length followed by the UTF-8 bytes.
+ *
+ *        File header:  quint32 magic "APMF", quint32 version
+ *        Every group:  string name, quint32 fieldCount, fieldCount x string label,
+ *                      quint32 rowCount, rowCount x double time [s],
+ *                      fieldCount x rowCount x double value
+ *
+ *        The groups follow each other up to the end of the file.
+ */
+class BinaryFieldExporter : public LogFieldExporterBase
+{
+public:
+
+    static const quint32 s_Magic   = 0x41504D46;    /// "APMF" - marks a binary field export
+    static const quint32 s_Version = 1;             /// Version of the file format
+
+    /**
+     * @brief Shared pointer for BinaryFieldExporter objects
+     */
+    typedef QSharedPointer<BinaryFieldExporter> Ptr;
+
+    /**
+     * @brief BinaryFieldExporter - CTOR
+     * @param p_callback - Callback for progress reporting. Can be null.
+     */
+    explicit BinaryFieldExporter(IExportCallback *p_callback);
+
+    /**
+     * @brief ~BinaryFieldExporter - DTOR
+     */
+    virtual ~BinaryFieldExporter();
+
+private:
+
+    QFile m_outputFile;     /// file object for exporting
+    QDataStream m_stream;   /// stream writing to m_outputFile
+
+    /**
+     * @brief startExport - Creates and opens the output file and writes the header
+     * @param fileName - file name
+     * @return - true on success, false otherwise
+     */
+    virtual bool startExport(const QString &fileName);
+
+    /**
+     * @brief writeGroup - appends the group to the output file
+     * @param group - the values of the group
+     * @return - true on success, false otherwise
+     */
+    virtual bool writeGroup(const fieldGroup &group);
+
+    /**
+     * @brief endExport - closes the output file
+     */
+    virtual void endExport();
+};
+
 
 #endif // LOGEXPORTER_H
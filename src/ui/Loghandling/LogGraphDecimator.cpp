@@ -0,0 +1,227 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogGraphDecimator.cpp
+ * @date 17 Oct 2026
+ * @brief File providing implementation for the level of detail handling of log graphs
+ */
+
+#include "LogGraphDecimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+    // NaN values are gaps in QCustomPlot. They must never win against a real value.
+    bool isLower(double candidate, double current)
+    {
+        return std::isnan(current) ? !std::isnan(candidate) : candidate < current;
+    }
+
+    bool isHigher(double candidate, double current)
+    {
+        return std::isnan(current) ? !std::isnan(candidate) : candidate > current;
+    }
+}
+
+LogGraphDecimator::LogGraphDecimator(const QVector<double> &keys, const QVector<double> &values) :
+    m_keys(keys),
+    m_values(values),
+    m_lastBegin(-1),
+    m_lastEnd(-1),
+    m_lastLevel(-1)
+{
+    m_values.resize(m_keys.size());
+
+    if (!std::is_sorted(m_keys.constBegin(), m_keys.constEnd()))
+    {
+        QVector<int> order(m_keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&keys](int left, int right) { return keys.at(left) < keys.at(right); });
+
+        // Sort from the padded copy - values may be shorter than keys
+        const QVector<double> paddedValues = m_values;
+        for (int i = 0; i < order.size(); ++i)
+        {
+            m_keys[i] = keys.at(order.at(i));
+            m_values[i] = paddedValues.at(order.at(i));
+        }
+    }
+
+    buildLevels();
+}
+
+int LogGraphDecimator::size() const
+{
+    return m_keys.size();
+}
+
+double LogGraphDecimator::key(int index) const
+{
+    return m_keys.at(index);
+}
+
+double LogGraphDecimator::value(int index) const
+{
+    return m_values.at(index);
+}
+
+int LogGraphDecimator::findBegin(double sortKey) const
+{
+    int index = static_cast<int>(std::lower_bound(m_keys.constBegin(), m_keys.constEnd(), sortKey) - m_keys.constBegin());
+    return index > 0 ? index - 1 : 0;
+}
+
+bool LogGraphDecimator::valueRange(double &lower, double &upper) const
+{
+    lower = std::numeric_limits<double>::quiet_NaN();
+    upper = lower;
+
+    if (!m_levels.isEmpty())
+    {
+        // the top level has only a few buckets left
+        const level &top = m_levels.last();
+        for (int i = 0; i < top.m_minIndex.size(); ++i)
+        {
+            lower = isLower(m_values.at(top.m_minIndex.at(i)), lower) ? m_values.at(top.m_minIndex.at(i)) : lower;
+            upper = isHigher(m_values.at(top.m_maxIndex.at(i)), upper) ? m_values.at(top.m_maxIndex.at(i)) : upper;
+        }
+    }
+    else
+    {
+        for (const auto value : m_values)
+        {
+            lower = isLower(value, lower) ? value : lower;
+            upper = isHigher(value, upper) ? value : upper;
+        }
+    }
+
+    return !std::isnan(lower);
+}
+
+bool LogGraphDecimator::getVisibleData(double lower, double upper, int pixelWidth, QVector<double> &keys, QVector<double> &values)
+{
+    pixelWidth = pixelWidth > 0 ? pixelWidth : 1;
+
+    // one point outside on each side
+    int begin = findBegin(lower);
+    int end = static_cast<int>(std::upper_bound(m_keys.constBegin(), m_keys.constEnd(), upper) - m_keys.constBegin());
+    end = end < m_keys.size() ? end + 1 : end;
+    const int count = end - begin;
+
+    // use the coarsest level which still has at least one bucket per pixel
+    int selectedLevel = -1;
+    if (count > pixelWidth * s_PointsPerPixel)
+    {
+        for (int i = 0; i < m_levels.size() && (count / m_levels.at(i).m_bucketSize) >= pixelWidth; ++i)
+        {
+            selectedLevel = i;
+        }
+    }
+
+    if (selectedLevel >= 0)
+    {
+        const int bucketSize = m_levels.at(selectedLevel).m_bucketSize;
+        begin = begin / bucketSize;
+        end = (end - 1) / bucketSize + 1;
+    }
+
+    if (begin == m_lastBegin && end == m_lastEnd && selectedLevel == m_lastLevel)
+    {
+        return false;
+    }
+    m_lastBegin = begin;
+    m_lastEnd = end;
+    m_lastLevel = selectedLevel;
+
+    keys.clear();
+    values.clear();
+
+    if (selectedLevel < 0)
+    {
+        keys = m_keys.mid(begin, end - begin);
+        values = m_values.mid(begin, end - begin);
+        return true;
+    }
+
+    const level &selected = m_levels.at(selectedLevel);
+    keys.reserve((end - begin) * 2);
+    values.reserve((end - begin) * 2);
+    for (int bucket = begin; bucket < end; ++bucket)
+    {
+        // keep the keys sorted - the one found first is drawn first
+        const int minIndex = selected.m_minIndex.at(bucket);
+        const int maxIndex = selected.m_maxIndex.at(bucket);
+        const int firstIndex = minIndex < maxIndex ? minIndex : maxIndex;
+        const int secondIndex = minIndex < maxIndex ? maxIndex : minIndex;
+
+        keys.append(m_keys.at(firstIndex));
+        values.append(m_values.at(firstIndex));
+        if (secondIndex != firstIndex)
+        {
+            keys.append(m_keys.at(secondIndex));
+            values.append(m_values.at(secondIndex));
+        }
+    }
+    return true;
+}
+
+void LogGraphDecimator::buildLevels()
+{
+    int childCount = m_keys.size();
+    int childSize = 1;
+
+    while (childCount > s_LevelFactor)
+    {
+        level newLevel;
+        newLevel.m_bucketSize = childSize * s_LevelFactor;
+        const int bucketCount = (childCount + s_LevelFactor - 1) / s_LevelFactor;
+        newLevel.m_minIndex.resize(bucketCount);
+        newLevel.m_maxIndex.resize(bucketCount);
+
+        for (int bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            const int firstChild = bucket * s_LevelFactor;
+            const int endChild = qMin(firstChild + s_LevelFactor, childCount);
+
+            // the first level is built from the full resolution data
+            int minIndex = m_levels.isEmpty() ? firstChild : m_levels.last().m_minIndex.at(firstChild);
+            int maxIndex = m_levels.isEmpty() ? firstChild : m_levels.last().m_maxIndex.at(firstChild);
+            for (int child = firstChild + 1; child < endChild; ++child)
+            {
+                const int childMin = m_levels.isEmpty() ? child : m_levels.last().m_minIndex.at(child);
+                const int childMax = m_levels.isEmpty() ? child : m_levels.last().m_maxIndex.at(child);
+                minIndex = isLower(m_values.at(childMin), m_values.at(minIndex)) ? childMin : minIndex;
+                maxIndex = isHigher(m_values.at(childMax), m_values.at(maxIndex)) ? childMax : maxIndex;
+            }
+            newLevel.m_minIndex[bucket] = minIndex;
+            newLevel.m_maxIndex[bucket] = maxIndex;
+        }
+
+        m_levels.append(newLevel);
+        childCount = bucketCount;
+        childSize = newLevel.m_bucketSize;
+    }
+}
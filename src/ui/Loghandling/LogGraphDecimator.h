@@ -0,0 +1,143 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogGraphDecimator.h
+ * @date 17 Oct 2026
+ * @brief File providing header for the level of detail handling of log graphs
+ */
+
+#ifndef LOGGRAPHDECIMATOR_H
+#define LOGGRAPHDECIMATOR_H
+
+#include <QSharedPointer>
+#include <QVector>
+
+/**
+ * @brief The LogGraphDecimator class holds the full resolution data of one plotted
+ *        series and a min/max pyramid on top of it. Every level of the pyramid combines
+ *        s_LevelFactor buckets of the level below and stores the indices of the minimum
+ *        and maximum value of each bucket.
+ *
+ *        getVisibleData() selects the coarsest level which still delivers at least one
+ *        bucket per pixel and returns min and max of each bucket. So the graph never gets
+ *        more than 4 points per pixel, no matter how long the log is, while peaks
+ *        stay visible on every zoom level.
+ */
+class LogGraphDecimator
+{
+public:
+
+    /**
+     * @brief Ptr - shared pointer type for this class
+     */
+    typedef QSharedPointer<LogGraphDecimator> Ptr;
+
+    /**
+     * @brief LogGraphDecimator - CTOR. Builds the pyramid. Unsorted keys are sorted
+     *        the same way QCustomPlot would do it.
+     * @param keys - x values of the series
+     * @param values - y values of the series, same size as keys
+     */
+    LogGraphDecimator(const QVector<double> &keys, const QVector<double> &values);
+
+    /**
+     * @brief size - number of points in full resolution
+     * @return number of points
+     */
+    int size() const;
+
+    /**
+     * @brief key - key (x value) in full resolution
+     * @param index - index of the point
+     * @return the key
+     */
+    double key(int index) const;
+
+    /**
+     * @brief value - value (y value) in full resolution
+     * @param index - index of the point
+     * @return the value
+     */
+    double value(int index) const;
+
+    /**
+     * @brief findBegin - same as QCPGraph::findBegin() but on the full resolution data.
+     *        Returns the index of the last point with a key below sortKey.
+     * @param sortKey - key to search for
+     * @return index of the point, 0 if sortKey is before the 2nd point
+     */
+    int findBegin(double sortKey) const;
+
+    /**
+     * @brief valueRange - delivers the smallest and the biggest value of the whole series
+     * @param lower - filled with the minimum
+     * @param upper - filled with the maximum
+     * @return true if there is at least one valid value, false otherwise
+     */
+    bool valueRange(double &lower, double &upper) const;
+
+    /**
+     * @brief getVisibleData - delivers the points needed to draw the key range
+     *        lower - upper on a graph which is pixelWidth pixels wide. One point left
+     *        and right of the range is added so the line leaves the plot correctly.
+     * @param lower - lower bound of the visible key range
+     * @param upper - upper bound of the visible key range
+     * @param pixelWidth - width of the plot area in pixels
+     * @param keys - filled with the keys of the points
+     * @param values - filled with the values of the points
+     * @return true if keys and values were filled, false if the selection did not change
+     *         since the last call so the graph can keep its current data
+     */
+    bool getVisibleData(double lower, double upper, int pixelWidth, QVector<double> &keys, QVector<double> &values);
+
+private:
+
+    static const int s_LevelFactor = 2;     ///< Number of buckets of a level combined into one bucket of the next level
+    static const int s_PointsPerPixel = 2;  ///< Full resolution is used as long as there are less points per pixel
+
+    /**
+     * @brief The level struct holds one level of the pyramid
+     */
+    struct level
+    {
+        int m_bucketSize;           ///< Number of full resolution points in one bucket
+        QVector<int> m_minIndex;    ///< Index of the minimum of each bucket
+        QVector<int> m_maxIndex;    ///< Index of the maximum of each bucket
+
+        level() : m_bucketSize(0) {}
+    };
+
+    QVector<double> m_keys;     ///< Full resolution keys
+    QVector<double> m_values;   ///< Full resolution values
+    QVector<level> m_levels;    ///< The pyramid, finest level first
+
+    int m_lastBegin;            ///< First index of the last selection
+    int m_lastEnd;              ///< End index of the last selection
+    int m_lastLevel;            ///< Level of the last selection, -1 for full resolution
+
+    /**
+     * @brief buildLevels creates all levels of the pyramid
+     */
+    void buildLevels();
+};
+
+#endif // LOGGRAPHDECIMATOR_H
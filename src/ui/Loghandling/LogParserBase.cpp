@@ -245,31 +245,41 @@ bool LogParserBase::extendedStoreNameValuePairList(QList<NameValuePair> &NameVal
 
 void LogParserBase::handleTimeStamp(QList<NameValuePair> &valuepairlist, const typeDescriptor &desc)
 {
-    // read time stamp value, add time offset of prepending flight (if there was one), and store it back.
-    // Due to this we always have a increasing time value
     quint64 tempVal = static_cast<quint64>(valuepairlist.at(desc.m_timeStampIndex).second.toULongLong());
-    tempVal += m_timestampOffset;
-    valuepairlist[desc.m_timeStampIndex].second = tempVal;
+    valuepairlist[desc.m_timeStampIndex].second = handleTimeStamp(tempVal, desc.m_name);
+}
 
-    if(!m_lastValidTimePerType.contains(desc.m_name))
+quint64 LogParserBase::handleTimeStamp(quint64 timeStamp, const QString &typeName)
+{
+    auto lastValidIter = m_lastValidTimePerType.find(typeName);
+    if(lastValidIter == m_lastValidTimePerType.end())
     {
-        m_lastValidTimePerType.insert(desc.m_name, 0);
+        lastValidIter = m_lastValidTimePerType.insert(typeName, 0);
     }
+    return handleTimeStamp(timeStamp, typeName, lastValidIter.value());
+}
+
+quint64 LogParserBase::handleTimeStamp(quint64 timeStamp, const QString &typeName, quint64 &lastValidTime)
+{
+    // add time offset of prepending flight (if there was one).
+    // Due to this we always have a increasing time value
+    quint64 tempVal = timeStamp + m_timestampOffset;
+
     // store highest
     m_highestTimestamp = m_highestTimestamp < tempVal ? tempVal : m_highestTimestamp;
 
     // check if time is increasing
-    if (tempVal >= m_lastValidTimePerType[desc.m_name])
+    if (tempVal >= lastValidTime)
     {
-        m_lastValidTimePerType[desc.m_name] = tempVal;
+        lastValidTime = tempVal;
     }
     // All time jumps < 60 sec shall be treated as error
-    else if(tempVal >= m_lastValidTimePerType[desc.m_name] - 60 * m_activeTimestamp.m_divisor)
+    else if(tempVal >= lastValidTime - 60 * m_activeTimestamp.m_divisor)
     {
         if(m_timeErrorCount < 50)
         {
-            QLOG_WARN() << "Corrupt data read: Time for " << desc.m_name << " is not increasing! Last valid time stamp:"
-                        << QString::number(m_lastValidTimePerType[desc.m_name]) << " actual read time stamp is:"
+            QLOG_WARN() << "Corrupt data read: Time for " << typeName << " is not increasing! Last valid time stamp:"
+                        << QString::number(lastValidTime) << " actual read time stamp is:"
                         << QString::number(tempVal);
 
             ++m_timeErrorCount;
@@ -279,11 +289,11 @@ void LogParserBase::handleTimeStamp(QList<NameValuePair> &valuepairlist, const t
             QLOG_WARN() << "Supressing further time is not increasing messages....";
             ++m_timeErrorCount;
         }
-        m_logLoadingState.corruptTimeRead(static_cast<int>(m_MessageCounter), "Log time for " + desc.m_name +
-                                          " is not increasing! Last Time:" + QString::number(m_lastValidTimePerType[desc.m_name]) +
+        m_logLoadingState.corruptTimeRead(static_cast<int>(m_MessageCounter), "Log time for " + typeName +
+                                          " is not increasing! Last Time:" + QString::number(lastValidTime) +
                                           " new Time:" + QString::number(tempVal));
         // if not increasing set to last valid value
-        valuepairlist[desc.m_timeStampIndex].second = m_lastValidTimePerType[desc.m_name];
+        tempVal = lastValidTime;
     }
     else
     {
@@ -292,9 +302,9 @@ void LogParserBase::handleTimeStamp(QList<NameValuePair> &valuepairlist, const t
         tempVal += m_timestampOffset;
         m_highestTimestamp = tempVal;
 
-        m_lastValidTimePerType[desc.m_name] = tempVal;
-        valuepairlist[desc.m_timeStampIndex].second = tempVal;
+        lastValidTime = tempVal;
     }
+    return tempVal;
 }
 
 void LogParserBase::detectMavType(const QList<NameValuePair> &valuepairlist)
@@ -369,6 +379,11 @@ bool LogParserBase::repairMessage(QList<NameValuePair> &NameValuePairList, const
     return true;
 }
 
+quint64 LogParserBase::highestTimestamp() const
+{
+    return m_highestTimestamp;
+}
+
 quint64 LogParserBase::nextValidTimestamp()
 {
     return m_highestTimestamp - m_timestampOffset;
@@ -178,6 +178,35 @@ protected:
      */
     void handleTimeStamp(QList<NameValuePair> &valuepairlist, const typeDescriptor &desc);
 
+    /**
+     * @brief handleTimeStamp does all time stamp handling for a single time stamp value.
+     *        It checks if the time is increasing and if not it handles error generation
+     *        and offset management.
+     * @param timeStamp - the time stamp as read from the log
+     * @param typeName - name of the type the time stamp belongs to
+     * @return - the time stamp which shall be stored
+     */
+    quint64 handleTimeStamp(quint64 timeStamp, const QString &typeName);
+
+    /**
+     * @brief handleTimeStamp like above but with the last valid time stamp of the type
+     *        held by the caller. Saves the lookup by name for parsers which keep a state
+     *        per type anyway. The same type must not be handled by both variants.
+     * @param timeStamp - the time stamp as read from the log
+     * @param typeName - name of the type the time stamp belongs to. Only used for errors.
+     * @param lastValidTime - last valid time stamp of the type, 0 for a new type
+     * @return - the time stamp which shall be stored
+     */
+    quint64 handleTimeStamp(quint64 timeStamp, const QString &typeName, quint64 &lastValidTime);
+
+    /**
+     * @brief highestTimestamp delivers the biggest time stamp seen so far including the
+     *        offset of prepending flights. Used for types which do not have a time stamp.
+     *
+     * @return - the highest time stamp
+     */
+    quint64 highestTimestamp() const;
+
     /**
      * @brief detectMavType tries to detect the MAV type from the data in a
      *        value pair list.
@@ -0,0 +1,480 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogdataCache.cpp
+ * @date 17 Oct 2026
+ * @brief File providing implementation for the log data cache
+ */
+
+#include "LogdataCache.h"
+#include "LogdataMappedColumn.h"
+#include "logging.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSysInfo>
+
+namespace
+{
+    /**
+     * @brief writeVector writes a vector of plain data in native byte order
+     */
+    template <typename T>
+    void writeVector(QDataStream &stream, const QVector<T> &vector)
+    {
+        stream << static_cast<qint32>(vector.size());
+        LogdataColumn::writeRawData(stream, reinterpret_cast<const char *>(vector.constData()),
+                                    static_cast<qint64>(vector.size()) * static_cast<qint64>(sizeof(T)));
+    }
+
+    /**
+     * @brief readVector reads a vector written by writeVector()
+     */
+    template <typename T>
+    bool readVector(QDataStream &stream, QVector<T> &vector)
+    {
+        qint32 size = 0;
+        stream >> size;
+        const qint64 bytes = static_cast<qint64>(size) * static_cast<qint64>(sizeof(T));
+        // never trust the size read from a file
+        if((stream.status() != QDataStream::Ok) || (size < 0) || (bytes > stream.device()->bytesAvailable()))
+        {
+            return false;
+        }
+        vector.resize(size);
+        return LogdataColumn::readRawData(stream, reinterpret_cast<char *>(vector.data()), bytes);
+    }
+}
+
+QString LogdataCache::cacheFileName(const QString &logFileName)
+{
+    return logFileName + ".apmidx";
+}
+
+bool LogdataCache::write(const QString &logFileName, const LogdataStorage &storage, const AP2DataPlotStatus &status)
+{
+    const QByteArray cacheData = serialize(logFileName, storage, status);
+    return !cacheData.isEmpty() && writeData(logFileName, cacheData);
+}
+
+QByteArray LogdataCache::serialize(const QString &logFileName, const LogdataStorage &storage, const AP2DataPlotStatus &status)
+{
+    logFileInfo info;
+    if(!getLogFileInfo(logFileName, info))
+    {
+        return QByteArray();
+    }
+
+    QByteArray cacheData;
+    QDataStream stream(&cacheData, QIODevice::WriteOnly);
+    stream.setVersion(s_StreamVersion);
+    stream << s_Magic << s_Version << static_cast<quint8>(QSysInfo::ByteOrder);
+    stream << info.m_size << info.m_modified << info.m_hash;
+    stream << status;
+
+    if(!writeStorage(stream, storage) || (stream.status() != QDataStream::Ok))
+    {
+        QLOG_WARN() << "LogdataCache::serialize() - Unable to serialize the datamodel of " << logFileName;
+        return QByteArray();
+    }
+    return cacheData;
+}
+
+bool LogdataCache::writeData(const QString &logFileName, const QByteArray &cacheData, const std::atomic<bool> *p_abort)
+{
+    QSaveFile file(cacheFileName(logFileName));
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        QLOG_INFO() << "LogdataCache::writeData() - Unable to create cache file " << file.fileName() << ":" << file.errorString();
+        return false;
+    }
+
+    for(int pos = 0; pos < cacheData.size(); pos += s_WriteBlockSize)
+    {
+        if(p_abort && p_abort->load())
+        {
+            QLOG_DEBUG() << "LogdataCache::writeData() - Writing " << file.fileName() << " aborted";
+            file.cancelWriting();
+            return false;
+        }
+        const int blockSize = qMin(s_WriteBlockSize, cacheData.size() - pos);
+        if(file.write(cacheData.constData() + pos, blockSize) != blockSize)
+        {
+            QLOG_WARN() << "LogdataCache::writeData() - Unable to write cache file " << file.fileName() << ":" << file.errorString();
+            file.cancelWriting();
+            return false;
+        }
+    }
+    // the file is only replaced if everything was written
+    return file.commit();
+}
+
+bool LogdataCache::read(const QString &logFileName, LogdataStorage &storage, AP2DataPlotStatus &status)
+{
+    QFile file(cacheFileName(logFileName));
+    if(!file.exists() || !file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(s_StreamVersion);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint8 byteOrder = 0;
+    stream >> magic >> version >> byteOrder;
+    if((magic != s_Magic) || (version != s_Version) || (byteOrder != static_cast<quint8>(QSysInfo::ByteOrder)))
+    {
+        QLOG_INFO() << "LogdataCache::read() - Cache file " << file.fileName() << " has an unsupported format";
+        return false;
+    }
+
+    logFileInfo cachedInfo;
+    logFileInfo info;
+    stream >> cachedInfo.m_size >> cachedInfo.m_modified >> cachedInfo.m_hash;
+    if(!getLogFileInfo(logFileName, info) || (cachedInfo.m_size != info.m_size) ||
+       (cachedInfo.m_modified != info.m_modified) || (cachedInfo.m_hash != info.m_hash))
+    {
+        QLOG_INFO() << "LogdataCache::read() - Cache file " << file.fileName() << " does not match the log";
+        return false;
+    }
+
+    AP2DataPlotStatus cachedStatus;
+    stream >> cachedStatus;
+    if((stream.status() != QDataStream::Ok) || !readStorage(stream, logFileName, storage))
+    {
+        QLOG_WARN() << "LogdataCache::read() - Cache file " << file.fileName() << " is corrupt";
+        return false;
+    }
+
+    status = cachedStatus;
+    return true;
+}
+
+bool LogdataCache::getLogFileInfo(const QString &logFileName, logFileInfo &info)
+{
+    QFile logFile(logFileName);
+    if(!logFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    info.m_size = logFile.size();
+    info.m_modified = QFileInfo(logFile).lastModified().toMSecsSinceEpoch();
+
+    // Hashing the whole log would take nearly as long as parsing it. Start and end of
+    // the log together with size and modification time are good enough to detect a change.
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(logFile.read(s_HashBlockSize));
+    if(info.m_size > 2 * s_HashBlockSize)
+    {
+        logFile.seek(info.m_size - s_HashBlockSize);
+        hash.addData(logFile.read(s_HashBlockSize));
+    }
+    else if(info.m_size > s_HashBlockSize)
+    {
+        hash.addData(logFile.readAll());
+    }
+    info.m_hash = hash.result();
+    return true;
+}
+
+bool LogdataCache::writeStorage(QDataStream &stream, const LogdataStorage &storage)
+{
+    stream << static_cast<qint32>(storage.m_columnCount) << storage.m_timeStampName << storage.m_timeDivisor
+           << storage.m_minTimeStamp << storage.m_maxTimeStamp;
+
+    stream << static_cast<qint32>(storage.m_typeStorage.size());
+    for(const auto &type : storage.m_typeStorage)
+    {
+        stream << type.m_name << type.m_ID << static_cast<qint32>(type.m_length) << type.m_format << type.m_labels
+               << type.m_units << type.m_multipliers << static_cast<qint32>(type.m_timeStampIndex)
+               << static_cast<qint32>(type.m_maxIndex) << static_cast<qint32>(type.m_indexFieldIndex);
+    }
+
+    stream << storage.m_unitStorage << storage.m_multiplierStorage
+           << storage.m_typeIDToUnitFieldInfo << storage.m_typeIDToMultiplierFieldInfo;
+
+    writeVector(stream, storage.m_TimeToIndexList);
+    writeVector(stream, storage.m_indexToDataRow);
+
+    // Mapped columns of one type share their offsets - collect them so they are only stored once.
+    QVector<LogdataMappedColumn::OffsetVectorPtr> offsetVectors;
+    QHash<const LogdataMappedColumn::OffsetVector *, int> offsetVectorIds;
+    bool legacyScaling = false;
+    for(const auto &table : storage.m_dataStorage)
+    {
+        for(const auto &column : table.m_columns)
+        {
+            if(column->type() == LogdataColumn::storageType::Mapped)
+            {
+                const auto mappedColumn = qSharedPointerCast<LogdataMappedColumn>(column);
+                if(!offsetVectorIds.contains(mappedColumn->offsets().data()))
+                {
+                    offsetVectorIds.insert(mappedColumn->offsets().data(), offsetVectors.size());
+                    offsetVectors.push_back(mappedColumn->offsets());
+                }
+                legacyScaling = mappedColumn->file()->legacyScaling();
+            }
+        }
+    }
+    stream << static_cast<qint32>(offsetVectors.size()) << legacyScaling;
+    for(const auto &offsets : offsetVectors)
+    {
+        writeVector(stream, *offsets);
+    }
+
+    for(const auto &table : storage.m_dataStorage)
+    {
+        writeVector(stream, table.m_globalIndex);
+        stream << static_cast<qint32>(table.m_columns.size());
+        for(const auto &column : table.m_columns)
+        {
+            stream << static_cast<quint8>(column->type()) << static_cast<qint32>(column->size());
+            if(column->type() == LogdataColumn::storageType::Mapped)
+            {
+                const auto mappedColumn = qSharedPointerCast<LogdataMappedColumn>(column);
+                stream << static_cast<qint32>(offsetVectorIds.value(mappedColumn->offsets().data()))
+                       << static_cast<qint32>(mappedColumn->fieldOffset()) << static_cast<qint8>(mappedColumn->formatChar());
+            }
+            else
+            {
+                column->writeValues(stream);
+            }
+        }
+    }
+    return true;
+}
+
+bool LogdataCache::readStorage(QDataStream &stream, const QString &logFileName, LogdataStorage &storage)
+{
+    if(!storage.m_typeStorage.isEmpty())
+    {
+        QLOG_ERROR() << "LogdataCache::readStorage() - The datamodel is not empty";
+        return false;
+    }
+
+    // Everything is read into local containers first. The storage is only filled
+    // if the whole cache is valid.
+    qint32 columnCount = 0;
+    QString timeStampName;
+    double timeDivisor = 0.0;
+    quint64 minTimeStamp = 0;
+    quint64 maxTimeStamp = 0;
+    stream >> columnCount >> timeStampName >> timeDivisor >> minTimeStamp >> maxTimeStamp;
+
+    qint32 typeCount = 0;
+    stream >> typeCount;
+    if((stream.status() != QDataStream::Ok) || (typeCount < 0) || (typeCount > 0xFFFF))
+    {
+        return false;
+    }
+    QVector<LogdataStorage::dataType> typeStorage(typeCount);
+    for(auto &type : typeStorage)
+    {
+        qint32 length = 0;
+        qint32 timeStampIndex = 0;
+        qint32 maxIndex = 0;
+        qint32 indexFieldIndex = 0;
+        stream >> type.m_name >> type.m_ID >> length >> type.m_format >> type.m_labels
+               >> type.m_units >> type.m_multipliers >> timeStampIndex >> maxIndex >> indexFieldIndex;
+        type.m_length = length;
+        type.m_timeStampIndex = timeStampIndex;
+        type.m_maxIndex = maxIndex;
+        type.m_indexFieldIndex = indexFieldIndex;
+    }
+
+    QHash<quint8, QString> unitStorage;
+    QHash<quint8, double> multiplierStorage;
+    QHash<quint32, QByteArray> typeIDToUnitFieldInfo;
+    QHash<quint32, QByteArray> typeIDToMultiplierFieldInfo;
+    stream >> unitStorage >> multiplierStorage >> typeIDToUnitFieldInfo >> typeIDToMultiplierFieldInfo;
+
+    QVector<LogdataStorage::TimeStampToIndexPair> timeToIndexList;
+    QVector<LogdataStorage::TypeRowPair> indexToDataRow;
+    if(!readVector(stream, timeToIndexList) || !readVector(stream, indexToDataRow))
+    {
+        return false;
+    }
+
+    qint32 offsetVectorCount = 0;
+    bool legacyScaling = false;
+    stream >> offsetVectorCount >> legacyScaling;
+    if((stream.status() != QDataStream::Ok) || (offsetVectorCount < 0) || (offsetVectorCount > typeCount))
+    {
+        return false;
+    }
+    LogdataMappedFile::Ptr mappedFilePtr;
+    QVector<LogdataMappedColumn::OffsetVectorPtr> offsetVectors;
+    QVector<qint64> maxOffsets;     /// highest offset of every offset vector
+    if(offsetVectorCount > 0)
+    {
+        mappedFilePtr = LogdataMappedFile::Ptr(new LogdataMappedFile(logFileName));
+        if(!mappedFilePtr->map())
+        {
+            return false;
+        }
+        mappedFilePtr->setLegacyScaling(legacyScaling);
+    }
+    for(int i = 0; i < offsetVectorCount; ++i)
+    {
+        LogdataMappedColumn::OffsetVectorPtr offsetsPtr(new LogdataMappedColumn::OffsetVector());
+        if(!readVector(stream, *offsetsPtr))
+        {
+            return false;
+        }
+        // Every offset must point into the log, a truncated cache must not lead to reads outside
+        qint64 maxOffset = 0;
+        for(const auto offset : *offsetsPtr)
+        {
+            if((offset < 0) || (offset >= mappedFilePtr->size()))
+            {
+                return false;
+            }
+            maxOffset = qMax(maxOffset, static_cast<qint64>(offset));
+        }
+        maxOffsets.push_back(maxOffset);
+        offsetVectors.push_back(offsetsPtr);
+    }
+
+    QVector<LogdataStorage::DataTable> dataStorage(typeCount);
+    for(int typeIndex = 0; typeIndex < typeCount; ++typeIndex)
+    {
+        LogdataStorage::DataTable &table = dataStorage[typeIndex];
+        qint32 tableColumnCount = 0;
+        if(!readVector(stream, table.m_globalIndex))
+        {
+            return false;
+        }
+        // Every row must be referenced by the global index and vice versa
+        for(int row = 0; row < table.m_globalIndex.size(); ++row)
+        {
+            const int globalIndex = table.m_globalIndex.at(row);
+            if((globalIndex < 0) || (globalIndex >= indexToDataRow.size()) ||
+               (indexToDataRow.at(globalIndex).m_typeIndex != typeIndex) ||
+               (indexToDataRow.at(globalIndex).m_row != row))
+            {
+                return false;
+            }
+        }
+        // The datamodel accesses the columns by label index, so every label needs its column.
+        // Only tables without rows have no columns at all.
+        const LogdataStorage::dataType &type = typeStorage.at(typeIndex);
+        const int labelCount = type.m_labels.size();
+        stream >> tableColumnCount;
+        if((stream.status() != QDataStream::Ok) ||
+           ((tableColumnCount != labelCount) && ((tableColumnCount != 0) || (table.rowCount() != 0))))
+        {
+            return false;
+        }
+        if((tableColumnCount > 0) &&
+           ((type.m_timeStampIndex < 0) || (type.m_timeStampIndex >= labelCount) ||
+            ((type.m_maxIndex != 0) && ((type.m_indexFieldIndex < 0) || (type.m_indexFieldIndex >= labelCount)))))
+        {
+            return false;
+        }
+        for(int i = 0; i < tableColumnCount; ++i)
+        {
+            quint8 type = 0;
+            qint32 size = 0;
+            stream >> type >> size;
+            if((stream.status() != QDataStream::Ok) || (size != table.rowCount()) ||
+               (type > static_cast<quint8>(LogdataColumn::storageType::Mapped)))
+            {
+                return false;
+            }
+
+            LogdataColumn::Ptr column;
+            if(static_cast<LogdataColumn::storageType>(type) == LogdataColumn::storageType::Mapped)
+            {
+                qint32 offsetVectorId = 0;
+                qint32 fieldOffset = 0;
+                qint8 formatChar = 0;
+                stream >> offsetVectorId >> fieldOffset >> formatChar;
+                if((offsetVectorId < 0) || (offsetVectorId >= offsetVectors.size()) || (fieldOffset < 0) ||
+                   (offsetVectors.at(offsetVectorId)->size() != size) ||
+                   ((maxOffsets.at(offsetVectorId) + fieldOffset + LogdataMappedColumn::fieldSize(formatChar)) > mappedFilePtr->size()))
+                {
+                    return false;   // would read outside the mapped file
+                }
+                column = LogdataColumn::Ptr(new LogdataMappedColumn(mappedFilePtr, offsetVectors.at(offsetVectorId),
+                                                                    fieldOffset, formatChar));
+            }
+            else
+            {
+                column = LogdataColumn::create(static_cast<LogdataColumn::storageType>(type));
+                const bool isNumberColumn = (column->type() != LogdataColumn::storageType::String) &&
+                                            (column->type() != LogdataColumn::storageType::Variant);
+                if(isNumberColumn && ((column->bytesPerValue() * static_cast<qint64>(size)) > stream.device()->bytesAvailable()))
+                {
+                    return false;   // never trust the size read from a file
+                }
+            }
+            if(!column->readValues(stream, size))
+            {
+                return false;
+            }
+            table.m_columns.push_back(column);
+        }
+    }
+
+    // check the global index so a corrupt cache cannot crash the datamodel
+    for(const auto &typeRow : indexToDataRow)
+    {
+        if((typeRow.m_typeIndex < 0) || (typeRow.m_typeIndex >= typeCount) || (typeRow.m_row < 0) ||
+           (typeRow.m_row >= dataStorage.at(typeRow.m_typeIndex).rowCount()))
+        {
+            return false;
+        }
+    }
+    for(const auto &timeIndex : timeToIndexList)
+    {
+        if((timeIndex.second < 0) || (timeIndex.second >= indexToDataRow.size()))
+        {
+            return false;
+        }
+    }
+
+    storage.m_columnCount = columnCount;
+    storage.m_currentRow = 0;
+    storage.m_timeStampName = timeStampName;
+    storage.m_timeDivisor = timeDivisor;
+    storage.m_minTimeStamp = minTimeStamp;
+    storage.m_maxTimeStamp = maxTimeStamp;
+    storage.m_TimeToIndexList = timeToIndexList;
+    storage.m_typeStorage = typeStorage;
+    storage.m_typeNameToIndex.clear();
+    for(int typeIndex = 0; typeIndex < typeStorage.size(); ++typeIndex)
+    {
+        storage.m_typeNameToIndex.insert(typeStorage.at(typeIndex).m_name, typeIndex);
+    }
+    storage.m_dataStorage = dataStorage;
+    storage.m_indexToDataRow = indexToDataRow;
+    storage.m_unitStorage = unitStorage;
+    storage.m_multiplierStorage = multiplierStorage;
+    storage.m_typeIDToUnitFieldInfo = typeIDToUnitFieldInfo;
+    storage.m_typeIDToMultiplierFieldInfo = typeIDToMultiplierFieldInfo;
+    return true;
+}
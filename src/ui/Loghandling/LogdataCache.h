@@ -0,0 +1,149 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogdataCache.h
+ * @date 17 Oct 2026
+ * @brief File providing header for the log data cache
+ */
+
+#ifndef LOGDATACACHE_H
+#define LOGDATACACHE_H
+
+#include <QString>
+#include <QDataStream>
+#include <atomic>
+#include "LogdataStorage.h"
+#include "AP2DataPlotStatus.h"
+
+/**
+ * @brief The LogdataCache class stores the content of a LogdataStorage and the
+ *        AP2DataPlotStatus of a parsed log in a sidecar file next to the log
+ *        (<log>.apmidx). When the same log is opened again the datamodel can be
+ *        restored from this file without parsing the log.
+ *
+ *        The cache is only used if the size, the modification time and a hash over the
+ *        first and the last MB of the log match. Columns which read their values from a
+ *        memory mapped log only store their offsets - the log is mapped again when
+ *        reading the cache.
+ *
+ *        The file is written in native byte order and is not meant to be exchanged
+ *        between machines. Increase s_Version whenever the format changes.
+ */
+class LogdataCache
+{
+public:
+
+    /**
+     * @brief cacheFileName delivers the name of the cache file for a log
+     * @param logFileName - name of the log file
+     * @return name of the cache file
+     */
+    static QString cacheFileName(const QString &logFileName);
+
+    /**
+     * @brief write writes the cache file for a log. Errors are only logged as
+     *        a missing cache just leads to parsing the log again.
+     * @param logFileName - name of the parsed log file
+     * @param storage - the datamodel filled by parsing the log
+     * @param status - the status of the parsing
+     * @return true - success, false otherwise
+     */
+    static bool write(const QString &logFileName, const LogdataStorage &storage, const AP2DataPlotStatus &status);
+
+    /**
+     * @brief serialize creates the content of the cache file for a log. This is a
+     *        snapshot of the datamodel which can be written by writeData() while
+     *        the datamodel is already in use.
+     * @param logFileName - name of the parsed log file
+     * @param storage - the datamodel filled by parsing the log
+     * @param status - the status of the parsing
+     * @return the content of the cache file, empty on error
+     */
+    static QByteArray serialize(const QString &logFileName, const LogdataStorage &storage, const AP2DataPlotStatus &status);
+
+    /**
+     * @brief writeData writes the content created by serialize() to the cache file
+     *        of a log. The data is written in blocks and the writing can be aborted
+     *        between them - an existing cache file is not changed then.
+     * @param logFileName - name of the parsed log file
+     * @param cacheData - content created by serialize()
+     * @param p_abort - checked before every block, may be nullptr
+     * @return true - success, false otherwise
+     */
+    static bool writeData(const QString &logFileName, const QByteArray &cacheData, const std::atomic<bool> *p_abort = nullptr);
+
+    /**
+     * @brief read restores the datamodel and the parsing status of a log from its
+     *        cache file. The storage is only changed if the whole cache could be read.
+     * @param logFileName - name of the log file
+     * @param storage - an empty datamodel to be filled
+     * @param status - filled with the status of the parsing
+     * @return true - success, false no valid cache for this log
+     */
+    static bool read(const QString &logFileName, LogdataStorage &storage, AP2DataPlotStatus &status);
+
+private:
+
+    static const quint32 s_Magic   = 0x41504D49;     /// "APMI" - marks a cache file
+    static const quint32 s_Version = 1;              /// Version of the file format
+    static const qint64  s_HashBlockSize = 1 << 20;  /// Bytes at the start and the end of the log used for the hash
+    static const int     s_WriteBlockSize = 4 << 20; /// Bytes written at once by writeData()
+    static const QDataStream::Version s_StreamVersion = QDataStream::Qt_5_0;    /// Version used for the Qt types
+
+    /**
+     * @brief The logFileInfo struct holds the data used to detect whether a
+     *        cache matches its log.
+     */
+    struct logFileInfo
+    {
+        qint64 m_size = 0;          /// size of the log in bytes
+        qint64 m_modified = 0;      /// modification time in ms since epoch
+        QByteArray m_hash;          /// hash over the start and the end of the log
+    };
+
+    /**
+     * @brief getLogFileInfo collects the info of a log file
+     * @param logFileName - name of the log file
+     * @param info - filled with the info
+     * @return true - success, false file could not be read
+     */
+    static bool getLogFileInfo(const QString &logFileName, logFileInfo &info);
+
+    /**
+     * @brief writeStorage writes the content of the datamodel
+     * @param stream - the stream to write to
+     * @param storage - the datamodel to write
+     * @return true - success, false the datamodel contains a column which cannot be stored
+     */
+    static bool writeStorage(QDataStream &stream, const LogdataStorage &storage);
+
+    /**
+     * @brief readStorage reads the content of a datamodel written by writeStorage()
+     * @param stream - the stream to read from
+     * @param logFileName - name of the log file. Needed for memory mapped columns.
+     * @param storage - the datamodel to fill
+     * @return true - success, false otherwise
+     */
+    static bool readStorage(QDataStream &stream, const QString &logFileName, LogdataStorage &storage);
+};
+
+#endif // LOGDATACACHE_H
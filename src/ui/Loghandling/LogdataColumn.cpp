@@ -0,0 +1,354 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogdataColumn.cpp
+ * @date 17 Oct 2026
+ * @brief File providing implementation for the typed column containers
+ */
+
+#include "LogdataColumn.h"
+
+namespace
+{
+bool isFloatingPoint(const QVariant &value)
+{
+    const int type = value.userType();
+    return (type == QMetaType::Double) || (type == QMetaType::Float);
+}
+
+bool isIntegral(LogdataColumn::storageType type)
+{
+    return (type >= LogdataColumn::storageType::Int8) && (type <= LogdataColumn::storageType::UInt64);
+}
+}
+
+LogdataColumn::Ptr LogdataColumn::create(char formatChar, const QVariant &firstValue)
+{
+    // Some parsers deliver strings for fields which are numbers in other log types
+    // (like the 'M' mode field in ascii logs). Those need a string column.
+    if(firstValue.type() == QVariant::String)
+    {
+        return Ptr(new LogdataStringColumn());
+    }
+
+    Ptr column = create(formatChar);
+    widenForValue(column, firstValue);
+    return column;
+}
+
+LogdataColumn::Ptr LogdataColumn::create(char formatChar)
+{
+    switch(formatChar)
+    {
+    case 'b':   // int8_t
+        return Ptr(new LogdataTypedColumn<qint8>());
+    case 'M':   // flight mode - int8_t in binary logs but uint8_t in tlogs
+        return Ptr(new LogdataTypedColumn<qint16>());
+    case 'B':   // uint8_t
+        return Ptr(new LogdataTypedColumn<quint8>());
+    case 'h':   // int16_t
+        return Ptr(new LogdataTypedColumn<qint16>());
+    case 'H':   // uint16_t
+        return Ptr(new LogdataTypedColumn<quint16>());
+    case 'i':   // int32_t
+        return Ptr(new LogdataTypedColumn<qint32>());
+    case 'I':   // uint32_t
+        return Ptr(new LogdataTypedColumn<quint32>());
+    case 'q':   // int64_t
+        return Ptr(new LogdataTypedColumn<qint64>());
+    case 'Q':   // uint64_t
+        return Ptr(new LogdataTypedColumn<quint64>());
+    case 'f':   // float
+        return Ptr(new LogdataTypedColumn<float>());
+    case 'd':   // double
+    case 'c':   // int16_t * 100 - parsers deliver them already as double
+    case 'C':   // uint16_t * 100
+    case 'e':   // int32_t * 100
+    case 'E':   // uint32_t * 100
+    case 'L':   // int32_t lat / lon
+        return Ptr(new LogdataTypedColumn<double>());
+    case 'n':   // char[4]
+    case 'N':   // char[16]
+    case 'Z':   // char[64]
+        return Ptr(new LogdataStringColumn());
+    default:    // arrays ('a') and unknown types
+        return Ptr(new LogdataVariantColumn());
+    }
+}
+
+LogdataColumn::Ptr LogdataColumn::create(storageType type)
+{
+    switch(type)
+    {
+    case storageType::Int8:
+        return Ptr(new LogdataTypedColumn<qint8>());
+    case storageType::UInt8:
+        return Ptr(new LogdataTypedColumn<quint8>());
+    case storageType::Int16:
+        return Ptr(new LogdataTypedColumn<qint16>());
+    case storageType::UInt16:
+        return Ptr(new LogdataTypedColumn<quint16>());
+    case storageType::Int32:
+        return Ptr(new LogdataTypedColumn<qint32>());
+    case storageType::UInt32:
+        return Ptr(new LogdataTypedColumn<quint32>());
+    case storageType::Int64:
+        return Ptr(new LogdataTypedColumn<qint64>());
+    case storageType::UInt64:
+        return Ptr(new LogdataTypedColumn<quint64>());
+    case storageType::Float:
+        return Ptr(new LogdataTypedColumn<float>());
+    case storageType::Double:
+        return Ptr(new LogdataTypedColumn<double>());
+    case storageType::String:
+        return Ptr(new LogdataStringColumn());
+    case storageType::Variant:
+        return Ptr(new LogdataVariantColumn());
+    default:    // mapped columns need a mapped file
+        return Ptr();
+    }
+}
+
+bool LogdataColumn::widenForValue(Ptr &column, const QVariant &value)
+{
+    if(!isFloatingPoint(value) || !isIntegral(column->type()))
+    {
+        return false;
+    }
+
+    QVector<double> values;
+    column->copyToDouble(values);
+    auto *doubleColumn = new LogdataTypedColumn<double>();
+    doubleColumn->reserve(values.size());
+    for(const double storedValue : values)
+    {
+        doubleColumn->appendValue(storedValue);
+    }
+    column = Ptr(doubleColumn);
+    return true;
+}
+
+void LogdataColumn::writeRawData(QDataStream &stream, const char *data, qint64 size)
+{
+    // QDataStream can only handle int sized blocks
+    static constexpr qint64 s_maxBlockSize {1 << 30};
+    while(size > 0)
+    {
+        const int blockSize = static_cast<int>(qMin(size, s_maxBlockSize));
+        stream.writeRawData(data, blockSize);
+        data += blockSize;
+        size -= blockSize;
+    }
+}
+
+bool LogdataColumn::readRawData(QDataStream &stream, char *data, qint64 size)
+{
+    static constexpr qint64 s_maxBlockSize {1 << 30};
+    while(size > 0)
+    {
+        const int blockSize = static_cast<int>(qMin(size, s_maxBlockSize));
+        if(stream.readRawData(data, blockSize) != blockSize)
+        {
+            return false;
+        }
+        data += blockSize;
+        size -= blockSize;
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+//****************************************************
+
+int LogdataStringColumn::size() const
+{
+    return m_values.size();
+}
+
+void LogdataStringColumn::reserve(int size)
+{
+    m_values.reserve(size);
+}
+
+void LogdataStringColumn::squeeze()
+{
+    m_values.squeeze();
+    m_internedValues.squeeze();
+}
+
+void LogdataStringColumn::append(const QVariant &value)
+{
+    const QString string = value.toString();
+    auto iter = m_internedValues.constFind(string);
+    if(iter == m_internedValues.constEnd())
+    {
+        iter = m_internedValues.insert(string);
+    }
+    m_values.push_back(*iter);   // implicitly shared with the interned one
+}
+
+QVariant LogdataStringColumn::value(int row) const
+{
+    return {m_values.at(row)};
+}
+
+double LogdataStringColumn::toDouble(int row) const
+{
+    return m_values.at(row).toDouble();
+}
+
+void LogdataStringColumn::copyToDouble(QVector<double> &target) const
+{
+    target.reserve(target.size() + m_values.size());
+    for(const auto &value : m_values)
+    {
+        target.push_back(value.toDouble());
+    }
+}
+
+void LogdataStringColumn::copyToDouble(QVector<double> &target, const QVector<int> &rows) const
+{
+    target.reserve(target.size() + rows.size());
+    for(const int row : rows)
+    {
+        target.push_back(m_values.at(row).toDouble());
+    }
+}
+
+bool LogdataStringColumn::isNumeric() const
+{
+    return false;
+}
+
+int LogdataStringColumn::bytesPerValue() const
+{
+    return static_cast<int>(sizeof(QString));
+}
+
+LogdataColumn::storageType LogdataStringColumn::type() const
+{
+    return storageType::String;
+}
+
+void LogdataStringColumn::writeValues(QDataStream &stream) const
+{
+    for(const auto &value : m_values)
+    {
+        stream << value;
+    }
+}
+
+bool LogdataStringColumn::readValues(QDataStream &stream, int count)
+{
+    m_values.reserve(m_values.size() + count);
+    QString value;
+    for(int i = 0; i < count; ++i)
+    {
+        stream >> value;
+        append(value);  // does the interning
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+//****************************************************
+
+int LogdataVariantColumn::size() const
+{
+    return m_values.size();
+}
+
+void LogdataVariantColumn::reserve(int size)
+{
+    m_values.reserve(size);
+}
+
+void LogdataVariantColumn::squeeze()
+{
+    m_values.squeeze();
+}
+
+void LogdataVariantColumn::append(const QVariant &value)
+{
+    m_values.push_back(value);
+}
+
+QVariant LogdataVariantColumn::value(int row) const
+{
+    return m_values.at(row);
+}
+
+double LogdataVariantColumn::toDouble(int row) const
+{
+    return m_values.at(row).toDouble();
+}
+
+void LogdataVariantColumn::copyToDouble(QVector<double> &target) const
+{
+    target.reserve(target.size() + m_values.size());
+    for(const auto &value : m_values)
+    {
+        target.push_back(value.toDouble());
+    }
+}
+
+void LogdataVariantColumn::copyToDouble(QVector<double> &target, const QVector<int> &rows) const
+{
+    target.reserve(target.size() + rows.size());
+    for(const int row : rows)
+    {
+        target.push_back(m_values.at(row).toDouble());
+    }
+}
+
+bool LogdataVariantColumn::isNumeric() const
+{
+    return false;
+}
+
+int LogdataVariantColumn::bytesPerValue() const
+{
+    return static_cast<int>(sizeof(QVariant));
+}
+
+LogdataColumn::storageType LogdataVariantColumn::type() const
+{
+    return storageType::Variant;
+}
+
+void LogdataVariantColumn::writeValues(QDataStream &stream) const
+{
+    for(const auto &value : m_values)
+    {
+        stream << value;
+    }
+}
+
+bool LogdataVariantColumn::readValues(QDataStream &stream, int count)
+{
+    m_values.reserve(m_values.size() + count);
+    QVariant value;
+    for(int i = 0; i < count; ++i)
+    {
+        stream >> value;
+        m_values.push_back(value);
+    }
+    return stream.status() == QDataStream::Ok;
+}
@@ -0,0 +1,405 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogdataColumn.h
+ * @date 17 Oct 2026
+ * @brief File providing the typed column containers used by the LogdataStorage
+ */
+
+#ifndef LOGDATACOLUMN_H
+#define LOGDATACOLUMN_H
+
+#include <QSharedPointer>
+#include <QDataStream>
+#include <QVariant>
+#include <QVector>
+#include <QString>
+#include <QSet>
+
+/**
+ * @brief The LogdataColumn class is the interface for one column of a data type
+ *        in the LogdataStorage. Every column holds the values of one label (FMT field)
+ *        in one contiguous array using the native width of the field. So a 'h' field
+ *        only needs 2 bytes per sample instead of a whole QVariant.
+ *
+ *        Use the create() factory to get the right column for a format character.
+ */
+class LogdataColumn
+{
+public:
+
+    /**
+     * @brief Ptr - shared pointer type for this class
+     */
+    using Ptr = QSharedPointer<LogdataColumn>;
+
+    /**
+     * @brief The storageType enum identifies how a column stores its values.
+     *        Used to recreate a column when reading it from a stream.
+     */
+    enum class storageType : quint8
+    {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float,
+        Double,
+        String,
+        Variant,
+        Mapped      /// values are not stored in the column but in a mapped file
+    };
+
+    /**
+     * @brief ~LogdataColumn - DTOR
+     */
+    virtual ~LogdataColumn() {}
+
+    /**
+     * @brief create - factory for columns. Selects the storage type by the format character
+     *        of the field. Some format characters are used differently by the parsers (like 'M'
+     *        which is a number in binary logs and a string in ascii logs). Therefore the type of
+     *        the first value is used to decide whether a string column is needed. Integer
+     *        fields delivered as floating point numbers get a double column.
+     * @param formatChar - format character of the field like 'f' or 'Q'
+     * @param firstValue - the first value which will be stored in this column
+     * @return - Pointer to the new column
+     */
+    static Ptr create(char formatChar, const QVariant &firstValue);
+
+    /**
+     * @brief create - factory for columns with a known storage type.
+     * @param type - the storage type of the column
+     * @return - Pointer to the new column, a null pointer for storageType::Mapped
+     *           as those need a mapped file.
+     */
+    static Ptr create(storageType type);
+
+    /**
+     * @brief widenForValue replaces an integer column by a double column holding the
+     *        same values if a floating point value shall be appended. So a column whose
+     *        first values were integral does not truncate later doubles.
+     * @param column - the column, replaced if needed
+     * @param value - the value which will be appended next
+     * @return true if the column was replaced
+     */
+    static bool widenForValue(Ptr &column, const QVariant &value);
+
+    /**
+     * @brief writeRawData writes a memory block to a stream. In contrast to
+     *        QDataStream::writeRawData() the block may be bigger than 2GB.
+     * @param stream - the stream to write to
+     * @param data - pointer to the first byte
+     * @param size - number of bytes to write
+     */
+    static void writeRawData(QDataStream &stream, const char *data, qint64 size);
+
+    /**
+     * @brief readRawData reads a memory block from a stream written by writeRawData().
+     * @param stream - the stream to read from
+     * @param data - pointer to the memory to fill
+     * @param size - number of bytes to read
+     * @return true - success, false - not enough data in stream
+     */
+    static bool readRawData(QDataStream &stream, char *data, qint64 size);
+
+    /**
+     * @brief size delivers the number of stored values
+     * @return number of values in this column
+     */
+    virtual int size() const = 0;
+
+    /**
+     * @brief reserve reserves memory for the given number of values
+     * @param size - number of values
+     */
+    virtual void reserve(int size) = 0;
+
+    /**
+     * @brief squeeze releases the memory not needed to store the current values.
+     *        Should be called after parsing is done.
+     */
+    virtual void squeeze() = 0;
+
+    /**
+     * @brief append converts the value to the type of the column and adds it
+     * @param value - the value to store
+     */
+    virtual void append(const QVariant &value) = 0;
+
+    /**
+     * @brief value delivers the value at row as QVariant. Only use it if the
+     *        value is really needed as variant like in the table model.
+     * @param row - row of the value
+     * @return the value as QVariant
+     */
+    virtual QVariant value(int row) const = 0;
+
+    /**
+     * @brief toDouble delivers the value at row converted to double.
+     * @param row - row of the value
+     * @return the value as double
+     */
+    virtual double toDouble(int row) const = 0;
+
+    /**
+     * @brief copyToDouble appends all values of the column converted to double
+     *        to the target vector.
+     * @param target - the vector to append to
+     */
+    virtual void copyToDouble(QVector<double> &target) const = 0;
+
+    /**
+     * @brief copyToDouble appends the values of the selected rows converted to double
+     *        to the target vector.
+     * @param target - the vector to append to
+     * @param rows - the rows to copy. Must be valid rows of this column.
+     */
+    virtual void copyToDouble(QVector<double> &target, const QVector<int> &rows) const = 0;
+
+    /**
+     * @brief isNumeric
+     * @return true if the column holds numbers and can be plotted, false otherwise
+     */
+    virtual bool isNumeric() const = 0;
+
+    /**
+     * @brief bytesPerValue delivers the number of bytes used to store one value.
+     *        For strings this is only the size of the reference.
+     * @return bytes per value
+     */
+    virtual int bytesPerValue() const = 0;
+
+    /**
+     * @brief type
+     * @return the storage type of this column
+     */
+    virtual storageType type() const = 0;
+
+    /**
+     * @brief writeValues writes all values of the column to a stream.
+     *        Numbers are written in native byte order.
+     * @param stream - the stream to write to
+     */
+    virtual void writeValues(QDataStream &stream) const = 0;
+
+    /**
+     * @brief readValues appends values written by writeValues() to the column.
+     * @param stream - the stream to read from
+     * @param count - number of values to read
+     * @return true - success, false - stream error
+     */
+    virtual bool readValues(QDataStream &stream, int count) = 0;
+
+private:
+
+    /**
+     * @brief create - selects the storage type by the format character only
+     * @param formatChar - format character of the field like 'f' or 'Q'
+     * @return - Pointer to the new column
+     */
+    static Ptr create(char formatChar);
+};
+
+/**
+ * @brief The LogdataColumnType struct maps the value type of a LogdataTypedColumn
+ *        to its storage type.
+ */
+template <typename T> struct LogdataColumnType;
+template <> struct LogdataColumnType<qint8>   { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::Int8; };
+template <> struct LogdataColumnType<quint8>  { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::UInt8; };
+template <> struct LogdataColumnType<qint16>  { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::Int16; };
+template <> struct LogdataColumnType<quint16> { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::UInt16; };
+template <> struct LogdataColumnType<qint32>  { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::Int32; };
+template <> struct LogdataColumnType<quint32> { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::UInt32; };
+template <> struct LogdataColumnType<qint64>  { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::Int64; };
+template <> struct LogdataColumnType<quint64> { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::UInt64; };
+template <> struct LogdataColumnType<float>   { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::Float; };
+template <> struct LogdataColumnType<double>  { static constexpr LogdataColumn::storageType value = LogdataColumn::storageType::Double; };
+
+/**
+ * @brief The LogdataTypedColumn class stores numbers of type T in one QVector.
+ */
+template <typename T>
+class LogdataTypedColumn : public LogdataColumn
+{
+public:
+
+    int size() const override
+    {
+        return m_values.size();
+    }
+
+    void reserve(int size) override
+    {
+        m_values.reserve(size);
+    }
+
+    void squeeze() override
+    {
+        m_values.squeeze();
+    }
+
+    void append(const QVariant &value) override
+    {
+        m_values.push_back(value.value<T>());
+    }
+
+    QVariant value(int row) const override
+    {
+        // Same overload resolution as the parsers use when creating the variant
+        return QVariant(m_values.at(row));
+    }
+
+    double toDouble(int row) const override
+    {
+        return static_cast<double>(m_values.at(row));
+    }
+
+    void copyToDouble(QVector<double> &target) const override
+    {
+        target.reserve(target.size() + m_values.size());
+        for(const T value : m_values)
+        {
+            target.push_back(static_cast<double>(value));
+        }
+    }
+
+    void copyToDouble(QVector<double> &target, const QVector<int> &rows) const override
+    {
+        target.reserve(target.size() + rows.size());
+        for(const int row : rows)
+        {
+            target.push_back(static_cast<double>(m_values.at(row)));
+        }
+    }
+
+    bool isNumeric() const override
+    {
+        return true;
+    }
+
+    int bytesPerValue() const override
+    {
+        return static_cast<int>(sizeof(T));
+    }
+
+    storageType type() const override
+    {
+        return LogdataColumnType<T>::value;
+    }
+
+    void writeValues(QDataStream &stream) const override
+    {
+        writeRawData(stream, reinterpret_cast<const char *>(m_values.constData()),
+                     static_cast<qint64>(m_values.size()) * static_cast<qint64>(sizeof(T)));
+    }
+
+    bool readValues(QDataStream &stream, int count) override
+    {
+        const int oldSize = m_values.size();
+        m_values.resize(oldSize + count);
+        return readRawData(stream, reinterpret_cast<char *>(m_values.data() + oldSize),
+                           static_cast<qint64>(count) * static_cast<qint64>(sizeof(T)));
+    }
+
+    /**
+     * @brief appendValue adds a value without any conversion
+     * @param value - the value to store
+     */
+    void appendValue(const T value)
+    {
+        m_values.push_back(value);
+    }
+
+    /**
+     * @brief values gives direct read access to the stored data
+     * @return reference to the data vector
+     */
+    const QVector<T> &values() const
+    {
+        return m_values;
+    }
+
+private:
+    QVector<T> m_values;    /// Holds the data
+};
+
+/**
+ * @brief The LogdataStringColumn class stores strings. As strings in logs repeat very
+ *        often (parameter names, modes, messages) all strings are interned so equal strings
+ *        share their memory.
+ */
+class LogdataStringColumn : public LogdataColumn
+{
+public:
+
+    int size() const override;
+    void reserve(int size) override;
+    void squeeze() override;
+    void append(const QVariant &value) override;
+    QVariant value(int row) const override;
+    double toDouble(int row) const override;
+    void copyToDouble(QVector<double> &target) const override;
+    void copyToDouble(QVector<double> &target, const QVector<int> &rows) const override;
+    bool isNumeric() const override;
+    int bytesPerValue() const override;
+    storageType type() const override;
+    void writeValues(QDataStream &stream) const override;
+    bool readValues(QDataStream &stream, int count) override;
+
+private:
+    QVector<QString> m_values;      /// Holds the data
+    QSet<QString> m_internedValues; /// All different strings of this column
+};
+
+/**
+ * @brief The LogdataVariantColumn class is the fallback for all fields which cannot
+ *        be stored in a typed column like arrays ('a' format).
+ */
+class LogdataVariantColumn : public LogdataColumn
+{
+public:
+
+    int size() const override;
+    void reserve(int size) override;
+    void squeeze() override;
+    void append(const QVariant &value) override;
+    QVariant value(int row) const override;
+    double toDouble(int row) const override;
+    void copyToDouble(QVector<double> &target) const override;
+    void copyToDouble(QVector<double> &target, const QVector<int> &rows) const override;
+    bool isNumeric() const override;
+    int bytesPerValue() const override;
+    storageType type() const override;
+    void writeValues(QDataStream &stream) const override;
+    bool readValues(QDataStream &stream, int count) override;
+
+private:
+    QVector<QVariant> m_values;     /// Holds the data
+};
+
+#endif // LOGDATACOLUMN_H
@@ -0,0 +1,368 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogdataMappedColumn.cpp
+ * @date 17 Oct 2026
+ * @brief File providing implementation for the memory mapped log column
+ */
+
+#include "LogdataMappedColumn.h"
+#include "logging.h"
+
+#include <QtEndian>
+#include <cstring>
+
+namespace
+{
+    template <typename T>
+    inline T readLittleEndian(const char *data)
+    {
+        return qFromLittleEndian<T>(reinterpret_cast<const uchar *>(data));
+    }
+
+    inline float readFloat(const char *data)
+    {
+        const quint32 raw = readLittleEndian<quint32>(data);
+        float value;
+        std::memcpy(&value, &raw, sizeof(value));
+        // store a Qt quiet NaN in any case which can be handled correctly by the graphing toolset
+        return qIsNaN(value) ? static_cast<float>(qQNaN()) : value;
+    }
+
+    inline double readDouble(const char *data)
+    {
+        const quint64 raw = readLittleEndian<quint64>(data);
+        double value;
+        std::memcpy(&value, &raw, sizeof(value));
+        return qIsNaN(value) ? qQNaN() : value;
+    }
+}
+
+LogdataMappedFile::LogdataMappedFile(const QString &fileName) :
+    m_file(fileName),
+    mp_data(nullptr),
+    m_size(0),
+    m_legacyScaling(false)
+{}
+
+LogdataMappedFile::~LogdataMappedFile()
+{
+    if(mp_data != nullptr)
+    {
+        m_file.unmap(mp_data);
+    }
+    m_file.close();
+}
+
+bool LogdataMappedFile::map()
+{
+    if(!m_file.open(QIODevice::ReadOnly))
+    {
+        QLOG_WARN() << "LogdataMappedFile::map() - Unable to open " << m_file.fileName() << ":" << m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    mp_data = m_file.map(0, m_size);
+    if(mp_data == nullptr)
+    {
+        QLOG_WARN() << "LogdataMappedFile::map() - Unable to map " << m_file.fileName() << ":" << m_file.errorString();
+        m_size = 0;
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+const char *LogdataMappedFile::data() const
+{
+    return reinterpret_cast<const char *>(mp_data);
+}
+
+qint64 LogdataMappedFile::size() const
+{
+    return m_size;
+}
+
+void LogdataMappedFile::setLegacyScaling(bool enable)
+{
+    m_legacyScaling = enable;
+}
+
+bool LogdataMappedFile::legacyScaling() const
+{
+    return m_legacyScaling;
+}
+
+//****************************************************
+
+LogdataMappedColumn::LogdataMappedColumn(LogdataMappedFile::Ptr file, OffsetVectorPtr offsets, int fieldOffset, char formatChar) :
+    m_filePtr(std::move(file)),
+    m_offsetsPtr(std::move(offsets)),
+    m_fieldOffset(fieldOffset),
+    m_formatChar(formatChar)
+{}
+
+int LogdataMappedColumn::fieldSize(char formatChar)
+{
+    switch(formatChar)
+    {
+    case 'b':
+    case 'B':
+    case 'M':
+        return 1;
+    case 'h':
+    case 'H':
+    case 'c':
+    case 'C':
+        return 2;
+    case 'i':
+    case 'I':
+    case 'f':
+    case 'e':
+    case 'E':
+    case 'L':
+    case 'n':
+        return 4;
+    case 'd':
+    case 'q':
+    case 'Q':
+        return 8;
+    case 'N':
+        return 16;
+    case 'Z':
+    case 'a':
+        return 64;
+    default:
+        return 0;
+    }
+}
+
+quint64 LogdataMappedColumn::decodeTimeStamp(const char *data, char formatChar)
+{
+    switch(formatChar)
+    {
+    case 'Q':
+    case 'q':
+        return readLittleEndian<quint64>(data);
+    case 'I':
+    case 'i':
+        return readLittleEndian<quint32>(data);
+    case 'H':
+    case 'h':
+        return readLittleEndian<quint16>(data);
+    case 'B':
+    case 'b':
+        return static_cast<quint8>(*data);
+    default:
+        return 0;
+    }
+}
+
+int LogdataMappedColumn::size() const
+{
+    return m_offsetsPtr->size();
+}
+
+void LogdataMappedColumn::reserve(int size)
+{
+    Q_UNUSED(size)  // offsets are managed by the parser
+}
+
+void LogdataMappedColumn::squeeze()
+{
+    m_offsetsPtr->squeeze();
+}
+
+void LogdataMappedColumn::append(const QVariant &value)
+{
+    Q_UNUSED(value)
+    QLOG_ERROR() << "LogdataMappedColumn::append() - Mapped columns are read only";
+}
+
+QVariant LogdataMappedColumn::value(int row) const
+{
+    const char *data = fieldData(row);
+    // Same types as delivered by the BinLogParser when decoding into a NameValuePair list
+    switch(m_formatChar)
+    {
+    case 'b':
+    case 'M':
+        return {static_cast<qint8>(*data)};
+    case 'B':
+        return {static_cast<quint8>(*data)};
+    case 'h':
+        return {readLittleEndian<qint16>(data)};
+    case 'H':
+        return {readLittleEndian<quint16>(data)};
+    case 'i':
+        return {readLittleEndian<qint32>(data)};
+    case 'I':
+        return {readLittleEndian<quint32>(data)};
+    case 'q':
+        return {readLittleEndian<qint64>(data)};
+    case 'Q':
+        return {readLittleEndian<quint64>(data)};
+    case 'f':
+        return {readFloat(data)};
+    case 'n':
+    case 'N':
+    case 'Z':
+        return {decodeString(data, fieldSize(m_formatChar))};
+    case 'a':
+    {
+        QList<QVariant> valArray;
+        valArray.reserve(32);
+        for (int i = 0; i < 32; ++i)
+        {
+            valArray.push_back(readLittleEndian<qint16>(data + i * 2));
+        }
+        return {valArray};
+    }
+    default:    // all others are delivered as double
+        return {toDouble(row)};
+    }
+}
+
+double LogdataMappedColumn::toDouble(int row) const
+{
+    const char *data = fieldData(row);
+    const bool scale = m_filePtr->legacyScaling();
+    switch(m_formatChar)
+    {
+    case 'b':
+    case 'M':
+        return static_cast<qint8>(*data);
+    case 'B':
+        return static_cast<quint8>(*data);
+    case 'h':
+        return readLittleEndian<qint16>(data);
+    case 'H':
+        return readLittleEndian<quint16>(data);
+    case 'i':
+        return readLittleEndian<qint32>(data);
+    case 'I':
+        return readLittleEndian<quint32>(data);
+    case 'q':
+        return static_cast<double>(readLittleEndian<qint64>(data));
+    case 'Q':
+        return static_cast<double>(readLittleEndian<quint64>(data));
+    case 'f':
+        return static_cast<double>(readFloat(data));
+    case 'd':
+        return readDouble(data);
+    case 'c':
+        return scale ? readLittleEndian<qint16>(data) / 100.0 : readLittleEndian<qint16>(data);
+    case 'C':
+        return scale ? readLittleEndian<quint16>(data) / 100.0 : readLittleEndian<quint16>(data);
+    case 'e':
+        return scale ? readLittleEndian<qint32>(data) / 100.0 : readLittleEndian<qint32>(data);
+    case 'E':
+        return scale ? readLittleEndian<quint32>(data) / 100.0 : readLittleEndian<quint32>(data);
+    case 'L':
+        return scale ? readLittleEndian<qint32>(data) / 10000000.0 : readLittleEndian<qint32>(data);
+    default:    // strings and arrays cannot be converted
+        return 0.0;
+    }
+}
+
+void LogdataMappedColumn::copyToDouble(QVector<double> &target) const
+{
+    target.reserve(target.size() + size());
+    for(int row = 0; row < size(); ++row)
+    {
+        target.push_back(toDouble(row));
+    }
+}
+
+void LogdataMappedColumn::copyToDouble(QVector<double> &target, const QVector<int> &rows) const
+{
+    target.reserve(target.size() + rows.size());
+    for(const int row : rows)
+    {
+        target.push_back(toDouble(row));
+    }
+}
+
+bool LogdataMappedColumn::isNumeric() const
+{
+    return !((m_formatChar == 'n') || (m_formatChar == 'N') || (m_formatChar == 'Z') || (m_formatChar == 'a'));
+}
+
+int LogdataMappedColumn::bytesPerValue() const
+{
+    return 0;   // the values are in the mapped file. Only the shared offsets need memory.
+}
+
+LogdataColumn::storageType LogdataMappedColumn::type() const
+{
+    return storageType::Mapped;
+}
+
+void LogdataMappedColumn::writeValues(QDataStream &stream) const
+{
+    Q_UNUSED(stream)
+}
+
+bool LogdataMappedColumn::readValues(QDataStream &stream, int count)
+{
+    Q_UNUSED(stream)
+    return count == size();
+}
+
+const LogdataMappedFile::Ptr &LogdataMappedColumn::file() const
+{
+    return m_filePtr;
+}
+
+const LogdataMappedColumn::OffsetVectorPtr &LogdataMappedColumn::offsets() const
+{
+    return m_offsetsPtr;
+}
+
+int LogdataMappedColumn::fieldOffset() const
+{
+    return m_fieldOffset;
+}
+
+char LogdataMappedColumn::formatChar() const
+{
+    return m_formatChar;
+}
+
+const char *LogdataMappedColumn::fieldData(int row) const
+{
+    return m_filePtr->data() + m_offsetsPtr->at(row) + m_fieldOffset;
+}
+
+QString LogdataMappedColumn::decodeString(const char *data, int size)
+{
+    QString string;
+    string.reserve(size);
+    for (int i = 0; i < size; ++i)
+    {
+        if(data[i])
+        {
+            string.append(QLatin1Char(data[i]));
+        }
+    }
+    return string;
+}
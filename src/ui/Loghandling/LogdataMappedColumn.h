@@ -0,0 +1,208 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+/**
+ * @file LogdataMappedColumn.h
+ * @date 17 Oct 2026
+ * @brief File providing a column which decodes its values directly from a memory
+ *        mapped binary log
+ */
+
+#ifndef LOGDATAMAPPEDCOLUMN_H
+#define LOGDATAMAPPEDCOLUMN_H
+
+#include <QFile>
+#include "LogdataColumn.h"
+
+/**
+ * @brief The LogdataMappedFile class holds a read only memory mapping of a log file.
+ *        It owns its own file handle so the mapping stays valid as long as one
+ *        column references it - even if the parser is long gone.
+ */
+class LogdataMappedFile
+{
+public:
+
+    /**
+     * @brief Ptr - shared pointer type for this class
+     */
+    using Ptr = QSharedPointer<LogdataMappedFile>;
+
+    /**
+     * @brief LogdataMappedFile - CTOR
+     * @param fileName - name of the file to map
+     */
+    explicit LogdataMappedFile(const QString &fileName);
+
+    /**
+     * @brief ~LogdataMappedFile - DTOR - unmaps the file
+     */
+    ~LogdataMappedFile();
+
+    /**
+     * @brief map opens the file and maps it completely into memory.
+     * @return true - success, false file could not be opened or mapped
+     */
+    bool map();
+
+    /**
+     * @brief data
+     * @return pointer to the first byte of the mapped file. nullptr if not mapped
+     */
+    const char *data() const;
+
+    /**
+     * @brief size
+     * @return size of the mapped file in bytes
+     */
+    qint64 size() const;
+
+    /**
+     * @brief setLegacyScaling - Logs without unit data (before ardupilot 3.6) do not
+     *        deliver a multiplier for the 'c', 'C', 'e', 'E' and 'L' fields. For those
+     *        the scaling must be done while decoding.
+     * @param enable - true the decoding does the scaling, false otherwise.
+     */
+    void setLegacyScaling(bool enable);
+
+    /**
+     * @brief legacyScaling
+     * @return true if the decoding has to scale 'c', 'C', 'e', 'E' and 'L' fields
+     */
+    bool legacyScaling() const;
+
+private:
+    QFile m_file;               /// file handle which owns the mapping
+    uchar *mp_data;             /// start of the mapped memory
+    qint64 m_size;              /// size of the mapped memory
+    bool m_legacyScaling;       /// true if decoding must scale the data
+};
+
+/**
+ * @brief The LogdataMappedColumn class is a LogdataColumn which does not store any
+ *        values. It only knows where the values of its field are located in the mapped
+ *        file and decodes them when they are needed. All columns of one type share the
+ *        same offset vector which holds the start of the payload of every message.
+ */
+class LogdataMappedColumn : public LogdataColumn
+{
+public:
+
+    using OffsetVector = QVector<qint64>;                  /// Type holding the payload offset of every row
+    using OffsetVectorPtr = QSharedPointer<OffsetVector>;  /// Shared pointer to an offset vector
+
+    /**
+     * @brief LogdataMappedColumn - CTOR
+     * @param file - the mapped file holding the data
+     * @param offsets - offsets of the payload of each row. Shared with all columns of the type
+     *                  and filled by the parser.
+     * @param fieldOffset - byte offset of this field within the payload
+     * @param formatChar - format character of the field like 'f'
+     */
+    LogdataMappedColumn(LogdataMappedFile::Ptr file, OffsetVectorPtr offsets, int fieldOffset, char formatChar);
+
+    /**
+     * @brief fieldSize delivers the number of bytes a field of the given format uses
+     *        in a binary log.
+     * @param formatChar - format character of the field
+     * @return size in bytes, 0 if the format is unknown
+     */
+    static int fieldSize(char formatChar);
+
+    /**
+     * @brief decodeTimeStamp decodes an integer time stamp field.
+     * @param data - pointer to the first byte of the field
+     * @param formatChar - format character of the field
+     * @return the time stamp, 0 if the format is no integer format
+     */
+    static quint64 decodeTimeStamp(const char *data, char formatChar);
+
+    int size() const override;
+    void reserve(int size) override;
+    void squeeze() override;
+    void append(const QVariant &value) override;
+    QVariant value(int row) const override;
+    double toDouble(int row) const override;
+    void copyToDouble(QVector<double> &target) const override;
+    void copyToDouble(QVector<double> &target, const QVector<int> &rows) const override;
+    bool isNumeric() const override;
+    int bytesPerValue() const override;
+    storageType type() const override;
+
+    /**
+     * @brief writeValues does nothing. The values are in the mapped file - the
+     *        owner of the offsets has to store them.
+     */
+    void writeValues(QDataStream &stream) const override;
+
+    /**
+     * @brief readValues does not read anything. It only checks that the
+     *        offsets hold count values.
+     */
+    bool readValues(QDataStream &stream, int count) override;
+
+    /**
+     * @brief file
+     * @return the mapped file holding the data
+     */
+    const LogdataMappedFile::Ptr &file() const;
+
+    /**
+     * @brief offsets
+     * @return the payload offsets of all rows
+     */
+    const OffsetVectorPtr &offsets() const;
+
+    /**
+     * @brief fieldOffset
+     * @return byte offset of this field within the payload
+     */
+    int fieldOffset() const;
+
+    /**
+     * @brief formatChar
+     * @return the format of the field
+     */
+    char formatChar() const;
+
+private:
+    LogdataMappedFile::Ptr m_filePtr;   /// The mapped log
+    OffsetVectorPtr m_offsetsPtr;       /// payload offset of each row
+    int m_fieldOffset;                  /// offset of the field within the payload
+    char m_formatChar;                  /// format of the field
+
+    /**
+     * @brief fieldData delivers the pointer to the field data of a row
+     * @param row - the row
+     * @return pointer to the first byte of the field
+     */
+    const char *fieldData(int row) const;
+
+    /**
+     * @brief decodeString decodes a char array. All '\0' characters are removed.
+     * @param data - pointer to the first byte of the field
+     * @param size - size of the field
+     * @return the string
+     */
+    static QString decodeString(const char *data, int size);
+};
+
+#endif // LOGDATAMAPPEDCOLUMN_H
@@ -52,7 +52,7 @@ LogdataStorage::LogdataStorage()
     QLOG_DEBUG() << "LogdataStorage::LogdataStorage()";
     // Reserve some memory...
     m_typeStorage.reserve(50);
-    m_indexToTypeRow.reserve(50);
+    m_typeNameToIndex.reserve(50);
     m_dataStorage.reserve(50);
     m_TimeToIndexList.reserve(20000);
     m_indexToDataRow.reserve(20000);
@@ -98,23 +98,24 @@ QVariant LogdataStorage::data(const QModelIndex &index, int role) const
     if (index.column() == 1)
     {
         // Column 1 is the name of the log data (ATT,ATUN...)
-        return {m_indexToDataRow[index.row()].first};
+        return {m_typeStorage[m_indexToDataRow[index.row()].m_typeIndex].m_name};
     }
 
-    const TypeIndexPair &typeIndex = m_indexToDataRow[index.row()];
-    const ValueTable &dataVect = m_dataStorage[typeIndex.first];
-    if(index.column() - s_ColumnOffset >= dataVect.at(typeIndex.second).m_values.size())
+    const TypeRowPair &typeRow = m_indexToDataRow[index.row()];
+    const DataTable &table = m_dataStorage[typeRow.m_typeIndex];
+    if(index.column() - s_ColumnOffset >= table.m_columns.size())
     {
         return {}; // this data type does not have so much colums
     }
 
-    const dataType &type = m_typeStorage[typeIndex.first];
+    const LogdataColumn &column = *table.m_columns.at(index.column() - s_ColumnOffset);
+    const dataType &type = m_typeStorage[typeRow.m_typeIndex];
     if((index.column() - s_ColumnOffset) < type.m_multipliers.size())   // do we have a multiplier??
     {
         const double &multi = type.m_multipliers.at(index.column() - s_ColumnOffset);
         if(!qIsNaN(multi))     // unknown multiplier are NaNs
         {
-            double temp = dataVect.at(typeIndex.second).m_values.at(index.column() - s_ColumnOffset).toDouble();
+            double temp = column.toDouble(typeRow.m_row);
             if(index.column() == 2)
             {
                 // Column 2 is the time we want 6 decimals in this one.
@@ -124,7 +125,7 @@ QVariant LogdataStorage::data(const QModelIndex &index, int role) const
         }
     }
     // If we do not have multipliers we do not need scaling
-    return dataVect.at(typeIndex.second).m_values.at(index.column() - s_ColumnOffset);
+    return column.value(typeRow.m_row);
 }
 
 QVariant LogdataStorage::headerData(int column, Qt::Orientation orientation, int role) const
@@ -146,8 +147,7 @@ QVariant LogdataStorage::headerData(int column, Qt::Orientation orientation, int
         return {"MSG Type"};    // second colum is always the message type
     }
 
-    const TypeIndexPair &typeIndex = m_indexToDataRow[m_currentRow];
-    const dataType &type = m_typeStorage[typeIndex.first];
+    const dataType &type = m_typeStorage[m_indexToDataRow[m_currentRow].m_typeIndex];
     if ((column - s_ColumnOffset) >= type.m_labels.size())
     {
         return {""};    // this row does not have this column
@@ -165,16 +165,27 @@ bool LogdataStorage::addDataType(const QString &typeName, quint32 typeID, int ty
 
     // create new type and store it
     dataType NewType(typeName, typeID, typeLength, typeFormat, typeLabels, timeColumn);
-    m_typeStorage.insert(typeName, NewType);
-    // to be able to recreate the order we store the names in a vector.
-    m_indexToTypeRow.push_back(typeName);
+    const auto iter = m_typeNameToIndex.constFind(typeName);
+    if(iter != m_typeNameToIndex.constEnd())
+    {
+        // a type with this name is already known. Replace it - the data stays.
+        m_typeStorage[iter.value()] = NewType;
+    }
+    else
+    {
+        // to be able to recreate the order the types are stored in a vector.
+        m_typeNameToIndex.insert(typeName, m_typeStorage.size());
+        m_typeStorage.push_back(NewType);
+        m_dataStorage.push_back(DataTable());
+    }
 
     return true;
 }
 
 bool LogdataStorage::addDataRow(const QString &typeName, const QList<QPair<QString,QVariant> >  &values)
 {
-    if (!m_typeStorage.contains(typeName))  // type exists in type storage?
+    const auto typeIter = m_typeNameToIndex.constFind(typeName);
+    if (typeIter == m_typeNameToIndex.constEnd())  // type exists in type storage?
     {
         m_errorText.clear();
         QTextStream error(&m_errorText);
@@ -182,7 +193,8 @@ bool LogdataStorage::addDataRow(const QString &typeName, const QList<QPair<QStri
         return false;
     }
 
-    const dataType &tempType = m_typeStorage[typeName];
+    const int typeIndex = typeIter.value();
+    const dataType &tempType = m_typeStorage[typeIndex];
     if(values.size() != tempType.m_labels.size())    // Number of elements match type?
     {
         m_errorText.clear();
@@ -197,8 +209,6 @@ bool LogdataStorage::addDataRow(const QString &typeName, const QList<QPair<QStri
     m_minTimeStamp = m_minTimeStamp > tempTime ? tempTime : m_minTimeStamp;
     m_maxTimeStamp = m_maxTimeStamp < tempTime ? tempTime : m_maxTimeStamp;
 
-    IndexValueRow newRow;
-    newRow.m_values.reserve(values.size());
     for(int i = 0; i < values.size(); ++i)
     {
         if(values[i].first != tempType.m_labels[i])  // value name match?
@@ -210,21 +220,88 @@ bool LogdataStorage::addDataRow(const QString &typeName, const QList<QPair<QStri
                   << " Dropping data.";
             return false;
         }
-        newRow.m_values.push_back(values[i].second);
-    }
-    // add current global dataindex to row
-    newRow.m_index = m_indexToDataRow.size();   // size() will be the index after push_back()
-    // add to data storage
-    m_dataStorage[typeName].append(newRow);
-    // add type name to global dataindex
-    m_indexToDataRow.push_back(TypeIndexPair(typeName, m_dataStorage[typeName].size() - 1)); // last index is size() - 1
+    }
+
+    DataTable &table = m_dataStorage[typeIndex];
+    if(table.m_columns.isEmpty())
+    {
+        // First row of this type - now we know the values and can create matching columns
+        table.m_columns.reserve(values.size());
+        for(int i = 0; i < values.size(); ++i)
+        {
+            const char formatChar = i < tempType.m_format.size() ? tempType.m_format.at(i).toLatin1() : '\0';
+            table.m_columns.push_back(LogdataColumn::create(formatChar, values[i].second));
+        }
+    }
+    else if(table.m_columns.size() != values.size())
+    {
+        m_errorText.clear();
+        QTextStream error(&m_errorText);
+        error << "Number of datafields for type " << typeName << " does not match the stored data. Expected:"
+              << table.m_columns.size() << " got:" << values.size();
+        return false;
+    }
+    for(int i = 0; i < values.size(); ++i)
+    {
+        // Integer columns must not truncate doubles arriving later
+        LogdataColumn::widenForValue(table.m_columns[i], values[i].second);
+        table.m_columns[i]->append(values[i].second);
+    }
+
+    // add current global dataindex to row - size() will be the index after push_back()
+    const int globalIndex = m_indexToDataRow.size();
+    table.m_globalIndex.push_back(globalIndex);
+    // add type and row to global dataindex
+    TypeRowPair typeRow;
+    typeRow.m_typeIndex = typeIndex;
+    typeRow.m_row = table.rowCount() - 1;   // last index is size() - 1
+    m_indexToDataRow.push_back(typeRow);
     // create time to index pair
-    TimeStampToIndexPair timeIndex(tempTime, newRow.m_index);
+    TimeStampToIndexPair timeIndex(tempTime, globalIndex);
     // and add it to time index
     m_TimeToIndexList.push_back(timeIndex);
     return true;
 }
 
+int LogdataStorage::getTypeIndex(const QString &typeName) const
+{
+    return m_typeNameToIndex.value(typeName, -1);
+}
+
+bool LogdataStorage::setDataColumns(int typeIndex, const QVector<LogdataColumn::Ptr> &columns)
+{
+    if((typeIndex < 0) || (typeIndex >= m_typeStorage.size()))
+    {
+        m_errorText = "Cannot set columns for unknown type index " + QString::number(typeIndex);
+        return false;
+    }
+    if((m_dataStorage[typeIndex].rowCount() != 0) || (columns.size() != m_typeStorage[typeIndex].m_labels.size()))
+    {
+        m_errorText = "Cannot set columns for type " + m_typeStorage[typeIndex].m_name +
+                      ". It already has data or the number of columns does not match.";
+        return false;
+    }
+    m_dataStorage[typeIndex].m_columns = columns;
+    return true;
+}
+
+void LogdataStorage::addLazyDataRow(int typeIndex, quint64 timeStamp)
+{
+    // fetch min & max timestamp of all data
+    m_minTimeStamp = m_minTimeStamp > timeStamp ? timeStamp : m_minTimeStamp;
+    m_maxTimeStamp = m_maxTimeStamp < timeStamp ? timeStamp : m_maxTimeStamp;
+
+    DataTable &table = m_dataStorage[typeIndex];
+    const int globalIndex = m_indexToDataRow.size();
+    table.m_globalIndex.push_back(globalIndex);
+
+    TypeRowPair typeRow;
+    typeRow.m_typeIndex = typeIndex;
+    typeRow.m_row = table.rowCount() - 1;
+    m_indexToDataRow.push_back(typeRow);
+    m_TimeToIndexList.push_back(TimeStampToIndexPair(timeStamp, globalIndex));
+}
+
 void LogdataStorage::addUnitData(quint8 unitID, const QString &unitName)
 {
     m_unitStorage[unitID] = unitName;
@@ -259,6 +336,18 @@ void LogdataStorage::setTimeStamp(const QString &timeStampName, double divisor)
     // As this method is called at the End of the parsing we should use the chance to sort the time index by
     // time - just to be sure...
     std::stable_sort(m_TimeToIndexList.begin(), m_TimeToIndexList.end(), TimeStampToIndexPairComparer());
+
+    // no more data will be added - release unused memory
+    for(auto &table : m_dataStorage)
+    {
+        table.m_globalIndex.squeeze();
+        for(auto &column : table.m_columns)
+        {
+            column->squeeze();
+        }
+    }
+    m_indexToDataRow.squeeze();
+    m_TimeToIndexList.squeeze();
 }
 
 double LogdataStorage::getTimeDivisor() const
@@ -270,9 +359,10 @@ QMap<QString, QStringList> LogdataStorage::getFmtValues(bool filterStringValues)
 {
     QMap<QString, QStringList> fmtValueMap; //using a map to get alphabetically sorting
 
-    for(const auto &type : m_typeStorage)
+    for(int typeIndex = 0; typeIndex < m_typeStorage.size(); ++typeIndex)
     {
-        if(m_dataStorage.contains(type.m_name))    // only types we have data for
+        const dataType &type = m_typeStorage[typeIndex];
+        if(m_dataStorage[typeIndex].rowCount() > 0)    // only types we have data for
         {
             if(!filterStringValues ||           // n N Z are string types - those cannot be plotted
                !(type.m_format.contains('n') || type.m_format.contains('N') || type.m_format.contains('Z')))
@@ -314,15 +404,7 @@ QMap<QString, QStringList> LogdataStorage::getFmtValues(bool filterStringValues)
 
 QVector<LogdataStorage::dataType> LogdataStorage::getAllDataTypes() const
 {
-    QVector<dataType> dataTypes;
-    dataTypes.reserve(m_indexToTypeRow.size());
-
-    foreach(const QString &name, m_indexToTypeRow)
-    {
-        dataTypes.push_back(m_typeStorage.value(name));
-    }
-
-    return dataTypes;
+    return m_typeStorage;
 }
 
 
@@ -336,13 +418,14 @@ bool LogdataStorage::getValues(const QString &name, bool useTimeAsIndex, QVector
     {
         return false;   // name is not valid - structure must be "groupName.indexName:idx.valueName or groupName.valueName"
     }
-    if(!m_typeStorage.contains(splitName.at(0)) || !m_dataStorage.contains(splitName.at(0)))
+    const int typeIndex = m_typeNameToIndex.value(splitName.at(0), -1);
+    if((typeIndex == -1) || (m_dataStorage[typeIndex].rowCount() == 0))
     {
         return false;    // don't have this type or no data for this type
     }
 
     // get the type for easier access
-    const auto &type = m_typeStorage[splitName.at(0)];
+    const auto &type = m_typeStorage[typeIndex];
 
     // The last element is always the valueName
     auto valueName = splitName.last().split(s_UnitParOpen).at(0).trimmed();  // Remove unit info like "[s]" from valueName
@@ -353,7 +436,6 @@ bool LogdataStorage::getValues(const QString &name, bool useTimeAsIndex, QVector
         return false;    // don't have this value type
     }
 
-    const int timeStampIndex {type.m_timeStampIndex};
     double multiplier {qQNaN()};                        // Unknown multiplier is always qQNaN
     if(type.m_multipliers.size() > valueIndex)
     {
@@ -370,47 +452,74 @@ bool LogdataStorage::getValues(const QString &name, bool useTimeAsIndex, QVector
         canHaveMultipleDatalines = true;
     }
 
-    int datalines {type.m_maxIndex + 1};
-    const ValueTable &data {m_dataStorage[splitName.at(0)]};
+    const int datalines {type.m_maxIndex + 1};
+    const DataTable &data {m_dataStorage[typeIndex]};
+    const LogdataColumn &valueColumn {*data.m_columns.at(valueIndex)};
+    const LogdataColumn &timeColumn {*data.m_columns.at(type.m_timeStampIndex)};
 
     xValues.clear();
-    xValues.reserve((data.size() / (datalines)) + 2 );  // the +2 is to gurantee the vector is big enough (really no reallocation is needed)
     yValues.clear();
-    yValues.reserve((data.size() / (datalines)) + 2 );
 
     // copy the requested data
     if (canHaveMultipleDatalines && (datalines > 1))    // only if we really have more than one dataline.
     {
-        for (const auto &valueRow: data)
+        // collect the rows of the requested dataline
+        const LogdataColumn &indexColumn {*data.m_columns.at(type.m_indexFieldIndex)};
+        QVector<int> rows;
+        rows.reserve((data.rowCount() / datalines) + 2);  // the +2 is to gurantee the vector is big enough (really no reallocation is needed)
+        for (int row = 0; row < data.rowCount(); ++row)
         {
-            if (valueRow.m_values.at(type.m_indexFieldIndex).toInt() == reqDataline)    // only if its the requested dataline
+            if (static_cast<int>(indexColumn.toDouble(row)) == reqDataline)
             {
-                xValues.push_back((useTimeAsIndex ? valueRow.m_values.at(timeStampIndex).toDouble() / m_timeDivisor : valueRow.m_index));
-                if(!qIsNaN(multiplier))
-                {
-                    yValues.push_back(valueRow.m_values.at(valueIndex).toDouble() * multiplier);
-                }
-                else
-                {
-                    yValues.push_back(valueRow.m_values.at(valueIndex).toDouble());
-                }
+                rows.push_back(row);
             }
         }
+
+        if (useTimeAsIndex)
+        {
+            timeColumn.copyToDouble(xValues, rows);
+        }
+        else
+        {
+            xValues.reserve(rows.size());
+            for (const int row : rows)
+            {
+                xValues.push_back(data.m_globalIndex.at(row));
+            }
+        }
+        valueColumn.copyToDouble(yValues, rows);
     }
     else
     {
-        for (const auto &valueRow: data)
+        if (useTimeAsIndex)
         {
-            xValues.push_back((useTimeAsIndex ? valueRow.m_values.at(timeStampIndex).toDouble() / m_timeDivisor : valueRow.m_index));
-            if(!qIsNaN(multiplier))
-            {
-                yValues.push_back(valueRow.m_values.at(valueIndex).toDouble() * multiplier);
-            }
-            else
+            timeColumn.copyToDouble(xValues);
+        }
+        else
+        {
+            xValues.reserve(data.rowCount());
+            for (const int index : data.m_globalIndex)
             {
-                yValues.push_back(valueRow.m_values.at(valueIndex).toDouble());
+                xValues.push_back(index);
             }
         }
+        valueColumn.copyToDouble(yValues);
+    }
+
+    // scale the data
+    if (useTimeAsIndex)
+    {
+        for (auto &value : xValues)
+        {
+            value /= m_timeDivisor;
+        }
+    }
+    if (!qIsNaN(multiplier))
+    {
+        for (auto &value : yValues)
+        {
+            value *= multiplier;
+        }
     }
 
     return true;
@@ -420,9 +529,13 @@ void LogdataStorage::getRawDataRow(int index, QString &name, QVector<QVariant> &
 {
     if(index < m_indexToDataRow.size())
     {
-        TypeIndexPair indexPair = m_indexToDataRow[index];
-        name = indexPair.first;
-        measurements = m_dataStorage.value(name).at(indexPair.second).m_values;
+        const TypeRowPair &typeRow = m_indexToDataRow[index];
+        name = m_typeStorage[typeRow.m_typeIndex].m_name;
+        measurements.clear();
+        for(const auto &column : m_dataStorage[typeRow.m_typeIndex].m_columns)
+        {
+            measurements.push_back(column->value(typeRow.m_row));
+        }
     }
     else
     {
@@ -500,28 +613,32 @@ int LogdataStorage::getNearestIndexForTimestamp(double timevalue) const
 
 void LogdataStorage::getMessagesOfType(const QString &type, QMap<quint64, MessageBase::Ptr> &indexToMessageMap) const
 {
-    if(!m_dataStorage.contains(type))
+    const int typeIndex = m_typeNameToIndex.value(type, -1);
+    if((typeIndex == -1) || (m_dataStorage[typeIndex].rowCount() == 0))
     {
         QLOG_DEBUG() << "Graph loaded with no table of type " << type;
         return;
     }
 
     QList<NameValuePair> nameValueList;
+    const DataTable &table = m_dataStorage[typeIndex];
+    const QStringList &labels = m_typeStorage[typeIndex].m_labels;
 
-    for(const auto &row : m_dataStorage[type])
+    for(int row = 0; row < table.rowCount(); ++row)
     {
+        const int globalIndex = table.m_globalIndex.at(row);
         nameValueList.clear();
-        nameValueList.append(NameValuePair("Index", row.m_index));  // Add Data index
+        nameValueList.append(NameValuePair("Index", globalIndex));  // Add Data index
 
-        for(int i = 0; i < row.m_values.size(); ++i)
+        for(int i = 0; i < table.m_columns.size(); ++i)
         {
-            NameValuePair tempPair(m_typeStorage[type].m_labels.at(i), row.m_values.at(i)); // add names and values
+            NameValuePair tempPair(labels.at(i), table.m_columns.at(i)->value(row)); // add names and values
             nameValueList.append(tempPair);
         }
         MessageBase::Ptr msgPtr = MessageFactory::CreateMessageOfType(type, nameValueList, m_timeStampName, m_timeDivisor);
         if(msgPtr != nullptr)
         {
-            indexToMessageMap.insert(static_cast<quint64>(row.m_index), msgPtr);
+            indexToMessageMap.insert(static_cast<quint64>(globalIndex), msgPtr);
         }
     }
 }
@@ -539,8 +656,9 @@ QStringList LogdataStorage::setupUnitData(const QString &timeStampName, double d
     // handle the unit and multiplier data if there is some
     if(!m_typeIDToMultiplierFieldInfo.empty())
     {
-        for(auto &type : m_typeStorage)
+        for(int typeIndex = 0; typeIndex < m_typeStorage.size(); ++typeIndex)
         {
+            dataType &type = m_typeStorage[typeIndex];
             // handle unit and index data
             if(m_typeIDToUnitFieldInfo.contains(type.m_ID))
             {
@@ -561,16 +679,17 @@ QStringList LogdataStorage::setupUnitData(const QString &timeStampName, double d
                 int indexFieldPos = m_typeIDToUnitFieldInfo.value(type.m_ID).indexOf('#'); // '#' is the unitID for index fields
                 if(indexFieldPos != -1)
                 {
-                    if(m_dataStorage.contains(type.m_name)) // only if we have data
+                    const DataTable &table = m_dataStorage[typeIndex];
+                    if(table.rowCount() > 0) // only if we have data
                     {
                         // find the max index within the first 50 entries and store it within the datatype
-                        const auto &valueRow {m_dataStorage[type.m_name]};
+                        const LogdataColumn &indexColumn {*table.m_columns.at(indexFieldPos)};
                         int maxIndex {0};
-                        int maxEntriesToCheck {valueRow.size() < s_maxItemsToCheck ? valueRow.size() : s_maxItemsToCheck};
+                        int maxEntriesToCheck {table.rowCount() < s_maxItemsToCheck ? table.rowCount() : s_maxItemsToCheck};
 
                         for (int i = 0; i < maxEntriesToCheck; ++i)
                         {
-                            auto index {valueRow[i].m_values[indexFieldPos].toInt()};
+                            auto index {static_cast<int>(indexColumn.toDouble(i))};
                             maxIndex = maxIndex < index ? index : maxIndex;
                         }
                         type.m_maxIndex = maxIndex;
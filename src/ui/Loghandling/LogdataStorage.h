@@ -31,7 +31,8 @@ This file is part of the APM_PLANNER project
 
 #include <QObject>
 #include <QAbstractTableModel>
-#include <ArduPilotMegaMAV.h>
+#include "ArduPilotMessages.h"
+#include "LogdataColumn.h"
 
 /**
  * @brief The LogdataStorage class is used to store the data parsed from logfiles.
@@ -42,6 +43,9 @@ This file is part of the APM_PLANNER project
  *        After that data values for this type can be added. They must respect the format
  *        of the added type.
  *
+ *        The data is stored column wise. Every label of a type gets its own typed column
+ *        (see LogdataColumn) so each value only needs the memory of its native type.
+ *
  */
 class LogdataStorage : public QAbstractTableModel
 {
@@ -134,6 +138,34 @@ public:
      */
     virtual bool addDataRow(const QString &typeName, const QList<QPair<QString,QVariant> >  &values);
 
+    /**
+     * @brief getTypeIndex delivers the internal index of a type. The index can be used
+     *        for the fast access methods like addLazyDataRow().
+     * @param typeName - name of the type
+     * @return the index of the type, -1 if type is unknown
+     */
+    virtual int getTypeIndex(const QString &typeName) const;
+
+    /**
+     * @brief setDataColumns sets the columns of a type which are filled by the caller
+     *        instead of the datamodel (like columns reading directly from a mapped file).
+     *        Must be called before the first row of this type is added. Rows for this type
+     *        must be added with addLazyDataRow() afterwards.
+     * @param typeIndex - index of the type delivered by getTypeIndex()
+     * @param columns - one column for every label of the type
+     * @return - true success, false otherwise (type unknown, already has data or wrong column count)
+     */
+    virtual bool setDataColumns(int typeIndex, const QVector<LogdataColumn::Ptr> &columns);
+
+    /**
+     * @brief addLazyDataRow adds a row to the global index for a type whose columns were set
+     *        with setDataColumns(). The caller must have appended the values to the columns
+     *        before calling this method.
+     * @param typeIndex - index of the type delivered by getTypeIndex()
+     * @param timeStamp - the time stamp of this row
+     */
+    virtual void addLazyDataRow(int typeIndex, quint64 timeStamp);
+
     /**
      * @brief addUnitData adds unit data to the datamodel which can be used to add units to the
      *        plotted data.
@@ -307,25 +339,38 @@ public:
 
 private:
 
+    friend class LogdataCache;  /// reads and writes the complete storage
+
     constexpr static int s_ColumnOffset  = 2;           /// Offset for columns cause model adds index and name column
     constexpr static char s_UnitParOpen  = '[';         /// Unit names are surrounded by this parenthesis
     constexpr static char s_UnitParClose = ']';         /// Unit names are surrounded by this parenthesis
 
     using NameValuePair = QPair<QString, QVariant>;     /// Type holding label string and its value
-    using TypeIndexPair = QPair<QString, int>;          /// Type holding name and index
-    using ValueRow = QVector<QVariant>;                 /// Type holding one data line of a specific type
 
     /**
-     * @brief The IndexValueRow struct adds a dedicated index field to the
-     *        ValueRow.
+     * @brief The TypeRowPair struct is one entry of the global index. It points
+     *        to a row of a type in the data storage.
      */
-    struct IndexValueRow
+    struct TypeRowPair
     {
-        int m_index{};        /// the global index of this row
-        ValueRow m_values;    /// The value row
+        int m_typeIndex{};    /// index of the type in m_typeStorage and m_dataStorage
+        int m_row{};          /// row within the data table of this type
     };
 
-    using ValueTable = QVector<IndexValueRow>;          /// Type holding all data rows of a specific type
+    /**
+     * @brief The DataTable struct holds all data of one type. Every label
+     *        of the type is stored in its own typed column.
+     */
+    struct DataTable
+    {
+        QVector<int> m_globalIndex;             /// the global index of each row
+        QVector<LogdataColumn::Ptr> m_columns;  /// One column per label. Created with the first row.
+
+        int rowCount() const
+        {
+            return m_globalIndex.size();
+        }
+    };
 
     int m_columnCount{};           /// Holds the maximum column count of all rows
     int m_currentRow{};            /// The current selected row in table
@@ -337,11 +382,11 @@ private:
 
     QVector<TimeStampToIndexPair> m_TimeToIndexList;    /// List holding pairs of time stamp and table row index
 
-    QHash<QString, dataType> m_typeStorage;     /// Holds all known types
-    QVector<QString>         m_indexToTypeRow;  /// Holds the Type name in the order they were added
+    QVector<dataType>   m_typeStorage;      /// Holds all known types in the order they were added
+    QHash<QString, int> m_typeNameToIndex;  /// Maps the type name to its index in m_typeStorage
 
-    QHash<QString, ValueTable> m_dataStorage;    /// Holds the complete data
-    QVector<TypeIndexPair>     m_indexToDataRow; /// The global index pointing to the row
+    QVector<DataTable>   m_dataStorage;     /// Holds the complete data - same index as m_typeStorage
+    QVector<TypeRowPair> m_indexToDataRow;  /// The global index pointing to the row
 
     QString m_errorText;                         /// Used to store current error
 
@@ -31,6 +31,31 @@ This file is part of the APM_PLANNER project
 #include "TlogParser.h"
 #include "logging.h"
 
+#include <cstring>
+
+namespace
+{
+/**
+ * @brief appendValue - decodes a number from the payload and appends it to a typed column
+ */
+template <typename T>
+void appendValue(LogdataColumn &column, const char *field, int length)
+{
+    Q_UNUSED(length)
+    T value;
+    memcpy(&value, field, sizeof(T));
+    static_cast<LogdataTypedColumn<T> &>(column).appendValue(value);
+}
+
+/**
+ * @brief appendString - decodes a char array from the payload and appends it to a string column.
+ *        The array is not null terminated if the string uses all of its chars.
+ */
+void appendString(LogdataColumn &column, const char *field, int length)
+{
+    column.append(QString::fromLatin1(field, static_cast<int>(qstrnlen(field, static_cast<uint>(length)))));
+}
+}
 
 bool TlogParser::tlogDescriptor::isValid() const
 {
@@ -41,23 +66,23 @@ bool TlogParser::tlogDescriptor::isValid() const
 //*****************************************
 
 TlogParser::TlogParser(LogdataStorage::Ptr storagePtr, IParserCallback *object) :
-    QObject(),
     LogParserBase (storagePtr, object),
-    m_mavDecoderPtr(new MAVLinkDecoder()),
-    m_lastModeVal(255),
-    mp_ReceiveData(nullptr)
+    m_rxMessage(),
+    m_rxStatus(),
+    m_lastModeVal(255)
 {
     QLOG_DEBUG() << "TlogParser::TlogParser - CTOR";
-    // connect to the callbacks of the mavlink deoder - all data is delivered through them
-    connect(m_mavDecoderPtr.data(), &MAVLinkDecoder::valueChanged, this, &TlogParser::newValue);
-    connect(m_mavDecoderPtr.data(), &MAVLinkDecoder::textMessageReceived, this, &TlogParser::newTextValue);
+    // copy message description into hashmap for fast access
+    const QVector<mavlink_message_info_t> mavlinkMsg = MAVLINK_MESSAGE_INFO;
+    for(const auto &typeInfo : mavlinkMsg)
+    {
+        m_messageInfo.insert(typeInfo.msgid, typeInfo);
+    }
 }
 
 TlogParser::~TlogParser()
 {
     QLOG_DEBUG() << "TlogParser::TlogParser - DTOR";
-    disconnect(m_mavDecoderPtr.data(), &MAVLinkDecoder::valueChanged, this, &TlogParser::newValue);
-    disconnect(m_mavDecoderPtr.data(), &MAVLinkDecoder::textMessageReceived, this, &TlogParser::newTextValue);
 }
 
 AP2DataPlotStatus TlogParser::parse(QFile &logfile)
@@ -77,102 +102,102 @@ AP2DataPlotStatus TlogParser::parse(QFile &logfile)
     // from other messages we add those descriptors artificially to the DB
     addMissingDescriptors();
 
-    int emptyMessages = 0;
+    int unknownMessages = 0;
     int currentSysID = 0;
+    mavlink_message_t mavlinkMessage;
+    mavlink_status_t mavlinkStatus;
+
+    m_dataBlock.resize(s_ReadBlockSize);
 
     while(!logfile.atEnd() && !m_stop)
     {
-        mavlink_message_t mavlinkMessage;
-        mavlink_status_t mavlinkStatus;
-
         m_callbackObject->onProgress(logfile.pos(),logfile.size());
-        m_dataBlock = logfile.read(8192);
+        const qint64 blockSize = logfile.read(m_dataBlock.data(), m_dataBlock.size());
+        if(blockSize <= 0)
+        {
+            break;
+        }
+        const char *p_data = m_dataBlock.constData();
 
-        for (int i = 0; i < m_dataBlock.size(); ++i)
+        for (qint64 i = 0; i < blockSize; ++i)
         {
-            unsigned int decodeState = mavlink_parse_char(14, static_cast<uint8_t>(m_dataBlock[i]), &mavlinkMessage, &mavlinkStatus);
-            if (decodeState == MAVLINK_FRAMING_OK)
+            // Bad CRCs are not reported - the time stamp in front of every tlog message
+            // may contain a start sign which leads to a bad frame.
+            if (mavlink_frame_char_buffer(&m_rxMessage, &m_rxStatus, static_cast<uint8_t>(p_data[i]),
+                                          &mavlinkMessage, &mavlinkStatus) != MAVLINK_FRAMING_OK)
             {
-                if ((mavlinkMessage.sysid > 250) || ((mavlinkMessage.msgid <= 23) && (mavlinkMessage.msgid >= 20)))
+                continue;
+            }
+
+            if ((mavlinkMessage.sysid > 250) || isIgnoredMessage(mavlinkMessage.msgid))
+            {
+                // Groundstations have a sysid > 250 we ignore them.
+                continue;
+            }
+
+            auto typeIter = m_typeInfo.find(mavlinkMessage.msgid);
+            if(typeIter == m_typeInfo.end())
+            {
+                const auto infoIter = m_messageInfo.constFind(mavlinkMessage.msgid);
+                if(infoIter == m_messageInfo.constEnd())
                 {
-                    // Groundstations have a sysid > 250 we ignore them.
-                    // The messages PARAM_REQUEST_READ (#20), PARAM_REQUEST_LIST (#21), PARAM_VALUE (#22), PARAM_SET (#23)
-                    // are useless for plotting. Therefore we skip them here.
+                    unknownMessages++;
                     continue;
                 }
+                typeIter = m_typeInfo.insert(mavlinkMessage.msgid, tlogTypeInfo());
+                typeIter->mp_messageInfo = &infoIter.value();
+                if(!setupType(typeIter.value()))
+                {
+                    return m_logLoadingState;
+                }
+            }
+
+            if(typeIter->m_typeIndex == -1)
+            {
+                // Type could not be stored in datamodel. Continue with next data package.
+                continue;
+            }
+            storeMessage(mavlinkMessage, typeIter.value());
 
-                tlogDescriptor descriptor;
-                descriptor.m_name = m_mavDecoderPtr->getMessageName(mavlinkMessage.msgid);
-                if (descriptor.m_name != "EMPTY")
+            // Special message handling - Heartbeat
+            if(mavlinkMessage.msgid == MAVLINK_MSG_ID_HEARTBEAT)
+            {
+                if (currentSysID != mavlinkMessage.sysid)
                 {
-                    descriptor.m_ID = mavlinkMessage.msgid;
-                    if(!m_nameToDescriptorMap.contains(descriptor.m_name))
-                    {
-                        if(parseDescriptor(descriptor))
-                        {
-                            descriptor.finalize(m_activeTimestamp);
-                            if(!storeDescriptor(descriptor))
-                            {
-                                return m_logLoadingState;
-                            }
-                        }
-                    }
-
-                    // Read packet data - if there is something
-                    QList<NameValuePair> NameValuePairList;
-                    if(decodeData(mavlinkMessage, NameValuePairList))
-                    {
-                        if(!storeNameValuePairList(NameValuePairList, m_nameToDescriptorMap.value(descriptor.m_name)))
-                        {
-                            // Data could not be stored cause of defects. Continue with next data package.
-                            continue;
-                        }
-
-                        // Special message handling - Heartbeat
-                        if(mavlinkMessage.msgid == MAVLINK_MSG_ID_HEARTBEAT)
-                        {
-                            if (currentSysID != mavlinkMessage.sysid)
-                            {
-                                QLOG_DEBUG() << "MavLink SysID Changed: " << mavlinkMessage.sysid;
-                                currentSysID = mavlinkMessage.sysid;
-                            }
-                            // extract mode message from tlog data
-                            if(!extractModeMessage(NameValuePairList))
-                            {
-                                return m_logLoadingState;
-                            }
-                            // detect mav type
-                            if(m_loadedLogType == MAV_TYPE_GENERIC)
-                            {
-                                detectMavType(NameValuePairList);
-                            }
-                        }
-                        // Special message handling - Statustext
-                        else if(mavlinkMessage.msgid == MAVLINK_MSG_ID_STATUSTEXT)
-                        {
-                            // Create a MsgMessage from STATUSTEXT
-                            if(!extractMsgMessage(NameValuePairList))
-                            {
-                                return m_logLoadingState;
-                            }
-                        }
-                    }
+                    QLOG_DEBUG() << "MavLink SysID Changed: " << mavlinkMessage.sysid;
+                    currentSysID = mavlinkMessage.sysid;
                 }
-                else
+                mavlink_heartbeat_t heartbeat;
+                mavlink_msg_heartbeat_decode(&mavlinkMessage, &heartbeat);
+                // extract mode message from tlog data
+                if(!extractModeMessage(heartbeat))
                 {
-                   emptyMessages++;
+                    return m_logLoadingState;
+                }
+                // detect mav type - the "type" field holds MAV_TYPE
+                if((m_loadedLogType == MAV_TYPE_GENERIC) && (heartbeat.type != MAV_TYPE_GENERIC))
+                {
+                    m_loadedLogType = static_cast<MAV_TYPE>(heartbeat.type);
+                    m_logLoadingState.setMavType(m_loadedLogType);
                 }
             }
-            else if(decodeState == MAVLINK_FRAMING_BAD_CRC)
+            // Special message handling - Statustext
+            else if(mavlinkMessage.msgid == MAVLINK_MSG_ID_STATUSTEXT)
             {
-                m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter), "Bad CRC");
+                // Create a MsgMessage from STATUSTEXT
+                mavlink_statustext_t statustext;
+                mavlink_msg_statustext_decode(&mavlinkMessage, &statustext);
+                if(!extractMsgMessage(statustext))
+                {
+                    return m_logLoadingState;
+                }
             }
         }
     }
 
-    if(emptyMessages != 0) // Did we have messages named "EMPTY" ?
+    if(unknownMessages != 0) // Did we have messages without mavlink info?
     {
-        m_logLoadingState.corruptDataRead(0, "Found " + QString::number(emptyMessages) +" 'EMPTY' messages wich could not be processed");
+        m_logLoadingState.corruptDataRead(0, "Found " + QString::number(unknownMessages) +" unknown messages wich could not be processed");
     }
 
     m_dataStoragePtr->setTimeStamp(m_activeTimestamp.m_name, m_activeTimestamp.m_divisor);
@@ -211,78 +236,171 @@ void TlogParser::addMissingDescriptors()
     storeDescriptor(descriptor);
 }
 
-bool TlogParser::parseDescriptor(tlogDescriptor &desc)
+bool TlogParser::isIgnoredMessage(quint32 msgid)
+{
+    switch(msgid)
+    {
+    // Parameter, mission and command messages are useless for plotting.
+    case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+    case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+    case MAVLINK_MSG_ID_PARAM_VALUE:
+    case MAVLINK_MSG_ID_PARAM_SET:
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+    case MAVLINK_MSG_ID_COMMAND_ACK:
+    case MAVLINK_MSG_ID_MISSION_ITEM:
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+    case MAVLINK_MSG_ID_MISSION_ACK:
+    case MAVLINK_MSG_ID_DATA_STREAM:
+    case MAVLINK_MSG_ID_GPS_STATUS:
+    // Raw data transfer messages
+    case MAVLINK_MSG_ID_ENCAPSULATED_DATA:
+    case MAVLINK_MSG_ID_DATA_TRANSMISSION_HANDSHAKE:
+    case MAVLINK_MSG_ID_LOG_DATA:
+    // Only used to sync the clocks of vehicle and GCS
+    case MAVLINK_MSG_ID_SYSTEM_TIME:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool TlogParser::setupType(tlogTypeInfo &info)
+{
+    tlogDescriptor descriptor;
+    descriptor.m_ID = info.mp_messageInfo->msgid;
+    descriptor.m_name = info.mp_messageInfo->name;
+
+    QVector<fieldDecoder> decoders;
+    if(!parseDescriptor(*info.mp_messageInfo, descriptor, decoders))
+    {
+        return true;    // Error is already reported, messages of this type are skipped
+    }
+    descriptor.finalize(m_activeTimestamp);
+    if(!storeDescriptor(descriptor))
+    {
+        return false;
+    }
+
+    info.m_descriptor = descriptor;
+    const int typeIndex = m_dataStoragePtr->getTypeIndex(descriptor.m_name);
+    if(typeIndex == -1)
+    {
+        return true;    // invalid descriptor - messages of this type are skipped
+    }
+
+    info.m_timeColumnPtr = QSharedPointer<LogdataTypedColumn<quint64> >(new LogdataTypedColumn<quint64>());
+
+    QVector<LogdataColumn::Ptr> columns;
+    columns.reserve(decoders.size() + 1);
+    if(descriptor.hasNoTimestamp())
+    {
+        // The datamodel has an additional time stamp column at the front of the message
+        columns.push_back(info.m_timeColumnPtr);
+    }
+    for(int i = 0; i < decoders.size(); ++i)
+    {
+        if(!descriptor.hasNoTimestamp() && (i == descriptor.m_timeStampIndex))
+        {
+            // time stamps must be corrected while parsing - they are not decoded like the other fields
+            columns.push_back(info.m_timeColumnPtr);
+            info.m_timeFieldOffset = decoders.at(i).m_wireOffset;
+        }
+        else
+        {
+            columns.push_back(decoders.at(i).m_columnPtr);
+            info.m_decoders.push_back(decoders.at(i));
+        }
+    }
+
+    if(m_dataStoragePtr->setDataColumns(typeIndex, columns))
+    {
+        info.m_typeIndex = typeIndex;
+    }
+    else
+    {
+        QLOG_WARN() << "TlogParser::setupType():" << m_dataStoragePtr->getError();
+        m_logLoadingState.corruptFMTRead(static_cast<int>(m_MessageCounter), m_dataStoragePtr->getError());
+    }
+    return true;
+}
+
+bool TlogParser::parseDescriptor(const mavlink_message_info_t &messageInfo, tlogDescriptor &desc, QVector<fieldDecoder> &decoders)
 {
-    QList<QString> fieldnames = m_mavDecoderPtr->getFieldList(desc.m_name);
-    for (int i = 0; i < fieldnames.size(); ++i)
+    for (unsigned int i = 0; i < messageInfo.num_fields; ++i)
     {
-        mavlink_field_info_t fieldinfo = m_mavDecoderPtr->getFieldInfo(desc.m_name, fieldnames.at(i));
+        const mavlink_field_info_t &fieldinfo = messageInfo.fields[i];
 
         switch (fieldinfo.type)
         {
             case MAVLINK_TYPE_CHAR:
             {
-                desc.m_labels.push_back(fieldinfo.name);
                 if (fieldinfo.array_length == 0)
                 {
-                    desc.m_format += "b";   // it is a single byte
-                    desc.m_length += 1;
+                    extractDescriptorDataFields<qint8>(desc, decoders, fieldinfo, 'b');   // it is a single byte
                 }
                 else
                 {
+                    desc.m_labels.push_back(fieldinfo.name);
                     desc.m_format += "Z";   // everything else is a string
                     desc.m_length += 64;
+
+                    fieldDecoder decoder;
+                    decoder.m_wireOffset = static_cast<int>(fieldinfo.wire_offset);
+                    decoder.m_length = static_cast<int>(fieldinfo.array_length);
+                    decoder.m_append = &appendString;
+                    decoder.m_columnPtr = LogdataColumn::Ptr(new LogdataStringColumn());
+                    decoders.push_back(decoder);
                 }
             }
             break;
             case MAVLINK_TYPE_UINT8_T:
             {
-                 extractDescriptorDataFields(desc, fieldinfo, "B", 1);
+                extractDescriptorDataFields<quint8>(desc, decoders, fieldinfo, 'B');
             }
             break;
             case MAVLINK_TYPE_INT8_T:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "b", 1);
+                extractDescriptorDataFields<qint8>(desc, decoders, fieldinfo, 'b');
             }
             break;
             case MAVLINK_TYPE_UINT16_T:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "H", 2);
+                extractDescriptorDataFields<quint16>(desc, decoders, fieldinfo, 'H');
             }
             break;
             case MAVLINK_TYPE_INT16_T:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "h", 2);
+                extractDescriptorDataFields<qint16>(desc, decoders, fieldinfo, 'h');
             }
             break;
             case MAVLINK_TYPE_UINT32_T:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "I", 4);
+                extractDescriptorDataFields<quint32>(desc, decoders, fieldinfo, 'I');
             }
             break;
             case MAVLINK_TYPE_INT32_T:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "i", 4);
+                extractDescriptorDataFields<qint32>(desc, decoders, fieldinfo, 'i');
             }
             break;
             case MAVLINK_TYPE_FLOAT:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "f", 4);
+                extractDescriptorDataFields<float>(desc, decoders, fieldinfo, 'f');
             }
             break;
             case MAVLINK_TYPE_DOUBLE:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "d", 8);
+                extractDescriptorDataFields<double>(desc, decoders, fieldinfo, 'd');
             }
             break;
             case MAVLINK_TYPE_UINT64_T:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "Q", 8);
+                extractDescriptorDataFields<quint64>(desc, decoders, fieldinfo, 'Q');
             }
             break;
             case MAVLINK_TYPE_INT64_T:
             {
-                extractDescriptorDataFields(desc, fieldinfo, "q", 8);
+                extractDescriptorDataFields<qint64>(desc, decoders, fieldinfo, 'q');
             }
             break;
             default:
@@ -297,31 +415,38 @@ bool TlogParser::parseDescriptor(tlogDescriptor &desc)
     return true;
 }
 
-void TlogParser::extractDescriptorDataFields(tlogDescriptor &desc, const mavlink_field_info_t &fieldInfo, const QString &format, int size)
+template <typename T>
+void TlogParser::extractDescriptorDataFields(tlogDescriptor &desc, QVector<fieldDecoder> &decoders,
+                                             const mavlink_field_info_t &fieldInfo, char format)
 {
-    if(fieldInfo.array_length == 0)
+    // a single value is handled like an array with one element
+    const unsigned int count = fieldInfo.array_length == 0 ? 1 : fieldInfo.array_length;
+    for (unsigned int i = 0; i < count; ++i)
     {
-        // extract single value
-        desc.m_labels.push_back(fieldInfo.name);
-        desc.m_format += format;
-        desc.m_length += size;
-    }
-    else
-    {
-        for (unsigned int i = 0; i < fieldInfo.array_length; ++i)
+        if(fieldInfo.array_length == 0)
+        {
+            // extract single value
+            desc.m_labels.push_back(fieldInfo.name);
+        }
+        else
         {
             // extract array value
             QString name(fieldInfo.name);
             name.append('-');
             name.append(QString::number(i));
             desc.m_labels.push_back(name);
-            desc.m_format += format;
-            desc.m_length += size;
         }
+        desc.m_format += format;
+        desc.m_length += static_cast<int>(sizeof(T));
+
+        fieldDecoder decoder;
+        decoder.m_wireOffset = static_cast<int>(fieldInfo.wire_offset + i * sizeof(T));
+        decoder.m_append = &appendValue<T>;
+        decoder.m_columnPtr = LogdataColumn::Ptr(new LogdataTypedColumn<T>());
+        decoders.push_back(decoder);
     }
 }
 
-
 bool TlogParser::storeDescriptor(tlogDescriptor desc)
 {
     if(desc.isValid())
@@ -343,90 +468,45 @@ bool TlogParser::storeDescriptor(tlogDescriptor desc)
     return true;
 }
 
-bool TlogParser::decodeData(const mavlink_message_t &mavlinkMessage, QList<NameValuePair> &NameValuePairList)
+void TlogParser::storeMessage(const mavlink_message_t &mavlinkMessage, tlogTypeInfo &info)
 {
-    bool success = true;
-    mp_ReceiveData = &NameValuePairList;
+    const char *p_payload = _MAV_PAYLOAD(&mavlinkMessage);
 
-    m_mavDecoderPtr->decodeMessage(mavlinkMessage);
-
-    if(NameValuePairList.empty())
+    quint64 timeStamp = 0;
+    if(info.m_timeFieldOffset < 0)
     {
-        success = false;
+        timeStamp = highestTimestamp();
     }
-
-    mp_ReceiveData = nullptr;
-    return success;
-}
-
-void TlogParser::newValue(int uasId, const QString &name, const QString &unit, const QVariant &value, quint64 msec)
-{
-    Q_UNUSED(uasId)
-    Q_UNUSED(msec)
-    Q_UNUSED(unit)
-
-    // the name of the expected data looks like this:
-    // "M1:RAW_IMU.time_usec" in standart case
-    // "M1:BATTERY_STATUS.voltages.0" in case of an array
-
-    if((mp_ReceiveData != nullptr) && value.isValid())
+    else
     {
-        QStringList list = name.split(".");
-        if(list.size() == 2)
-        {   // handle standart data
-            mp_ReceiveData->append(NameValuePair(list[1], value));
-        }
-        else if(list.size() == 3)
-        {   // handle array data
-            QString name(list[1] + "-" + list[2]);
-            mp_ReceiveData->append(NameValuePair(name, value));
-        }
-        else
-        {
-            QLOG_WARN() << "Missing data type information. Message:" << name <<  ":"
-                        << value.toString();
-            m_logLoadingState.corruptDataRead(static_cast<int>(m_MessageCounter),
-                                              "Missing data type information. Message:" + name +
-                                              ":" + value.toString());
-        }
+        quint32 timeBootMs = 0;
+        memcpy(&timeBootMs, p_payload + info.m_timeFieldOffset, sizeof(timeBootMs));
+        timeStamp = handleTimeStamp(timeBootMs, info.m_descriptor.m_name);
     }
-}
-
-void TlogParser::newTextValue(int uasId, int componentId, int severity, const QString &text)
-{
-    Q_UNUSED(uasId)
-    Q_UNUSED(componentId)
-    Q_UNUSED(severity)
+    info.m_timeColumnPtr->appendValue(timeStamp);
 
-    // The date we are expecting looks like this:
-    // M1:STATUSTEXT.text: ArduCopter V3.6-dev (12a53ed6)
-    // M1:STATUSTEXT.text: Frame: QUAD
-
-    if(mp_ReceiveData != nullptr && text.contains(':'))
+    for(const auto &decoder : qAsConst(info.m_decoders))
     {
-         // we remove the "M1:STATUSTEXT.text:" part
-        int index = text.indexOf(':') + 1;
-        index = text.indexOf(':', index) + 1;
-
-        if(index != -1)
-        {
-            mp_ReceiveData->append(NameValuePair("text", text.mid(index)));
-        }
+        decoder.m_append(*decoder.m_columnPtr, p_payload + decoder.m_wireOffset, decoder.m_length);
     }
+    m_dataStoragePtr->addLazyDataRow(info.m_typeIndex, timeStamp);
+
+    m_logLoadingState.validDataRead();
+    m_MessageCounter++;
 }
 
-bool TlogParser::extractModeMessage(const QList<NameValuePair> &NameValuePairList)
+bool TlogParser::extractModeMessage(const mavlink_heartbeat_t &heartbeat)
 {
     // Tlog does not contain MODE messages the mode information ins transmitted in
     // a heartbeat message. So here we extract MODE data from heartbeat
 
     // Only if mode val has canged
-    if (m_lastModeVal != static_cast<quint8>(NameValuePairList[4].second.toInt()))
+    if (m_lastModeVal != static_cast<quint8>(heartbeat.custom_mode))
     {
         QList<NameValuePair> modeValuePairlist;
         tlogDescriptor modeDesc = m_nameToDescriptorMap.value(ModeMessage::TypeName);
         // Extract MODE messages from heartbeat messages
-        m_lastModeVal = static_cast<quint8>(NameValuePairList[4].second.toInt());
+        m_lastModeVal = static_cast<quint8>(heartbeat.custom_mode);
 
         modeValuePairlist.append(QPair<QString, QVariant>(modeDesc.m_labels[0], nextValidTimestamp()));
         modeValuePairlist.append(QPair<QString, QVariant>(modeDesc.m_labels[1], m_lastModeVal));
@@ -442,17 +522,18 @@ bool TlogParser::extractModeMessage(const QList<NameValuePair> &NameValuePairLis
     return true;
 }
 
-bool TlogParser::extractMsgMessage(const QList<NameValuePair> &NameValuePairList)
+bool TlogParser::extractMsgMessage(const mavlink_statustext_t &statustext)
 {
     // Tlog does not contain MSG messages the MSG information ins transmitted in
     // a statustext message. So here we extract MSG data from statustext
     QList<NameValuePair> msgValuePairlist;
     tlogDescriptor msgDesc = m_nameToDescriptorMap.value(MsgMessage::TypeName);
 
-    if((msgDesc.m_labels.size() >= 2) && (NameValuePairList.size() >= 2))
+    if(msgDesc.m_labels.size() >= 3)
     {
+        const QString text = QString::fromLatin1(statustext.text, static_cast<int>(qstrnlen(statustext.text, sizeof(statustext.text))));
         msgValuePairlist.append(QPair<QString, QVariant>(msgDesc.m_labels[0], nextValidTimestamp()));
-        msgValuePairlist.append(QPair<QString, QVariant>(msgDesc.m_labels[1], NameValuePairList[2].second));
+        msgValuePairlist.append(QPair<QString, QVariant>(msgDesc.m_labels[1], text));
         msgValuePairlist.append(QPair<QString, QVariant>(msgDesc.m_labels[2], "Generated from statustext"));
         if (!storeNameValuePairList(msgValuePairlist, msgDesc))
         {
@@ -465,4 +546,3 @@ bool TlogParser::extractMsgMessage(const QList<NameValuePair> &NameValuePairList
     }
     return true;
 }
-
@@ -32,16 +32,24 @@ This file is part of the APM_PLANNER project
 #include "ILogParser.h"
 #include "IParserCallback.h"
 #include "LogParserBase.h"
-#include "MAVLinkDecoder.h"
 #include "LogdataStorage.h"
 
+#include <mavlink.h>
+
+#include <QHash>
+#include <QVector>
+
 /**
  * @brief The TlogParser class is a parser for tlog ArduPilot
  *        logfiles (.tlog extension).
+ *
+ *        The payload of every message is decoded directly using the field offsets
+ *        of the mavlink message info. The values are appended to typed columns which
+ *        are handed over to the datamodel, so there is no conversion to strings or
+ *        QVariants for the bulk of the data.
  */
-class TlogParser : public QObject, public LogParserBase
+class TlogParser : public LogParserBase
 {
-    Q_OBJECT
 public:
     /**
      * @brief TlogParser - CTOR
@@ -63,27 +71,10 @@ public:
      */
     virtual AP2DataPlotStatus parse(QFile &logfile) override;
 
-    /**
-     * @brief newValue - Callback for the mavlink decoder - called for every decoded value
-     * @param uasId - UAS ID
-     * @param name  - Name of the value
-     * @param unit  - Unit / data type
-     * @param value - the value itself
-     * @param msec  - some sort of timestamp
-     */
-    void newValue(int uasId, const QString &name, const QString &unit, const QVariant &value, quint64 msec);
-
-    /**
-     * @brief newTextValue - Callback for the mavlink decoder - called for every decoded string
-     * @param uasId         - UAS ID
-     * @param componentId   - Component ID
-     * @param severity      - severity
-     * @param text          - The text
-     */
-    void newTextValue(int uasId, int componentId, int severity, const QString &text);
-
 private:
 
+    static constexpr int s_ReadBlockSize = 1024 * 1024;   /// Size of the blocks read from the log file
+
     /**
      * @brief The tlogDescriptor class provides a specialized typeDescriptor
      *        with an own isValid method.
@@ -94,18 +85,50 @@ private:
         virtual bool isValid() const override;
     };
 
+    /**
+     * @brief appendFunction - type of the functions decoding one field of the payload
+     *        and appending it to its column.
+     */
+    using appendFunction = void (*)(LogdataColumn &column, const char *field, int length);
+
+    /**
+     * @brief The fieldDecoder struct holds everything needed to decode one value
+     *        of a message. Every element of an array has its own decoder.
+     */
+    struct fieldDecoder
+    {
+        int m_wireOffset = 0;               /// Byte offset of the value in the payload
+        int m_length = 0;                   /// Length of char arrays, 0 for all other types
+        appendFunction m_append = nullptr;  /// Decodes the value and appends it to m_columnPtr
+        LogdataColumn::Ptr m_columnPtr;     /// The column of the datamodel holding the values
+    };
+
+    /**
+     * @brief The tlogTypeInfo struct holds everything needed to store the messages
+     *        of one message ID.
+     */
+    struct tlogTypeInfo
+    {
+        const mavlink_message_info_t *mp_messageInfo = nullptr;  /// mavlink info of the message
+        tlogDescriptor m_descriptor;                             /// descriptor of this type
+        int m_typeIndex = -1;                                    /// Index of the type in the datamodel, -1 if not stored
+        int m_timeFieldOffset = -1;                              /// Byte offset of time_boot_ms in payload, -1 if there is none
+        QVector<fieldDecoder> m_decoders;                        /// one decoder for every value except the time stamp
+        QSharedPointer<LogdataTypedColumn<quint64> > m_timeColumnPtr;  /// the corrected time stamps
+    };
+
     QHash<QString, tlogDescriptor> m_nameToDescriptorMap;   /// hashMap storing a format descriptor for every message type
 
+    QHash<quint32, mavlink_message_info_t> m_messageInfo;   /// mavlink info of every known message ID
+    QHash<quint32, tlogTypeInfo> m_typeInfo;                /// storage info for every message ID seen in the log
+
     QByteArray m_dataBlock;                 /// Data buffer for parsing.
 
-    QScopedPointer<MAVLinkDecoder> m_mavDecoderPtr;     /// pointer to mavlink decoder
+    mavlink_message_t m_rxMessage;          /// message being framed
+    mavlink_status_t m_rxStatus;            /// framing state
 
     quint8 m_lastModeVal;       /// holds the current mode used to detect changes
 
-    QList<NameValuePair> *mp_ReceiveData;  /// pointer to the data structure for receiving data
-
-    quint8 m_GCSMavID = QGC::MavlinkID();  /// sys id of Ground station
-
     /**
      * @brief addMissingDescriptors adds the missing type descriptors to the
      *        database. tlogs do not have a message for MODE or MSG messages
@@ -115,23 +138,42 @@ private:
     void addMissingDescriptors();
 
     /**
-     * @brief parseDescriptor extracts the descriptor data from tlog messages.
-     *        It reads its data direcly from the mavlink decoder.
+     * @brief isIgnoredMessage - true for all messages which are not stored as they
+     *        are useless for plotting like parameter, mission and command messages.
+     * @param msgid - ID of the message
+     */
+    static bool isIgnoredMessage(quint32 msgid);
+
+    /**
+     * @brief setupType creates the descriptor of a message ID, stores it in the
+     *        datamodel and creates the typed columns for its values.
+     * @param info - the info to set up. mp_messageInfo must be valid.
+     * @return true - success, false - datamodel failure
+     */
+    bool setupType(tlogTypeInfo &info);
+
+    /**
+     * @brief parseDescriptor extracts the descriptor data from the mavlink message info
+     *        and creates a decoder for every value.
+     * @param messageInfo - The mavlink info of the message
      * @param desc - The descriptor is filled.
+     * @param decoders - filled with one decoder for every label of the descriptor
      * @return - true - success, false - data could not be parsed
      */
-    bool parseDescriptor(tlogDescriptor &desc);
+    bool parseDescriptor(const mavlink_message_info_t &messageInfo, tlogDescriptor &desc, QVector<fieldDecoder> &decoders);
 
     /**
      * @brief extractDataFields extracts the datafields of a descriptor. it is a helper
      *        used by parseDescriptor method. Maily handles the differences between single
      *        and array data.
      * @param desc - The tlog descriptor to add the datatfiled info
+     * @param decoders - a decoder for every added value is appended
      * @param fieldInfo - the mavlink fieldinfo descriptor where the data is extracted from
-     * @param format - the format type for the field
-     * @param size - the size of the data field in bytes
+     * @param format - the format type for the field. T must match it.
      */
-    void extractDescriptorDataFields(tlogDescriptor &desc, const mavlink_field_info_t &fieldInfo, const QString &format, int size);
+    template <typename T>
+    void extractDescriptorDataFields(tlogDescriptor &desc, QVector<fieldDecoder> &decoders,
+                                     const mavlink_field_info_t &fieldInfo, char format);
 
     /**
      * @brief storeDescriptor validates the descriptor adds a time stamp field
@@ -142,29 +184,28 @@ private:
     bool storeDescriptor(tlogDescriptor desc);
 
     /**
-     * @brief decodeData - decodes data from a mavlink message to a name value
-     *        pair list.
-     * @param mavlinkMessage - the message to decode
-     * @param NameValuePairList - the parsing result as list of NameValuePair
-     * @return true - success, false otherwise or no result
+     * @brief storeMessage decodes a mavlink message and stores its values
+     *        in the columns of its type.
+     * @param mavlinkMessage - the message to store
+     * @param info - the storage info of the message ID
      */
-    bool decodeData(const mavlink_message_t &mavlinkMessage, QList<NameValuePair> &NameValuePairList);
+    void storeMessage(const mavlink_message_t &mavlinkMessage, tlogTypeInfo &info);
 
     /**
      * @brief extractModeMessage - extracts the data needed for a MODE message from
-     *        a NameValuePair list of a tlog HEARTBEAT message and stores it in the datamodel.
-     * @param NameValuePairList - input data of a tlog HEARTBEAT message
+     *        a tlog HEARTBEAT message and stores it in the datamodel.
+     * @param heartbeat - the decoded HEARTBEAT message
      * @return - true success, false datamodel failure
      */
-    bool extractModeMessage(const QList<NameValuePair> &NameValuePairList);
+    bool extractModeMessage(const mavlink_heartbeat_t &heartbeat);
 
     /**
      * @brief extractMsgMessage extracts the data needed for a MSG message from
-     *        a NameValuePair list of a tlog STATUSTEXT message and stores it in the datamodel.
-     * @param NameValuePairList - input data of a tlog STATUSTEXT message
+     *        a tlog STATUSTEXT message and stores it in the datamodel.
+     * @param statustext - the decoded STATUSTEXT message
      * @return - true success, false datamodel failure
      */
-    bool extractMsgMessage(const QList<NameValuePair> &NameValuePairList);
+    bool extractMsgMessage(const mavlink_statustext_t &statustext);
 
 };
 
@@ -0,0 +1,202 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkRouterConfiguration
+ *          Settings of the frames forwarded from one link to others.
+ *
+ */
+
+#include "MAVLinkRouterConfiguration.h"
+#include "LinkManager.h"
+
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+MAVLinkRouterConfiguration::MAVLinkRouterConfiguration(int linkid, QWidget *parent) :
+    QGroupBox(tr("Forwarding"), parent),
+    m_linkId(linkid)
+{
+    mp_routeTable = new QTableWidget(0, ColumnCount, this);
+    mp_routeTable->setHorizontalHeaderLabels(QStringList() << tr("Target") << tr("SysID") << tr("CompID") << tr("Max rate")
+                                                           << tr("Frames") << tr("Bytes") << tr("Dropped"));
+    mp_routeTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mp_routeTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mp_routeTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    mp_routeTable->verticalHeader()->setVisible(false);
+    mp_routeTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    mp_routeTable->horizontalHeader()->setStretchLastSection(true);
+
+    mp_targetComboBox = new QComboBox(this);
+
+    // 0 matches all senders
+    mp_sysidSpinBox = new QSpinBox(this);
+    mp_sysidSpinBox->setRange(0, 255);
+    mp_sysidSpinBox->setSpecialValueText(tr("All"));
+    mp_compidSpinBox = new QSpinBox(this);
+    mp_compidSpinBox->setRange(0, 255);
+    mp_compidSpinBox->setSpecialValueText(tr("All"));
+
+    mp_rateSpinBox = new QSpinBox(this);
+    mp_rateSpinBox->setRange(0, 10000);
+    mp_rateSpinBox->setSuffix(tr(" Hz"));
+    mp_rateSpinBox->setSpecialValueText(tr("Unlimited"));
+
+    QPushButton *addButton = new QPushButton(tr("Add"), this);
+    mp_removeButton = new QPushButton(tr("Remove"), this);
+
+    QHBoxLayout *addLayout = new QHBoxLayout();
+    addLayout->addWidget(new QLabel(tr("To:"), this));
+    addLayout->addWidget(mp_targetComboBox, 1);
+    addLayout->addWidget(new QLabel(tr("SysID:"), this));
+    addLayout->addWidget(mp_sysidSpinBox);
+    addLayout->addWidget(new QLabel(tr("CompID:"), this));
+    addLayout->addWidget(mp_compidSpinBox);
+    addLayout->addWidget(new QLabel(tr("Max rate:"), this));
+    addLayout->addWidget(mp_rateSpinBox);
+    addLayout->addWidget(addButton);
+    addLayout->addWidget(mp_removeButton);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addWidget(mp_routeTable);
+    mainLayout->addLayout(addLayout);
+
+    connect(addButton, SIGNAL(clicked()), this, SLOT(addRoute()));
+    connect(mp_removeButton, SIGNAL(clicked()), this, SLOT(removeRoute()));
+    connect(LinkManager::instance()->getRouter(), SIGNAL(routesChanged()), this, SLOT(updateRoutes()));
+    connect(LinkManager::instance(), SIGNAL(newLink(int)), this, SLOT(updateRoutes()));
+    connect(LinkManager::instance(), SIGNAL(linkChanged(int)), this, SLOT(updateRoutes()));
+
+    m_statisticsTimer.setInterval(1000);
+    connect(&m_statisticsTimer, SIGNAL(timeout()), this, SLOT(updateStatistics()));
+
+    updateRoutes();
+}
+
+void MAVLinkRouterConfiguration::showEvent(QShowEvent *event)
+{
+    updateStatistics();
+    m_statisticsTimer.start();
+    QGroupBox::showEvent(event);
+}
+
+void MAVLinkRouterConfiguration::hideEvent(QHideEvent *event)
+{
+    m_statisticsTimer.stop();
+    QGroupBox::hideEvent(event);
+}
+
+void MAVLinkRouterConfiguration::updateRoutes()
+{
+    LinkManager *linkManager = LinkManager::instance();
+    MAVLinkRouter *router = linkManager->getRouter();
+
+    const int selectedTarget = mp_targetComboBox->currentData().toInt();
+    mp_targetComboBox->clear();
+    foreach (int linkId, linkManager->getLinks())
+    {
+        if (linkId != m_linkId)
+        {
+            mp_targetComboBox->addItem(linkManager->getLinkName(linkId), linkId);
+        }
+    }
+    const int selectedIndex = mp_targetComboBox->findData(selectedTarget);
+    mp_targetComboBox->setCurrentIndex(selectedIndex >= 0 ? selectedIndex : 0);
+
+    mp_routeTable->setRowCount(0);
+    foreach (int routeId, router->getRoutes())
+    {
+        const MAVLinkRouter::Route route = router->getRoute(routeId);
+        if (route.sourceLinkId != m_linkId)
+        {
+            continue;
+        }
+
+        const int row = mp_routeTable->rowCount();
+        mp_routeTable->insertRow(row);
+        QString targetName = linkManager->getLinkName(route.targetLinkId);
+        if (linkManager->getLink(route.targetLinkId) == nullptr)
+        {
+            targetName = tr("Removed link %1").arg(route.targetLinkId);
+        }
+        QTableWidgetItem *targetItem = new QTableWidgetItem(targetName);
+        targetItem->setData(Qt::UserRole, routeId);
+        mp_routeTable->setItem(row, TargetColumn, targetItem);
+        mp_routeTable->setItem(row, SysidColumn, new QTableWidgetItem(route.sysid == 0 ? tr("All") : QString::number(route.sysid)));
+        mp_routeTable->setItem(row, CompidColumn, new QTableWidgetItem(route.compid == 0 ? tr("All") : QString::number(route.compid)));
+        mp_routeTable->setItem(row, RateColumn, new QTableWidgetItem(route.maxRate == 0 ? tr("Unlimited") : tr("%1 Hz").arg(route.maxRate)));
+        for (int column = FramesColumn; column < ColumnCount; ++column)
+        {
+            mp_routeTable->setItem(row, column, new QTableWidgetItem());
+        }
+    }
+
+    mp_removeButton->setEnabled(mp_routeTable->rowCount() > 0);
+    updateStatistics();
+}
+
+void MAVLinkRouterConfiguration::updateStatistics()
+{
+    MAVLinkRouter *router = LinkManager::instance()->getRouter();
+    for (int row = 0; row < mp_routeTable->rowCount(); ++row)
+    {
+        const int routeId = mp_routeTable->item(row, TargetColumn)->data(Qt::UserRole).toInt();
+        const MAVLinkRouter::RouteStatistics statistics = router->getStatistics(routeId);
+        mp_routeTable->item(row, FramesColumn)->setText(QString::number(statistics.forwardedFrames));
+        mp_routeTable->item(row, BytesColumn)->setText(QString::number(statistics.forwardedBytes));
+        mp_routeTable->item(row, DroppedColumn)->setText(QString::number(statistics.droppedFrames));
+    }
+}
+
+void MAVLinkRouterConfiguration::addRoute()
+{
+    if (mp_targetComboBox->currentIndex() < 0)
+    {
+        return;     // no other link to forward to
+    }
+
+    MAVLinkRouter::Route route;
+    route.sourceLinkId = m_linkId;
+    route.targetLinkId = mp_targetComboBox->currentData().toInt();
+    route.sysid = mp_sysidSpinBox->value();
+    route.compid = mp_compidSpinBox->value();
+    route.maxRate = mp_rateSpinBox->value();
+    LinkManager::instance()->getRouter()->addRoute(route);
+}
+
+void MAVLinkRouterConfiguration::removeRoute()
+{
+    const int row = mp_routeTable->currentRow();
+    if (row < 0)
+    {
+        return;
+    }
+    const int routeId = mp_routeTable->item(row, TargetColumn)->data(Qt::UserRole).toInt();
+    LinkManager::instance()->getRouter()->removeRoute(routeId);
+}
@@ -0,0 +1,94 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief MAVLinkRouterConfiguration
+ *          Settings of the frames forwarded from one link to others.
+ *
+ */
+
+#ifndef MAVLINKROUTERCONFIGURATION_H
+#define MAVLINKROUTERCONFIGURATION_H
+
+#include <QGroupBox>
+#include <QTimer>
+
+class QComboBox;
+class QPushButton;
+class QSpinBox;
+class QTableWidget;
+
+/**
+ * @brief The MAVLinkRouterConfiguration class lists the routes of the MAVLinkRouter
+ *        starting at one link together with their counters and allows to add and
+ *        remove routes. The routes are stored with the link settings.
+ */
+class MAVLinkRouterConfiguration : public QGroupBox
+{
+    Q_OBJECT
+
+public:
+    explicit MAVLinkRouterConfiguration(int linkid, QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    /**
+     * @brief updateRoutes - Rebuilds the route table and the list of target links
+     */
+    void updateRoutes();
+
+    /**
+     * @brief updateStatistics - Updates the counters of all routes in the table
+     */
+    void updateStatistics();
+
+    void addRoute();
+    void removeRoute();
+
+private:
+    enum routeColumns
+    {
+        TargetColumn,
+        SysidColumn,
+        CompidColumn,
+        RateColumn,
+        FramesColumn,
+        BytesColumn,
+        DroppedColumn,
+        ColumnCount
+    };
+
+    int m_linkId;                       /// id of the link the routes start at
+    QTableWidget *mp_routeTable;        /// one row per route, the route id is the data of the first column
+    QComboBox *mp_targetComboBox;
+    QSpinBox *mp_sysidSpinBox;
+    QSpinBox *mp_compidSpinBox;
+    QSpinBox *mp_rateSpinBox;
+    QPushButton *mp_removeButton;
+    QTimer m_statisticsTimer;           /// only runs while the widget is visible
+};
+
+#endif // MAVLINKROUTERCONFIGURATION_H
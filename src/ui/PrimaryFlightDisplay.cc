@@ -6,6 +6,7 @@
 #include <QRectF>
 #include <cmath>
 #include <QPen>
+#include <QHash>
 #include <QPainter>
 #include <QPainterPath>
 #include <QResizeEvent>
@@ -161,7 +162,8 @@ PrimaryFlightDisplay::PrimaryFlightDisplay(int width, int height, QWidget *paren
     instrumentOpagueBackground(QColor::fromHsvF(0, 0, 0.3, 1.0)),
 
     font("Bitstream Vera Sans"),
-    refreshTimer(new QTimer(this))
+    refreshTimer(new QTimer(this)),
+    m_compassRoseLabels(false)
 {
     Q_UNUSED(width);
     Q_UNUSED(height);
@@ -184,7 +186,7 @@ PrimaryFlightDisplay::PrimaryFlightDisplay(int width, int height, QWidget *paren
     // Refresh timer
     refreshTimer->setInterval(updateInterval);
     //    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(paintHUD()));
-    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(update()));
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshIfChanged()));
 }
 
 PrimaryFlightDisplay::~PrimaryFlightDisplay()
@@ -192,6 +194,43 @@ PrimaryFlightDisplay::~PrimaryFlightDisplay()
     refreshTimer->stop();
 }
 
+const InstrumentRefresh &PrimaryFlightDisplay::instrumentRefresh() const
+{
+    return m_refresh;
+}
+
+void PrimaryFlightDisplay::refreshIfChanged()
+{
+    if (m_refresh.needsRepaint(displayState()))
+    {
+        update();
+    }
+}
+
+QVector<qint64> PrimaryFlightDisplay::displayState() const
+{
+    // Pixels per unit, approximated from the layout in doPaint()
+    const qreal arcPerDegree = width() * M_PI / 360.0;      // at half the width from the center
+    const qreal pitchPerDegree = height() / PITCHTRANSLATION;
+    const qreal tapeHalfHeight = height() * 0.45;
+    const qreal speedStep = (AIRSPEED_LINEAR_SPAN / 2.0) / tapeHalfHeight;
+
+    QVector<qint64> state;
+    state << width() << height()
+          << InstrumentRefresh::quantize(roll, 1.0 / arcPerDegree)
+          << InstrumentRefresh::quantize(pitch, 1.0 / pitchPerDegree)
+          << InstrumentRefresh::quantize(heading, 1.0 / arcPerDegree)
+          << InstrumentRefresh::quantize(m_altitudeRelative, (ALTIMETER_LINEAR_SPAN / 2.0) / tapeHalfHeight)
+          << InstrumentRefresh::quantize(m_altitudeAMSL, 1.0)
+          << InstrumentRefresh::quantize(m_climbRate / 4.0, ALTIMETER_VVI_SPAN / tapeHalfHeight)
+          << InstrumentRefresh::quantize(m_groundspeed, qMin(0.1, speedStep))
+          << InstrumentRefresh::quantize(m_airspeed, speedStep)
+          << InstrumentRefresh::quantize(navigationCrosstrackError, 1.0)
+          << InstrumentRefresh::quantize(navigationTargetBearing, 1.0)
+          << preArmCheckFailure << qHash(preArmCheckMessage);
+    return state;
+}
+
 
 QSize PrimaryFlightDisplay::sizeHint() const
 {
@@ -232,6 +271,10 @@ void PrimaryFlightDisplay::resizeEvent(QResizeEvent *e) {
     mediumTextSize = size * MEDIUM_TEXT_SIZE;
     largeTextSize = size * LARGE_TEXT_SIZE;
 
+    // The static layers depend on the size and the line widths
+    m_airframeLayer = QPixmap();
+    m_compassRose = QPixmap();
+
     /*
      * Try without layout Change-O-Matic. It was too complicated.
     qreal aspect = e->size().width() / e->size().height();
@@ -246,7 +289,9 @@ void PrimaryFlightDisplay::resizeEvent(QResizeEvent *e) {
 void PrimaryFlightDisplay::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event);
+    m_refresh.beginFrame();
     doPaint();
+    m_refresh.endFrame();
 }
 
 ///*
@@ -805,20 +850,9 @@ void PrimaryFlightDisplay::drawAIAttitudeScales(
     drawPitchScale(painter, area, intrusion, true, true);
 }
 
-void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, float halfspan) {
-    float displayHeading = this->heading;
-    if(displayHeading == UNKNOWN_ATTITUDE)
-        displayHeading = 0;
-
-    float start = displayHeading - halfspan;
-    float end = displayHeading + halfspan;
-
-    int firstTick = ceil(start / COMPASS_DISK_RESOLUTION) * COMPASS_DISK_RESOLUTION;
-    int lastTick = floor(end / COMPASS_DISK_RESOLUTION) * COMPASS_DISK_RESOLUTION;
-
+void PrimaryFlightDisplay::drawCompassRose(QPainter& painter, QRectF area, bool drawLabels) {
     float radius = area.width()/2;
     float innerRadius = radius * 0.96;
-    painter.resetTransform();
     painter.setBrush(instrumentBackground);
     painter.setPen(instrumentEdgePen);
     painter.drawEllipse(area);
@@ -827,23 +861,16 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
     QPen scalePen(Qt::black);
     scalePen.setWidthF(fineLineWidth);
 
-    for (int tickYaw = firstTick; tickYaw <= lastTick; tickYaw += COMPASS_DISK_RESOLUTION) {
-        int displayTick = tickYaw;
-        if (displayTick < 0) displayTick+=360;
-        else if (displayTick>=360) displayTick-=360;
-
-        // yaw is in center.
-        float off = tickYaw - displayHeading;
-        // wrap that to ]-180..180]
-        if (off<=-180) off+= 360; else if (off>180) off -= 360;
+    QTransform savedTransform = painter.transform();
 
+    for (int displayTick = 0; displayTick < 360; displayTick += COMPASS_DISK_RESOLUTION) {
         painter.translate(area.center());
-        painter.rotate(off);
+        painter.rotate(displayTick);
         bool drewArrow = false;
         bool isMajor = displayTick % COMPASS_DISK_MAJORTICK == 0;
 
         // If heading unknown, still draw marks but no numbers.
-        if (this->heading != UNKNOWN_ATTITUDE &&
+        if (drawLabels &&
                 (displayTick==30 || displayTick==60 ||
                 displayTick==120 || displayTick==150 ||
                 displayTick==210 || displayTick==240 ||
@@ -868,7 +895,7 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
                     drewArrow = true;
                 }
                 // If heading unknown, still draw marks but no N S E W.
-                if (this->heading != UNKNOWN_ATTITUDE && displayTick%90 == 0) {
+                if (drawLabels && displayTick%90 == 0) {
                     // Also draw a label
                     QString name = compassWindNames[displayTick / 45];
                     painter.setPen(scalePen);
@@ -883,8 +910,41 @@ void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area, flo
 
         painter.setPen(scalePen);
         painter.drawLine(p_start, p_end);
-        painter.resetTransform();
+        painter.setTransform(savedTransform);
     }
+}
+
+void PrimaryFlightDisplay::drawAICompassDisk(QPainter& painter, QRectF area) {
+    float displayHeading = this->heading;
+    if(displayHeading == UNKNOWN_ATTITUDE)
+        displayHeading = 0;
+
+    float radius = area.width()/2;
+
+    // The disk only depends on the size, it is rendered once and rotated to the heading.
+    // Without heading it is drawn without labels.
+    bool drawLabels = this->heading != UNKNOWN_ATTITUDE;
+    qreal roseMargin = qCeil(instrumentEdgePen.widthF()) + 1;
+    if (m_compassRose.isNull() || m_compassRoseLabels != drawLabels) {
+        QSize roseSize(qCeil(area.width() + roseMargin*2), qCeil(area.height() + roseMargin*2));
+        m_compassRose = InstrumentRefresh::createLayer(this, roseSize);
+        m_compassRoseLabels = drawLabels;
+
+        QPainter rosePainter(&m_compassRose);
+        rosePainter.setRenderHint(QPainter::Antialiasing, true);
+        rosePainter.setRenderHint(QPainter::HighQualityAntialiasing, true);
+        drawCompassRose(rosePainter, QRectF(roseMargin, roseMargin, area.width(), area.height()), drawLabels);
+    }
+
+    QPen scalePen(Qt::black);
+    scalePen.setWidthF(fineLineWidth);
+
+    painter.resetTransform();
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+    painter.translate(area.center());
+    painter.rotate(-displayHeading);
+    painter.drawPixmap(QPointF(-radius-roseMargin, -area.height()/2-roseMargin), m_compassRose);
+    painter.resetTransform();
 
     painter.setPen(scalePen);
     //painter.setBrush(Qt::SolidPattern);
@@ -1271,7 +1331,6 @@ void PrimaryFlightDisplay::doPaint() {
     painter.fillRect(rect(), Qt::black);
     qreal tapeGaugeWidth;
 
-    qreal compassHalfSpan = 180;
     float compassAIIntrusion = 0;
 
     switch(layout) {
@@ -1408,11 +1467,6 @@ void PrimaryFlightDisplay::doPaint() {
                              compassSize,
                              compassSize);
 
-        if (height()-compassCenterY < compassSize/2) {
-            compassHalfSpan = acos((compassCenterY-height())*2/compassSize) * 180/M_PI + COMPASS_DISK_RESOLUTION;
-            if (compassHalfSpan > 180) compassHalfSpan = 180;
-        }
-
         compassAIIntrusion = compassSize/2 + AIMainArea.bottom() - compassCenterY;
         if (compassAIIntrusion<0) compassAIIntrusion = 0;
 
@@ -1499,12 +1553,31 @@ void PrimaryFlightDisplay::doPaint() {
 
     drawAIGlobalFeatures(painter, AIMainArea, AIPaintArea);
     drawAIAttitudeScales(painter, AIMainArea, compassAIIntrusion);
-    drawAIAirframeFixedFeatures(painter, AIMainArea);
+
+    // The airframe features are fixed, render them once per size
+    if (m_airframeLayer.isNull()) {
+        qreal w = AIMainArea.width();
+        qreal airframeMargin = qCeil(lineWidth * 1.5f) + 1;
+        QRectF bounds(AIMainArea.center().x() - w/2, AIMainArea.center().y() - w*ROLL_SCALE_RADIUS,
+                      w, w*ROLL_SCALE_RADIUS*2);
+        bounds.adjust(-airframeMargin, -airframeMargin, airframeMargin, airframeMargin);
+        bounds &= QRectF(rect());
+        m_airframeLayerPos = QPoint(qFloor(bounds.left()), qFloor(bounds.top()));
+        QSize layerSize(qCeil(bounds.right()) - m_airframeLayerPos.x(), qCeil(bounds.bottom()) - m_airframeLayerPos.y());
+        m_airframeLayer = InstrumentRefresh::createLayer(this, layerSize);
+
+        QPainter airframePainter(&m_airframeLayer);
+        airframePainter.setRenderHint(QPainter::Antialiasing, true);
+        airframePainter.setRenderHint(QPainter::HighQualityAntialiasing, true);
+        drawAIAirframeFixedFeatures(airframePainter, AIMainArea.translated(-m_airframeLayerPos));
+    }
+    painter.resetTransform();
+    painter.drawPixmap(m_airframeLayerPos, m_airframeLayer);
 
    // if(layout ==COMPASS_SEPARATED)
         //drawSeparateCompassDisk(painter, compassArea);
    // else
-        drawAICompassDisk(painter, compassArea, compassHalfSpan);
+        drawAICompassDisk(painter, compassArea);
 
     painter.setClipping(hadClip);
 
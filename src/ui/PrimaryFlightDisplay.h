@@ -3,7 +3,9 @@
 
 #include <QWidget>
 #include <QPen>
+#include <QPixmap>
 #include "UASInterface.h"
+#include "InstrumentRefresh.h"
 
 class PrimaryFlightDisplay : public QWidget
 {
@@ -12,6 +14,9 @@ public:
     PrimaryFlightDisplay(int width = 640, int height = 480, QWidget* parent = NULL);
     ~PrimaryFlightDisplay();
 
+    /** @brief Repaint statistics and frame time of this instrument */
+    const InstrumentRefresh &instrumentRefresh() const;
+
 public slots:
     /** @brief Attitude from main autopilot / system state */
     void updateAttitude(UASInterface* uas, double roll, double pitch, double yaw, quint64 timestamp);
@@ -65,6 +70,10 @@ protected:
 signals:
     void visibilityChanged(bool visible);
 
+private slots:
+    /** @brief Repaint if a displayed value changed by at least one pixel */
+    void refreshIfChanged();
+
 private:
     /*
     enum AltimeterMode {
@@ -99,7 +108,9 @@ private:
     void drawPitchScale(QPainter& painter, QRectF area, float intrusion, bool drawNumbersLeft, bool drawNumbersRight);
     void drawRollScale(QPainter& painter, QRectF area, bool drawTicks, bool drawNumbers);
     void drawAIAttitudeScales(QPainter& painter, QRectF area, float intrusion);
-    void drawAICompassDisk(QPainter& painter, QRectF area, float halfspan);
+    void drawAICompassDisk(QPainter& painter, QRectF area);
+    /** @brief Draw the rotating part of the compass disk for heading 0, centered on area */
+    void drawCompassRose(QPainter& painter, QRectF area, bool drawLabels);
     void drawSeparateCompassDisk(QPainter& painter, QRectF area);
 
     void drawAltimeter(QPainter& painter, QRectF area, float altitudeRelative, float altitudeAMSL, float vv);
@@ -116,6 +127,8 @@ private:
     */
 
     void doPaint();
+    /** @brief The displayed values quantized to the pixels they move, see InstrumentRefresh */
+    QVector<qint64> displayState() const;
 
     UASInterface* uas;          ///< The uas currently monitored
 
@@ -176,6 +189,13 @@ private:
     QFont font;
 
     QTimer* refreshTimer;       ///< The main timer, controls the update rate
+    InstrumentRefresh m_refresh;
+
+    // Static layers, rendered once per widget size
+    QPixmap m_airframeLayer;    ///< Fixed airframe symbol and roll marker
+    QPoint m_airframeLayerPos;
+    QPixmap m_compassRose;      ///< Compass disk for heading 0, rotated when painted
+    bool m_compassRoseLabels;   ///< m_compassRose has its labels, the heading is known
 
     static const int tickValues[];
     static const QString compassWindNames[];
@@ -1,10 +1,52 @@
 #include <QList>
+#include <iterator>
 
 #include "QGCMAVLinkInspector.h"
 #include "UASManager.h"
 #include "LinkManager.h"
 #include "ui_QGCMAVLinkInspector.h"
 
+namespace
+{
+/**
+ * @brief intervalRange delivers the range of the inter-arrival times between the
+ *        10th and the 90th percentile of a histogram like "16-64 ms"
+ */
+QString intervalRange(const quint64 *intervals)
+{
+    quint64 total = 0;
+    for (int bin = 0; bin < MAVLinkMessageStatistics::s_HistogramBins; ++bin)
+    {
+        total += intervals[bin];
+    }
+    if (total == 0)
+    {
+        return QString("---");
+    }
+
+    int low = -1;
+    int high = 0;
+    quint64 sum = 0;
+    for (int bin = 0; bin < MAVLinkMessageStatistics::s_HistogramBins; ++bin)
+    {
+        sum += intervals[bin];
+        if (low < 0 && sum * 10 >= total)
+        {
+            low = bin;
+        }
+        if (sum * 10 >= total * 9)
+        {
+            high = bin;
+            break;
+        }
+    }
+    if (high == MAVLinkMessageStatistics::s_HistogramBins - 1)
+    {
+        return QString(">%1 ms").arg(low > 0 ? 1 << (low - 1) : 0);
+    }
+    return QString("%1-%2 ms").arg(low > 0 ? 1 << (low - 1) : 0).arg(1 << high);
+}
+}
 
 QGCMAVLinkInspector::QGCMAVLinkInspector(QWidget *parent) :
     QWidget(parent),
@@ -54,7 +96,8 @@ QGCMAVLinkInspector::QGCMAVLinkInspector(QWidget *parent) :
 
     // Connect external connections
     connect(UASManager::instance(), QOverload<UASInterface*>::of(&UASManager::UASCreated), this, &QGCMAVLinkInspector::addSystem);
-    connect(LinkManager::instance(), QOverload<LinkInterface*, mavlink_message_t>::of(&LinkManager::messageReceived), this, &QGCMAVLinkInspector::receiveMessage);
+    // Direct connection: receiveMessage() only updates the lock-free statistics
+    connect(LinkManager::instance(), QOverload<LinkInterface*, mavlink_message_t>::of(&LinkManager::messageReceived), this, &QGCMAVLinkInspector::receiveMessage, Qt::DirectConnection);
 
     QList<UASInterface*> uasList = UASManager::instance()->getUASList();
     for(UASInterface *uas: qAsConst(uasList))
@@ -151,65 +194,16 @@ void QGCMAVLinkInspector::addComponent(int uas, int component, const QString& na
  */
 void QGCMAVLinkInspector::clearView()
 {
-    QMultiMap<int, mavlink_message_t* >::iterator ite;
-    for(ite=uasMessageStorage.begin(); ite!=uasMessageStorage.end();++ite)
-    {
-        delete ite.value();
-        ite.value() = NULL;
-    }
-    uasMessageStorage.clear();
-
-    QMap<int, QMultiMap<int, QTreeWidgetItem*>* >::iterator iteMsg;
-    for (iteMsg = uasMsgTreeItems.begin(); iteMsg!=uasMsgTreeItems.end();++iteMsg)
-    {
-        QMultiMap<int, QTreeWidgetItem*>* msgTreeItems = iteMsg.value();
+    messageStatistics.reset();
+    messageViews.clear();
 
-        QList<int> groupKeys = msgTreeItems->uniqueKeys();
-        QList<int>::iterator listKeys;
-        for (listKeys=groupKeys.begin();listKeys!=groupKeys.end();++listKeys)
-        {
-            delete msgTreeItems->take(*listKeys);
-        }
-    }
+    // The message widgets are deleted with the widget of their UAS
     uasMsgTreeItems.clear();
-
-    QMap<int, QTreeWidgetItem* >::iterator iteTree;
-    for(iteTree=uasTreeWidgetItems.begin(); iteTree!=uasTreeWidgetItems.end();++iteTree)
-    {
-        delete iteTree.value();
-        iteTree.value() = NULL;
-    }
+    qDeleteAll(uasTreeWidgetItems);
     uasTreeWidgetItems.clear();
-    
-    QMultiMap<int, QMap<int, float>* >::iterator iteHz;
-    for (iteHz=uasMessageHz.begin(); iteHz!=uasMessageHz.end();++iteHz)
-    {
-
-        iteHz.value()->clear();
-        delete iteHz.value();
-        iteHz.value() = NULL;
-    }
-    uasMessageHz.clear();
-
-    QMultiMap<int, QMap<int, unsigned int>* >::iterator iteCount;
-    for(iteCount=uasMessageCount.begin(); iteCount!=uasMessageCount.end();++iteCount)
-    {
-        iteCount.value()->clear();
-        delete iteCount.value();
-        iteCount.value() = NULL;
-    }
-    uasMessageCount.clear();
-
-    QMultiMap<int, QMap<int, quint64>* >::iterator iteLast;
-    for(iteLast=uasLastMessageUpdate.begin(); iteLast!=uasLastMessageUpdate.end();++iteLast)
-    {
-        iteLast.value()->clear();
-        delete iteLast.value();
-        iteLast.value() = NULL;
-    }
-    uasLastMessageUpdate.clear();
 
     onboardMessageInterval.clear();
+    rateTreeWidgetItems.clear();
 
     mp_Ui->treeWidget->clear();
     mp_Ui->rateTreeWidget->clear();
@@ -227,96 +221,29 @@ void QGCMAVLinkInspector::refreshView()
         mp_Ui->msg_lost->setText(message);
     }
 
-    QMultiMap<int, mavlink_message_t* >::const_iterator ite;
-
-    for(ite=uasMessageStorage.constBegin(); ite!=uasMessageStorage.constEnd();++ite)
+    // Grow the view with the statistics, a slot keeps its index forever
+    const int usedSlots = messageStatistics.usedSlots();
+    if (messageViews.size() < usedSlots)
     {
+        messageViews.resize(usedSlots);
+    }
 
-        mavlink_message_t* msg = ite.value();
-        // Ignore NULL values
-        if (msg->msgid == 0xFF) continue;
-
-        // Update the message frenquency
-
-        // Get the previous frequency for low-pass filtering
-        float msgHz = 0.0f;
-        QMultiMap<int, QMap<int, float>* >::const_iterator iteHz = uasMessageHz.find(msg->sysid);
-        QMap<int, float>* uasMsgHz = iteHz.value();
-
-        while((iteHz != uasMessageHz.end()) && (iteHz.key() == msg->sysid))
-        {
-            if(iteHz.value()->contains(msg->msgid))
-            {
-                uasMsgHz = iteHz.value();
-                msgHz = iteHz.value()->value(msg->msgid);
-                break;
-            }
-            ++iteHz;
-        }
-
-        // Get the number of message received
-        float msgCount = 0;
-        QMultiMap<int, QMap<int, unsigned int> * >::const_iterator iter = uasMessageCount.find(msg->sysid);
-        QMap<int, unsigned int>* uasMsgCount = iter.value();
-
-        while((iter != uasMessageCount.end()) && (iter.key()==msg->sysid))
-        {
-            if(iter.value()->contains(msg->msgid))
-            {
-                msgCount = (float) iter.value()->value(msg->msgid);
-                uasMsgCount = iter.value();
-                break;
-            }
-            ++iter;
-        }
-
-        // Compute the new low-pass filtered frequency and update the message count
-        msgHz = (1.0f-updateHzLowpass)* msgHz + updateHzLowpass*msgCount/((float)updateInterval/1000.0f);
-        uasMsgHz->insert(msg->msgid,msgHz);
-        uasMsgCount->insert(msg->msgid,(unsigned int) 0);
-
-        // Update the tree view
-        QString messageName("%1 (%2 Hz, #%3)");
-        messageName = messageName.arg(messageInfo[msg->msgid].name).arg(msgHz, 3, 'f', 1).arg(msg->msgid);
-
-        addUAStoTree(msg->sysid);
-
-        // Look for the tree for the UAS sysid
-        QMultiMap<int, QTreeWidgetItem*>* msgTreeItems = uasMsgTreeItems.value(msg->sysid);
-        if (!msgTreeItems)
-        {
-            // The UAS tree has not been created yet, no update
-            return;
-        }
-
-        // Add the message with msgid to the tree if not done yet
-        if(!msgTreeItems->contains(msg->msgid))
+    MAVLinkMessageStatistics::messageStatistics statistics;
+    for (int i = 0; i < usedSlots; ++i)
+    {
+        if (!messageStatistics.read(i, statistics, nullptr))
         {
-            QStringList fields;
-            fields << messageName;
-            QTreeWidgetItem* widget = new QTreeWidgetItem();
-            for (unsigned int i = 0; i < messageInfo[msg->msgid].num_fields; ++i)
-            {
-                QTreeWidgetItem* field = new QTreeWidgetItem();
-                widget->addChild(field);
-            }
-            msgTreeItems->insert(msg->msgid,widget);
-            QList<int> groupKeys = msgTreeItems->uniqueKeys();
-            int insertIndex = groupKeys.indexOf(msg->msgid);
-            uasTreeWidgetItems.value(msg->sysid)->insertChild(insertIndex,widget);
+            continue;
         }
+        if (selectedSystemID != 0 && selectedSystemID != statistics.sysid) continue;
+        if (selectedComponentID != 0 && selectedComponentID != statistics.compid) continue;
 
-        // Update the message
-        QTreeWidgetItem* message = msgTreeItems->value(msg->msgid);
-        if(message)
+        if (statistics.count == 0 && !messageViews.at(i).item)
         {
-            message->setFirstColumnSpanned(true);
-            message->setData(0, Qt::DisplayRole, QVariant(messageName));
-            for (unsigned int i = 0; i < messageInfo[msg->msgid].num_fields; ++i)
-            {
-                updateField(msg->sysid,msg->msgid, i, message->child(i));
-            }
+            // Not received since the last clear
+            continue;
         }
+        updateMessage(i, statistics);
     }
 
     if (selectedSystemID == 0 || selectedComponentID == 0)
@@ -379,134 +306,113 @@ void QGCMAVLinkInspector::addUAStoTree(int sysId)
             uasWidget->setFirstColumnSpanned(true);
             uasTreeWidgetItems.insert(sysId,uasWidget);
             mp_Ui->treeWidget->addTopLevelItem(uasWidget);
-            uasMsgTreeItems.insert(sysId,new QMultiMap<int, QTreeWidgetItem*>());
+            uasMsgTreeItems.insert(sysId,QMap<quint32, QTreeWidgetItem*>());
         }
     }
 }
 
-void QGCMAVLinkInspector::receiveMessage(LinkInterface* link,mavlink_message_t message)
+void QGCMAVLinkInspector::updateMessage(int index, const MAVLinkMessageStatistics::messageStatistics &statistics)
 {
-    Q_UNUSED(link);
-
-    quint64 receiveTime;
-    
-    if (selectedSystemID != 0 && selectedSystemID != message.sysid) return;
-    if (selectedComponentID != 0 && selectedComponentID != message.compid) return;
-
-    // Create dynamically an array to store the messages for each UAS
-    if (!uasMessageStorage.contains(message.sysid))
+    messageView &view = messageViews[index];
+
+    // Rates since the last update, the counters may have been reset in between
+    const quint64 newMessages = statistics.count >= view.count ? statistics.count - view.count : statistics.count;
+    const quint64 newBytes = statistics.bytes >= view.bytes ? statistics.bytes - view.bytes : statistics.bytes;
+    quint64 newIntervals[MAVLinkMessageStatistics::s_HistogramBins];
+    QString intervalToolTip;
+    for (int bin = 0; bin < MAVLinkMessageStatistics::s_HistogramBins; ++bin)
     {
-        mavlink_message_t* msg = new mavlink_message_t;
-        *msg = message;
-        uasMessageStorage.insert(message.sysid,msg);
+        newIntervals[bin] = statistics.intervals[bin] >= view.intervals[bin] ? statistics.intervals[bin] - view.intervals[bin]
+                                                                              : statistics.intervals[bin];
+        view.intervals[bin] = statistics.intervals[bin];
+        if (newIntervals[bin] > 0)
+        {
+            intervalToolTip += tr("%1: %2\n").arg(MAVLinkMessageStatistics::intervalName(bin)).arg(newIntervals[bin]);
+        }
     }
+    view.count = statistics.count;
+    view.bytes = statistics.bytes;
+
+    const float seconds = static_cast<float>(updateInterval) / 1000.0f;
+    view.messageHz = (1.0f-updateHzLowpass) * view.messageHz + updateHzLowpass * newMessages / seconds;
+    view.bytesPerSecond = (1.0f-updateHzLowpass) * view.bytesPerSecond + updateHzLowpass * newBytes / seconds;
 
-    bool msgFound = false;
-    QMultiMap<int, mavlink_message_t* >::const_iterator iteMsg = uasMessageStorage.find(message.sysid);
-    mavlink_message_t* uasMessage = iteMsg.value();
-    while((iteMsg != uasMessageStorage.end()) && (iteMsg.key() == message.sysid))
+    const mavlink_message_info_t info = messageInfo.value(statistics.msgid);
+
+    // Update the tree view
+    QString messageName("%1 (%2 Hz, %3 B/s, %4, #%5, comp %6)");
+    messageName = messageName.arg(info.name).arg(view.messageHz, 3, 'f', 1).arg(view.bytesPerSecond, 3, 'f', 0)
+                             .arg(intervalRange(newIntervals)).arg(statistics.msgid).arg(statistics.compid);
+
+    if (!view.item)
     {
-        if (iteMsg.value()->msgid == message.msgid)
+        addUAStoTree(statistics.sysid);
+        QTreeWidgetItem* uasWidget = uasTreeWidgetItems.value(statistics.sysid);
+        if (!uasWidget)
         {
-            msgFound = true;
-            uasMessage = iteMsg.value();
-            break;
+            // The UAS tree has not been created yet, no update
+            return;
         }
-        ++iteMsg;
-    }
-    if (!msgFound)
-    {
-        mavlink_message_t* msgIdMessage = new mavlink_message_t;
-        *msgIdMessage = message;
-        uasMessageStorage.insert(message.sysid,msgIdMessage);
-    }
-    else
-    {
-        *uasMessage = message;
-    }
 
-    // Looking if this message has already been received once
-    msgFound = false;
-    QMultiMap<int, QMap<int, quint64>* >::const_iterator ite = uasLastMessageUpdate.find(message.sysid);
-    QMap<int, quint64>* lastMsgUpdate = ite.value();
-    while((ite != uasLastMessageUpdate.end()) && (ite.key() == message.sysid))
-    {   
-        if(ite.value()->contains(message.msgid))
+        // Add the message sorted by msgid and compid
+        QMap<quint32, QTreeWidgetItem*> &msgTreeItems = uasMsgTreeItems[statistics.sysid];
+        const quint32 key = (statistics.msgid << 8) | static_cast<quint32>(statistics.compid);
+        view.item = new QTreeWidgetItem();
+        for (unsigned int i = 0; i < info.num_fields; ++i)
         {
-            msgFound = true;
-
-            // Point to the found message
-            lastMsgUpdate = ite.value();
-            break;
+            view.item->addChild(new QTreeWidgetItem());
         }
-        ++ite;
+        const auto iter = msgTreeItems.insert(key, view.item);
+        uasWidget->insertChild(static_cast<int>(std::distance(msgTreeItems.begin(), iter)), view.item);
+        view.item->setFirstColumnSpanned(true);
+        view.fieldsFilled = false;
     }
 
-    receiveTime = QGC::groundTimeMilliseconds();
+    view.item->setData(0, Qt::DisplayRole, QVariant(messageName));
+    view.item->setToolTip(0, intervalToolTip.isEmpty() ? tr("No messages in the last second") : tr("Inter-arrival times:\n") + intervalToolTip.trimmed());
 
-    // If the message doesn't exist, create a map for the frequency, message count and time of reception
-    if(!msgFound)
-    {
-        // Create a map for the message frequency
-        QMap<int, float>* messageHz = new QMap<int,float>;
-        messageHz->insert(message.msgid,0.0f);
-        uasMessageHz.insert(message.sysid,messageHz);
-
-        // Create a map for the message count
-        QMap<int, unsigned int>* messagesCount = new QMap<int, unsigned int>;
-        messagesCount->insert(message.msgid,0);
-        uasMessageCount.insert(message.sysid,messagesCount);
-
-        // Create a map for the time of reception of the message
-        QMap<int, quint64>* lastMessage = new QMap<int, quint64>;
-        lastMessage->insert(message.msgid,receiveTime);
-        uasLastMessageUpdate.insert(message.sysid,lastMessage);
-
-        // Point to the created message
-        lastMsgUpdate = lastMessage;
-    }
-    else
+    // Fields are only decoded if they are visible
+    const bool updateFields = (newMessages > 0 || !view.fieldsFilled) && (view.item->isExpanded() || !view.fieldsFilled);
+    const bool dataStream = statistics.msgid == MAVLINK_MSG_ID_DATA_STREAM && newMessages > 0
+                            && selectedSystemID != 0 && selectedComponentID != 0;
+    if (!updateFields && !dataStream)
     {
-        // The message has been found/created
-        if ((lastMsgUpdate->contains(message.msgid))&&(uasMessageCount.contains(message.sysid)))
-        {
-            // Looking for and updating the message count
-            unsigned int count = 0;
-            QMultiMap<int, QMap<int, unsigned int>* >::const_iterator iter = uasMessageCount.find(message.sysid);
-            QMap<int, unsigned int> * uasMsgCount = iter.value();
-            while((iter != uasMessageCount.end()) && (iter.key() == message.sysid))
-            {
-                if(iter.value()->contains(message.msgid))
-                {
-                    uasMsgCount = iter.value();
-                    count = uasMsgCount->value(message.msgid,0);
-                    uasMsgCount->insert(message.msgid,count+1);
-                    break;
-                }
-                ++iter;
-            }
-        }
-        lastMsgUpdate->insert(message.msgid,receiveTime);
+        return;
     }
 
-    if (selectedSystemID == 0 || selectedComponentID == 0)
+    MAVLinkMessageStatistics::messageStatistics unused;
+    mavlink_message_t message;
+    if (!messageStatistics.read(index, unused, &message))
     {
         return;
     }
 
-    switch (message.msgid)
+    if (updateFields)
     {
-        case MAVLINK_MSG_ID_DATA_STREAM:
-            {
-                mavlink_data_stream_t stream;
-                mavlink_msg_data_stream_decode(&message, &stream);
-                onboardMessageInterval.insert(stream.stream_id, stream.message_rate);
-            }
-            break;
+        for (unsigned int i = 0; i < info.num_fields && static_cast<int>(i) < view.item->childCount(); ++i)
+        {
+            updateField(message, i, view.item->child(i));
+        }
+        view.fieldsFilled = true;
+    }
 
+    if (dataStream)
+    {
+        mavlink_data_stream_t stream;
+        mavlink_msg_data_stream_decode(&message, &stream);
+        onboardMessageInterval.insert(stream.stream_id, stream.message_rate);
     }
 }
 
+void QGCMAVLinkInspector::receiveMessage(LinkInterface* link,mavlink_message_t message)
+{
+    Q_UNUSED(link);
+
+    // Called in the thread of the sender for every message. Everything else
+    // is done by refreshView() in the GUI thread.
+    messageStatistics.record(message);
+}
+
 void QGCMAVLinkInspector::changeStreamInterval(int msgid, int interval)
 {
     Q_UNUSED(msgid)
@@ -549,38 +455,19 @@ QGCMAVLinkInspector::~QGCMAVLinkInspector()
     delete mp_Ui;
 }
 
-void QGCMAVLinkInspector::updateField(int sysid, int msgid, int fieldid, QTreeWidgetItem* item)
+void QGCMAVLinkInspector::updateField(mavlink_message_t &message, int fieldid, QTreeWidgetItem* item)
 {
     // Add field tree widget item
-    const auto p_messageInfo = messageInfo.find(static_cast<quint32>(msgid));
-    if(p_messageInfo == messageInfo.end())
+    const auto p_messageInfo = messageInfo.constFind(message.msgid);
+    if(p_messageInfo == messageInfo.constEnd())
     {
-        QLOG_INFO() << "No Mavlink message info for message ID:" << msgid << "Cannot send message!";
+        QLOG_INFO() << "No Mavlink message info for message ID:" << message.msgid << "Cannot show message!";
         return;
     }
 
     item->setData(0, Qt::DisplayRole, QVariant(p_messageInfo->fields[fieldid].name));
-    
-    bool msgFound = false;
-    QMultiMap<int, mavlink_message_t* >::const_iterator iteMsg = uasMessageStorage.find(sysid);
-    mavlink_message_t* uasMessage = iteMsg.value();
-    while((iteMsg != uasMessageStorage.end()) && (iteMsg.key() == sysid))
-    {
-        if (iteMsg.value()->msgid == msgid)
-        {
-            msgFound = true;
-            uasMessage = iteMsg.value();
-            break;
-        }
-        ++iteMsg;
-    }
-
-    if (!msgFound)
-    {
-        return;
-    }
 
-    const char *p_payload = _MAV_PAYLOAD(uasMessage);
+    const char *p_payload = _MAV_PAYLOAD(&message);
 
     switch (p_messageInfo->fields[fieldid].type)
     {
@@ -4,9 +4,11 @@
 #include <QWidget>
 #include <QTreeWidget>
 #include <QMap>
+#include <QVector>
 #include <QTimer>
 
 #include "MAVLinkProtocol.h"
+#include "MAVLinkMessageStatistics.h"
 
 namespace Ui {
     class QGCMAVLinkInspector;
@@ -70,18 +72,27 @@ private:
 
     QMap<int, QTreeWidgetItem* > uasTreeWidgetItems; ///< Tree of available uas with their widget
 
+    QMap<int, QMap<quint32, QTreeWidgetItem*> > uasMsgTreeItems; ///< Message widgets of each UAS by msgid and compid
 
-    QMap<int, QMultiMap<int, QTreeWidgetItem*>* > uasMsgTreeItems; ///< Stores the widget of the received message for each UAS
+    /** @brief State of the view of one message, only touched by the GUI thread */
+    struct messageView
+    {
+        QTreeWidgetItem* item {nullptr};    ///< Tree widget of the message, nullptr if not shown
+        quint64 count {0};                  ///< Message count at the last update
+        quint64 bytes {0};                  ///< Byte count at the last update
+        quint64 intervals[MAVLinkMessageStatistics::s_HistogramBins] {}; ///< Inter-arrival histogram at the last update
+        float messageHz {0.0f};             ///< Low-pass filtered message rate
+        float bytesPerSecond {0.0f};        ///< Low-pass filtered data rate
+        bool fieldsFilled {false};          ///< Field widgets were filled at least once
+    };
 
-    QMultiMap<int, mavlink_message_t* > uasMessageStorage; ///< Stores the messages for every UAS
-
-    QMultiMap<int, QMap<int, float>* > uasMessageHz; ///< Stores the frequency of each message of each UAS
-    QMultiMap<int, QMap<int, unsigned int>* > uasMessageCount; ///< Stores the message count of each message of each UAS
-
-    QMultiMap<int, QMap<int, quint64>* > uasLastMessageUpdate; ///< Stores the time of the last message for each message of each UAS
+    MAVLinkMessageStatistics messageStatistics;    ///< Statistics of all messages, written by the protocol thread
+    QVector<messageView> messageViews;              ///< View of each message by slot of messageStatistics
 
     /* @brief Update one message field */
-    void updateField(int sysid, int msgid, int fieldid, QTreeWidgetItem* item);
+    void updateField(mavlink_message_t &message, int fieldid, QTreeWidgetItem* item);
+    /** @brief Update the widget of one message, create it if needed */
+    void updateMessage(int index, const MAVLinkMessageStatistics::messageStatistics &statistics);
     /** @brief Rebuild the list of components */
     void rebuildComponentList();
     /** @brief Change the stream interval */
@@ -7,6 +7,7 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QDesktopServices>
+#include <QTime>
 
 QGCMAVLinkLogPlayer::QGCMAVLinkLogPlayer(QWidget *parent):
     QWidget(parent),
@@ -32,6 +33,9 @@ QGCMAVLinkLogPlayer::QGCMAVLinkLogPlayer(QWidget *parent):
     connect(ui->speedButton200,SIGNAL(clicked()),this,SLOT(speed200Clicked()));
     connect(ui->speedButton500,SIGNAL(clicked()),this,SLOT(speed500Clicked()));
     connect(ui->speedButton1000,SIGNAL(clicked()),this,SLOT(speed1000Clicked()));
+    connect(ui->speedButtonMax,SIGNAL(clicked()),this,SLOT(speedMaxClicked()));
+    connect(ui->stepForwardButton,SIGNAL(clicked()),this,SLOT(stepForwardClicked()));
+    connect(ui->stepBackwardButton,SIGNAL(clicked()),this,SLOT(stepBackwardClicked()));
 
     ui->speedButton75->setEnabled(false);
     ui->speedButton100->setEnabled(false);
@@ -39,6 +43,7 @@ QGCMAVLinkLogPlayer::QGCMAVLinkLogPlayer(QWidget *parent):
     ui->speedButton200->setEnabled(false);
     ui->speedButton500->setEnabled(false);
     ui->speedButton1000->setEnabled(false);
+    ui->speedButtonMax->setEnabled(false);
 }
 void QGCMAVLinkLogPlayer::speed75Clicked()
 {
@@ -48,6 +53,7 @@ void QGCMAVLinkLogPlayer::speed75Clicked()
     ui->speedButton200->setChecked(false);
     ui->speedButton500->setChecked(false);
     ui->speedButton1000->setChecked(false);
+    ui->speedButtonMax->setChecked(false);
 }
 
 void QGCMAVLinkLogPlayer::speed100Clicked()
@@ -58,6 +64,7 @@ void QGCMAVLinkLogPlayer::speed100Clicked()
     ui->speedButton200->setChecked(false);
     ui->speedButton500->setChecked(false);
     ui->speedButton1000->setChecked(false);
+    ui->speedButtonMax->setChecked(false);
 }
 
 void QGCMAVLinkLogPlayer::speed150Clicked()
@@ -68,6 +75,7 @@ void QGCMAVLinkLogPlayer::speed150Clicked()
     ui->speedButton200->setChecked(false);
     ui->speedButton500->setChecked(false);
     ui->speedButton1000->setChecked(false);
+    ui->speedButtonMax->setChecked(false);
 }
 
 void QGCMAVLinkLogPlayer::speed200Clicked()
@@ -78,6 +86,7 @@ void QGCMAVLinkLogPlayer::speed200Clicked()
     m_logLink->setSpeed(200);
     ui->speedButton500->setChecked(false);
     ui->speedButton1000->setChecked(false);
+    ui->speedButtonMax->setChecked(false);
 }
 
 void QGCMAVLinkLogPlayer::speed500Clicked()
@@ -88,6 +97,7 @@ void QGCMAVLinkLogPlayer::speed500Clicked()
     ui->speedButton200->setChecked(false);
     m_logLink->setSpeed(500);
     ui->speedButton1000->setChecked(false);
+    ui->speedButtonMax->setChecked(false);
 }
 void QGCMAVLinkLogPlayer::speed1000Clicked()
 {
@@ -97,6 +107,34 @@ void QGCMAVLinkLogPlayer::speed1000Clicked()
     ui->speedButton200->setChecked(false);
     ui->speedButton500->setChecked(false);
     m_logLink->setSpeed(1000);
+    ui->speedButtonMax->setChecked(false);
+}
+
+void QGCMAVLinkLogPlayer::speedMaxClicked()
+{
+    ui->speedButton75->setChecked(false);
+    ui->speedButton100->setChecked(false);
+    ui->speedButton150->setChecked(false);
+    ui->speedButton200->setChecked(false);
+    ui->speedButton500->setChecked(false);
+    ui->speedButton1000->setChecked(false);
+    m_logLink->setSpeed(TLogReplayLink::s_FastAsPossible);
+}
+
+void QGCMAVLinkLogPlayer::stepForwardClicked()
+{
+    if (m_logLink)
+    {
+        m_logLink->stepForward();
+    }
+}
+
+void QGCMAVLinkLogPlayer::stepBackwardClicked()
+{
+    if (m_logLink)
+    {
+        m_logLink->stepBackward();
+    }
 }
 
 void QGCMAVLinkLogPlayer::positionSliderReleased()
@@ -156,6 +194,8 @@ void QGCMAVLinkLogPlayer::loadLogButtonClicked()
                 ui->speedButton150->setEnabled(false);
                 ui->speedButton200->setEnabled(false);
                 ui->speedButton500->setEnabled(false);
+                ui->speedButton1000->setEnabled(false);
+                ui->speedButtonMax->setEnabled(false);
             }
         }
         else
@@ -204,15 +244,24 @@ void QGCMAVLinkLogPlayer::loadLogDialogAccepted()
     ui->speedButton200->setEnabled(true);
     ui->speedButton500->setEnabled(true);
     ui->speedButton1000->setEnabled(true);
+    ui->speedButtonMax->setEnabled(true);
 }
 void QGCMAVLinkLogPlayer::logProgress(qint64 pos,qint64 total)
 {
-    //ui->positionSlider->setValue(((double)pos / (double)total) * 100);
+    // pos and total are milliseconds. The slider uses milliseconds too, so seeking is not
+    // limited to steps of 1 percent.
     if (!m_sliderDown)
     {
-        //ui->positionProgressBar->setValue(((double)pos / (double)total) * 100);
-        ui->positionLabel->setText(QString::number(pos) + "/" + QString::number(total));
-        ui->positionSlider->setValue(((double)pos / (double)total) * 100);
+        const QTime zero(0, 0);
+        const QString format = total >= 3600000 ? "h:mm:ss" : "mm:ss";
+        ui->positionLabel->setText(zero.addMSecs(static_cast<int>(pos)).toString(format) + "/" +
+                                   zero.addMSecs(static_cast<int>(total)).toString(format));
+        if (ui->positionSlider->maximum() != total)
+        {
+            ui->positionSlider->setMaximum(static_cast<int>(total));
+            ui->positionSlider->setPageStep(static_cast<int>(qMax<qint64>(total / 100, 1)));
+        }
+        ui->positionSlider->setValue(static_cast<int>(pos));
     }
 }
 void QGCMAVLinkLogPlayer::setMavlinkDecoder(MAVLinkDecoder *decoder)
@@ -254,6 +303,8 @@ void QGCMAVLinkLogPlayer::logLinkTerminated()
         ui->speedButton150->setEnabled(false);
         ui->speedButton200->setEnabled(false);
         ui->speedButton500->setEnabled(false);
+        ui->speedButton1000->setEnabled(false);
+        ui->speedButtonMax->setEnabled(false);
         emit logFinished();
     }
 }
@@ -52,6 +52,9 @@ public slots:
     void speed200Clicked();
     void speed500Clicked();
     void speed1000Clicked();
+    void speedMaxClicked();
+    void stepForwardClicked();
+    void stepBackwardClicked();
 private slots:
     void logProgress(qint64 pos,qint64 total);
     void positionSliderReleased();
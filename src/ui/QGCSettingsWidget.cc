@@ -67,6 +67,7 @@ void QGCSettingsWidget::showEvent(QShowEvent *evt)
 
         ui->mavlinkLoggingCheckBox->setChecked(LinkManager::instance()->loggingEnabled());
         connect(ui->mavlinkLoggingCheckBox,SIGNAL(clicked(bool)),LinkManager::instance(),SLOT(enableLogging(bool)));
+        connect(LinkManager::instance(),SIGNAL(loggingStatisticsChanged(quint64,quint64)),this,SLOT(loggingStatisticsChanged(quint64,quint64)));
 
         ui->logDirEdit->setText(QGC::logDirectory());
 
@@ -310,6 +311,12 @@ void QGCSettingsWidget::setBetaRelease(bool state)
     settings.sync();
 }
 
+void QGCSettingsWidget::loggingStatisticsChanged(quint64 queuedFrames, quint64 droppedFrames)
+{
+    ui->mavlinkLoggingStatusLabel->setText(tr("Recorded messages: %1, dropped (disk too slow): %2")
+                                           .arg(queuedFrames).arg(droppedFrames));
+}
+
 void QGCSettingsWidget::setHideDonateButton(bool state)
 {
     QSettings settings;
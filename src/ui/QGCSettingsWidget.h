@@ -29,6 +29,7 @@ private slots:
     void ratesChanged();
     void setBetaRelease(bool state);
     void setHideDonateButton(bool state);
+    void loggingStatisticsChanged(quint64 queuedFrames, quint64 droppedFrames);
 
     void setActiveUAS(UASInterface *uas);
 
@@ -41,6 +41,8 @@ QGCToolBar::QGCToolBar(QWidget *parent) :
     batteryVoltage(0),
     wpId(0),
     wpDistance(0),
+    altitudeMSL(0),
+    altitudeKey(-1),
     systemArmed(false),
     currentLink(NULL),
     firstAction(NULL)
@@ -50,14 +52,24 @@ QGCToolBar::QGCToolBar(QWidget *parent) :
     // Do not load UI, wait for actions
 }
 
-void QGCToolBar::globalPositionChanged(UASInterface* uas, double lat, double lon, double alt, quint64 usec)
+void QGCToolBar::telemetryChanged(const UASTelemetrySnapshot &snapshot)
 {
-    Q_UNUSED(uas);
-    Q_UNUSED(lat);
-    Q_UNUSED(lon);
-    Q_UNUSED(usec);
-    altitudeMSL = alt;
-    changed = true;
+    if (altitudeKey < 0)
+    {
+        if (!mav)
+            return;
+        altitudeKey = mav->getTelemetryStore()->findKey("GCS Metric.Alt MSL", "m");
+    }
+
+    foreach (const UASTelemetryValue &value, snapshot.m_values)
+    {
+        if (value.m_key == altitudeKey)
+        {
+            altitudeMSL = value.m_value;
+            changed = true;
+            return;
+        }
+    }
 }
 
 void QGCToolBar::heartbeatTimeout(bool timeout, unsigned int ms)
@@ -319,7 +331,7 @@ void QGCToolBar::setActiveUAS(UASInterface* active)
         disconnect(mav, SIGNAL(batteryChanged(UASInterface*, double, double, double,int)), this, SLOT(updateBatteryRemaining(UASInterface*, double, double, double, int)));
         disconnect(mav, SIGNAL(armingChanged(bool)), this, SLOT(updateArmingState(bool)));
         disconnect(mav, SIGNAL(heartbeatTimeout(bool, unsigned int)), this, SLOT(heartbeatTimeout(bool,unsigned int)));
-        disconnect(active, SIGNAL(globalPositionChanged(UASInterface*,double,double,double,quint64)), this, SLOT(globalPositionChanged(UASInterface*,double,double,double,quint64)));
+        disconnect(mav->getTelemetryStore(), SIGNAL(snapshotChanged(UASTelemetrySnapshot)), this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
         if (mav->getWaypointManager())
         {
             disconnect(mav->getWaypointManager(), SIGNAL(currentWaypointChanged(quint16)), this, SLOT(updateCurrentWaypoint(quint16)));
@@ -337,7 +349,8 @@ void QGCToolBar::setActiveUAS(UASInterface* active)
     connect(active, SIGNAL(batteryChanged(UASInterface*, double, double, double, int)), this, SLOT(updateBatteryRemaining(UASInterface*, double, double, double, int)));
     connect(active, SIGNAL(armingChanged(bool)), this, SLOT(updateArmingState(bool)));
     connect(active, SIGNAL(heartbeatTimeout(bool, unsigned int)), this, SLOT(heartbeatTimeout(bool,unsigned int)));
-    connect(active, SIGNAL(globalPositionChanged(UASInterface*,double,double,double,quint64)), this, SLOT(globalPositionChanged(UASInterface*,double,double,double,quint64)));
+    altitudeKey = -1;
+    connect(active->getTelemetryStore(), SIGNAL(snapshotChanged(UASTelemetrySnapshot)), this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
     if (active->getWaypointManager())
     {
         connect(active->getWaypointManager(), SIGNAL(currentWaypointChanged(quint16)), this, SLOT(updateCurrentWaypoint(quint16)));
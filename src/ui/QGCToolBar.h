@@ -75,8 +75,8 @@ public slots:
     void updateView();
     /** @brief Update connection timeout time */
     void heartbeatTimeout(bool timeout, unsigned int ms);
-    /** @brief Update global position */
-    void globalPositionChanged(UASInterface* uas, double lat, double lon, double alt, quint64 usec);
+    /** @brief Update altitude from the telemetry of the active UAS */
+    void telemetryChanged(const UASTelemetrySnapshot &snapshot);
     /** @brief Create or connect link */
     void connectLink(bool connect);
     /** @brief Clear status string */
@@ -112,6 +112,7 @@ protected:
     int wpId;
     double wpDistance;
     float altitudeMSL;
+    int altitudeKey;    ///< Key of "GCS Metric.Alt MSL" in the telemetry store, -1 if not known yet
     float altitudeRel;
     QString state;
     QString mode;
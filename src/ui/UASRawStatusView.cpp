@@ -34,9 +34,11 @@ void UASRawStatusView::activeUASSet(UASInterface* uas)
     if (m_uas)
     {
         disconnect(m_uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
+        disconnect(m_uas,SIGNAL(valuesChanged(MAVLinkValueBatch)),this,SLOT(valuesChanged(MAVLinkValueBatch)));
     }
     m_uas = uas;
     connect(m_uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
+    connect(m_uas,SIGNAL(valuesChanged(MAVLinkValueBatch)),this,SLOT(valuesChanged(MAVLinkValueBatch)));
 
 }
 
@@ -95,6 +97,28 @@ void UASRawStatusView::valueChanged(const int uasId, const QString& name, const
     Q_UNUSED(msec)
     valueMap[name] = value;
 }
+
+void UASRawStatusView::valuesChanged(const MAVLinkValueBatch& values)
+{
+    const MAVLinkFieldRegistry &registry = MAVLinkFieldRegistry::instance();
+    for (int i = 0; i < values.count(); ++i)
+    {
+        // Build the name only once per field. Looks like M1:ATTITUDE.roll
+        const quint64 key = values.cacheKey(i);
+        auto iter = m_nameCache.find(key);
+        if (iter == m_nameCache.end())
+        {
+            QString name('M' + QString::number(values.m_uasId) + ':');
+            if (values.m_multiComponent)
+            {
+                name.append('C' + QString::number(values.m_compId) + ':');
+            }
+            name.append(registry.info(values.m_fieldIds[i]).m_name);
+            iter = m_nameCache.insert(key, name);
+        }
+        valueMap[iter.value()] = values.m_values[i];
+    }
+}
 void UASRawStatusView::resizeEvent(QResizeEvent *event)
 {
     Q_UNUSED(event)
@@ -18,6 +18,7 @@ private slots:
     void updateTimerTick();
     void valueChanged(const int uasId, const QString& name, const QString& unit, const double value, const quint64 msec);
     void valueChanged(const int uasId, const QString& name, const QString& unit, const QVariant value, const quint64 msec);
+    void valuesChanged(const MAVLinkValueBatch& values);
     void activeUASSet(UASInterface* uas);
 protected:
     void resizeEvent(QResizeEvent *event);
@@ -26,6 +27,7 @@ protected:
 private:
     UASInterface *m_uas;
     QMap<QString,double> valueMap;
+    QHash<quint64,QString> m_nameCache; //Value names of the mavlink fields by MAVLinkValueBatch::cacheKey()
     QMap<QString,QTableWidgetItem*> nameToUpdateWidgetMap;
     Ui::UASRawStatusView ui;
     QTimer *m_updateTimer;
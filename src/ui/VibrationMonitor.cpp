@@ -22,7 +22,6 @@ This file is part of the APM_PLANNER project
 #include "logging.h"
 #include "VibrationMonitor.h"
 #include "UASManager.h"
-#include "LinkManager.h"
 #include "configuration.h"
 
 #include <QVBoxLayout>
@@ -68,22 +67,67 @@ VibrationMonitor::VibrationMonitor(QWidget *parent) : QWidget(parent)
 
 void VibrationMonitor::setActiveUAS(UASInterface *p_uas)
 {
+    if (mp_uasInterface != nullptr)
+    {
+        disconnect(mp_uasInterface->getTelemetryStore(), SIGNAL(snapshotChanged(UASTelemetrySnapshot)),
+                   this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
+    }
     mp_uasInterface = p_uas;
+    m_keyToValueIndex.clear();      // keys are only unique within one store
 
     if (mp_uasInterface != nullptr)
     {
         //connect(uas,SIGNAL(textMessageReceived(int,int,int,QString)), this, SLOT(uasTextMessage(int,int,int,QString)));
 
-        VehicleOverview *p_vehicleOverview = LinkManager::instance()->getUasObject(mp_uasInterface->getUASID())->getVehicleOverview();
-        if (p_vehicleOverview)
+        QMetaObject::invokeMethod(m_ptrDeclarativeView->rootObject(),"activeUasSet");
+
+        // The values are delivered coalesced at display rate. Show the known ones right now.
+        UASTelemetryStore *p_store = mp_uasInterface->getTelemetryStore();
+        UASTelemetrySnapshot snapshot;
+        snapshot.m_uasId = mp_uasInterface->getUASID();
+        snapshot.m_values = p_store->changedSince(0);
+        telemetryChanged(snapshot);
+        connect(p_store, SIGNAL(snapshotChanged(UASTelemetrySnapshot)), this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
+    }
+}
+
+void VibrationMonitor::telemetryChanged(const UASTelemetrySnapshot &snapshot)
+{
+    static const QString s_FieldNames[s_ValueCount] =
+    {
+        "VIBRATION.vibration_x", "VIBRATION.vibration_y", "VIBRATION.vibration_z",
+        "VIBRATION.clipping_0", "VIBRATION.clipping_1", "VIBRATION.clipping_2"
+    };
+
+    bool changed = false;
+    for (const auto &value : snapshot.m_values)
+    {
+        auto iter = m_keyToValueIndex.constFind(value.m_key);
+        if (iter == m_keyToValueIndex.constEnd())
         {
-            m_ptrDeclarativeView->rootContext()->setContextProperty("vehicleOverview", p_vehicleOverview);
+            // resolve every field once
+            int index = -1;
+            if (value.m_fieldId >= 0)
+            {
+                const QString &name = MAVLinkFieldRegistry::instance().info(value.m_fieldId).m_name;
+                for (int i = 0; (i < s_ValueCount) && (index < 0); ++i)
+                {
+                    index = (name == s_FieldNames[i]) ? i : -1;
+                }
+            }
+            iter = m_keyToValueIndex.insert(value.m_key, index);
         }
-        else
+        if (iter.value() >= 0)
         {
-            QLOG_ERROR() << "VibrationMonitor::setActiveUAS() Invalid vehicleOverview!";
+            m_values[iter.value()] = value.m_value;
+            changed = true;
         }
+    }
 
-        QMetaObject::invokeMethod(m_ptrDeclarativeView->rootObject(),"activeUasSet");
+    if (changed)
+    {
+        QMetaObject::invokeMethod(m_ptrDeclarativeView->rootObject(), "updateVibration",
+                                  Q_ARG(QVariant, m_values[0]), Q_ARG(QVariant, m_values[1]), Q_ARG(QVariant, m_values[2]),
+                                  Q_ARG(QVariant, m_values[3]), Q_ARG(QVariant, m_values[4]), Q_ARG(QVariant, m_values[5]));
     }
 }
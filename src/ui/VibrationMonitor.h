@@ -26,6 +26,7 @@ This file is part of the APM_PLANNER project
 #include <QWidget>
 #include <QQuickView>
 #include <QScopedPointer>
+#include <QHash>
 
 class VibrationMonitor : public QWidget
 {
@@ -36,9 +37,14 @@ public:
 
 private slots:
     void setActiveUAS(UASInterface *p_uas);
+    void telemetryChanged(const UASTelemetrySnapshot &snapshot);
 
 private:
+    static constexpr int s_ValueCount = 6;   /// vibration x, y, z and clipping 0, 1, 2
+
     QScopedPointer<QQuickView> m_ptrDeclarativeView;
     UASInterface *mp_uasInterface {nullptr};
+    QHash<int, int> m_keyToValueIndex;      /// index in m_values by key of the telemetry store, -1 if not shown
+    double m_values[s_ValueCount] {};       /// latest values shown
 };
 #endif // VIBRATIONMONITOR_H
@@ -802,14 +802,8 @@ void LinechartPlot::removeAllData()
 
 
 TimeSeriesData::TimeSeriesData(QwtPlot* plot, QString friendlyName, quint64 plotInterval, quint64 maxInterval, double zeroValue):
-    minValue(DBL_MAX),
-    maxValue(DBL_MIN),
     zeroValue(0),
-    count(0),
-    mean(0.0),
-    median(0.0),
-    variance(0.0),
-    averageWindow(50)
+    plotStart(0)
 {
     this->plot = plot;
     this->friendlyName = friendlyName;
@@ -820,6 +814,7 @@ TimeSeriesData::TimeSeriesData(QwtPlot* plot, QString friendlyName, quint64 plot
     /* initialize time */
     startTime = QUINT64_MAX;
     stopTime = QUINT64_MIN;
+    interval = 0;
 
     plotCount = 0;
 }
@@ -832,92 +827,54 @@ TimeSeriesData::~TimeSeriesData()
 void TimeSeriesData::setInterval(quint64 ms)
 {
     plotInterval = ms;
+    // Start over, the new interval may reach further back
+    plotStart = buffer.firstIndex();
+    updatePlotWindow();
 }
 
 void TimeSeriesData::setAverageWindowSize(int windowSize)
 {
-    this->averageWindow = windowSize;
+    buffer.setAverageWindow(windowSize);
 }
 
 /**
  * @brief Append a data point to this data set
  *
+ * The buffer keeps a fixed number of samples, the oldest sample is dropped
+ * when it is full. Mean and variance are updated in constant time.
+ *
  * @param ms The time in milliseconds
  * @param value The data value
  **/
 void TimeSeriesData::append(quint64 ms, double value)
 {
-    dataMutex.lock();
-    // Pre- allocate new space
-    // FIXME Check this for validity
-    if(static_cast<quint64>(size()) < (count + 100)) {
-        this->ms.resize(size() + 10000);
-        this->value.resize(size() + 10000);
-    }
-    this->ms[count] = ms;
-    this->value[count] = value;
-    this->lastValue = value;
-    this->mean = 0;
-    //QList<double> medianList = QList<double>();
-    for (unsigned int i = 0; (i < averageWindow) && (((int)count - (int)i) >= 0); ++i) {
-        this->mean += this->value[count-i];
-        //medianList.append(this->value[count-i]);
-    }
-    this->mean = mean / static_cast<double>(qMin(averageWindow,static_cast<unsigned int>(count)));
-
-    this->variance = 0;
-    for (unsigned int i = 0; (i < averageWindow) && (((int)count - (int)i) >= 0); ++i) {
-        this->variance += (this->value[count-i] - mean) * (this->value[count-i] - mean);
-    }
-    this->variance = this->variance / static_cast<double>(qMin(averageWindow,static_cast<unsigned int>(count)));
-
-//    qSort(medianList);
-
-//    if (medianList.count() > 2)
-//    {
-//        if (medianList.count() % 2 == 0)
-//        {
-//            median = (medianList.at(medianList.count()/2) + medianList.at(medianList.count()/2+1)) / 2.0;
-//        }
-//        else
-//        {
-//            median = medianList.at(medianList.count()/2+1);
-//        }
-//    }
+    buffer.append(ms, value);
 
     // Update statistical values
     if(ms < startTime) startTime = ms;
     if(ms > stopTime) stopTime = ms;
     interval = stopTime - startTime;
 
-    if (interval > plotInterval) {
-        while (this->ms[count - plotCount] < stopTime - plotInterval) {
-            plotCount--;
-        }
-    }
+    updatePlotWindow();
+}
 
-    count++;
-    plotCount++;
-
-    if(minValue > value) minValue = value;
-    if(maxValue < value) maxValue = value;
-
-    // Trim dataset if necessary
-    if(maxInterval > 0) {
-        // maxInterval = 0 means infinite
-
-        if(interval > maxInterval && !this->ms.isEmpty() && !this->value.isEmpty()) {
-            // The time at which this time series should be cut
-            double minTime = stopTime - maxInterval;
-            // Delete elements from the start of the list as long the time
-            // value of this elements is before the cut time
-            while(this->ms.first() < minTime) {
-                this->ms.pop_front();
-                this->value.pop_front();
-            }
+void TimeSeriesData::updatePlotWindow()
+{
+    const quint64 end = buffer.endIndex();
+    if (plotStart < buffer.firstIndex())
+    {
+        // Overwritten by newer samples
+        plotStart = buffer.firstIndex();
+    }
+    if (end > plotStart)
+    {
+        const double newest = buffer.time(end - 1);
+        while (plotStart < end && buffer.time(plotStart) < newest - static_cast<double>(plotInterval))
+        {
+            ++plotStart;
         }
     }
-    dataMutex.unlock();
+    plotCount = end - plotStart;
 }
 
 /**
@@ -937,7 +894,7 @@ int TimeSeriesData::getID()
  **/
 double TimeSeriesData::getMinValue()
 {
-    return minValue;
+    return buffer.minValue();
 }
 
 /**
@@ -947,7 +904,7 @@ double TimeSeriesData::getMinValue()
  **/
 double TimeSeriesData::getMaxValue()
 {
-    return maxValue;
+    return buffer.maxValue();
 }
 
 /**
@@ -955,7 +912,7 @@ double TimeSeriesData::getMaxValue()
  */
 double TimeSeriesData::getMean()
 {
-    return mean;
+    return buffer.mean();
 }
 
 /**
@@ -963,7 +920,7 @@ double TimeSeriesData::getMean()
  */
 double TimeSeriesData::getMedian()
 {
-    return median;
+    return buffer.median();
 }
 
 /**
@@ -971,12 +928,12 @@ double TimeSeriesData::getMedian()
  */
 double TimeSeriesData::getVariance()
 {
-    return variance;
+    return buffer.variance();
 }
 
 double TimeSeriesData::getCurrentValue()
 {
-    return lastValue;
+    return buffer.lastValue();
 }
 
 /**
@@ -1008,7 +965,7 @@ void TimeSeriesData::setZeroValue(double zeroValue)
  **/
 int TimeSeriesData::getCount() const
 {
-    return count;
+    return buffer.size();
 }
 
 /**
@@ -1031,7 +988,7 @@ int TimeSeriesData::getPlotCount() const
  **/
 int TimeSeriesData::size() const
 {
-    return ms.size();
+    return buffer.capacity();
 }
 
 /**
@@ -1041,12 +998,12 @@ int TimeSeriesData::size() const
  **/
 const double* TimeSeriesData::getX() const
 {
-    return ms.data();
+    return buffer.times(buffer.firstIndex());
 }
 
 const double* TimeSeriesData::getPlotX() const
 {
-    return ms.data() + (count - plotCount);
+    return buffer.times(plotStart);
 }
 
 /**
@@ -1056,10 +1013,10 @@ const double* TimeSeriesData::getPlotX() const
  **/
 const double* TimeSeriesData::getY() const
 {
-    return value.data();
+    return buffer.values(buffer.firstIndex());
 }
 
 const double* TimeSeriesData::getPlotY() const
 {
-    return value.data() + (count - plotCount);
+    return buffer.values(plotStart);
 }
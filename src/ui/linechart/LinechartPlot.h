@@ -49,6 +49,7 @@ This file is part of the PIXHAWK project
 #include <qwt_plot.h>
 #include <ScrollZoomer.h>
 #include "MG.h"
+#include "TimeSeriesBuffer.h"
 
 class TimeScaleDraw: public QwtScaleDraw
 {
@@ -102,6 +103,8 @@ class QwtPlotCurve;
 /**
  * @brief Container class for the time series data
  *
+ * The samples are kept in a TimeSeriesBuffer, TimeSeriesData tracks the
+ * plot interval within it.
  **/
 class TimeSeriesData
 {
@@ -151,27 +154,18 @@ protected:
     quint64 plotCount;
     QString friendlyName;
 
-    double lastValue; ///< The last inserted value
-    double minValue;  ///< The smallest value in the dataset
-    double maxValue;  ///< The largest value in the dataset
     double zeroValue; ///< The expected value in the dataset
 
-    QMutex dataMutex;
-
     QwtScaleMap* scaleMap;
 
     void updateScaleMap();
 
 private:
-    quint64 count;
-    QwtArray<double> ms;
-    QwtArray<double> value;
-    double mean;
-    double median;
-    double variance;
-    unsigned int averageWindow;
-    QwtArray<double> outputMs;
-    QwtArray<double> outputValue;
+    /** @brief Drop the samples which left the plot interval from the plot */
+    void updatePlotWindow();
+
+    TimeSeriesBuffer buffer; ///< The samples and the statistics of this plot
+    quint64 plotStart; ///< Index of the first sample in the plot interval
 };
 
 
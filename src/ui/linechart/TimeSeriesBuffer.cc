@@ -0,0 +1,230 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief TimeSeriesBuffer
+ *          Fixed capacity sample store with rolling statistics for the linechart.
+ *
+ */
+
+#include "TimeSeriesBuffer.h"
+
+#include <algorithm>
+#include <cfloat>
+
+TimeSeriesBuffer::TimeSeriesBuffer(int capacity) :
+    m_capacity(capacity > 0 ? capacity : s_DefaultCapacity),
+    m_times(2 * m_capacity, 0.0),
+    m_values(2 * m_capacity, 0.0),
+    m_end(0),
+    m_size(0),
+    m_lastValue(0.0),
+    m_minValue(DBL_MAX),
+    m_maxValue(-DBL_MAX),
+    m_averageWindow(qMin(s_DefaultAverageWindow, m_capacity)),
+    m_windowCount(0),
+    m_mean(0.0),
+    m_m2(0.0),
+    m_updatesSinceRecalculation(0),
+    m_sortedEnd(0)
+{
+}
+
+void TimeSeriesBuffer::append(quint64 ms, double value)
+{
+    const double time = static_cast<double>(ms);
+
+    // Update the window statistics before the oldest sample may be overwritten
+    if (m_windowCount < m_averageWindow)
+    {
+        ++m_windowCount;
+        const double delta = value - m_mean;
+        m_mean += delta / m_windowCount;
+        m_m2 += delta * (value - m_mean);
+    }
+    else
+    {
+        const double oldValue = m_values[position(m_end - m_averageWindow)];
+        const double newMean = m_mean + (value - oldValue) / m_averageWindow;
+        m_m2 += (value - oldValue) * (value - newMean + oldValue - m_mean);
+        m_mean = newMean;
+        if (m_m2 < 0.0)
+        {
+            m_m2 = 0.0;
+        }
+    }
+
+    const int pos = position(m_end);
+    m_times[pos] = time;
+    m_times[pos + m_capacity] = time;
+    m_values[pos] = value;
+    m_values[pos + m_capacity] = value;
+    ++m_end;
+    if (m_size < m_capacity)
+    {
+        ++m_size;
+    }
+
+    m_lastValue = value;
+    if (value < m_minValue) m_minValue = value;
+    if (value > m_maxValue) m_maxValue = value;
+
+    if (++m_updatesSinceRecalculation >= m_capacity)
+    {
+        recalculateStatistics();
+    }
+}
+
+int TimeSeriesBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+int TimeSeriesBuffer::size() const
+{
+    return m_size;
+}
+
+quint64 TimeSeriesBuffer::firstIndex() const
+{
+    return m_end - static_cast<quint64>(m_size);
+}
+
+quint64 TimeSeriesBuffer::endIndex() const
+{
+    return m_end;
+}
+
+double TimeSeriesBuffer::time(quint64 index) const
+{
+    return m_times[position(index)];
+}
+
+const double *TimeSeriesBuffer::times(quint64 index) const
+{
+    return m_times.constData() + position(index);
+}
+
+const double *TimeSeriesBuffer::values(quint64 index) const
+{
+    return m_values.constData() + position(index);
+}
+
+double TimeSeriesBuffer::lastValue() const
+{
+    return m_lastValue;
+}
+
+double TimeSeriesBuffer::minValue() const
+{
+    return m_minValue;
+}
+
+double TimeSeriesBuffer::maxValue() const
+{
+    return m_maxValue;
+}
+
+void TimeSeriesBuffer::setAverageWindow(int windowSize)
+{
+    m_averageWindow = qBound(1, windowSize, m_capacity);
+    recalculateStatistics();
+}
+
+double TimeSeriesBuffer::mean() const
+{
+    return m_mean;
+}
+
+double TimeSeriesBuffer::variance() const
+{
+    return m_windowCount > 0 ? m_m2 / m_windowCount : 0.0;
+}
+
+double TimeSeriesBuffer::median() const
+{
+    updateOrderStatistics();
+    const int count = m_sortedWindow.size();
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    if (count % 2 == 0)
+    {
+        return (m_sortedWindow.at(count / 2 - 1) + m_sortedWindow.at(count / 2)) / 2.0;
+    }
+    return m_sortedWindow.at(count / 2);
+}
+
+double TimeSeriesBuffer::windowMin() const
+{
+    updateOrderStatistics();
+    return m_sortedWindow.isEmpty() ? 0.0 : m_sortedWindow.first();
+}
+
+double TimeSeriesBuffer::windowMax() const
+{
+    updateOrderStatistics();
+    return m_sortedWindow.isEmpty() ? 0.0 : m_sortedWindow.last();
+}
+
+int TimeSeriesBuffer::position(quint64 index) const
+{
+    return static_cast<int>(index % static_cast<quint64>(m_capacity));
+}
+
+void TimeSeriesBuffer::recalculateStatistics()
+{
+    m_windowCount = qMin(m_averageWindow, m_size);
+    m_mean = 0.0;
+    m_m2 = 0.0;
+    m_updatesSinceRecalculation = 0;
+    if (m_windowCount == 0)
+    {
+        return;
+    }
+
+    const double *window = values(m_end - m_windowCount);
+    for (int i = 0; i < m_windowCount; ++i)
+    {
+        m_mean += window[i];
+    }
+    m_mean /= m_windowCount;
+    for (int i = 0; i < m_windowCount; ++i)
+    {
+        m_m2 += (window[i] - m_mean) * (window[i] - m_mean);
+    }
+}
+
+void TimeSeriesBuffer::updateOrderStatistics() const
+{
+    if (m_sortedEnd == m_end && m_sortedWindow.size() == m_windowCount)
+    {
+        return;
+    }
+    const double *window = values(m_end - m_windowCount);
+    m_sortedWindow.resize(m_windowCount);
+    std::copy(window, window + m_windowCount, m_sortedWindow.begin());
+    std::sort(m_sortedWindow.begin(), m_sortedWindow.end());
+    m_sortedEnd = m_end;
+}
@@ -0,0 +1,117 @@
+/*===================================================================
+APM_PLANNER Open Source Ground Control Station
+
+(c) 2026 APM_PLANNER PROJECT <http://www.ardupilot.com>
+
+This file is part of the APM_PLANNER project
+
+    APM_PLANNER is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    APM_PLANNER is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with APM_PLANNER. If not, see <http://www.gnu.org/licenses/>.
+
+======================================================================*/
+
+/**
+ * @file
+ *   @brief TimeSeriesBuffer
+ *          Fixed capacity sample store with rolling statistics for the linechart.
+ *
+ */
+
+#ifndef TIMESERIESBUFFER_H
+#define TIMESERIESBUFFER_H
+
+#include <QVector>
+
+/**
+ * @brief The TimeSeriesBuffer class stores the newest samples of one field in a ring
+ *        buffer of fixed capacity. Each sample is written twice, at its position and at
+ *        its position + capacity, so every range of stored samples is contiguous in memory
+ *        and can be handed to a curve without copying.
+ *
+ *        Mean and variance over the averaging window are updated in O(1) per sample.
+ *        Median, min and max of the window are only computed when asked for.
+ *
+ *        Samples are addressed by their absolute index, the number of samples appended
+ *        before them. Each plot owns its buffer, so the averaging window is per plot.
+ *        The buffer must only be used from the GUI thread.
+ */
+class TimeSeriesBuffer
+{
+public:
+    static const int s_DefaultCapacity = 16384;     /// ~5 minutes at 50 Hz
+    static const int s_DefaultAverageWindow = 50;
+
+    explicit TimeSeriesBuffer(int capacity = s_DefaultCapacity);
+
+    /**
+     * @brief append adds a sample, the oldest one is dropped if the buffer is full.
+     */
+    void append(quint64 ms, double value);
+
+    int capacity() const;
+    /** @brief number of samples stored */
+    int size() const;
+    /** @brief absolute index of the oldest sample stored */
+    quint64 firstIndex() const;
+    /** @brief absolute index behind the newest sample */
+    quint64 endIndex() const;
+
+    /** @brief time of a stored sample, firstIndex() <= index < endIndex() */
+    double time(quint64 index) const;
+    /** @brief samples from index to the newest one, contiguous */
+    const double *times(quint64 index) const;
+    const double *values(quint64 index) const;
+
+    double lastValue() const;
+    /** @brief smallest value ever appended */
+    double minValue() const;
+    /** @brief largest value ever appended */
+    double maxValue() const;
+
+    /** @brief sets the number of samples of the averaging window, clamped to the capacity */
+    void setAverageWindow(int windowSize);
+    double mean() const;
+    double variance() const;
+    double median() const;
+    double windowMin() const;
+    double windowMax() const;
+
+private:
+    /** @brief position of an absolute index in the first copy */
+    int position(quint64 index) const;
+    /** @brief recalculates the window statistics from scratch, also removes the rounding drift */
+    void recalculateStatistics();
+    /** @brief sorts the window for median(), windowMin() and windowMax() if new samples arrived */
+    void updateOrderStatistics() const;
+
+    int m_capacity;
+    QVector<double> m_times;        /// 2 * m_capacity, each sample twice
+    QVector<double> m_values;       /// 2 * m_capacity, each sample twice
+    quint64 m_end;                  /// absolute index behind the newest sample
+    int m_size;
+
+    double m_lastValue;
+    double m_minValue;
+    double m_maxValue;
+
+    int m_averageWindow;
+    int m_windowCount;              /// samples in the averaging window
+    double m_mean;
+    double m_m2;                    /// sum of squared differences from m_mean
+    int m_updatesSinceRecalculation;
+
+    mutable QVector<double> m_sortedWindow;     /// cache of updateOrderStatistics()
+    mutable quint64 m_sortedEnd;                /// m_end when m_sortedWindow was filled
+};
+
+#endif // TIMESERIESBUFFER_H
@@ -12,6 +12,7 @@ QGCMapToolBar::QGCMapToolBar(QWidget *parent) :
     trailPlotMenu(this),
     updateTimesMenu(this),
     mapTypesMenu(this),
+    offlineMapsMenu(this),
     trailSettingsGroup(new QActionGroup(this)),
     updateTimesGroup(new QActionGroup(this)),
     mapTypesGroup(new QActionGroup(this))
@@ -162,6 +163,15 @@ void QGCMapToolBar::setMap(QGCMapWidget* map)
         }
         optionsMenu.addMenu(&updateTimesMenu);
 
+        // Offline maps
+        offlineMapsMenu.setTitle(tr("&Offline maps"));
+        offlineMapsMenu.addAction(tr("Cache selected area..."), map, SLOT(cacheVisibleRegion()));
+        offlineMapsMenu.addAction(tr("Cache mission area..."), map, SLOT(cacheMissionRegion()));
+        offlineMapsMenu.addSeparator();
+        offlineMapsMenu.addAction(tr("Export tile pack..."), map, SLOT(exportTilePack()));
+        offlineMapsMenu.addAction(tr("Import tile pack..."), map, SLOT(importTilePack()));
+        optionsMenu.addMenu(&offlineMapsMenu);
+
         ui->optionsButton->setMenu(&optionsMenu);
     }
 }
@@ -44,6 +44,7 @@ protected:
     QMenu trailPlotMenu;
     QMenu updateTimesMenu;
     QMenu mapTypesMenu;
+    QMenu offlineMapsMenu;
 
     QActionGroup* trailSettingsGroup;
     QActionGroup* updateTimesGroup;
@@ -9,6 +9,9 @@
 #include "ArduPilotMegaMAV.h"
 #include "WaypointNavigation.h"
 #include <QInputDialog>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QApplication>
 
 QGCMapWidget::QGCMapWidget(QWidget *parent) :
     mapcontrol::OPMapWidget(parent),
@@ -672,6 +675,153 @@ void QGCMapWidget::cacheVisibleRegion()
     }
 }
 
+void QGCMapWidget::cacheMissionRegion()
+{
+    QVector<internals::PointLatLng> region = missionRegion();
+
+    if (region.isEmpty())
+    {
+        QMessageBox::information(this, tr("Cannot cache tiles for offline use"),
+                                 tr("The current mission has no waypoints with a position."));
+        return;
+    }
+    RipMap(region);
+}
+
+void QGCMapWidget::exportTilePack()
+{
+    QVector<internals::PointLatLng> region;
+    internals::RectLatLng rect = map->SelectedArea();
+    if (!rect.IsEmpty())
+    {
+        region << internals::PointLatLng(rect.Top(), rect.Left())
+               << internals::PointLatLng(rect.Top(), rect.Right())
+               << internals::PointLatLng(rect.Bottom(), rect.Right())
+               << internals::PointLatLng(rect.Bottom(), rect.Left());
+    }
+    else
+    {
+        region = missionRegion();
+    }
+
+    if (region.isEmpty())
+    {
+        QMessageBox::information(this, tr("Cannot export tile pack"),
+                                 tr("Please select an area first by holding down SHIFT or ALT and selecting the area with the left mouse button, or load a mission."));
+        return;
+    }
+
+    const int minZoom = static_cast<int>(ZoomTotal());
+    bool ok = false;
+    const int maxZoom = QInputDialog::getInt(this, tr("Export tile pack"),
+                                             tr("Export cached tiles from zoom level %1 up to zoom level:").arg(minZoom),
+                                             qMin(minZoom + 4, MaxZoom()), minZoom, MaxZoom(), 1, &ok);
+    if (!ok)
+    {
+        return;
+    }
+
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export tile pack"), QGC::appDataDirectory(),
+                                                    tr("Tile packs (*.mbtiles)"));
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+    if (!fileName.endsWith(".mbtiles", Qt::CaseInsensitive))
+    {
+        fileName += ".mbtiles";
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const int count = ExportTilePack(fileName, region, minZoom, maxZoom);
+    QApplication::restoreOverrideCursor();
+
+    if (count < 0)
+    {
+        QLOG_WARN() << "Unable to export tile pack" << fileName;
+        QMessageBox::warning(this, tr("Export tile pack"), tr("Unable to write %1").arg(fileName));
+    }
+    else
+    {
+        QLOG_INFO() << "Exported" << count << "tiles to" << fileName;
+        QMessageBox::information(this, tr("Export tile pack"), tr("%1 tiles exported to %2").arg(count).arg(fileName));
+    }
+}
+
+void QGCMapWidget::importTilePack()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, tr("Import tile pack"), QGC::appDataDirectory(),
+                                                    tr("Tile packs (*.mbtiles)"));
+    if (fileName.isEmpty())
+    {
+        return;
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const int count = ImportTilePack(fileName);
+    QApplication::restoreOverrideCursor();
+
+    if (count < 0)
+    {
+        QLOG_WARN() << "Unable to import tile pack" << fileName;
+        QMessageBox::warning(this, tr("Import tile pack"), tr("Unable to read %1").arg(fileName));
+    }
+    else
+    {
+        QLOG_INFO() << "Imported" << count << "tiles from" << fileName;
+        QMessageBox::information(this, tr("Import tile pack"), tr("%1 new tiles imported").arg(count));
+    }
+}
+
+QVector<internals::PointLatLng> QGCMapWidget::missionRegion() const
+{
+    QVector<internals::PointLatLng> region;
+    if (!currWPManager)
+    {
+        return region;
+    }
+
+    bool valid = false;
+    double north = 0.0;
+    double south = 0.0;
+    double east = 0.0;
+    double west = 0.0;
+    foreach (Waypoint *wp, currWPManager->getWaypointEditableList())
+    {
+        const double lat = wp->getLatitude();
+        const double lon = wp->getLongitude();
+        if (lat == 0.0 && lon == 0.0)
+        {
+            continue;   // command without a position
+        }
+        if (!valid)
+        {
+            north = south = lat;
+            east = west = lon;
+            valid = true;
+        }
+        north = qMax(north, lat);
+        south = qMin(south, lat);
+        east = qMax(east, lon);
+        west = qMin(west, lon);
+    }
+
+    if (valid)
+    {
+        // Keep some space around the mission, at least about 200m
+        const double marginLat = qMax((north - south) * 0.1, 0.002);
+        const double marginLon = qMax((east - west) * 0.1, 0.002);
+        north = qMin(north + marginLat, 85.0);
+        south = qMax(south - marginLat, -85.0);
+        east = qMin(east + marginLon, 180.0);
+        west = qMax(west - marginLon, -180.0);
+        region << internals::PointLatLng(north, west)
+               << internals::PointLatLng(north, east)
+               << internals::PointLatLng(south, east)
+               << internals::PointLatLng(south, west);
+    }
+    return region;
+}
 
 // WAYPOINT MAP INTERACTION FUNCTIONS
 
@@ -79,6 +79,12 @@ public slots:
     void setUpdateRateLimit(float seconds);
     /** @brief Cache visible region to harddisk */
     void cacheVisibleRegion();
+    /** @brief Cache the area of the current mission to harddisk */
+    void cacheMissionRegion();
+    /** @brief Export the cached tiles of the selected area or the mission to a tile pack */
+    void exportTilePack();
+    /** @brief Import a tile pack into the cache */
+    void importTilePack();
     /** @brief Set follow mode */
     void setFollowUAVEnabled(bool enabled) { followUAVEnabled = enabled; }
     /** @brief Set trail to time mode and set time @param seconds The minimum time between trail dots in seconds. If set to a value < 0, trails will be disabled*/
@@ -132,6 +138,8 @@ protected slots:
     void handleMapWaypointEdit(WayPointItem* waypoint);
 
 private:
+    /** @brief Corners of the bounding box of the current mission, empty if there is none */
+    QVector<internals::PointLatLng> missionRegion() const;
     void sendGuidedAction(Waypoint *wp, double alt);
     bool isValidGpsLocation(UASInterface* system) const;
 
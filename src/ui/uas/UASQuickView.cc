@@ -7,6 +7,7 @@
 #include <QInputDialog>
 UASQuickView::UASQuickView(QWidget *parent) : QWidget(parent)
 {
+    uas=0;
     quickViewSelectDialog=0;
     m_columnCount=2;
     m_currentColumn=0;
@@ -358,37 +359,62 @@ void UASQuickView::setActiveUAS(UASInterface* uas)
     {
         return;
     }
+    if (this->uas)
+    {
+        disconnect(this->uas->getTelemetryStore(), SIGNAL(snapshotChanged(UASTelemetrySnapshot)),
+                   this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
+    }
     this->uas = uas;
-    connect(uas,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,
-            SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
-
+    m_propertyNameCache.clear();    // keys are only unique within one store
+
+    // Values are delivered coalesced at display rate, fetch everything known so far once
+    UASTelemetryStore *store = uas->getTelemetryStore();
+    UASTelemetrySnapshot snapshot;
+    snapshot.m_uasId = uas->getUASID();
+    snapshot.m_values = store->changedSince(0);
+    telemetryChanged(snapshot);
+    connect(store, SIGNAL(snapshotChanged(UASTelemetrySnapshot)), this, SLOT(telemetryChanged(UASTelemetrySnapshot)));
 }
 void UASQuickView::addSource(MAVLinkDecoder *decoder)
 {
     Q_UNUSED(decoder);
     //connect(decoder,SIGNAL(valueChanged(int,QString,QString,QVariant,quint64)),this,SLOT(valueChanged(int,QString,QString,QVariant,quint64)));
 }
-void UASQuickView::valueChanged(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec)
-{
-    Q_UNUSED(msec);
 
-    if (this->uas->getUASID() != uasId)
+void UASQuickView::telemetryChanged(const UASTelemetrySnapshot& snapshot)
+{
+    if (this->uas->getUASID() != snapshot.m_uasId)
     {
-        //This message is for the non active UAS
+        //This snapshot is for the non active UAS
         return;
     }
-    QString propername = name.mid(name.indexOf(":")+1);
-    if (!uasPropertyValueMap.contains(propername +" ("+unit+")"))
+
+    for (const auto &value : snapshot.m_values)
+    {
+        // Build the property name only once per field
+        auto iter = m_propertyNameCache.find(value.m_key);
+        if (iter == m_propertyNameCache.end())
+        {
+            iter = m_propertyNameCache.insert(value.m_key, value.m_name + " (" + value.m_unit + ")");
+        }
+        updatePropertyValue(iter.value(), value.m_value);
+    }
+}
+
+void UASQuickView::updatePropertyValue(const QString &property, const double value)
+{
+    auto iter = uasPropertyValueMap.find(property);
+    if (iter == uasPropertyValueMap.end())
     {
         if (quickViewSelectDialog)
         {
-            quickViewSelectDialog->addItem(propername +" ("+unit+")");
+            quickViewSelectDialog->addItem(property);
         }
+        uasPropertyValueMap.insert(property, value);
     }
-    bool ok = false;
-    uasPropertyValueMap[propername +" ("+unit+")"] = value.toDouble(&ok);
-    if (!ok){
-        QLOG_ERROR() << "Quick View: Error Converting QuickView Item Value: " << propername;
+    else
+    {
+        iter.value() = value;
     }
 }
 
@@ -30,6 +30,12 @@ private:
     /** Maps from property name to the display item */
     QMap<QString,UASQuickViewItem*> uasPropertyToLabelMap;
 
+    /** Property names of the telemetry fields by their key in the UASTelemetryStore */
+    QHash<int,QString> m_propertyNameCache;
+
+    /** Stores the value of a property and announces new properties to the selection dialog */
+    void updatePropertyValue(const QString &property, const double value);
+
 
     /** Timer for updating the UI */
     QTimer *updateTimer;
@@ -63,7 +69,7 @@ protected:
 signals:
     
 public slots:
-    void valueChanged(const int uasid, const QString& name, const QString& unit, const QVariant& value,const quint64 msecs);
+    void telemetryChanged(const UASTelemetrySnapshot& snapshot);
 
     void actionTriggered(bool checked);
     void actionTriggered();